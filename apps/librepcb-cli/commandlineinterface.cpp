@@ -59,7 +59,10 @@
 #include <librepcb/core/project/projectattributelookup.h>
 #include <librepcb/core/project/projectloader.h>
 #include <librepcb/core/project/schematic/schematicpainter.h>
+#include <librepcb/core/utils/scopeguard.h>
+#include <librepcb/core/utils/taskscheduler.h>
 #include <librepcb/core/utils/toolbox.h>
+#include <librepcb/core/utils/tracer.h>
 
 #include <QtCore>
 
@@ -85,6 +88,9 @@ CommandLineInterface::CommandLineInterface() noexcept {
 int CommandLineInterface::execute(const QStringList& args) noexcept {
   QStringList positionalArgNames;
   QMap<QString, QPair<QString, QString>> commands = {
+      {"generate-project",
+       {tr("Generate a synthetic project for stress testing."),
+        "generate-project [command_options]"}},  // no tr()!
       {"open-project",
        {tr("Open a project to execute project-related tasks."),
         "open-project [command_options]"}},  // no tr()!
@@ -119,6 +125,13 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
                                tr("The command to execute (see list below)."));
   positionalArgNames.append("command");
 
+  // Define options for several commands
+  QCommandLineOption traceOption(
+      "trace",
+      tr("Record a performance trace and write it to the given file (Chrome "
+         "trace event format, e.g. for Perfetto)."),
+      tr("file"));
+
   // Define options for "open-project"
   QCommandLineOption ercOption(
       "erc",
@@ -148,6 +161,15 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
       tr("Override output jobs with a *.lp file containing custom jobs. If not "
          "set, the jobs from the project will be used instead."),
       tr("file"));
+  QCommandLineOption parallelOption(
+      {"j", "parallel"},
+      tr("Maximum number of output jobs to run in parallel. Use 0 to run as "
+         "many jobs in parallel as there are CPU cores. Default: 1"),
+      tr("count"));
+  QCommandLineOption forceOption(
+      "force",
+      tr("Run output jobs even if their inputs did not change since the last "
+         "run."));
   QCommandLineOption customOutDirOption(
       "outdir",
       tr("Override the output base directory of jobs. If not set, the "
@@ -263,6 +285,12 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
       "minify-step",
       tr("Minify the STEP models of all packages. Only works in conjunction "
          "with '--all'. Pass '--save' to write the minified files to disk."));
+  QCommandLineOption libParallelOption(
+      {"j", "parallel"},
+      tr("Maximum number of library elements to process in parallel. Use 0 to "
+         "process as many elements in parallel as there are CPU cores. "
+         "Default: 1"),
+      tr("count"));
   QCommandLineOption libSaveOption(
       "save",
       tr("Save library (and contained elements if '--all' is given) "
@@ -314,6 +342,47 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
           .arg("--minify"),
       tr("file"));
 
+  // Define options for "generate-project"
+  const SyntheticProjectGenerator::Options defaultGeneratorOptions;
+  QCommandLineOption genComponentsOption(
+      "components", tr("Number of two-pin components (default: %1).")
+                        .arg(defaultGeneratorOptions.componentCount),
+      tr("count"));
+  QCommandLineOption genNetsOption(
+      "nets",
+      tr("Number of nets (default: %1).").arg(defaultGeneratorOptions.netCount),
+      tr("count"));
+  QCommandLineOption genInnerLayersOption(
+      "inner-layers",
+      tr("Number of inner copper layers (default: %1).")
+          .arg(defaultGeneratorOptions.innerLayerCount),
+      tr("count"));
+  QCommandLineOption genSchematicsOption(
+      "schematics",
+      tr("Number of schematic sheets (default: %1).")
+          .arg(defaultGeneratorOptions.schematicCount),
+      tr("count"));
+  QCommandLineOption genPlanesOption(
+      "planes",
+      tr("Number of planes (default: %1).")
+          .arg(defaultGeneratorOptions.planeCount),
+      tr("count"));
+  QCommandLineOption genTracesOption(
+      "traces",
+      tr("Percentage of pad connections routed with traces (default: %1).")
+          .arg(defaultGeneratorOptions.tracePercent),
+      tr("percent"));
+  QCommandLineOption genViasOption(
+      "vias",
+      tr("Percentage of routed connections containing a via (default: %1).")
+          .arg(defaultGeneratorOptions.viaPercent),
+      tr("percent"));
+  QCommandLineOption genSeedOption(
+      "seed",
+      tr("Seed of the random generator. The same seed and options always "
+         "lead to the same content (default: 0)."),
+      tr("number"));
+
   // Mark deprecated options.
   QMap<QString, QString> deprecations;
   auto setDeprecated = [&](QCommandLineOption& option,
@@ -339,7 +408,7 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
   const QString executable = args.value(0);
   QString helpText = parser.helpText() % "\n" % tr("Commands:") % "\n";
   for (auto it = commands.constBegin(); it != commands.constEnd(); ++it) {
-    helpText += "  " % it.key().leftJustified(15) % it.value().first % "\n";
+    helpText += "  " % it.key().leftJustified(19) % it.value().first % "\n";
   }
   helpText += "\n" % tr("List command-specific options:") % "\n  " %
       executable % " <command> --help";
@@ -354,7 +423,21 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
   // Add command-dependent options
   const QString command = parser.positionalArguments().value(0);
   parser.clearPositionalArguments();
-  if (command == "open-project") {
+  if (command == "generate-project") {
+    parser.addPositionalArgument(command, commands[command].first,
+                                 commands[command].second);
+    parser.addPositionalArgument(
+        "project", tr("Path to the project file to create (*.lpp)."));
+    positionalArgNames.append("project");
+    parser.addOption(genComponentsOption);
+    parser.addOption(genNetsOption);
+    parser.addOption(genInnerLayersOption);
+    parser.addOption(genSchematicsOption);
+    parser.addOption(genPlanesOption);
+    parser.addOption(genTracesOption);
+    parser.addOption(genViasOption);
+    parser.addOption(genSeedOption);
+  } else if (command == "open-project") {
     parser.addPositionalArgument(command, commands[command].first,
                                  commands[command].second);
     parser.addPositionalArgument("project",
@@ -367,6 +450,8 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
     parser.addOption(runAllJobsOption);
     parser.addOption(customJobsOption);
     parser.addOption(customOutDirOption);
+    parser.addOption(parallelOption);
+    parser.addOption(forceOption);
     parser.addOption(exportSchematicsOption);
     parser.addOption(exportBomOption);
     parser.addOption(exportBoardBomOption);
@@ -384,6 +469,7 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
     parser.addOption(setDefaultAssemblyVariantOption);
     parser.addOption(saveOption);
     parser.addOption(prjStrictOption);
+    parser.addOption(traceOption);
   } else if (command == "open-library") {
     parser.addPositionalArgument(command, commands[command].first,
                                  commands[command].second);
@@ -393,8 +479,10 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
     parser.addOption(libAllOption);
     parser.addOption(libCheckOption);
     parser.addOption(libMinifyStepOption);
+    parser.addOption(libParallelOption);
     parser.addOption(libSaveOption);
     parser.addOption(libStrictOption);
+    parser.addOption(traceOption);
   } else if (command == "open-symbol") {
     parser.addPositionalArgument(command, commands[command].first,
                                  commands[command].second);
@@ -503,9 +591,70 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
     }
   }
 
+  // --parallel
+  int parallelJobs = 1;
+  if (((command == "open-project") || (command == "open-library")) &&
+      parser.isSet("parallel")) {
+    bool ok = false;
+    parallelJobs = parser.value("parallel").toInt(&ok);
+    if ((!ok) || (parallelJobs < 0)) {
+      printErr(tr("Invalid number of parallel jobs: '%1'")
+                   .arg(parser.value("parallel")));
+      printErr(helpCommandText);
+      return 1;
+    } else if (parallelJobs == 0) {
+      parallelJobs = QThread::idealThreadCount();
+    }
+  }
+
+  // generate-project options
+  SyntheticProjectGenerator::Options generatorOptions;
+  quint32 generatorSeed = 0;
+  if (command == "generate-project") {
+    auto parseInt = [&](const QCommandLineOption& option, int& value) {
+      if (parser.isSet(option)) {
+        bool ok = false;
+        value = parser.value(option).toInt(&ok);
+        if (!ok) {
+          printErr(tr("Invalid value for '%1': '%2'")
+                       .arg("--" % option.names().value(0))
+                       .arg(parser.value(option)));
+          printErr(helpCommandText);
+          return false;
+        }
+      }
+      return true;
+    };
+    int seed = 0;
+    if ((!parseInt(genComponentsOption, generatorOptions.componentCount)) ||
+        (!parseInt(genNetsOption, generatorOptions.netCount)) ||
+        (!parseInt(genInnerLayersOption, generatorOptions.innerLayerCount)) ||
+        (!parseInt(genSchematicsOption, generatorOptions.schematicCount)) ||
+        (!parseInt(genPlanesOption, generatorOptions.planeCount)) ||
+        (!parseInt(genTracesOption, generatorOptions.tracePercent)) ||
+        (!parseInt(genViasOption, generatorOptions.viaPercent)) ||
+        (!parseInt(genSeedOption, seed))) {
+      return 1;
+    }
+    generatorSeed = static_cast<quint32>(seed);
+  }
+
+  // --trace
+  QString traceFile;
+  if (((command == "open-project") || (command == "open-library")) &&
+      parser.isSet(traceOption)) {
+    traceFile = parser.value(traceOption).trimmed();
+    Tracer::instance().start();
+  }
+
   // Execute command
   bool cmdSuccess = false;
-  if (command == "open-project") {
+  if (command == "generate-project") {
+    cmdSuccess = generateProject(positionalArgs.value(1),  // project filepath
+                                 generatorOptions,  // generator options
+                                 generatorSeed  // generator seed
+    );
+  } else if (command == "open-project") {
     cmdSuccess = openProject(
         positionalArgs.value(1),  // project filepath
         parser.isSet(ercOption),  // run ERC
@@ -515,6 +664,8 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
         parser.isSet(runAllJobsOption),  // run all output jobs
         parser.value(customJobsOption).trimmed(),  // custom jobs file path
         parser.value(customOutDirOption).trimmed(),  // custom jobs outdir
+        parallelJobs,  // parallel output jobs
+        parser.isSet(forceOption),  // force running unchanged output jobs
         parser.values(exportSchematicsOption),  // export schematics
         parser.values(exportBomOption),  // export generic BOM
         parser.values(exportBoardBomOption),  // export board BOM
@@ -538,6 +689,7 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
                              parser.isSet(libAllOption),  // all elements
                              parser.isSet(libCheckOption),  // run check
                              parser.isSet(libMinifyStepOption),  // minify STEP
+                             parallelJobs,  // parallel elements
                              parser.isSet(libSaveOption),  // save
                              parser.isSet(libStrictOption)  // strict mode
     );
@@ -561,6 +713,19 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
     printErr("Internal failure.");  // No tr() because this cannot occur.
   }
 
+  // Write trace file.
+  if (!traceFile.isEmpty()) {
+    Tracer::instance().stop();
+    try {
+      const FilePath fp(QFileInfo(traceFile).absoluteFilePath());
+      Tracer::instance().writeChromeTrace(fp);  // can throw
+      print(tr("Trace written to '%1'.").arg(prettyPath(fp, traceFile)));
+    } catch (const Exception& e) {
+      printErr(tr("ERROR: Failed to write trace: %1").arg(e.getMsg()));
+      cmdSuccess = false;
+    }
+  }
+
   // Report status with the exit code:
   //  - 0: Success
   //  - 1: Errors
@@ -581,11 +746,50 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
  *  Private Methods
  ******************************************************************************/
 
+bool CommandLineInterface::generateProject(
+    const QString& projectFile,
+    const SyntheticProjectGenerator::Options& options,
+    quint32 seed) const noexcept {
+  try {
+    // Note: Not using tr() for this command as it is basically intended for
+    // developers, not end users.
+
+    const FilePath projectFp(QFileInfo(projectFile).absoluteFilePath());
+    print(QString("Generate project '%1'...")
+              .arg(prettyPath(projectFp, projectFile)));
+    if (projectFp.getSuffix() != "lpp") {
+      printErr("ERROR: The project file must have the suffix '.lpp'.");
+      return false;
+    }
+    if (failIfFileFormatUnstable()) {
+      return false;
+    }
+    SyntheticProjectGenerator generator(options, seed);
+    generator.generate(projectFp);  // can throw
+    const SyntheticProjectGenerator::Statistics& stats =
+        generator.getStatistics();
+    print(QString(" - %1 components, %2 nets, %3 schematics, %4 net labels")
+              .arg(stats.components)
+              .arg(stats.nets)
+              .arg(stats.schematics)
+              .arg(stats.netLabels));
+    print(QString(" - %1 traces, %2 vias, %3 planes")
+              .arg(stats.traces)
+              .arg(stats.vias)
+              .arg(stats.planes));
+    return true;
+  } catch (const Exception& e) {
+    printErr(QString("ERROR: %1").arg(e.getMsg()));
+    return false;
+  }
+}
+
 bool CommandLineInterface::openProject(
     const QString& projectFile, bool runErc, bool runDrc,
     const QString& drcSettingsPath, const QStringList& runJobs, bool runAllJobs,
     const QString& customJobsPath, const QString& customOutDir,
-    const QStringList& exportSchematicsFiles, const QStringList& exportBomFiles,
+    int parallelJobs, bool force, const QStringList& exportSchematicsFiles,
+    const QStringList& exportBomFiles,
     const QStringList& exportBoardBomFiles, const QString& bomAttributes,
     bool exportPcbFabricationData, const QString& pcbFabricationSettingsPath,
     const QStringList& exportPnpTopFiles,
@@ -618,6 +822,7 @@ bool CommandLineInterface::openProject(
       projectFileName = projectFp.getFilename();
     }
     ProjectLoader loader;
+    loader.setLazyLoading(true);  // Load schematics & boards only if needed.
     std::unique_ptr<Project> project =
         loader.open(std::unique_ptr<TransactionalDirectory>(
                         new TransactionalDirectory(projectFs)),
@@ -723,8 +928,14 @@ bool CommandLineInterface::openProject(
       }
     }
 
-    // If no boards are specified, export all boards.
-    if (boardNames.isEmpty() && boardIndices.isEmpty()) {
+    // If no boards are specified, export all boards. But since boards are
+    // loaded lazily, avoid accessing them if no command needs them.
+    const bool boardsNeeded = runDrc || exportPcbFabricationData ||
+        (!runJobs.isEmpty()) || runAllJobs ||
+        (!exportBoardBomFiles.isEmpty()) || (!exportPnpTopFiles.isEmpty()) ||
+        (!exportPnpBottomFiles.isEmpty()) || (!exportNetlistFiles.isEmpty());
+    if (boardNames.isEmpty() && boardIndices.isEmpty() && boardsNeeded) {
+      project->loadPendingBoards();  // can throw
       boards = project->getBoards();
     }
 
@@ -770,9 +981,12 @@ bool CommandLineInterface::openProject(
     // ERC
     if (runErc) {
       print(tr("Run ERC..."));
-      ElectricalRuleCheck erc(*project);
+      project->loadPendingSchematics();  // can throw
+      project->loadPendingBoards();  // can throw
+      ElectricalRuleCheck erc;
       int approvedMsgCount = 0;
-      const RuleCheckMessageList messages = erc.runChecks();
+      const RuleCheckMessageList messages =
+          erc.runChecks(ElectricalRuleCheckData(*project));
       const QStringList nonApproved = prepareRuleCheckMessages(
           messages, project->getErcMessageApprovals(), approvedMsgCount);
 
@@ -878,6 +1092,12 @@ bool CommandLineInterface::openProject(
               [](std::shared_ptr<const OutputJob> job) {
                 print(tr("Run output job '%1'...").arg(*job->getName()));
               });
+          QObject::connect(
+              &runner, &OutputJobRunner::jobSkipped,
+              [](std::shared_ptr<const OutputJob> job) {
+                print(tr("Skip output job '%1' (up to date).")
+                          .arg(*job->getName()));
+              });
           QObject::connect(
               &runner, &OutputJobRunner::aboutToWriteFile,
               [&projectFile,
@@ -893,6 +1113,11 @@ bool CommandLineInterface::openProject(
           }
           qDebug() << "Using output base directory:"
                    << runner.getOutputDirectory().toNative();
+          runner.setMaxConcurrentJobs(parallelJobs);
+          // Modifications in memory are not covered by the job fingerprints,
+          // so unchanged jobs can only be skipped if there are none.
+          runner.setSkipUnchangedJobs((!force) && (!removeOtherBoards) &&
+                                      setDefaultAv.isEmpty());
           runner.run(jobs);  // can throw
         } catch (const Exception& e) {
           printErr(tr("ERROR:") % " " % e.getMsg());
@@ -1132,6 +1357,12 @@ bool CommandLineInterface::openProject(
       }
     }
 
+    // Fail if schematics or boards failed to load on first access.
+    foreach (const QString& msg, project->getLazyLoadingErrors()) {
+      printErr(tr("ERROR: %1").arg(msg));
+      success = false;
+    }
+
     // Fail if some files were written multiple times
     bool filesOverwritten = false;
     for (auto it = writtenFilesCounter.begin(); it != writtenFilesCounter.end();
@@ -1163,7 +1394,8 @@ bool CommandLineInterface::openProject(
 
 bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
                                        bool runCheck, bool minifyStepFiles,
-                                       bool save, bool strict) const noexcept {
+                                       int parallelJobs, bool save,
+                                       bool strict) const noexcept {
   try {
     bool success = true;
 
@@ -1176,122 +1408,40 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
     std::unique_ptr<Library> lib =
         Library::open(std::unique_ptr<TransactionalDirectory>(
             new TransactionalDirectory(libFs)));  // can throw
+    ElementOutput output;
     processLibraryElement(libDir, *libFs, *lib, runCheck, minifyStepFiles, save,
-                          strict,
-                          success);  // can throw
-
-    // Open all component categories
-    if (all) {
-      QStringList elements = lib->searchForElements<ComponentCategory>();
-      elements.sort();  // For deterministic console output.
-      print(tr("Process %1 component categories...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<ComponentCategory> element =
-            ComponentCategory::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
-    }
-
-    // Open all package categories
-    if (all) {
-      QStringList elements = lib->searchForElements<PackageCategory>();
-      elements.sort();  // For deterministic console output.
-      print(tr("Process %1 package categories...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<PackageCategory> element =
-            PackageCategory::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
-    }
-
-    // Open all symbols
-    if (all) {
-      QStringList elements = lib->searchForElements<Symbol>();
-      elements.sort();  // For deterministic console output.
-      print(tr("Process %1 symbols...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<Symbol> element =
-            Symbol::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
-    }
-
-    // Open all packages
-    if (all) {
-      QStringList elements = lib->searchForElements<Package>();
-      elements.sort();  // For deterministic console output.
-      print(tr("Process %1 packages...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<Package> element =
-            Package::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
-    }
-
-    // Open all components
-    if (all) {
-      QStringList elements = lib->searchForElements<Component>();
-      elements.sort();  // For deterministic console output.
-      print(tr("Process %1 components...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<Component> element =
-            Component::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
+                          strict, output);  // can throw
+    output.flush();
+    if (!output.success) {
+      success = false;
     }
 
-    // Open all devices
+    // Open all contained elements
     if (all) {
-      QStringList elements = lib->searchForElements<Device>();
-      elements.sort();  // For deterministic console output.
-      print(tr("Process %1 devices...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<Device> element =
-            Device::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
+      processLibraryElements<ComponentCategory>(
+          libDir, libFp, *lib, tr("Process %1 component categories..."),
+          runCheck, minifyStepFiles, parallelJobs, save, strict,
+          success);  // can throw
+      processLibraryElements<PackageCategory>(
+          libDir, libFp, *lib, tr("Process %1 package categories..."),
+          runCheck, minifyStepFiles, parallelJobs, save, strict,
+          success);  // can throw
+      processLibraryElements<Symbol>(libDir, libFp, *lib,
+                                     tr("Process %1 symbols..."), runCheck,
+                                     minifyStepFiles, parallelJobs, save,
+                                     strict, success);  // can throw
+      processLibraryElements<Package>(libDir, libFp, *lib,
+                                      tr("Process %1 packages..."), runCheck,
+                                      minifyStepFiles, parallelJobs, save,
+                                      strict, success);  // can throw
+      processLibraryElements<Component>(
+          libDir, libFp, *lib, tr("Process %1 components..."), runCheck,
+          minifyStepFiles, parallelJobs, save, strict,
+          success);  // can throw
+      processLibraryElements<Device>(libDir, libFp, *lib,
+                                     tr("Process %1 devices..."), runCheck,
+                                     minifyStepFiles, parallelJobs, save,
+                                     strict, success);  // can throw
     }
 
     return success;
@@ -1301,6 +1451,60 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
   }
 }
 
+template <typename ElementType>
+void CommandLineInterface::processLibraryElements(
+    const QString& libDir, const FilePath& libFp, const Library& lib,
+    const QString& title, bool runCheck, bool minifyStepFiles,
+    int parallelJobs, bool save, bool strict, bool& success) const {
+  QStringList elements = lib.searchForElements<ElementType>();
+  elements.sort();  // For deterministic console output.
+  print(title.arg(elements.count()));
+
+  // The elements are independent of each other, so they are processed in
+  // parallel. The output is collected and printed in the sorted order.
+  TaskScheduler& scheduler = TaskScheduler::instance();
+  scheduler.setConcurrencyLimit(TaskScheduler::Group::Library, parallelJobs);
+  CancellationToken token;
+  QVector<QFuture<ElementOutput>> futures;
+  auto sg = scopeGuard([&scheduler, &token, &futures]() {
+    // In case of errors, don't process any further elements.
+    token.cancel();
+    for (const QFuture<ElementOutput>& future : futures) {
+      try {
+        scheduler.waitForFinished(future);  // can throw
+      } catch (...) {
+        // Only the first error is reported.
+      }
+    }
+  });
+  foreach (const QString& dir, elements) {
+    futures.append(scheduler.run(
+        TaskScheduler::Group::Library, TaskScheduler::Priority::Normal,
+        [&, dir]() {
+          const FilePath fp = libFp.getPathTo(dir);
+          qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
+          std::shared_ptr<TransactionalFileSystem> fs =
+              TransactionalFileSystem::open(fp, save);  // can throw
+          std::unique_ptr<ElementType> element =
+              ElementType::open(std::unique_ptr<TransactionalDirectory>(
+                  new TransactionalDirectory(fs)));  // can throw
+          ElementOutput output;
+          processLibraryElement(libDir, *fs, *element, runCheck,
+                                minifyStepFiles, save, strict,
+                                output);  // can throw
+          return output;
+        },
+        token));
+  }
+  for (QFuture<ElementOutput>& future : futures) {
+    const ElementOutput output = future.result();  // can throw
+    output.flush();
+    if (!output.success) {
+      success = false;
+    }
+  }
+}
+
 CommandLineInterface::CheckResult
     CommandLineInterface::gatherElementCheckMessages(
         const LibraryBaseElement& element) const {
@@ -1332,14 +1536,14 @@ QStringList CommandLineInterface::formatCheckSummary(
 void CommandLineInterface::processLibraryElement(
     const QString& libDir, TransactionalFileSystem& fs,
     LibraryBaseElement& element, bool runCheck, bool minifyStepFiles, bool save,
-    bool strict, bool& success) const {
+    bool strict, ElementOutput& output) const {
   // Keep track of whether we've yet printed the error header for this element
   bool errorHeaderPrinted = false;
-  auto printErrorHeaderOnce = [&errorHeaderPrinted, &element]() {
+  auto printErrorHeaderOnce = [&errorHeaderPrinted, &element, &output]() {
     if (!errorHeaderPrinted) {
-      printErr(QString("  - %1 (%2):")
-                   .arg(*element.getNames().getDefaultValue(),
-                        element.getUuid().toStr()));
+      output.printErr(QString("  - %1 (%2):")
+                          .arg(*element.getNames().getDefaultValue(),
+                               element.getUuid().toStr()));
       errorHeaderPrinted = true;
     }
   };
@@ -1360,18 +1564,19 @@ void CommandLineInterface::processLibraryElement(
           const QByteArray minified =
               OccModel::minifyStep(content);  // can throw
           if (minified != content) {
-            print(tr("  - Minified '%1' from %2 to %3 bytes")
-                      .arg(fp)
-                      .arg(content.size())
-                      .arg(minified.size()));
+            output.print(tr("  - Minified '%1' from %2 to %3 bytes")
+                             .arg(fp)
+                             .arg(content.size())
+                             .arg(minified.size()));
             OccModel::loadStep(minified);  // throws if STEP is invalid
             fs.write(file, minified);
           }
         } catch (const Exception& e) {
           printErrorHeaderOnce();
-          printErr(QString("    - Failed to minify STEP model '%1': %2")
-                       .arg(fp, e.getMsg()));
-          success = false;
+          output.printErr(
+              QString("    - Failed to minify STEP model '%1': %2")
+                  .arg(fp, e.getMsg()));
+          output.success = false;
         }
       }
     }
@@ -1388,10 +1593,10 @@ void CommandLineInterface::processLibraryElement(
       std::sort(paths.begin(), paths.end());
       printErrorHeaderOnce();
       foreach (const QString& path, paths) {
-        printErr(QString("    - Non-canonical file: '%1'")
-                     .arg(prettyPath(fs.getAbsPath(path), libDir)));
+        output.printErr(QString("    - Non-canonical file: '%1'")
+                            .arg(prettyPath(fs.getAbsPath(path), libDir)));
       }
-      success = false;
+      output.success = false;
     }
   }
 
@@ -1414,8 +1619,8 @@ void CommandLineInterface::processLibraryElement(
     // messages
     foreach (const QString& msg, checkResult.nonApprovedMessages) {
       printErrorHeaderOnce();
-      printErr("    - " % msg);
-      success = false;
+      output.printErr("    - " % msg);
+      output.success = false;
     }
   }
 
@@ -1423,8 +1628,8 @@ void CommandLineInterface::processLibraryElement(
   if (save) {
     qInfo().noquote()
         << tr("Save '%1'...").arg(prettyPath(fs.getPath(), libDir));
-    if (failIfFileFormatUnstable()) {
-      success = false;
+    if (failIfFileFormatUnstable(&output)) {
+      output.success = false;
     } else {
       fs.save();  // can throw
     }
@@ -1742,7 +1947,7 @@ bool CommandLineInterface::openStep(const QString& filePath, bool minify,
 }
 
 QStringList CommandLineInterface::prepareRuleCheckMessages(
-    RuleCheckMessageList messages, const QSet<SExpression>& approvals,
+    RuleCheckMessageList messages, const QSet<ApprovalKey>& approvals,
     int& approvedMsgCount) noexcept {
   // Sort messages to increases readability of console output.
   Toolbox::sortNumeric(
@@ -1760,7 +1965,7 @@ QStringList CommandLineInterface::prepareRuleCheckMessages(
   approvedMsgCount = 0;
   QStringList printedMessages;
   foreach (const auto& msg, messages) {
-    if (approvals.contains(msg->getApproval())) {
+    if (approvals.contains(msg->getApprovalKey())) {
       ++approvedMsgCount;
     } else {
       printedMessages.append(QString("[%1] %2").arg(
@@ -1784,14 +1989,20 @@ QString CommandLineInterface::prettyPath(const FilePath& path,
   }
 }
 
-bool CommandLineInterface::failIfFileFormatUnstable() noexcept {
+bool CommandLineInterface::failIfFileFormatUnstable(
+    ElementOutput* output) noexcept {
   if ((!Application::isFileFormatStable()) &&
       (qgetenv("LIBREPCB_DISABLE_UNSTABLE_WARNING") != "1")) {
-    printErr(
+    const QString msg =
         tr("This application version is UNSTABLE! Option '%1' is disabled to "
            "avoid breaking projects or libraries. Please use a stable "
            "release instead.")
-            .arg("--save"));
+            .arg("--save");
+    if (output) {
+      output->printErr(msg);
+    } else {
+      printErr(msg);
+    }
     return true;
   } else {
     qInfo() << "Application version is unstable, but warning is disabled with "
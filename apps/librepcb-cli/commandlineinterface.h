@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include <librepcb/core/project/syntheticprojectgenerator.h>
 #include <librepcb/core/rulecheck/rulecheckmessage.h>
 
 #include <QtCore>
@@ -33,8 +34,8 @@
 namespace librepcb {
 
 class FilePath;
+class Library;
 class LibraryBaseElement;
-class SExpression;
 class TransactionalFileSystem;
 
 namespace cli {
@@ -64,11 +65,38 @@ private:  // Methods
     QStringList nonApprovedMessages;
   };
 
+  // Console output of a library element. Since elements are processed in
+  // parallel, the output is collected first and printed afterwards.
+  struct ElementOutput {
+    QList<std::pair<bool, QString>> lines;  ///< {isError, line}
+    bool success = true;
+
+    void print(const QString& str) noexcept {
+      lines.append(std::make_pair(false, str));
+    }
+    void printErr(const QString& str) noexcept {
+      lines.append(std::make_pair(true, str));
+    }
+    void flush() const noexcept {
+      for (const auto& line : lines) {
+        if (line.first) {
+          CommandLineInterface::printErr(line.second);
+        } else {
+          CommandLineInterface::print(line.second);
+        }
+      }
+    }
+  };
+
+  bool generateProject(const QString& projectFile,
+                       const SyntheticProjectGenerator::Options& options,
+                       quint32 seed) const noexcept;
   bool openProject(
       const QString& projectFile, bool runErc, bool runDrc,
       const QString& drcSettingsPath, const QStringList& runJobs,
       bool runAllJobs, const QString& customJobsPath,
-      const QString& customOutDir, const QStringList& exportSchematicsFiles,
+      const QString& customOutDir, int parallelJobs, bool force,
+      const QStringList& exportSchematicsFiles,
       const QStringList& exportBomFiles, const QStringList& exportBoardBomFiles,
       const QString& bomAttributes, bool exportPcbFabricationData,
       const QString& pcbFabricationSettingsPath,
@@ -80,7 +108,8 @@ private:  // Methods
       const QString& setDefaultAv, bool save, bool strict) const noexcept;
 
   bool openLibrary(const QString& libDir, bool all, bool runCheck,
-                   bool minifyStepFiles, bool save, bool strict) const noexcept;
+                   bool minifyStepFiles, int parallelJobs, bool save,
+                   bool strict) const noexcept;
 
   /**
    * @brief Gather validation check messages for a library element
@@ -101,10 +130,16 @@ private:  // Methods
   QStringList formatCheckSummary(int approvedCount, int nonApprovedCount,
                                  const QString& indent = "") const;
 
+  template <typename ElementType>
+  void processLibraryElements(const QString& libDir, const FilePath& libFp,
+                              const Library& lib, const QString& title,
+                              bool runCheck, bool minifyStepFiles,
+                              int parallelJobs, bool save, bool strict,
+                              bool& success) const;
   void processLibraryElement(const QString& libDir, TransactionalFileSystem& fs,
                              LibraryBaseElement& element, bool runCheck,
                              bool minifyStepFiles, bool save, bool strict,
-                             bool& success) const;
+                             ElementOutput& output) const;
   bool openSymbol(const QString& symbolFile, bool runCheck,
                   const QString& exportFile) const noexcept;
   bool openPackage(const QString& packageFile, bool runCheck,
@@ -112,11 +147,12 @@ private:  // Methods
   bool openStep(const QString& filePath, bool minify, bool tesselate,
                 const QString& saveTo) const noexcept;
   static QStringList prepareRuleCheckMessages(
-      RuleCheckMessageList messages, const QSet<SExpression>& approvals,
+      RuleCheckMessageList messages, const QSet<ApprovalKey>& approvals,
       int& approvedMsgCount) noexcept;
   static QString prettyPath(const FilePath& path,
                             const QString& style) noexcept;
-  static bool failIfFileFormatUnstable() noexcept;
+  static bool failIfFileFormatUnstable(
+      ElementOutput* output = nullptr) noexcept;
   static void print(const QString& str) noexcept;
   static void printErr(const QString& str) noexcept;
   static bool suppressDeprecationWarnings() noexcept;
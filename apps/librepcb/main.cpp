@@ -24,6 +24,8 @@
 #include <librepcb/core/debug.h>
 #include <librepcb/core/exceptions.h>
 #include <librepcb/core/network/networkaccessmanager.h>
+#include <librepcb/core/utils/taskscheduler.h>
+#include <librepcb/core/utils/tracer.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacesettings.h>
 #include <librepcb/editor/dialogs/directorylockhandlerdialog.h>
@@ -32,7 +34,6 @@
 #include <librepcb/editor/project/partinformationprovider.h>
 #include <librepcb/editor/workspace/initializeworkspacewizard/initializeworkspacewizard.h>
 
-#include <QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -52,6 +53,7 @@ static void writeLogHeader() noexcept;
 static int runApplication() noexcept;
 static bool isFileFormatStableOrAcceptUnstable() noexcept;
 static int openWorkspace(FilePath& path);
+static void writeTraceFile(const QString& path) noexcept;
 
 /*******************************************************************************
  *  main()
@@ -79,6 +81,13 @@ int main(int argc, char* argv[]) {
   // Write some information about the application instance to the log.
   writeLogHeader();
 
+  // Record a performance trace if the environment variable
+  // "LIBREPCB_TRACE_FILE" is set. The trace is written when exiting.
+  const QString traceFile = qgetenv("LIBREPCB_TRACE_FILE");
+  if (!traceFile.isEmpty()) {
+    Tracer::instance().start();
+  }
+
   // Perform global initialization tasks. This must be done before any widget is
   // shown.
   Application::loadBundledFonts();
@@ -86,7 +95,9 @@ int main(int argc, char* argv[]) {
 
   // Clean up old temporary files since at least on Windows this is not done
   // automatically. Let's do it in a thread to avoid delaying application start.
-  std::ignore = QtConcurrent::run(&Application::cleanTemporaryDirectory);
+  std::ignore = TaskScheduler::instance().run(
+      TaskScheduler::Group::Default, TaskScheduler::Priority::Background,
+      &Application::cleanTemporaryDirectory);
 
   // This is to remove the ugly frames around widgets in all status bars...
   // (from http://www.qtcentre.org/threads/1904)
@@ -131,6 +142,11 @@ int main(int argc, char* argv[]) {
   // Stop network access manager thread
   networkAccessManager.reset();
 
+  // Write performance trace, if enabled
+  if (!traceFile.isEmpty()) {
+    writeTraceFile(traceFile);
+  }
+
   qDebug().nospace() << "Exit application with code " << retval << ".";
   return retval;
 }
@@ -355,3 +371,19 @@ static int openWorkspace(FilePath& path) {
   app.exec();
   return 0;
 }
+
+/*******************************************************************************
+ *  writeTraceFile()
+ ******************************************************************************/
+
+static void writeTraceFile(const QString& path) noexcept {
+  Tracer::instance().stop();
+  try {
+    const FilePath fp(QFileInfo(path).absoluteFilePath());
+    Tracer::instance().writeChromeTrace(fp);  // can throw
+    qInfo().nospace() << "Written performance trace to " << fp.toNative()
+                      << ".";
+  } catch (const Exception& e) {
+    qCritical() << "Failed to write performance trace:" << e.getMsg();
+  }
+}
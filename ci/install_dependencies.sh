@@ -156,6 +156,14 @@ then
   fi
 fi
 
+# Install Google Benchmark if the benchmarks shall be built
+if [ "${BUILD_BENCHMARKS-}" = "true" ]
+then
+  echo "Installing Google Benchmark..."
+  sudo apt-get update
+  sudo apt-get install -y --no-install-recommends libbenchmark-dev
+fi
+
 # Install Python packages
 export CMAKE_GENERATOR=Ninja
 export FUNQ_MAKE_PATH=ninja
@@ -0,0 +1,28 @@
+# Note: Google Benchmark is not vendored, so it is only searched on the system.
+# The benchmarks are optional anyway (see BUILD_BENCHMARKS option).
+
+find_package(benchmark CONFIG)
+if(benchmark_FOUND)
+  message(STATUS "Using system Google Benchmark")
+
+  # Add namespaced alias if only the plain target is defined
+  if(NOT TARGET benchmark::benchmark)
+    add_library(benchmark::benchmark ALIAS benchmark)
+  endif()
+
+  # Stop here, we're done
+  return()
+endif()
+
+# Otherwise, try to find shared library on the system via pkg-config
+find_package(PkgConfig QUIET)
+if(PKGCONFIG_FOUND)
+  pkg_check_modules(GoogleBenchmark GLOBAL IMPORTED_TARGET benchmark)
+endif()
+if(GoogleBenchmark_FOUND)
+  message(STATUS "Using system Google Benchmark (via pkg-config)")
+  add_library(benchmark::benchmark ALIAS PkgConfig::GoogleBenchmark)
+  return()
+endif()
+
+message(FATAL_ERROR "Did not find Google Benchmark system library")
@@ -86,6 +86,11 @@ struct OccModel::Data {
 #if USE_OPENCASCADE
   Handle(TDocStd_Document) doc;
   TDF_Label assemblyLabel;
+
+  // Models already added to this assembly, with the label of their product.
+  // The source document handle is kept to ensure the key stays unique.
+  QHash<const TDocStd_Document*, std::pair<Handle(TDocStd_Document), TDF_Label>>
+      products;
 #else
   int dummy;
 #endif
@@ -253,6 +258,18 @@ static void tesselateLabel(Handle(XCAFDoc_ShapeTool) shapeTool,
   }
 }
 
+static Handle(TDocStd_Document) newDocument() {
+  // The application is a process-wide singleton which is not thread-safe, so
+  // creating documents must be serialized. Everything else works on per-thread
+  // documents and shapes, thus can run in parallel.
+  static QMutex mutex;
+  QMutexLocker lock(&mutex);
+  Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
+  Handle(TDocStd_Document) doc;
+  app->NewDocument("MDTV-XCAF", doc);
+  return doc;
+}
+
 static gp_Pnt convertPoint(const Point& xy, const Length& z) {
   return gp_Pnt(xy.getX().toMm(), xy.getY().toMm(), z.toMm());
 }
@@ -314,7 +331,7 @@ OccModel::~OccModel() noexcept {
 
 void OccModel::addToAssembly(const OccModel& model, const Point3D& pos,
                              const Angle3D& rot, const Transform& transform,
-                             const QString& name) {
+                             const QString& productName, const QString& name) {
 #if USE_OPENCASCADE
   try {
     Handle(XCAFDoc_ShapeTool) assemblyShapeTool =
@@ -328,17 +345,28 @@ void OccModel::addToAssembly(const OccModel& model, const Point3D& pos,
     TopExp_Explorer assemblyExplorer;
     TopExp_Explorer modelExplorer;
 
-    TDF_Label newLabel = assemblyShapeTool->NewShape();
-    TCollection_ExtendedString newName(cleanString(name).toStdString().c_str());
-    TDataStd_Name::Set(newLabel, newName);
+    // If the same model was already added before, only add another instance
+    // of its product to avoid duplicating the whole geometry.
+    const QString cleanProductName = cleanString(productName);
+    const TDocStd_Document* modelKey = model.mImpl->doc.get();
+    const bool isNewProduct = !mImpl->products.contains(modelKey);
+    if (isNewProduct) {
+      TDF_Label label = assemblyShapeTool->NewShape();
+      TDataStd_Name::Set(label, cleanProductName.toStdString().c_str());
+      mImpl->products.insert(modelKey,
+                             std::make_pair(model.mImpl->doc, label));
+    }
+    TDF_Label newLabel = mImpl->products.value(modelKey).second;
 
     TDF_LabelSequence modelShapes;
-    modelShapeTool->GetFreeShapes(modelShapes);
+    if (isNewProduct) {
+      modelShapeTool->GetFreeShapes(modelShapes);
+    }
     for (int i = 1; i <= modelShapes.Length(); ++i) {
       TopoDS_Shape shape = modelShapeTool->GetShape(modelShapes.Value(i));
       if (shape.IsNull()) continue;
       TDF_Label shapeLabel = assemblyShapeTool->AddShape(shape, Standard_False);
-      const QString shapeName = QString("%1:%2").arg(cleanString(name)).arg(i);
+      const QString shapeName = QString("%1:%2").arg(cleanProductName).arg(i);
       TDataStd_Name::Set(shapeLabel, shapeName.toStdString().c_str());
       // ATTENTION: Until LibrePCB 1.1.0 we passed shape.Location() instead of
       // TopLoc_Location(), but this caused wrong placement in rare cases.
@@ -414,12 +442,9 @@ void OccModel::addToAssembly(const OccModel& model, const Point3D& pos,
     tTmp.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(1, 0, 0)),
                      std::get<0>(rot).toRad());
     t *= tTmp;
-    assemblyShapeTool->AddComponent(mImpl->assemblyLabel, newLabel,
-                                    TopLoc_Location(t));
-
-#if OCC_VERSION_HEX >= 0x070200
-    assemblyShapeTool->UpdateAssemblies();
-#endif
+    TDF_Label instanceLabel = assemblyShapeTool->AddComponent(
+        mImpl->assemblyLabel, newLabel, TopLoc_Location(t));
+    TDataStd_Name::Set(instanceLabel, cleanString(name).toStdString().c_str());
   } catch (const Standard_Failure& e) {
     qCritical() << "OpenCascade error:" << e.GetMessageString();
     throw RuntimeError(
@@ -431,6 +456,7 @@ void OccModel::addToAssembly(const OccModel& model, const Point3D& pos,
   Q_UNUSED(pos);
   Q_UNUSED(rot);
   Q_UNUSED(transform);
+  Q_UNUSED(productName);
   Q_UNUSED(name);
 #endif
 }
@@ -450,6 +476,12 @@ void OccModel::saveAsStep(const QString& name, const FilePath& fp) const {
     hdr.SetOriginatingSystem(new TCollection_HAsciiString("LibrePCB"));
     hdr.SetDescriptionValue(1, new TCollection_HAsciiString("PCB Assembly"));
 
+    // Assemblies are updated only once here rather than after adding every
+    // single component, as it gets slow with many components.
+#if OCC_VERSION_HEX >= 0x070200
+    XCAFDoc_DocumentTool::ShapeTool(mImpl->doc->Main())->UpdateAssemblies();
+#endif
+
     FileUtils::makePath(fp.getParentDir());
     if (writer.Perform(mImpl->doc, qPrintable(fp.toStr())) != Standard_True) {
       throw RuntimeError(__FILE__, __LINE__, tr("Failed to write STEP file."));
@@ -528,9 +560,7 @@ std::unique_ptr<OccModel> OccModel::createAssembly(const QString& name) {
   try {
     initOpenCascade();
 
-    Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
-    Handle(TDocStd_Document) doc;
-    app->NewDocument("MDTV-XCAF", doc);
+    Handle(TDocStd_Document) doc = newDocument();
     Handle(XCAFDoc_ShapeTool) shapeTool =
         XCAFDoc_DocumentTool::ShapeTool(doc->Main());
     TDF_Label label = shapeTool->NewShape();
@@ -562,9 +592,7 @@ std::unique_ptr<OccModel> OccModel::createBoard(const librepcb::Path& outline,
   try {
     initOpenCascade();
 
-    Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
-    Handle(TDocStd_Document) doc;
-    app->NewDocument("MDTV-XCAF", doc);
+    Handle(TDocStd_Document) doc = newDocument();
     Handle(XCAFDoc_ShapeTool) shapeTool =
         XCAFDoc_DocumentTool::ShapeTool(doc->Main());
 
@@ -638,9 +666,7 @@ std::unique_ptr<OccModel> OccModel::loadStep(const QByteArray content) {
   try {
     initOpenCascade();
 
-    Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
-    Handle(TDocStd_Document) doc;
-    app->NewDocument("MDTV-XCAF", doc);
+    Handle(TDocStd_Document) doc = newDocument();
     STEPCAFControl_Reader stepReader;
     stepReader.SetColorMode(Standard_True);
     stepReader.SetNameMode(Standard_False);
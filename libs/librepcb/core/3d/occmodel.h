@@ -47,6 +47,10 @@ class Transform;
 
 /**
  * @brief 3D model implemented with OpenCascade
+ *
+ * @note Different instances of this class can safely be used from different
+ *       threads concurrently (e.g. to load and tesselate multiple STEP models
+ *       in parallel), but a single instance must not be accessed concurrently.
  */
 class OccModel final {
   Q_DECLARE_TR_FUNCTIONS(OccModel)
@@ -63,9 +67,25 @@ public:
   ~OccModel() noexcept;
 
   // General Methods
+
+  /**
+   * @brief Add a model to this assembly
+   *
+   * If the same model object is added multiple times, its geometry is added
+   * only once and all placements reference it as instances of the same
+   * product. Thus models used several times should be loaded only once.
+   *
+   * @param model       The model to add.
+   * @param pos         3D position offset of the model.
+   * @param rot         3D rotation of the model.
+   * @param transform   Placement of the model on the board.
+   * @param productName Name of the model's product. Only used when the model
+   *                    is added for the first time.
+   * @param name        Name of the added instance.
+   */
   void addToAssembly(const OccModel& model, const Point3D& pos,
                      const Angle3D& rot, const Transform& transform,
-                     const QString& name);
+                     const QString& productName, const QString& name);
   void saveAsStep(const QString& name, const FilePath& fp) const;
   QMap<Color, QVector<QVector3D>> tesselate() const;
 
@@ -59,11 +59,12 @@ SceneData3D::~SceneData3D() noexcept {
 
 void SceneData3D::addDevice(const Uuid& uuid, const Transform& transform,
                             const QString& stepFile,
+                            const QString& stepName,
                             const Point3D& stepPosition,
                             const Angle3D& stepRotation,
                             const QString& name) noexcept {
-  mDevices.append(
-      DeviceData{uuid, transform, stepFile, stepPosition, stepRotation, name});
+  mDevices.append(DeviceData{uuid, transform, stepFile, stepName, stepPosition,
+                             stepRotation, name});
 }
 
 void SceneData3D::addPolygon(const Polygon& polygon,
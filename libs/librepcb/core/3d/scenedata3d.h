@@ -58,6 +58,7 @@ public:
     Uuid uuid;
     Transform transform;
     QString stepFile;
+    QString stepName;
     Point3D stepPosition;
     Angle3D stepRotation;
     QString name;
@@ -157,8 +158,9 @@ public:
 
   // General Methods
   void addDevice(const Uuid& uuid, const Transform& transform,
-                 const QString& stepFile, const Point3D& stepPosition,
-                 const Angle3D& stepRotation, const QString& name) noexcept;
+                 const QString& stepFile, const QString& stepName,
+                 const Point3D& stepPosition, const Angle3D& stepRotation,
+                 const QString& name) noexcept;
   void addPolygon(const Polygon& polygon, const Transform& transform) noexcept;
   void addCircle(const Circle& circle, const Transform& transform) noexcept;
   void addStroke(const Layer& layer, const QVector<Path>& paths,
@@ -27,10 +27,10 @@
 #include "../types/pcbcolor.h"
 #include "../utils/clipperhelpers.h"
 #include "../utils/scopeguard.h"
+#include "../utils/taskscheduler.h"
 #include "occmodel.h"
 #include "scenedata3d.h"
 
-#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -57,7 +57,11 @@ StepExport::~StepExport() noexcept {
 void StepExport::start(std::shared_ptr<SceneData3D> data, const FilePath& fp,
                        int finishDelayMs) noexcept {
   cancel();
-  mFuture = QtConcurrent::run(&StepExport::run, this, data, fp, finishDelayMs);
+  mFuture = TaskScheduler::instance().run(
+      TaskScheduler::Group::Export, TaskScheduler::Priority::Normal,
+      [this, data, fp, finishDelayMs]() {
+        return run(data, fp, finishDelayMs);
+      });
 }
 
 bool StepExport::isBusy() const noexcept {
@@ -138,7 +142,7 @@ QString StepExport::run(std::shared_ptr<SceneData3D> data, FilePath fp,
       const QString suffix =
           (outlines.size() > 1) ? QString::number(i + 1) : QString();
       model->addToAssembly(*pcb, Point3D(), Angle3D(), Transform(),
-                           "PCB" % suffix);
+                           "PCB" % suffix, "PCB" % suffix);
     }
     emit progressPercent(20);
 
@@ -146,21 +150,32 @@ QString StepExport::run(std::shared_ptr<SceneData3D> data, FilePath fp,
     int deviceErrors = 0;
     QString lastError;
     if (std::shared_ptr<FileSystem> fs = data->getFileSystem()) {
+      // Each STEP model is loaded only once and then shared by all devices
+      // using it, which makes them being exported as instances of the same
+      // product instead of copying the whole geometry for every device.
+      QHash<QString, std::shared_ptr<const OccModel>> devModels;
       int i = 1;
       for (const auto& obj : data->getDevices()) {
         try {
           emit progressStatus(tr("Exporting device %1/%2...")
                                   .arg(i)
                                   .arg(data->getDevices().count()));
-          const QByteArray content = fs->readIfExists(obj.stepFile);
-          if (!content.isEmpty()) {
+          auto it = devModels.find(obj.stepFile);
+          if (it == devModels.end()) {
+            std::shared_ptr<const OccModel> devModel;
+            const QByteArray content = fs->readIfExists(obj.stepFile);
+            if (!content.isEmpty()) {
+              devModel = OccModel::loadStep(content);  // can throw
+            }
+            it = devModels.insert(obj.stepFile, devModel);
+          }
+          if (const std::shared_ptr<const OccModel>& devModel = *it) {
             Point3D pos = obj.stepPosition;
             if (!obj.transform.getMirrored()) {
               std::get<2>(pos) += *data->getThickness();
             }
-            std::unique_ptr<OccModel> devModel = OccModel::loadStep(content);
             model->addToAssembly(*devModel, pos, obj.stepRotation,
-                                 obj.transform, obj.name);
+                                 obj.transform, obj.stepName, obj.name);
           }
         } catch (const Exception& e) {
           qCritical().noquote() << "Failed to export STEP model of " << obj.name
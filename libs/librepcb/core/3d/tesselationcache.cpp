@@ -0,0 +1,199 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "tesselationcache.h"
+
+#include "../application.h"
+#include "../exceptions.h"
+#include "../fileio/fileutils.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+// The vertices are written as raw float arrays, so the memory layout must
+// be exactly three floats per vertex.
+static_assert(sizeof(QVector3D) == 3 * sizeof(float));
+
+// File format version. Must be incremented whenever the file format or the
+// tesselation algorithm in OccModel changes.
+static const quint8 sFormatVersion = 1;
+static const char sMagic[] = {'L', 'P', 'T', 'C'};
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+TesselationCache::TesselationCache() noexcept
+  : TesselationCache(getDefaultDirectory()) {
+}
+
+TesselationCache::TesselationCache(const FilePath& dir) noexcept : mDir(dir) {
+}
+
+TesselationCache::~TesselationCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+TesselationCache::Triangles TesselationCache::tesselate(
+    const QByteArray& stepContent) const {
+  if (std::optional<Triangles> cached = read(stepContent)) {
+    return *cached;
+  }
+
+  std::unique_ptr<OccModel> model = OccModel::loadStep(stepContent);  // throws
+  const Triangles triangles = model->tesselate();  // can throw
+  write(stepContent, triangles);
+  return triangles;
+}
+
+std::optional<TesselationCache::Triangles> TesselationCache::read(
+    const QByteArray& stepContent) const noexcept {
+  const FilePath fp = getFilePath(stepContent);
+  if (!fp.isExistingFile()) {
+    return std::nullopt;
+  }
+  try {
+    std::optional<Triangles> triangles =
+        deserialize(FileUtils::readFile(fp));  // can throw
+    if (!triangles) {
+      qWarning() << "Ignoring invalid 3D model cache file:" << fp.toNative();
+    }
+    return triangles;
+  } catch (const Exception& e) {
+    qWarning() << "Failed to read 3D model cache file:" << e.getMsg();
+    return std::nullopt;
+  }
+}
+
+void TesselationCache::write(const QByteArray& stepContent,
+                             const Triangles& triangles) const noexcept {
+  try {
+    FileUtils::writeFile(getFilePath(stepContent),
+                         serialize(triangles));  // can throw
+  } catch (const Exception& e) {
+    qWarning() << "Failed to write 3D model cache file:" << e.getMsg();
+  }
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+FilePath TesselationCache::getDefaultDirectory() noexcept {
+  return Application::getCacheDir().getPathTo("3dmodels");
+}
+
+QByteArray TesselationCache::serialize(const Triangles& triangles) noexcept {
+  qsizetype size = sizeof(sMagic) + 16;
+  for (auto it = triangles.begin(); it != triangles.end(); it++) {
+    size += 32 + it.value().count() * sizeof(QVector3D);
+  }
+
+  QByteArray data;
+  data.reserve(size);
+  QDataStream stream(&data, QIODevice::WriteOnly);
+  stream.setVersion(QDataStream::Qt_6_2);
+  stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+  stream.writeRawData(sMagic, sizeof(sMagic));
+  stream << sFormatVersion;
+  stream << static_cast<quint8>(QSysInfo::ByteOrder);
+  stream << static_cast<quint32>(triangles.count());
+  for (auto it = triangles.begin(); it != triangles.end(); it++) {
+    stream << std::get<0>(it.key()) << std::get<1>(it.key())
+           << std::get<2>(it.key());
+    stream << static_cast<quint32>(it.value().count());
+    stream.writeRawData(reinterpret_cast<const char*>(it.value().constData()),
+                        it.value().count() * sizeof(QVector3D));
+  }
+  return data;
+}
+
+std::optional<TesselationCache::Triangles> TesselationCache::deserialize(
+    const QByteArray& data) noexcept {
+  QDataStream stream(data);
+  stream.setVersion(QDataStream::Qt_6_2);
+  stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+  char magic[sizeof(sMagic)];
+  quint8 version = 0;
+  quint8 byteOrder = 0;
+  quint32 colorCount = 0;
+  if ((stream.readRawData(magic, sizeof(magic)) != sizeof(magic)) ||
+      (memcmp(magic, sMagic, sizeof(magic)) != 0)) {
+    return std::nullopt;
+  }
+  stream >> version >> byteOrder >> colorCount;
+  if ((stream.status() != QDataStream::Ok) || (version != sFormatVersion) ||
+      (byteOrder != static_cast<quint8>(QSysInfo::ByteOrder))) {
+    return std::nullopt;
+  }
+
+  Triangles triangles;
+  for (quint32 i = 0; i < colorCount; ++i) {
+    qreal r, g, b;
+    quint32 vertexCount = 0;
+    stream >> r >> g >> b >> vertexCount;
+    const qint64 bytes = qint64(vertexCount) * sizeof(QVector3D);
+    if ((stream.status() != QDataStream::Ok) ||
+        (bytes > (data.size() - stream.device()->pos()))) {
+      return std::nullopt;
+    }
+    QVector<QVector3D> vertices(vertexCount);
+    if (stream.readRawData(reinterpret_cast<char*>(vertices.data()), bytes) !=
+        bytes) {
+      return std::nullopt;
+    }
+    triangles.insert(std::make_tuple(r, g, b), vertices);
+  }
+  if (!stream.atEnd()) {
+    return std::nullopt;
+  }
+  return triangles;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+FilePath TesselationCache::getFilePath(
+    const QByteArray& stepContent) const noexcept {
+  // Include the OpenCascade version in the hash since a different version
+  // might lead to a different tesselation result.
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  hash.addData(OccModel::getOccVersionString().toUtf8());
+  hash.addData(QByteArray(1, static_cast<char>(sFormatVersion)));
+  hash.addData(stepContent);
+  return mDir.getPathTo(QString::fromLatin1(hash.result().toHex()) + ".bin");
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
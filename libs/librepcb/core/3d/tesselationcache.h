@@ -0,0 +1,170 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_TESSELATIONCACHE_H
+#define LIBREPCB_CORE_TESSELATIONCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../fileio/filepath.h"
+#include "occmodel.h"
+
+#include <QtCore>
+#include <QtGui>
+
+#include <optional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class TesselationCache
+ ******************************************************************************/
+
+/**
+ * @brief Persistent on-disk cache for tesselated STEP models
+ *
+ * Loading and tesselating a STEP model with OpenCascade is very expensive,
+ * thus the result of ::librepcb::OccModel::tesselate() is stored in a compact
+ * binary file within the cache directory. The file name is derived from a
+ * hash of the STEP file content, so any change of the model automatically
+ * leads to a cache miss. As the cache files are written atomically, a cache
+ * directory can safely be shared between multiple threads and processes
+ * (e.g. the GUI application and the CLI).
+ *
+ * Cache files are considered as disposable, i.e. any missing, outdated or
+ * corrupt file is just ignored and overwritten by a fresh tesselation.
+ *
+ * @note All methods of this class are thread-safe.
+ */
+class TesselationCache final {
+  Q_DECLARE_TR_FUNCTIONS(TesselationCache)
+
+public:
+  // Types
+  typedef QMap<OccModel::Color, QVector<QVector3D>> Triangles;
+
+  // Constructors / Destructor
+
+  /**
+   * @brief Constructor using the default cache directory
+   *
+   * @see #getDefaultDirectory()
+   */
+  TesselationCache() noexcept;
+
+  /**
+   * @brief Constructor
+   *
+   * @param dir   Directory where the cache files are stored. It does not need
+   *              to exist yet, it will be created as needed.
+   */
+  explicit TesselationCache(const FilePath& dir) noexcept;
+
+  TesselationCache(const TesselationCache& other) = default;
+  ~TesselationCache() noexcept;
+
+  // Getters
+  const FilePath& getDirectory() const noexcept { return mDir; }
+
+  // General Methods
+
+  /**
+   * @brief Get the tesselated triangles of a STEP model
+   *
+   * Returns the cached result if available, otherwise the STEP model is
+   * loaded, tesselated and the result is added to the cache.
+   *
+   * @param stepContent   Content of the STEP file.
+   *
+   * @return Triangles grouped by color.
+   *
+   * @throw Exception if the STEP model could not be loaded or tesselated.
+   */
+  Triangles tesselate(const QByteArray& stepContent) const;
+
+  /**
+   * @brief Read the tesselated triangles of a STEP model from the cache
+   *
+   * @param stepContent   Content of the STEP file.
+   *
+   * @return Cached triangles, or `std::nullopt` on cache miss.
+   */
+  std::optional<Triangles> read(const QByteArray& stepContent) const noexcept;
+
+  /**
+   * @brief Add the tesselated triangles of a STEP model to the cache
+   *
+   * @param stepContent   Content of the STEP file.
+   * @param triangles     The tesselation result to store.
+   *
+   * @note Errors are only logged but not reported since a failed cache write
+   *       is not critical.
+   */
+  void write(const QByteArray& stepContent,
+             const Triangles& triangles) const noexcept;
+
+  // Static Methods
+
+  /**
+   * @brief Get the default cache directory
+   *
+   * @return Subdirectory of ::librepcb::Application::getCacheDir()
+   */
+  static FilePath getDefaultDirectory() noexcept;
+
+  /**
+   * @brief Serialize triangles into the binary cache file format
+   *
+   * @param triangles   Triangles to serialize.
+   *
+   * @return Serialized data.
+   */
+  static QByteArray serialize(const Triangles& triangles) noexcept;
+
+  /**
+   * @brief Deserialize triangles from the binary cache file format
+   *
+   * @param data  Serialized data, as returned by #serialize().
+   *
+   * @return Deserialized triangles, or `std::nullopt` if the data is invalid
+   *         or was written by an incompatible version.
+   */
+  static std::optional<Triangles> deserialize(const QByteArray& data) noexcept;
+
+  // Operator Overloadings
+  TesselationCache& operator=(const TesselationCache& rhs) = default;
+
+private:  // Methods
+  FilePath getFilePath(const QByteArray& stepContent) const noexcept;
+
+private:  // Data
+  FilePath mDir;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -27,11 +27,19 @@
 
 #include <QtCore>
 
+#include <cmath>
+#include <limits>
+#include <map>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+// Maximum distance of a point from a non-orthogonal line to be considered
+// as located on that line.
+static const Length sMaxStraightLineTolerance(50);
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -149,119 +157,206 @@ QSet<int> NetSegmentSimplifier::getConnectedPinsOrPads() const noexcept {
 }
 
 void NetSegmentSimplifier::addJunctionsAtLineIntersections() noexcept {
-  auto intersectsHorizontalVertical = [](const Point& a1, const Point& a2,
-                                         const Point& b1, const Point& b2) {
-    // Line 'a' must be horizontal and line 'b' vertical.
-    const Length ay = a1.getY();
-    const Length ax0 = std::min(a1.getX(), a2.getX());
-    const Length ax1 = std::max(a1.getX(), a2.getX());
-    const Length bx = b1.getX();
-    const Length by0 = std::min(b1.getY(), b2.getY());
-    const Length by1 = std::max(b1.getY(), b2.getY());
-    return (ax0 < bx) && (bx < ax1) && (by0 < ay) && (ay < by1);
-  };
-
   // For now we only detect orthogonal intersections, not arbitrary-angle
   // intersections. Maybe it's better anyway to split only those lines?
-  auto getIntersectionPos = [&](const Point& a1, const Point& a2,
-                                const Point& b1, const Point& b2) {
-    if ((a1.getY() == a2.getY()) && (b1.getX() == b2.getX()) &&
-        intersectsHorizontalVertical(a1, a2, b1, b2)) {
-      // Line 'a' is horizontal, line 'b' is vertical.
-      return std::make_optional(Point(b1.getX(), a1.getY()));
-    } else if ((a1.getX() == a2.getX()) && (b1.getY() == b2.getY()) &&
-               intersectsHorizontalVertical(b1, b2, a1, a2)) {
-      // Line 'a' is vertical, line 'b' is horizontal.
-      return std::make_optional(Point(a1.getX(), b1.getY()));
-    } else {
-      return std::optional<Point>();
-    }
+  //
+  // To avoid comparing every pair of lines, a sweep line is moved in X
+  // direction over the horizontal and vertical lines of each layer.
+  // Horizontal lines are active while the sweep line is strictly between
+  // their end points, and each vertical line intersects with all active
+  // lines strictly between its end points.
+  enum class EventType : int {
+    // Value is important for the sort algorithm, do not change!
+    HorizontalEnd = 0,
+    Vertical = 1,
+    HorizontalStart = 2,
+  };
+  struct Event {
+    Length x;
+    EventType type;
+    int index;  // Index in 'lines'.
   };
-
   const QList<Line> lines = mLines.values();
+  QHash<const Layer*, QVector<Event>> events;
   for (int i = 0; i < lines.count(); ++i) {
-    const Line& line0 = lines.at(i);
-    const Point a1 = mAnchors.at(line0.p1).pos;
-    const Point a2 = mAnchors.at(line0.p2).pos;
-    for (int k = i + 1; k < lines.count(); ++k) {
-      const Line& line1 = lines.at(k);
-      if (line0.layer != line1.layer) {
-        continue;
-      }
-      const Point b1 = mAnchors.at(line1.p1).pos;
-      const Point b2 = mAnchors.at(line1.p2).pos;
-      if (const std::optional<Point> pos = getIntersectionPos(a1, a2, b1, b2)) {
-        if (!findAnchor(*pos, line0.layer)) {
-          const Anchor anchor{
-              static_cast<int>(mAnchors.count()),  // ID
-              AnchorType::Junction,  // Type
-              *pos,  // Position
-              line0.layer,  // Start layer
-              line0.layer,  // End layer
-              true,  // Is new
-          };
-          mAnchors.append(anchor);
-          mAnchorMap[*pos].append(anchor);
+    const Line& line = lines.at(i);
+    const Point p1 = mAnchors.at(line.p1).pos;
+    const Point p2 = mAnchors.at(line.p2).pos;
+    if (p1 == p2) {
+      continue;  // Zero-length lines can't intersect.
+    } else if (p1.getY() == p2.getY()) {
+      QVector<Event>& layerEvents = events[line.layer];
+      layerEvents.append(Event{std::min(p1.getX(), p2.getX()),
+                               EventType::HorizontalStart, i});
+      layerEvents.append(Event{std::max(p1.getX(), p2.getX()),
+                               EventType::HorizontalEnd, i});
+    } else if (p1.getX() == p2.getX()) {
+      events[line.layer].append(Event{p1.getX(), EventType::Vertical, i});
+    }
+  }
+
+  // Collect all intersections as [index0, index1, position].
+  QVector<std::tuple<int, int, Point>> intersections;
+  for (auto it = events.begin(); it != events.end(); it++) {
+    std::sort(it->begin(), it->end(), [](const Event& a, const Event& b) {
+      if (a.x != b.x) return a.x < b.x;
+      return static_cast<int>(a.type) < static_cast<int>(b.type);
+    });
+    std::multimap<Length, int> active;  // Key: Y, Value: Index in 'lines'.
+    QHash<int, std::multimap<Length, int>::iterator> activeIterators;
+    for (const Event& event : *it) {
+      const Line& line = lines.at(event.index);
+      const Point p1 = mAnchors.at(line.p1).pos;
+      const Point p2 = mAnchors.at(line.p2).pos;
+      if (event.type == EventType::HorizontalStart) {
+        activeIterators.insert(event.index,
+                               active.emplace(p1.getY(), event.index));
+      } else if (event.type == EventType::HorizontalEnd) {
+        active.erase(activeIterators.take(event.index));
+      } else {
+        const Length y0 = std::min(p1.getY(), p2.getY());
+        const Length y1 = std::max(p1.getY(), p2.getY());
+        for (auto activeIt = active.upper_bound(y0);
+             (activeIt != active.end()) && (activeIt->first < y1);
+             activeIt++) {
+          intersections.append(
+              std::make_tuple(std::min(activeIt->second, event.index),
+                              std::max(activeIt->second, event.index),
+                              Point(p1.getX(), activeIt->first)));
         }
       }
     }
   }
+
+  // Add the junctions in the order of the line indices to get the same
+  // anchor IDs as when comparing each line with each other line.
+  std::sort(intersections.begin(), intersections.end(),
+            [](const std::tuple<int, int, Point>& a,
+               const std::tuple<int, int, Point>& b) {
+              return std::make_pair(std::get<0>(a), std::get<1>(a)) <
+                  std::make_pair(std::get<0>(b), std::get<1>(b));
+            });
+  for (const auto& intersection : intersections) {
+    const Line& line0 = lines.at(std::get<0>(intersection));
+    const Point pos = std::get<2>(intersection);
+    if (!findAnchor(pos, line0.layer)) {
+      const Anchor anchor{
+          static_cast<int>(mAnchors.count()),  // ID
+          AnchorType::Junction,  // Type
+          pos,  // Position
+          line0.layer,  // Start layer
+          line0.layer,  // End layer
+          true,  // Is new
+      };
+      mAnchors.append(anchor);
+      mAnchorMap[pos].append(anchor);
+    }
+  }
 }
 
 void NetSegmentSimplifier::splitLinesAtAnchors() noexcept {
+  // Build a grid index of all anchors to avoid comparing each line with all
+  // anchors. Anchors located on a line can only be within the bounding rect
+  // of the line, expanded by the maximum tolerance of isStraightLine(). The
+  // cell size is chosen to get roughly one anchor per cell.
+  qint64 minX = std::numeric_limits<qint64>::max();
+  qint64 minY = std::numeric_limits<qint64>::max();
+  qint64 maxX = std::numeric_limits<qint64>::min();
+  qint64 maxY = std::numeric_limits<qint64>::min();
+  for (const Anchor& anchor : mAnchors) {
+    const qint64 x = anchor.pos.getX().toNm();
+    const qint64 y = anchor.pos.getY().toNm();
+    minX = std::min(minX, x);
+    minY = std::min(minY, y);
+    maxX = std::max(maxX, x);
+    maxY = std::max(maxY, y);
+  }
+  const qint64 extent =
+      mAnchors.isEmpty() ? 0 : std::max(maxX - minX, maxY - minY);
+  const qint64 cellsPerRow =
+      std::max(static_cast<qint64>(std::sqrt(mAnchors.count())), qint64(1));
+  const qint64 cellSize = std::max(extent / cellsPerRow, qint64(1));
+  auto toCell = [cellSize](const Length& value) {
+    const qint64 nm = value.toNm();
+    return (nm >= 0) ? (nm / cellSize) : ((nm - cellSize + 1) / cellSize);
+  };
+  QHash<std::pair<qint64, qint64>, QVector<int>> grid;
+  for (const Anchor& anchor : mAnchors) {
+    grid[std::make_pair(toCell(anchor.pos.getX()), toCell(anchor.pos.getY()))]
+        .append(anchor.id);
+  }
+
   auto findIntersectingAnchor = [&](const Line& line) {
     const Point p1 = mAnchors.at(line.p1).pos;
     const Point p2 = mAnchors.at(line.p2).pos;
+    const Anchor* result = nullptr;
     if (p1 != p2) {
-      for (const Anchor& anchor : mAnchors) {
-        if ((anchor.pos != p1) && (anchor.pos != p2) &&
-            isAnchorOnLayer(anchor, line.layer) &&
+      // Find the anchor with the lowest ID.
+      auto check = [&](const Anchor& anchor) {
+        if (((!result) || (anchor.id < result->id)) && (anchor.pos != p1) &&
+            (anchor.pos != p2) && isAnchorOnLayer(anchor, line.layer) &&
             isStraightLine(p1, anchor.pos, p2)) {
-          return &anchor;
+          result = &anchor;
+        }
+      };
+      const qint64 x0 = toCell(std::min(p1.getX(), p2.getX()) -
+                               sMaxStraightLineTolerance);
+      const qint64 x1 = toCell(std::max(p1.getX(), p2.getX()) +
+                               sMaxStraightLineTolerance);
+      const qint64 y0 = toCell(std::min(p1.getY(), p2.getY()) -
+                               sMaxStraightLineTolerance);
+      const qint64 y1 = toCell(std::max(p1.getY(), p2.getY()) +
+                               sMaxStraightLineTolerance);
+      if ((x1 - x0 + 1) * (y1 - y0 + 1) > mAnchors.count()) {
+        // Long diagonal line, cheaper to check all anchors.
+        for (const Anchor& anchor : mAnchors) {
+          check(anchor);
         }
-      }
-    }
-    return static_cast<const Anchor*>(nullptr);
-  };
-
-  QMap<int, Line> lines = mLines;
-  QSet<int> finishedLineIds;
-  auto splitNextLine = [&]() {
-    for (Line& line : lines) {
-      if (finishedLineIds.contains(line.id)) continue;  // Already processed.
-      if (const Anchor* anchor = findIntersectingAnchor(line)) {
-        // Add new line.
-        lines.insert(mNextFreeLineId,
-                     Line{mNextFreeLineId, anchor->id, line.p2, line.layer,
-                          line.width, true});
-        ++mNextFreeLineId;
-        // Split existing line.
-        line.p2 = anchor->id;
-        line.modified = true;
-        return true;
       } else {
-        finishedLineIds.insert(line.id);
+        for (qint64 x = x0; x <= x1; ++x) {
+          for (qint64 y = y0; y <= y1; ++y) {
+            for (int id : grid.value(std::make_pair(x, y))) {
+              check(mAnchors.at(id));
+            }
+          }
+        }
       }
     }
-    return false;
+    return result;
   };
 
   // We have to do this iterative because the same line may need to be split
   // multiple times. This causes some risk that to end up in an endless loop.
   // To recover from such a situation, we set a maximum number of new lines
   // allowed to be created and apply the result only if we didn't reach that
-  // limit.
+  // limit. Lines are processed in the order of their IDs, new lines are
+  // appended to the end.
+  QMap<int, Line> lines = mLines;
+  QVector<int> lineIds = lines.keys();
   const int maxLinesCount = (mLines.count() * 2) + 10;
   bool modified = false;
-  while (splitNextLine()) {
-    modified = true;
-
-    // Check abort condition to prevent endless loop.
-    if (lines.count() >= maxLinesCount) {
-      qWarning() << "Aborted net segment simplification of initially"
-                 << mLines.count() << "lines after" << lines.count()
-                 << "lines.";
-      return;  // Discard all changes.
+  for (int i = 0; i < lineIds.count(); ++i) {
+    const int id = lineIds.at(i);
+    while (const Anchor* anchor = findIntersectingAnchor(lines[id])) {
+      Line& line = lines[id];
+      // Add new line.
+      const Line newLine{mNextFreeLineId, anchor->id, line.p2,
+                         line.layer,      line.width, true};
+      // Split existing line.
+      line.p2 = anchor->id;
+      line.modified = true;
+      lines.insert(newLine.id, newLine);
+      lineIds.append(newLine.id);
+      ++mNextFreeLineId;
+      modified = true;
+
+      // Check abort condition to prevent endless loop.
+      if (lines.count() >= maxLinesCount) {
+        qWarning() << "Aborted net segment simplification of initially"
+                   << mLines.count() << "lines after" << lines.count()
+                   << "lines.";
+        return;  // Discard all changes.
+      }
     }
   }
 
@@ -300,18 +395,23 @@ void NetSegmentSimplifier::removeDuplicateJunctions() noexcept {
 }
 
 void NetSegmentSimplifier::removeRedundantLines() noexcept {
-  auto isDuplicateLine = [&](const Line& line) {
-    for (const Line& other : mLines) {
-      if ((other.id != line.id) && (other.layer == line.layer) &&
-          (other.width >= line.width) &&
-          (QSet<int>{other.p1, other.p2} == QSet<int>{line.p1, line.p2})) {
-        return true;
-      }
+  // Of all lines with the same anchors on the same layer, keep only the last
+  // one of the thickest lines.
+  QHash<std::pair<const Layer*, std::pair<int, int>>, int> keptLines;
+  for (const Line& line : mLines) {
+    const auto key = std::make_pair(
+        line.layer,
+        std::make_pair(std::min(line.p1, line.p2), std::max(line.p1, line.p2)));
+    auto it = keptLines.find(key);
+    if (it == keptLines.end()) {
+      keptLines.insert(key, line.id);
+    } else if (line.width >= mLines.value(*it).width) {
+      *it = line.id;
     }
-    return false;
-  };
+  }
+  const QSet<int> keptLineIds = Toolbox::toSet(keptLines.values());
   for (int id : mLines.keys()) {
-    if (isDuplicateLine(mLines.value(id))) {
+    if (!keptLineIds.contains(id)) {
       mLines.remove(id);
       mModified = true;
     }
@@ -420,7 +520,7 @@ bool NetSegmentSimplifier::isStraightLine(const Point& p0, const Point& p1,
   } else {
     // Not sure what tolerance we should allow for non-90° lines...
     const UnsignedLength length = (p2 - p0).getLength();
-    const Length tolerance = std::min(length / 100, Length(50));
+    const Length tolerance = std::min(length / 100, sMaxStraightLineTolerance);
     return Toolbox::shortestDistanceBetweenPointAndLine(p1, p0, p2) < tolerance;
   }
 }
@@ -303,12 +303,14 @@ QString GerberApertureList::buildOutlineMacro(Path path,
 
 int GerberApertureList::addAperture(QString aperture,
                                     Function function) noexcept {
-  auto value = std::make_pair(function, aperture);
-  int number = mApertures.key(value, -1);
+  const auto key =
+      std::make_pair(function ? static_cast<int>(*function) : -1, aperture);
+  int number = mApertureNumbers.value(key, -1);
   if (number < 0) {
     number = mApertures.count() + 10;  // 10 is the number of the first aperture
     Q_ASSERT(!mApertures.contains(number));
-    mApertures.insert(number, value);
+    mApertures.insert(number, std::make_pair(function, aperture));
+    mApertureNumbers.insert(key, number);
   }
   return number;
 }
@@ -225,6 +225,12 @@ private:  // Data
   ///           instead of the aperture number. Needs to be substituted by the
   ///           aperture number when serializing.
   QMap<int, std::pair<Function, QString>> mApertures;
+
+  /// Reverse lookup of #mApertures to find existing apertures in O(1)
+  ///
+  /// - key:    Aperture function (-1 if none) and definition.
+  /// - value:  Aperture number.
+  QHash<std::pair<int, QString>, int> mApertureNumbers;
 };
 
 /*******************************************************************************
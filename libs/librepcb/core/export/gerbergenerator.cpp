@@ -33,6 +33,8 @@
 
 #include <QtCore>
 
+#include <charconv>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -400,6 +402,7 @@ void GerberGenerator::flashComponentPin(
 
 void GerberGenerator::generate() {
   mOutput.clear();
+  mOutput.reserve(mContent.size() + 4096);  // Content plus header & apertures
   printHeader();
   printApertureList();
   printContent();
@@ -410,7 +413,7 @@ void GerberGenerator::saveToFile(const FilePath& filepath) const {
   // Note: Although we save it as UTF-8, usually it will still contain only
   // ASCII characters for maximum compatibility with legacy crappy readers.
   // Unicode is only required when exporting Gerber X3 assembly attributes.
-  FileUtils::writeFile(filepath, mOutput.toUtf8());  // can throw
+  FileUtils::writeFile(filepath, mOutput);  // can throw
 }
 
 /*******************************************************************************
@@ -458,12 +461,14 @@ void GerberGenerator::setCurrentAttributes(
   if (componentRotation) {
     attributes.append(GerberAttribute::componentRotation(*componentRotation));
   }
-  mContent.append(mAttributeWriter->setAttributes(attributes));
+  mContent.append(mAttributeWriter->setAttributes(attributes).toUtf8());
 }
 
 void GerberGenerator::setCurrentAperture(int number) noexcept {
   if (number != mCurrentApertureNumber) {
-    mContent.append(QString("D%1*\n").arg(number));
+    mContent.append('D');
+    appendNumber(mContent, number);
+    mContent.append("*\n");
     mCurrentApertureNumber = number;
   }
 }
@@ -489,22 +494,25 @@ void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept {
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D02*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendCoordinates(pos);
+  mContent.append("D02*\n");
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D01*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendCoordinates(pos);
+  mContent.append("D01*\n");
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start,
                                                     const Point& center,
                                                     const Point& end) noexcept {
   Point diff = center - start;
-  mContent.append(QString("X%1Y%2I%3J%4D01*\n")
-                      .arg(end.getX().toNmString(), end.getY().toNmString(),
-                           diff.getX().toNmString(), diff.getY().toNmString()));
+  appendCoordinates(end);
+  mContent.append('I');
+  appendNumber(mContent, diff.getX().toNm());
+  mContent.append('J');
+  appendNumber(mContent, diff.getY().toNm());
+  mContent.append("D01*\n");
 }
 
 void GerberGenerator::interpolateBetween(const Vertex& from,
@@ -526,8 +534,26 @@ void GerberGenerator::interpolateBetween(const Vertex& from,
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D03*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendCoordinates(pos);
+  mContent.append("D03*\n");
+}
+
+void GerberGenerator::appendCoordinates(const Point& pos) noexcept {
+  mContent.append('X');
+  appendNumber(mContent, pos.getX().toNm());
+  mContent.append('Y');
+  appendNumber(mContent, pos.getY().toNm());
+}
+
+void GerberGenerator::appendNumber(QByteArray& out,
+                                   LengthBase_t value) noexcept {
+  // Format the integer directly into a stack buffer to avoid any temporary
+  // string allocations.
+  char buffer[24];
+  const std::to_chars_result result =
+      std::to_chars(buffer, buffer + sizeof(buffer), value);
+  Q_ASSERT(result.ec == std::errc());
+  out.append(buffer, result.ptr - buffer);
 }
 
 void GerberGenerator::printHeader() noexcept {
@@ -535,7 +561,7 @@ void GerberGenerator::printHeader() noexcept {
 
   // Add file attributes.
   foreach (const GerberAttribute& a, mFileAttributes) {
-    mOutput.append(a.toGerberString());
+    mOutput.append(a.toGerberString().toUtf8());
   }
 
   // coordinate format specification:
@@ -561,7 +587,7 @@ void GerberGenerator::printHeader() noexcept {
 
 void GerberGenerator::printApertureList() noexcept {
   mOutput.append("G04 --- APERTURE LIST BEGIN --- *\n");
-  mOutput.append(mApertureList->generateString());
+  mOutput.append(mApertureList->generateString().toUtf8());
   mOutput.append("G04 --- APERTURE LIST END --- *\n");
 }
 
@@ -573,8 +599,9 @@ void GerberGenerator::printContent() noexcept {
 
 void GerberGenerator::printFooter() noexcept {
   // MD5 checksum over content
-  mOutput.append(
-      GerberAttribute::fileMd5(calcOutputMd5Checksum()).toGerberString());
+  mOutput.append(GerberAttribute::fileMd5(calcOutputMd5Checksum())
+                     .toGerberString()
+                     .toUtf8());
 
   // end of file
   mOutput.append("M02*\n");
@@ -582,10 +609,18 @@ void GerberGenerator::printFooter() noexcept {
 
 QString GerberGenerator::calcOutputMd5Checksum() const noexcept {
   // according to the RS-274C standard, linebreaks are not included in the
-  // checksum
-  QString data = QString(mOutput).remove(QChar('\n'));
-  return QString(
-      QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+  // checksum, so feed the output line by line instead of copying it
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  qsizetype start = 0;
+  while (start < mOutput.size()) {
+    qsizetype end = mOutput.indexOf('\n', start);
+    if (end < 0) {
+      end = mOutput.size();
+    }
+    hash.addData(QByteArrayView(mOutput.constData() + start, end - start));
+    start = end + 1;
+  }
+  return QString(hash.result().toHex());
 }
 
 /*******************************************************************************
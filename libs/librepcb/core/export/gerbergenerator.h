@@ -67,7 +67,8 @@ public:
   ~GerberGenerator() noexcept;
 
   // Getters
-  const QString& toStr() const noexcept { return mOutput; }
+  const QByteArray& toByteArray() const noexcept { return mOutput; }
+  QString toStr() const noexcept { return QString::fromUtf8(mOutput); }
 
   // Plot Methods
   void setFileFunctionOutlines(bool plated) noexcept;
@@ -158,6 +159,8 @@ private:
                                      const Point& end) noexcept;
   void interpolateBetween(const Vertex& from, const Vertex& to) noexcept;
   void flashAtPosition(const Point& pos) noexcept;
+  void appendCoordinates(const Point& pos) noexcept;
+  static void appendNumber(QByteArray& out, LengthBase_t value) noexcept;
   void printHeader() noexcept;
   void printApertureList() noexcept;
   void printContent() noexcept;
@@ -168,8 +171,12 @@ private:
   QVector<GerberAttribute> mFileAttributes;
 
   // Gerber Data
-  QString mOutput;
-  QString mContent;
+  //
+  // Note: The content is stored as UTF-8 encoded bytes with numbers being
+  // formatted directly into the buffer, since converting millions of
+  // coordinates to temporary strings was a bottleneck for large boards.
+  QByteArray mOutput;
+  QByteArray mContent;
   QScopedPointer<GerberAttributeWriter> mAttributeWriter;
   QScopedPointer<GerberApertureList> mApertureList;
   int mCurrentApertureNumber;
@@ -24,10 +24,11 @@
 
 #include "../application.h"
 #include "../fileio/fileutils.h"
+#include "../utils/taskscheduler.h"
+#include "../utils/tracer.h"
 #include "graphicsexportsettings.h"
 #include "utils/qtmetatyperegistration.h"
 
-#include <QtConcurrent>
 #include <QtCore>
 #include <QtGui>
 #include <QtPrintSupport>
@@ -72,7 +73,9 @@ void GraphicsExport::startPreview(const Pages& pages) noexcept {
   RunArgs args{
       true, pages, FilePath(), QString(), QPrinter::DuplexNone, 1,
   };
-  mFuture = QtConcurrent::run(&GraphicsExport::run, this, args);
+  mFuture = TaskScheduler::instance().run(
+      TaskScheduler::Group::Export, TaskScheduler::Priority::Interactive,
+      [this, args]() { return run(args); });
 }
 
 void GraphicsExport::startExport(const Pages& pages,
@@ -81,7 +84,9 @@ void GraphicsExport::startExport(const Pages& pages,
   RunArgs args{
       false, pages, filePath, QString(), QPrinter::DuplexNone, 1,
   };
-  mFuture = QtConcurrent::run(&GraphicsExport::run, this, args);
+  mFuture = TaskScheduler::instance().run(
+      TaskScheduler::Group::Export, TaskScheduler::Priority::Normal,
+      [this, args]() { return run(args); });
 }
 
 void GraphicsExport::startPrint(const Pages& pages, const QString& printerName,
@@ -91,7 +96,9 @@ void GraphicsExport::startPrint(const Pages& pages, const QString& printerName,
   RunArgs args{
       false, pages, FilePath(), printerName, duplex, copies,
   };
-  mFuture = QtConcurrent::run(&GraphicsExport::run, this, args);
+  mFuture = TaskScheduler::instance().run(
+      TaskScheduler::Group::Export, TaskScheduler::Priority::Normal,
+      [this, args]() { return run(args); });
 }
 
 GraphicsExport::Result GraphicsExport::waitForFinished() noexcept {
@@ -129,6 +136,7 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
   // Note: This method is called from a different thread, thus be careful with
   //       calling other methods to only call thread-safe methods!
 
+  LIBREPCB_TRACE_ZONE("GraphicsExport::run");
   QElapsedTimer timer;
   timer.start();
   qDebug() << "Start graphics export in worker thread...";
@@ -188,6 +196,7 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
     // Export all pages.
     QPainter painter;
     for (int index = 0; index < args.pages.count(); ++index) {
+      LIBREPCB_TRACE_ZONE("GraphicsExport::page");
       const qreal percentPerPage = qreal(80) / args.pages.count();
       emit progress(20 + std::ceil(percentPerPage * index), index + 1,
                     args.pages.count());
@@ -57,14 +57,44 @@ OutputDirectoryWriter::~OutputDirectoryWriter() noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QMultiHash<Uuid, FilePath> OutputDirectoryWriter::getWrittenFiles()
+    const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mWrittenFiles;
+}
+
+QString OutputDirectoryWriter::getFingerprint(const Uuid& job) const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mFingerprints.value(job);
+}
+
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void OutputDirectoryWriter::setFingerprint(
+    const Uuid& job, const QString& fingerprint) noexcept {
+  QMutexLocker lock(&mMutex);
+  if (mFingerprints.value(job) != fingerprint) {
+    mFingerprints.insert(job, fingerprint);
+    mIndexModified = true;
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
 bool OutputDirectoryWriter::loadIndex() {
+  QMutexLocker lock(&mMutex);
   bool success = false;
   try {
     mIndex.clear();
+    mFingerprints.clear();
     if (mIndexFilePath.isExistingFile()) {
       const QString content = FileUtils::readFile(mIndexFilePath);  // can throw
       const QStringList lines = content.split("\n", Qt::SkipEmptyParts);
@@ -74,6 +104,15 @@ bool OutputDirectoryWriter::loadIndex() {
           const QString file = values.first();
           const Uuid uuid = Uuid::fromString(values.value(1));
           mIndex.insert(mDirPath.getPathTo(file), uuid);
+          // All files of a job shall have the same fingerprint, otherwise
+          // consider it as invalid.
+          const QString fingerprint = values.value(2);
+          auto it = mFingerprints.find(uuid);
+          if (it == mFingerprints.end()) {
+            mFingerprints.insert(uuid, fingerprint);
+          } else if (*it != fingerprint) {
+            *it = QString();
+          }
         }
       }
     }
@@ -87,12 +126,18 @@ bool OutputDirectoryWriter::loadIndex() {
 }
 
 void OutputDirectoryWriter::storeIndex() {
+  QMutexLocker lock(&mMutex);
   QStringList lines;
   for (auto it = mIndex.begin(); it != mIndex.end(); ++it) {
     if (it.key().isExistingFile()) {
-      lines.append(QString("%1 | %2")
-                       .arg(it.key().toRelative(mDirPath))
-                       .arg(it.value().toStr()));
+      QString line = QString("%1 | %2")
+                         .arg(it.key().toRelative(mDirPath))
+                         .arg(it.value().toStr());
+      const QString fingerprint = mFingerprints.value(it.value());
+      if (!fingerprint.isEmpty()) {
+        line += " | " % fingerprint;
+      }
+      lines.append(line);
     }
   }
   std::sort(lines.begin(), lines.end());
@@ -106,6 +151,7 @@ FilePath OutputDirectoryWriter::beginWritingFile(const Uuid& job,
   const FilePath fp = mDirPath.getPathTo(relPath);
   emit aboutToWriteFile(fp);
 
+  QMutexLocker lock(&mMutex);
   if (!mIndexLoaded) {
     throw LogicError(__FILE__, __LINE__, "Output directory index not loaded.");
   }
@@ -169,21 +215,53 @@ FilePath OutputDirectoryWriter::beginWritingFile(const Uuid& job,
 }
 
 void OutputDirectoryWriter::removeObsoleteFiles(const Uuid& job) {
-  const auto tmpIndex = mIndex;  // Avoid removing while iterating.
-  for (auto it = tmpIndex.begin(); it != tmpIndex.end(); ++it) {
-    if ((it.value() == job) &&
-        (!mWrittenFiles.values(job).contains(it.key()))) {
-      emit aboutToRemoveFile(it.key());
-      if (it.key().isExistingFile()) {
-        FileUtils::removeFile(it.key());  // can throw
+  // Determine obsolete files first to not emit signals while locked.
+  QList<FilePath> obsoleteFiles;
+  {
+    QMutexLocker lock(&mMutex);
+    for (auto it = mIndex.begin(); it != mIndex.end(); ++it) {
+      if ((it.value() == job) &&
+          (!mWrittenFiles.values(job).contains(it.key()))) {
+        obsoleteFiles.append(it.key());
       }
-      mIndex.remove(it.key());
     }
   }
+  foreach (const FilePath& fp, obsoleteFiles) {
+    emit aboutToRemoveFile(fp);
+    if (fp.isExistingFile()) {
+      FileUtils::removeFile(fp);  // can throw
+    }
+    QMutexLocker lock(&mMutex);
+    mIndex.remove(fp);
+  }
+}
+
+bool OutputDirectoryWriter::reuseFiles(const Uuid& job,
+                                       const QString& fingerprint) noexcept {
+  QMutexLocker lock(&mMutex);
+  if ((!mIndexLoaded) || fingerprint.isEmpty() ||
+      (mFingerprints.value(job) != fingerprint)) {
+    return false;
+  }
+  const QList<FilePath> files = mIndex.keys(job);
+  if (files.isEmpty()) {
+    return false;
+  }
+  const QList<FilePath> writtenFiles = mWrittenFiles.values();
+  foreach (const FilePath& fp, files) {
+    if ((!fp.isExistingFile()) || writtenFiles.contains(fp)) {
+      return false;
+    }
+  }
+  foreach (const FilePath& fp, files) {
+    mWrittenFiles.insert(job, fp);
+  }
+  return true;
 }
 
 QList<FilePath> OutputDirectoryWriter::findUnknownFiles(
     const QSet<Uuid>& knownJobs) const {
+  QMutexLocker lock(&mMutex);
   if (!mIndexLoaded) {
     throw LogicError(__FILE__, __LINE__, "Output directory index not loaded.");
   }
@@ -202,8 +280,12 @@ QList<FilePath> OutputDirectoryWriter::findUnknownFiles(
 }
 
 void OutputDirectoryWriter::removeUnknownFiles(const QList<FilePath>& files) {
-  if (!mIndexLoaded) {
-    throw LogicError(__FILE__, __LINE__, "Output directory index not loaded.");
+  {
+    QMutexLocker lock(&mMutex);
+    if (!mIndexLoaded) {
+      throw LogicError(__FILE__, __LINE__,
+                       "Output directory index not loaded.");
+    }
   }
   foreach (const FilePath& fp, files) {
     emit aboutToRemoveFile(fp);
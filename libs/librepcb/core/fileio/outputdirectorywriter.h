@@ -40,6 +40,9 @@ class Uuid;
 
 /**
  * @brief The OutputDirectoryWriter class
+ *
+ * @note All methods are thread-safe, so multiple output jobs are allowed to
+ *       write files concurrently. Signals may be emitted from any thread.
  */
 class OutputDirectoryWriter final : public QObject {
   Q_OBJECT
@@ -53,15 +56,53 @@ public:
 
   // Getters
   const FilePath& getDirectoryPath() const noexcept { return mDirPath; }
-  const QMultiHash<Uuid, FilePath>& getWrittenFiles() const noexcept {
-    return mWrittenFiles;
-  }
+  QMultiHash<Uuid, FilePath> getWrittenFiles() const noexcept;
+
+  /**
+   * @brief Get the input fingerprint of a job from the last run
+   *
+   * @param job   UUID of the job.
+   *
+   * @return The fingerprint set with #setFingerprint() in a previous run,
+   *         or an empty string if unknown.
+   */
+  QString getFingerprint(const Uuid& job) const noexcept;
+
+  // Setters
+
+  /**
+   * @brief Set the input fingerprint of a job
+   *
+   * The fingerprint is stored in the index file, so the next run can detect
+   * whether the job inputs have changed or not.
+   *
+   * @param job           UUID of the job.
+   * @param fingerprint   Fingerprint of the job inputs, or an empty string
+   *                      to invalidate the fingerprint.
+   */
+  void setFingerprint(const Uuid& job, const QString& fingerprint) noexcept;
 
   // General Methods
   bool loadIndex();
   void storeIndex();
   FilePath beginWritingFile(const Uuid& job, const QString& relPath);
   void removeObsoleteFiles(const Uuid& job);
+
+  /**
+   * @brief Keep the output files of a job from the last run
+   *
+   * If the fingerprint matches the one from the last run and all of the
+   * job's output files still exist, these files are marked as written
+   * without actually writing them again.
+   *
+   * @param job           UUID of the job.
+   * @param fingerprint   Fingerprint of the current job inputs.
+   *
+   * @retval true   The existing files are up to date and were kept.
+   * @retval false  The job needs to be run.
+   */
+  bool reuseFiles(const Uuid& job, const QString& fingerprint) noexcept;
+
   QList<FilePath> findUnknownFiles(const QSet<Uuid>& knownJobs) const;
   void removeUnknownFiles(const QList<FilePath>& files);
 
@@ -73,9 +114,11 @@ signals:
   void aboutToRemoveFile(const FilePath& fp);
 
 private:  // Data
+  mutable QMutex mMutex;  ///< Protects all the members below
   const FilePath mDirPath;
   const FilePath mIndexFilePath;
   QMap<FilePath, Uuid> mIndex;
+  QHash<Uuid, QString> mFingerprints;
   bool mIndexLoaded;
   bool mIndexModified;
   QMultiHash<Uuid, FilePath> mWrittenFiles;
@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "strokefont.h"
 
+#include "../utils/taskscheduler.h"
+
 #if FONTOBENE_QT5
 #warning "Using legacy fontobene-qt5, please replace it by fontobene-qt."
 #include <fontobene-qt5/font.h>
@@ -31,7 +33,6 @@
 #include <fontobene-qt/glyphlistaccessor.h>
 #endif
 
-#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -47,14 +48,16 @@ namespace fb = fontobene;
 
 StrokeFont::StrokeFont(const FilePath& fontFilePath,
                        const QByteArray& content) noexcept
-  : QObject(nullptr), mFilePath(fontFilePath) {
+  : QObject(nullptr), mFilePath(fontFilePath), mStrokeCache(10000) {
   // load the font in another thread because it takes some time to load it
   qDebug() << "Start loading stroke font " << mFilePath.toNative()
            << "in worker thread...";
-  mFuture = QtConcurrent::run([content]() {
-    QTextStream s(content);
-    return std::make_shared<fb::Font>(s);
-  });
+  mFuture = TaskScheduler::instance().run(
+      TaskScheduler::Group::Fonts, TaskScheduler::Priority::Normal,
+      [content]() {
+        QTextStream s(content);
+        return std::make_shared<fb::Font>(s);
+      });
   connect(&mWatcher, &QFutureWatcher<fb::Font>::finished, this,
           &StrokeFont::fontLoaded);
   mWatcher.setFuture(mFuture);
@@ -87,6 +90,18 @@ QVector<Path> StrokeFont::stroke(const QString& text,
                                  const Length& lineSpacing,
                                  const Alignment& align, Point& bottomLeft,
                                  Point& topRight) const noexcept {
+  // Texts like reference designators are stroked again and again with the
+  // same parameters, so better return them from the cache if possible.
+  const StrokeCacheKey key{text, height, letterSpacing, lineSpacing, align};
+  {
+    QMutexLocker lock(&mStrokeCacheMutex);
+    if (const StrokeCacheValue* value = mStrokeCache.object(key)) {
+      bottomLeft = value->bottomLeft;
+      topRight = value->topRight;
+      return value->paths;
+    }
+  }
+
   accessor();  // block until the font is loaded. TODO: abort instead of
                // waiting?
   QVector<Path> paths;
@@ -137,6 +152,8 @@ QVector<Path> StrokeFont::stroke(const QString& text,
     topRight.setY(totalHeight / 2);
   }
 
+  QMutexLocker lock(&mStrokeCacheMutex);
+  mStrokeCache.insert(key, new StrokeCacheValue{paths, bottomLeft, topRight});
   return paths;
 }
 
@@ -211,6 +228,8 @@ void StrokeFont::fontLoaded() noexcept {
 const fb::GlyphListAccessor& StrokeFont::accessor() const noexcept {
   if (!mFont) {
     try {
+      // Release the worker slot if called from within a scheduler task.
+      TaskScheduler::instance().waitForFinished(mFuture);  // can throw
       mFont = mFuture.result();  // can throw
       qDebug() << "Successfully loaded stroke font" << mFilePath.toNative()
                << "with" << mFont->glyphs.count() << "glyphs.";
@@ -83,6 +83,32 @@ public:
   // Operator Overloadings
   StrokeFont& operator=(const StrokeFont& rhs) = delete;
 
+private:  // Types
+  struct StrokeCacheKey {
+    QString text;
+    PositiveLength height;
+    Length letterSpacing;
+    Length lineSpacing;
+    Alignment align;
+
+    bool operator==(const StrokeCacheKey& rhs) const noexcept {
+      return (text == rhs.text) && (height == rhs.height) &&
+          (letterSpacing == rhs.letterSpacing) &&
+          (lineSpacing == rhs.lineSpacing) && (align == rhs.align);
+    }
+    friend std::size_t qHash(const StrokeCacheKey& key,
+                             std::size_t seed = 0) noexcept {
+      return qHashMulti(seed, key.text, key.height, key.letterSpacing,
+                        key.lineSpacing,
+                        static_cast<int>(key.align.toQtAlign()));
+    }
+  };
+  struct StrokeCacheValue {
+    QVector<Path> paths;
+    Point bottomLeft;
+    Point topRight;
+  };
+
 private:
   void fontLoaded() noexcept;
   const fontobene::GlyphListAccessor& accessor() const noexcept;
@@ -105,6 +131,10 @@ private:  // Data
   mutable std::shared_ptr<fontobene::Font> mFont;
   mutable QScopedPointer<fontobene::GlyphListCache> mGlyphListCache;
   mutable QScopedPointer<fontobene::GlyphListAccessor> mGlyphListAccessor;
+
+  // Cache of stroked texts, as the same texts are stroked very often.
+  mutable QCache<StrokeCacheKey, StrokeCacheValue> mStrokeCache;
+  mutable QMutex mStrokeCacheMutex;
 };
 
 /*******************************************************************************
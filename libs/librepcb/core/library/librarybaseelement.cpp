@@ -80,7 +80,7 @@ LibraryBaseElement::LibraryBaseElement(
     mMessageApprovals() {
   // Load message approvals.
   foreach (const SExpression* child, root.getChildren("approved")) {
-    mMessageApprovals.insert(*child);
+    mMessageApprovals.insert(ApprovalKey(*child));
   }
 
   // Check directory name.
@@ -114,7 +114,7 @@ QStringList LibraryBaseElement::getAllAvailableLocales() const noexcept {
  *  Setters
  ******************************************************************************/
 
-bool LibraryBaseElement::setMessageApproved(const SExpression& approval,
+bool LibraryBaseElement::setMessageApproved(const ApprovalKey& approval,
                                             bool approved) noexcept {
   if (approved && (!mMessageApprovals.contains(approval))) {
     mMessageApprovals.insert(approval);
@@ -188,9 +188,9 @@ void LibraryBaseElement::serialize(SExpression& root) const {
 }
 
 void LibraryBaseElement::serializeMessageApprovals(SExpression& root) const {
-  foreach (const SExpression& node, Toolbox::sortedQSet(mMessageApprovals)) {
+  foreach (const ApprovalKey& key, Toolbox::sortedQSet(mMessageApprovals)) {
     root.ensureLineBreak();
-    root.appendChild(node);
+    root.appendChild(key.getNode());
   }
   root.ensureLineBreak();
 }
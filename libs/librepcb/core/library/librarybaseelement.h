@@ -82,7 +82,7 @@ public:
   }
   const LocalizedKeywordsMap& getKeywords() const noexcept { return mKeywords; }
   QStringList getAllAvailableLocales() const noexcept;
-  const QSet<SExpression>& getMessageApprovals() const noexcept {
+  const QSet<ApprovalKey>& getMessageApprovals() const noexcept {
     return mMessageApprovals;
   }
 
@@ -98,10 +98,11 @@ public:
   void setKeywords(const LocalizedKeywordsMap& keywords) noexcept {
     mKeywords = keywords;
   }
-  void setMessageApprovals(const QSet<SExpression>& approvals) noexcept {
+  void setMessageApprovals(const QSet<ApprovalKey>& approvals) noexcept {
     mMessageApprovals = approvals;
   }
-  bool setMessageApproved(const SExpression& approval, bool approved) noexcept;
+  bool setMessageApproved(const ApprovalKey& approval,
+                          bool approved) noexcept;
 
   // General Methods
   virtual RuleCheckMessageList runChecks() const;
@@ -159,7 +160,7 @@ protected:  // Data
   LocalizedKeywordsMap mKeywords;
 
   // Library element check
-  QSet<SExpression> mMessageApprovals;
+  QSet<ApprovalKey> mMessageApprovals;
 };
 
 /*******************************************************************************
@@ -36,6 +36,7 @@
 #include "../../types/pcbcolor.h"
 #include "../../utils/scopeguardlist.h"
 #include "../../utils/toolbox.h"
+#include "../../utils/tracer.h"
 #include "../circuit/circuit.h"
 #include "../circuit/componentinstance.h"
 #include "../circuit/netsignal.h"
@@ -82,6 +83,7 @@ Board::Board(Project& project,
     mDesignRules(new BoardDesignRules()),
     mDrcSettings(new BoardDesignRuleCheckSettings()),
     mFabricationOutputSettings(new BoardFabricationOutputSettings()),
+    mBatchUpdateLevel(0),
     mUuid(uuid),
     mName(name),
     mDefaultFontFileName(Application::getDefaultStrokeFontName()),
@@ -178,6 +180,7 @@ std::shared_ptr<SceneData3D> Board::buildScene3D(
         const QString stepFile = obj->getLibPackage().getDirectory().getPath() %
             "/" % model->getFileName();
         data->addDevice(obj->getComponentInstanceUuid(), transform, stepFile,
+                        *model->getName(),
                         obj->getLibFootprint().getModelPosition(),
                         obj->getLibFootprint().getModelRotation(),
                         *obj->getComponentInstance().getName());
@@ -331,12 +334,12 @@ void Board::setDrcSettings(
  ******************************************************************************/
 
 void Board::loadDrcMessageApprovals(
-    const Version& version, const QSet<SExpression>& approvals) noexcept {
+    const Version& version, const QSet<ApprovalKey>& approvals) noexcept {
   mDrcMessageApprovalsVersion = version;
   mDrcMessageApprovals = approvals;
 }
 
-bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
+bool Board::updateDrcMessageApprovals(QSet<ApprovalKey> approvals,
                                       bool partialRun) noexcept {
   mSupportedDrcMessageApprovals |= approvals;
 
@@ -367,7 +370,7 @@ bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
   return false;
 }
 
-void Board::setDrcMessageApproved(const SExpression& approval,
+void Board::setDrcMessageApproved(const ApprovalKey& approval,
                                   bool approved) noexcept {
   if (approved) {
     mDrcMessageApprovals.insert(approval);
@@ -640,6 +643,9 @@ void Board::triggerAirWiresRebuild() noexcept {
     return;
   }
 
+  LIBREPCB_TRACE_ZONE("Board::rebuildAirWires");
+  LIBREPCB_TRACE_COUNTER("Air wire net signals",
+                         mScheduledNetSignalsForAirWireRebuild.count());
   try {
     foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
       // remove old airwires
@@ -679,6 +685,88 @@ void Board::forceAirWiresRebuild() noexcept {
   triggerAirWiresRebuild();
 }
 
+/*******************************************************************************
+ *  Batch Update Methods
+ ******************************************************************************/
+
+void Board::beginBatchUpdate() noexcept {
+  ++mBatchUpdateLevel;
+}
+
+void Board::endBatchUpdate() noexcept {
+  Q_ASSERT(mBatchUpdateLevel > 0);
+  if (mBatchUpdateLevel != 1) {
+    mBatchUpdateLevel = std::max(mBatchUpdateLevel - 1, 0);
+    return;
+  }
+
+  const QVector<DeferredNotification> notifications = mDeferredNotifications;
+  const std::optional<std::pair<Point, Point>> region = mBatchUpdateRegion;
+  mDeferredNotificationKeys.clear();
+  mDeferredNotifications.clear();
+  mBatchUpdateRegion = std::nullopt;
+  mBatchUpdateLevel = 0;
+
+  // Send each notification only once, in the order of the first edit. Any
+  // follow-up notifications (e.g. pads of a moved device) are sent
+  // immediately as the batch update is already finished.
+  for (const DeferredNotification& notification : notifications) {
+    if (notification.item) {
+      notification.notify();
+    }
+  }
+
+  // Update airwires immediately as they are important while moving items,
+  // and since they are also read by the DRC. Only the net signals affected
+  // by the batch update are scheduled.
+  QSet<NetSignal*> netSignals = mScheduledNetSignalsForAirWireRebuild;
+  netSignals.remove(nullptr);
+  triggerAirWiresRebuild();
+
+  if (region) {
+    emit batchUpdateFinished(*region, netSignals);
+  }
+}
+
+void Board::addToBatchUpdateRegion(const Point& pos,
+                                   const Length& margin) noexcept {
+  if (mBatchUpdateLevel <= 0) {
+    return;
+  }
+  const Point min = pos - Point(margin, margin);
+  const Point max = pos + Point(margin, margin);
+  if (mBatchUpdateRegion) {
+    Point& regionMin = mBatchUpdateRegion->first;
+    Point& regionMax = mBatchUpdateRegion->second;
+    regionMin = Point(std::min(regionMin.getX(), min.getX()),
+                      std::min(regionMin.getY(), min.getY()));
+    regionMax = Point(std::max(regionMax.getX(), max.getX()),
+                      std::max(regionMax.getY(), max.getY()));
+  } else {
+    mBatchUpdateRegion = std::make_pair(min, max);
+  }
+}
+
+void Board::addToBatchUpdateRegion(const Path& path,
+                                   const Length& margin) noexcept {
+  if ((mBatchUpdateLevel > 0) && (!path.getVertices().isEmpty())) {
+    // Use the painter path to take arc segments into account.
+    const QRectF rectPx = path.toQPainterPathPx().boundingRect();
+    addToBatchUpdateRegion(Point::fromPx(rectPx.bottomLeft()), margin);
+    addToBatchUpdateRegion(Point::fromPx(rectPx.topRight()), margin);
+  }
+}
+
+void Board::deferItemNotification(
+    BI_Base& item, int event, const std::function<void()>& notify) noexcept {
+  Q_ASSERT(mBatchUpdateLevel > 0);
+  const auto key = std::make_pair(static_cast<const BI_Base*>(&item), event);
+  if (!mDeferredNotificationKeys.contains(key)) {
+    mDeferredNotificationKeys.insert(key);
+    mDeferredNotifications.append(DeferredNotification{&item, notify});
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -967,9 +1055,9 @@ void Board::save() {
       mDrcSettings->serialize(node);
       node.appendChild("approvals_version", mDrcMessageApprovalsVersion);
       node.ensureLineBreak();
-      foreach (const SExpression& child,
+      foreach (const ApprovalKey& approval,
                Toolbox::sortedQSet(mDrcMessageApprovals)) {
-        node.appendChild(child);
+        node.appendChild(approval.getNode());
         node.ensureLineBreak();
       }
     }
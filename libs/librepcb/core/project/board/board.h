@@ -25,15 +25,19 @@
  ******************************************************************************/
 #include "../../fileio/filepath.h"
 #include "../../fileio/transactionaldirectory.h"
+#include "../../rulecheck/approvalkey.h"
 #include "../../types/elementname.h"
 #include "../../types/length.h"
 #include "../../types/lengthunit.h"
+#include "../../types/point.h"
 #include "../../types/uuid.h"
 #include "../../types/version.h"
 
 #include <QtCore>
 
+#include <functional>
 #include <memory>
+#include <optional>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -58,6 +62,7 @@ class BoardDesignRules;
 class BoardFabricationOutputSettings;
 class Layer;
 class NetSignal;
+class Path;
 class PcbColor;
 class Project;
 class SceneData3D;
@@ -167,14 +172,14 @@ public:
   void setDrcSettings(const BoardDesignRuleCheckSettings& settings) noexcept;
 
   // DRC Message Approval Methods
-  const QSet<SExpression>& getDrcMessageApprovals() const noexcept {
+  const QSet<ApprovalKey>& getDrcMessageApprovals() const noexcept {
     return mDrcMessageApprovals;
   }
   void loadDrcMessageApprovals(const Version& version,
-                               const QSet<SExpression>& approvals) noexcept;
-  bool updateDrcMessageApprovals(QSet<SExpression> approvals,
+                               const QSet<ApprovalKey>& approvals) noexcept;
+  bool updateDrcMessageApprovals(QSet<ApprovalKey> approvals,
                                  bool partialRun) noexcept;
-  void setDrcMessageApproved(const SExpression& approval,
+  void setDrcMessageApproved(const ApprovalKey& approval,
                              bool approved) noexcept;
 
   // DeviceInstance Methods
@@ -233,6 +238,51 @@ public:
   void triggerAirWiresRebuild() noexcept;
   void forceAirWiresRebuild() noexcept;
 
+  // Batch Update Methods
+
+  /**
+   * @brief Start a batch update, e.g. while dragging many items
+   *
+   * Until the (outermost) batch update is finished with #endBatchUpdate(),
+   * item notifications sent with #notifyItemEdited() are deferred, and the
+   * bounding rect of all modified items is recorded. Calls can be nested.
+   */
+  void beginBatchUpdate() noexcept;
+
+  /**
+   * @brief Finish a batch update started with #beginBatchUpdate()
+   *
+   * When the outermost batch update is finished, each deferred item
+   * notification is sent once, the airwires are rebuilt and
+   * #batchUpdateFinished() is emitted.
+   */
+  void endBatchUpdate() noexcept;
+  bool isBatchUpdateActive() const noexcept { return mBatchUpdateLevel > 0; }
+  void addToBatchUpdateRegion(const Point& pos,
+                              const Length& margin = Length(0)) noexcept;
+  void addToBatchUpdateRegion(const Path& path,
+                              const Length& margin = Length(0)) noexcept;
+
+  /**
+   * @brief Notify the `onEdited` signal of a board item
+   *
+   * During a batch update, the notification is deferred to the end of the
+   * outermost batch update. Then it is sent only once, no matter how often
+   * the item has been edited in the meantime.
+   *
+   * @param item    The edited board item.
+   * @param event   The event to notify.
+   */
+  template <typename T>
+  void notifyItemEdited(T& item, typename T::Event event) noexcept {
+    if (mBatchUpdateLevel > 0) {
+      deferItemNotification(item, static_cast<int>(event),
+                            [&item, event]() { item.onEdited.notify(event); });
+    } else {
+      item.onEdited.notify(event);
+    }
+  }
+
   // General Methods
   std::optional<std::pair<Point, Point>> calculateBoundingRect() const noexcept;
   void addDefaultContent();
@@ -269,7 +319,20 @@ signals:
   void airWireAdded(BI_AirWire& airWire);
   void airWireRemoved(BI_AirWire& airWire);
 
+  /**
+   * @brief Emitted once when the outermost batch update has finished
+   *
+   * @param region      Bounding rect (bottom left, top right) of all
+   *                    modified items, before and after the modification.
+   * @param netSignals  Net signals whose airwires have been rebuilt.
+   */
+  void batchUpdateFinished(const std::pair<Point, Point>& region,
+                           const QSet<NetSignal*>& netSignals);
+
 private:
+  void deferItemNotification(BI_Base& item, int event,
+                             const std::function<void()>& notify) noexcept;
+
   // General
   Project& mProject;  ///< A reference to the Project object (from the ctor)
   const QString mDirectoryName;
@@ -282,6 +345,16 @@ private:
   QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
   QSet<const Layer*> mScheduledLayersForPlanesRebuild;
 
+  // Batch updates
+  struct DeferredNotification {
+    QPointer<BI_Base> item;
+    std::function<void()> notify;
+  };
+  int mBatchUpdateLevel;
+  QSet<std::pair<const BI_Base*, int>> mDeferredNotificationKeys;
+  QVector<DeferredNotification> mDeferredNotifications;
+  std::optional<std::pair<Point, Point>> mBatchUpdateRegion;
+
   // Attributes
   Uuid mUuid;
   ElementName mName;
@@ -306,8 +379,8 @@ private:
 
   // DRC
   Version mDrcMessageApprovalsVersion;
-  QSet<SExpression> mDrcMessageApprovals;
-  QSet<SExpression> mSupportedDrcMessageApprovals;
+  QSet<ApprovalKey> mDrcMessageApprovals;
+  QSet<ApprovalKey> mSupportedDrcMessageApprovals;
 
   // items
   QMap<Uuid, BI_Device*> mDeviceInstances;
@@ -32,6 +32,8 @@
 #include "../../library/pkg/footprintpad.h"
 #include "../../library/pkg/package.h"
 #include "../../library/pkg/packagepad.h"
+#include "../../utils/scopeguard.h"
+#include "../../utils/taskscheduler.h"
 #include "../../utils/transform.h"
 #include "../circuit/componentinstance.h"
 #include "../circuit/componentsignalinstance.h"
@@ -87,6 +89,7 @@ BoardGerberExport::BoardGerberExport(const Board& board) noexcept
 }
 
 BoardGerberExport::~BoardGerberExport() noexcept {
+  waitForPendingFiles();
 }
 
 /*******************************************************************************
@@ -117,8 +120,18 @@ void BoardGerberExport::setBeforeWriteCallback(BeforeWriteCallback cb) {
 
 void BoardGerberExport::exportPcbLayers(
     const BoardFabricationOutputSettings& settings) const {
+  startPcbLayersExport(settings);
+  finishPcbLayersExport();  // can throw
+}
+
+void BoardGerberExport::startPcbLayersExport(
+    const BoardFabricationOutputSettings& settings) const {
+  waitForPendingFiles();
   mWrittenFiles.clear();
 
+  // Note: The output file paths are determined sequentially in this thread
+  // since they depend on the mutable attribute state, only the generators
+  // are run concurrently.
   exportDrillsMerged(settings);
   exportDrillsNpth(settings);
   exportDrillsPth(settings);
@@ -135,6 +148,25 @@ void BoardGerberExport::exportPcbLayers(
   exportLayerBottomSolderPaste(settings);
 }
 
+void BoardGerberExport::finishPcbLayersExport() const {
+  // Worker threads are accessing the board, so they must be finished
+  // before leaving this method, even in case of errors.
+  auto sg = scopeGuard([this]() { waitForPendingFiles(); });
+
+  // Write files in a deterministic order, independent of which generator
+  // finished first.
+  for (const PendingFile& file : std::as_const(mPendingFiles)) {
+    if (file.save) {
+      TaskScheduler::instance().waitForFinished(file.future);  // can throw
+      trackFileBeforeWrite(file.filePath);  // can throw
+      file.save();  // can throw
+    } else if (mRemoveObsoleteFiles && file.filePath.isExistingFile() &&
+               (!mWrittenFiles.contains(file.filePath))) {
+      FileUtils::removeFile(file.filePath);  // can throw
+    }
+  }
+}
+
 void BoardGerberExport::exportGlueLayer(BoardSide side,
                                         const Uuid& assemblyVariant,
                                         const FilePath& filePath) const {
@@ -333,17 +365,15 @@ void BoardGerberExport::exportDrillsMerged(
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixDrills());
   if (settings.getMergeDrillFiles()) {
-    std::unique_ptr<ExcellonGenerator> gen =
-        BoardGerberExport::createExcellonGenerator(
-            settings, ExcellonGenerator::Plating::Mixed);
-    drawPthDrills(*gen);
-    drawNpthDrills(*gen);
-    gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    addExcellonFile(fp,
+                    createExcellonGenerator(settings,
+                                            ExcellonGenerator::Plating::Mixed),
+                    [this](ExcellonGenerator& gen) {
+                      drawPthDrills(gen);
+                      drawNpthDrills(gen);
+                    });
+  } else {
+    addObsoleteFile(fp);
   }
 }
 
@@ -352,11 +382,6 @@ void BoardGerberExport::exportDrillsNpth(
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixDrillsNpth());
   if (!settings.getMergeDrillFiles()) {
-    std::unique_ptr<ExcellonGenerator> gen =
-        BoardGerberExport::createExcellonGenerator(
-            settings, ExcellonGenerator::Plating::No);
-    drawNpthDrills(*gen);
-
     // Note that separate NPTH drill files could lead to issues with some PCB
     // manufacturers, even if it's empty in many cases. However, we generate the
     // NPTH file even if there are no NPTH drills since it could also lead to
@@ -364,12 +389,11 @@ void BoardGerberExport::exportDrillsNpth(
     // https://github.com/LibrePCB/LibrePCB/issues/998. If the PCB manufacturer
     // doesn't support a separate NPTH file, the user shall enable the
     // "merge PTH and NPTH drills"  option.
-    gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    addExcellonFile(
+        fp, createExcellonGenerator(settings, ExcellonGenerator::Plating::No),
+        [this](ExcellonGenerator& gen) { drawNpthDrills(gen); });
+  } else {
+    addObsoleteFile(fp);
   }
 }
 
@@ -378,16 +402,11 @@ void BoardGerberExport::exportDrillsPth(
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixDrillsPth());
   if (!settings.getMergeDrillFiles()) {
-    std::unique_ptr<ExcellonGenerator> gen =
-        BoardGerberExport::createExcellonGenerator(
-            settings, ExcellonGenerator::Plating::Yes);
-    drawPthDrills(*gen);
-    gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    addExcellonFile(
+        fp, createExcellonGenerator(settings, ExcellonGenerator::Plating::Yes),
+        [this](ExcellonGenerator& gen) { drawPthDrills(gen); });
+  } else {
+    addObsoleteFile(fp);
   }
 }
 
@@ -399,16 +418,15 @@ void BoardGerberExport::exportDrillsBlindBuried(
     mCurrentEndLayer = it.key().second;
     const FilePath fp = getOutputFilePath(
         settings.getOutputBasePath() % settings.getSuffixDrillsBlindBuried());
-    std::unique_ptr<ExcellonGenerator> gen =
-        BoardGerberExport::createExcellonGenerator(
-            settings, ExcellonGenerator::Plating::Yes);
-    foreach (const BI_Via* via, it.value()) {
-      gen->drill(via->getPosition(), via->getActualDrillDiameter(), true,
-                 ExcellonGenerator::Function::ViaDrill);
-    }
-    gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
+    const QList<const BI_Via*> layerVias = it.value();
+    addExcellonFile(
+        fp, createExcellonGenerator(settings, ExcellonGenerator::Plating::Yes),
+        [layerVias](ExcellonGenerator& gen) {
+          foreach (const BI_Via* via, layerVias) {
+            gen.drill(via->getPosition(), via->getActualDrillDiameter(), true,
+                      ExcellonGenerator::Function::ViaDrill);
+          }
+        });
   }
 }
 
@@ -416,49 +434,41 @@ void BoardGerberExport::exportLayerBoardOutlines(
     const BoardFabricationOutputSettings& settings) const {
   FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                   settings.getSuffixOutlines());
-  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                      *mProject.getVersion());
-  gen.setFileFunctionOutlines(false);
-  drawLayer(gen, Layer::boardOutlines());
-  drawLayer(gen, Layer::boardCutouts());
-  // Note: Currently the "plated cutouts" layer is exported to the normal board
-  // outlines Gerber file, which is not ideal but unfortunately there doesn't
-  // exist a standardized way of exporting plated cutouts :-( This way may
-  // still work fine if there is copper around the plated cutout polygons,
-  // therefore we have implemented a DRC warning if this is not the case.
-  drawLayer(gen, Layer::boardPlatedCutouts());
-  gen.generate();
-  trackFileBeforeWrite(fp);  // can throw
-  gen.saveToFile(fp);
+  addGerberFile(fp, [this](GerberGenerator& gen) {
+    gen.setFileFunctionOutlines(false);
+    drawLayer(gen, Layer::boardOutlines());
+    drawLayer(gen, Layer::boardCutouts());
+    // Note: Currently the "plated cutouts" layer is exported to the normal
+    // board outlines Gerber file, which is not ideal but unfortunately there
+    // doesn't exist a standardized way of exporting plated cutouts :-( This
+    // way may still work fine if there is copper around the plated cutout
+    // polygons, therefore we have implemented a DRC warning if this is not
+    // the case.
+    drawLayer(gen, Layer::boardPlatedCutouts());
+  });
 }
 
 void BoardGerberExport::exportLayerTopCopper(
     const BoardFabricationOutputSettings& settings) const {
   FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                   settings.getSuffixCopperTop());
-  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                      *mProject.getVersion());
-  gen.setFileFunctionCopper(1, GerberGenerator::CopperSide::Top,
-                            GerberGenerator::Polarity::Positive);
-  drawLayer(gen, Layer::topCopper());
-  gen.generate();
-  trackFileBeforeWrite(fp);  // can throw
-  gen.saveToFile(fp);
+  addGerberFile(fp, [this](GerberGenerator& gen) {
+    gen.setFileFunctionCopper(1, GerberGenerator::CopperSide::Top,
+                              GerberGenerator::Polarity::Positive);
+    drawLayer(gen, Layer::topCopper());
+  });
 }
 
 void BoardGerberExport::exportLayerBottomCopper(
     const BoardFabricationOutputSettings& settings) const {
   FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                   settings.getSuffixCopperBot());
-  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                      *mProject.getVersion());
-  gen.setFileFunctionCopper(mBoard.getInnerLayerCount() + 2,
-                            GerberGenerator::CopperSide::Bottom,
-                            GerberGenerator::Polarity::Positive);
-  drawLayer(gen, Layer::botCopper());
-  gen.generate();
-  trackFileBeforeWrite(fp);  // can throw
-  gen.saveToFile(fp);
+  addGerberFile(fp, [this](GerberGenerator& gen) {
+    gen.setFileFunctionCopper(mBoard.getInnerLayerCount() + 2,
+                              GerberGenerator::CopperSide::Bottom,
+                              GerberGenerator::Polarity::Positive);
+    drawLayer(gen, Layer::botCopper());
+  });
 }
 
 void BoardGerberExport::exportLayerInnerCopper(
@@ -467,18 +477,15 @@ void BoardGerberExport::exportLayerInnerCopper(
     mCurrentInnerCopperLayer = i;  // used for attribute provider
     FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                     settings.getSuffixCopperInner());
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionCopper(i + 1, GerberGenerator::CopperSide::Inner,
-                              GerberGenerator::Polarity::Positive);
-    if (const Layer* layer = Layer::innerCopper(i)) {
-      drawLayer(gen, *layer);
-    } else {
+    const Layer* layer = Layer::innerCopper(i);
+    if (!layer) {
       throw LogicError(__FILE__, __LINE__, "Unknown inner copper layer.");
     }
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
+    addGerberFile(fp, [this, i, layer](GerberGenerator& gen) {
+      gen.setFileFunctionCopper(i + 1, GerberGenerator::CopperSide::Inner,
+                                GerberGenerator::Polarity::Positive);
+      drawLayer(gen, *layer);
+    });
   }
   mCurrentInnerCopperLayer = 0;
 }
@@ -488,17 +495,13 @@ void BoardGerberExport::exportLayerTopSolderMask(
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderMaskTop());
   if (mBoard.getSolderResist()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Top,
-                                  GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::topStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    addGerberFile(fp, [this](GerberGenerator& gen) {
+      gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Top,
+                                    GerberGenerator::Polarity::Negative);
+      drawLayer(gen, Layer::topStopMask());
+    });
+  } else {
+    addObsoleteFile(fp);
   }
 }
 
@@ -507,17 +510,13 @@ void BoardGerberExport::exportLayerBottomSolderMask(
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderMaskBot());
   if (mBoard.getSolderResist()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Bottom,
-                                  GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::botStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    addGerberFile(fp, [this](GerberGenerator& gen) {
+      gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Bottom,
+                                    GerberGenerator::Polarity::Negative);
+      drawLayer(gen, Layer::botStopMask());
+    });
+  } else {
+    addObsoleteFile(fp);
   }
 }
 
@@ -527,21 +526,17 @@ void BoardGerberExport::exportLayerTopSilkscreen(
                                         settings.getSuffixSilkscreenTop());
   const QVector<const Layer*>& layers = mBoard.getSilkscreenLayersTop();
   if (layers.count() > 0) {  // don't export silkscreen if no layers selected
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionLegend(GerberGenerator::BoardSide::Top,
-                              GerberGenerator::Polarity::Positive);
-    foreach (const Layer* layer, layers) {
-      drawLayer(gen, *layer);
-    }
-    gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::topStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    addGerberFile(fp, [this, layers](GerberGenerator& gen) {
+      gen.setFileFunctionLegend(GerberGenerator::BoardSide::Top,
+                                GerberGenerator::Polarity::Positive);
+      foreach (const Layer* layer, layers) {
+        drawLayer(gen, *layer);
+      }
+      gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
+      drawLayer(gen, Layer::topStopMask());
+    });
+  } else {
+    addObsoleteFile(fp);
   }
 }
 
@@ -551,21 +546,17 @@ void BoardGerberExport::exportLayerBottomSilkscreen(
                                         settings.getSuffixSilkscreenBot());
   const QVector<const Layer*>& layers = mBoard.getSilkscreenLayersBot();
   if (layers.count() > 0) {  // don't export silkscreen if no layers selected
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionLegend(GerberGenerator::BoardSide::Bottom,
-                              GerberGenerator::Polarity::Positive);
-    foreach (const Layer* layer, layers) {
-      drawLayer(gen, *layer);
-    }
-    gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::botStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    addGerberFile(fp, [this, layers](GerberGenerator& gen) {
+      gen.setFileFunctionLegend(GerberGenerator::BoardSide::Bottom,
+                                GerberGenerator::Polarity::Positive);
+      foreach (const Layer* layer, layers) {
+        drawLayer(gen, *layer);
+      }
+      gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
+      drawLayer(gen, Layer::botStopMask());
+    });
+  } else {
+    addObsoleteFile(fp);
   }
 }
 
@@ -574,17 +565,13 @@ void BoardGerberExport::exportLayerTopSolderPaste(
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderPasteTop());
   if (settings.getEnableSolderPasteTop()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionPaste(GerberGenerator::BoardSide::Top,
-                             GerberGenerator::Polarity::Positive);
-    drawLayer(gen, Layer::topSolderPaste());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    addGerberFile(fp, [this](GerberGenerator& gen) {
+      gen.setFileFunctionPaste(GerberGenerator::BoardSide::Top,
+                               GerberGenerator::Polarity::Positive);
+      drawLayer(gen, Layer::topSolderPaste());
+    });
+  } else {
+    addObsoleteFile(fp);
   }
 }
 
@@ -593,18 +580,63 @@ void BoardGerberExport::exportLayerBottomSolderPaste(
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderPasteBot());
   if (settings.getEnableSolderPasteBot()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionPaste(GerberGenerator::BoardSide::Bottom,
-                             GerberGenerator::Polarity::Positive);
-    drawLayer(gen, Layer::botSolderPaste());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    addGerberFile(fp, [this](GerberGenerator& gen) {
+      gen.setFileFunctionPaste(GerberGenerator::BoardSide::Bottom,
+                               GerberGenerator::Polarity::Positive);
+      drawLayer(gen, Layer::botSolderPaste());
+    });
+  } else {
+    addObsoleteFile(fp);
+  }
+}
+
+void BoardGerberExport::addGerberFile(
+    const FilePath& fp, std::function<void(GerberGenerator&)> draw) const {
+  auto gen = std::make_shared<GerberGenerator>(
+      mCreationDateTime, mProjectName, mBoard.getUuid(),
+      *mProject.getVersion());
+  PendingFile file;
+  file.filePath = fp;
+  file.future = TaskScheduler::instance().run(
+      TaskScheduler::Group::Export, TaskScheduler::Priority::Normal,
+      [gen, draw]() {
+        draw(*gen);  // can throw
+        gen->generate();  // can throw
+      });
+  file.save = [gen, fp]() { gen->saveToFile(fp); };
+  mPendingFiles.append(file);
+}
+
+void BoardGerberExport::addExcellonFile(
+    const FilePath& fp, std::shared_ptr<ExcellonGenerator> gen,
+    std::function<void(ExcellonGenerator&)> draw) const {
+  PendingFile file;
+  file.filePath = fp;
+  file.future = TaskScheduler::instance().run(
+      TaskScheduler::Group::Export, TaskScheduler::Priority::Normal,
+      [gen, draw]() {
+        draw(*gen);  // can throw
+        gen->generate();  // can throw
+      });
+  file.save = [gen, fp]() { gen->saveToFile(fp); };
+  mPendingFiles.append(file);
+}
+
+void BoardGerberExport::addObsoleteFile(const FilePath& fp) const {
+  PendingFile file;
+  file.filePath = fp;
+  mPendingFiles.append(file);
+}
+
+void BoardGerberExport::waitForPendingFiles() const noexcept {
+  for (const PendingFile& file : std::as_const(mPendingFiles)) {
+    try {
+      TaskScheduler::instance().waitForFinished(file.future);
+    } catch (...) {
+      // Errors are reported by finishPcbLayersExport(), if needed.
+    }
   }
+  mPendingFiles.clear();
 }
 
 int BoardGerberExport::drawNpthDrills(ExcellonGenerator& gen) const {
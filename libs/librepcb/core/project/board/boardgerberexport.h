@@ -60,6 +60,13 @@ class Project;
 class BoardGerberExport final : public QObject {
   Q_OBJECT
 
+  /// A file being generated in a worker thread
+  struct PendingFile {
+    FilePath filePath;
+    QFuture<void> future;  ///< Generator thread
+    std::function<void()> save;  ///< Empty if the file is obsolete
+  };
+
 public:
   enum class BoardSide { Top, Bottom };
   typedef std::pair<const Layer*, const Layer*> LayerPair;
@@ -84,6 +91,31 @@ public:
 
   // General Methods
   void exportPcbLayers(const BoardFabricationOutputSettings& settings) const;
+
+  /**
+   * @brief Start generating all PCB layer files in background threads
+   *
+   * The files are not written until #finishPcbLayersExport() is called. This
+   * allows to generate the files of multiple boards concurrently.
+   *
+   * @attention The board must not be modified until
+   *            #finishPcbLayersExport() returned.
+   *
+   * @param settings  The fabrication output settings.
+   */
+  void startPcbLayersExport(
+      const BoardFabricationOutputSettings& settings) const;
+
+  /**
+   * @brief Wait for the generators and write all PCB layer files
+   *
+   * Files are written (and obsolete files removed) in a deterministic order,
+   * i.e. exactly the same as with the sequential export.
+   *
+   * @throw Exception if any file could not be generated or written.
+   */
+  void finishPcbLayersExport() const;
+
   void exportGlueLayer(BoardSide side, const Uuid& assemblyVariant,
                        const FilePath& filePath) const;
   void exportComponentLayer(BoardSide side, const Uuid& assemblyVariant,
@@ -120,6 +152,14 @@ private:
   void exportLayerBottomSolderPaste(
       const BoardFabricationOutputSettings& settings) const;
 
+  void addGerberFile(const FilePath& fp,
+                     std::function<void(GerberGenerator&)> draw) const;
+  void addExcellonFile(const FilePath& fp,
+                       std::shared_ptr<ExcellonGenerator> gen,
+                       std::function<void(ExcellonGenerator&)> draw) const;
+  void addObsoleteFile(const FilePath& fp) const;
+  void waitForPendingFiles() const noexcept;
+
   int drawNpthDrills(ExcellonGenerator& gen) const;
   int drawPthDrills(ExcellonGenerator& gen) const;
   QMap<LayerPair, QList<const BI_Via*> > getBlindBuriedVias() const;
@@ -163,6 +203,7 @@ private:
   mutable const Layer* mCurrentStartLayer;
   mutable const Layer* mCurrentEndLayer;
   mutable QVector<FilePath> mWrittenFiles;
+  mutable QVector<PendingFile> mPendingFiles;
 };
 
 /*******************************************************************************
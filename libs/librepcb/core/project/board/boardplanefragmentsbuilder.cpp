@@ -25,6 +25,8 @@
 #include "../../library/pkg/footprint.h"
 #include "../../library/pkg/footprintpad.h"
 #include "../../utils/clipperhelpers.h"
+#include "../../utils/taskscheduler.h"
+#include "../../utils/tracer.h"
 #include "../../utils/transform.h"
 #include "../circuit/netsignal.h"
 #include "board.h"
@@ -41,7 +43,6 @@
 
 #include <polyclipping/clipper.hpp>
 
-#include <QtConcurrent>
 #include <QtCore>
 
 #include <algorithm>
@@ -115,8 +116,10 @@ bool BoardPlaneFragmentsBuilder::start(
     Board& board, const QSet<const Layer*>* layers) noexcept {
   if (auto data = createJob(board, layers)) {
     cancel();
-    mFuture =
-        QtConcurrent::run(&BoardPlaneFragmentsBuilder::run, this, &board, data);
+    QPointer<Board> boardPtr(&board);
+    mFuture = TaskScheduler::instance().run(
+        TaskScheduler::Group::Planes, TaskScheduler::Priority::Interactive,
+        [this, boardPtr, data]() { return run(boardPtr, data); });
     return true;
   } else {
     return false;
@@ -146,6 +149,7 @@ void BoardPlaneFragmentsBuilder::cancel() noexcept {
 std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
     BoardPlaneFragmentsBuilder::createJob(
         Board& board, const QSet<const Layer*>* filter) noexcept {
+  LIBREPCB_TRACE_ZONE("PlaneBuilder::createJob");
   QSet<const Layer*> layersWithPlanes;
   foreach (const BI_Plane* plane, board.getPlanes()) {
     if ((!filter) ||
@@ -299,6 +303,7 @@ BoardPlaneFragmentsBuilder::Result BoardPlaneFragmentsBuilder::run(
   // Note: This method is called from a different thread, thus be careful with
   //       calling other methods to only call thread-safe methods!
 
+  LIBREPCB_TRACE_ZONE("PlaneBuilder::run");
   QElapsedTimer timer;
   timer.start();
   qDebug() << "Start calculating areas of" << data->planes.count()
@@ -381,9 +386,10 @@ BoardPlaneFragmentsBuilder::Result BoardPlaneFragmentsBuilder::run(
       const Layer* layer = data->layers.at(i);
       if (i < data->layers.count() - 1) {
         // Run in other thread -> Copy JobData for safe concurrent access.
-        futures.append(
-            QtConcurrent::run(&BoardPlaneFragmentsBuilder::runLayer, this,
-                              std::make_shared<const JobData>(*data), layer));
+        auto layerData = std::make_shared<const JobData>(*data);
+        futures.append(TaskScheduler::instance().run(
+            TaskScheduler::Group::Planes, TaskScheduler::Priority::Interactive,
+            [this, layerData, layer]() { return runLayer(layerData, layer); }));
       } else {
         // Run in this thread -> no copy of JobData required.
         const LayerJobResult res = runLayer(data, layer);
@@ -394,6 +400,7 @@ BoardPlaneFragmentsBuilder::Result BoardPlaneFragmentsBuilder::run(
 
     // Fetch result of each thread (blocking until all threads finished).
     foreach (const auto& future, futures) {
+      TaskScheduler::instance().waitForFinished(future);
       const LayerJobResult res = future.result();
       result.planes.insert(res.planes);
       result.errors.append(res.errors);
@@ -411,6 +418,7 @@ BoardPlaneFragmentsBuilder::Result BoardPlaneFragmentsBuilder::run(
     result.finished = true;
     qDebug() << "Calculated plane areas in" << timer.elapsed() << "ms.";
   }
+  LIBREPCB_TRACE_COUNTER("Planes", result.planes.count());
 
   emit finished(result);
   return result;
@@ -418,6 +426,7 @@ BoardPlaneFragmentsBuilder::Result BoardPlaneFragmentsBuilder::run(
 
 BoardPlaneFragmentsBuilder::LayerJobResult BoardPlaneFragmentsBuilder::runLayer(
     std::shared_ptr<const JobData> data, const Layer* layer) noexcept {
+  LIBREPCB_TRACE_ZONE("PlaneBuilder::runLayer");
   LayerJobResult result;
 
   // Build all planes.
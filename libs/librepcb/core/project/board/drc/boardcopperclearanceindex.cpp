@@ -0,0 +1,478 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardcopperclearanceindex.h"
+
+#include "../../../types/layer.h"
+#include "../../../utils/clipperhelpers.h"
+#include "../../../utils/transform.h"
+#include "boardclipperpathgenerator.h"
+
+#include <QtCore>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+// Size of the grid cells. Items covering more than kMaxCellsPerItem cells
+// (e.g. large polygons) are not put into the grid but always considered.
+static constexpr ClipperLib::cInt kGridCellSize = 2000000;  // 2mm
+static constexpr qint64 kMaxCellsPerItem = 64;
+
+static int getGridCell(ClipperLib::cInt coordinate) noexcept {
+  return static_cast<int>(
+      std::floor(static_cast<qreal>(coordinate) / kGridCellSize));
+}
+
+static quint64 getGridKey(int x, int y) noexcept {
+  return (static_cast<quint64>(static_cast<quint32>(x)) << 32) |
+      static_cast<quint64>(static_cast<quint32>(y));
+}
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardCopperClearanceIndex::BoardCopperClearanceIndex(
+    const Data& data, const PositiveLength& maxArcTolerance)
+  : mData(data),
+    mMaxArcTolerance(maxArcTolerance),
+    mItems(),
+    mGrid(),
+    mLargeItems() {
+  // Skip building the index if no minimum copper clearances are configured.
+  if (!isCheckEnabled(mData)) {
+    return;
+  }
+
+  // Helper to add polygon-like items whose clearance area is calculated by
+  // offsetting their copper area.
+  BoardClipperPathGenerator gen(mMaxArcTolerance);
+  auto offsetCopperArea = [this](Item& item) {
+    item.clearanceArea = item.copperArea;
+    ClipperHelpers::offset(item.clearanceArea,
+                           getClearanceOffset(item.clearance),
+                           mMaxArcTolerance);
+  };
+
+  // Net segments.
+  for (const Data::Segment& ns : mData.segments) {
+    addSegmentItems(mItems, ns, true);
+  }
+
+  // Planes.
+  if (!mData.quick) {
+    for (const Data::Plane& plane : mData.planes) {
+      if (mData.copperLayers.contains(plane.layer)) {
+        Item& item = addItem(
+            mItems, Object::plane(plane), plane.layer, plane.layer, plane.net,
+            std::nullopt, mData.getMinCopperCopperClearance(plane.netClass));
+        gen.addPlane(plane.fragments);
+        gen.takePathsTo(item.copperArea);
+        offsetCopperArea(item);
+      }
+    }
+  }
+
+  // Board polygons.
+  for (const Data::Polygon& polygon : mData.polygons) {
+    if (mData.copperLayers.contains(polygon.layer)) {
+      Item& item = addItem(mItems, Object::polygon(polygon, nullptr),
+                           polygon.layer, polygon.layer, std::nullopt,
+                           std::nullopt,
+                           mData.settings.getMinCopperCopperClearance());
+      gen.addPolygon(polygon.path, polygon.lineWidth, polygon.filled);
+      gen.takePathsTo(item.copperArea);
+      offsetCopperArea(item);
+    }
+  }
+
+  // Board stroke texts.
+  for (const Data::StrokeText& st : mData.strokeTexts) {
+    if (mData.copperLayers.contains(st.layer)) {
+      const UnsignedLength clearance =
+          mData.settings.getMinCopperCopperClearance();
+      Item& item =
+          addItem(mItems, Object::strokeText(st, nullptr), st.layer, st.layer,
+                  std::nullopt, std::nullopt, clearance);
+      gen.addStrokeText(st);
+      gen.takePathsTo(item.copperArea);
+      gen.addStrokeText(st, getClearanceOffset(*clearance));
+      gen.takePathsTo(item.clearanceArea);
+    }
+  }
+
+  // Devices.
+  for (const Data::Device& dev : mData.devices) {
+    const Transform transform(dev.position, dev.rotation, dev.mirror);
+
+    // Pads.
+    for (const Data::Pad& pad : dev.pads) {
+      addPadItems(mItems, pad, Object::footprintPad(pad, dev), std::nullopt);
+    }
+
+    // Polygons.
+    for (const Data::Polygon& polygon : dev.polygons) {
+      const Layer& layer = transform.map(*polygon.layer);
+      if (mData.copperLayers.contains(&layer)) {
+        Item& item = addItem(mItems, Object::polygon(polygon, &dev), &layer,
+                             &layer, std::nullopt, std::nullopt,
+                             mData.settings.getMinCopperCopperClearance());
+        gen.addPolygon(transform.map(polygon.path), polygon.lineWidth,
+                       polygon.filled);
+        gen.takePathsTo(item.copperArea);
+        offsetCopperArea(item);
+      }
+    }
+
+    // Circles.
+    for (const Data::Circle& circle : dev.circles) {
+      const Layer& layer = transform.map(*circle.layer);
+      if (mData.copperLayers.contains(&layer)) {
+        const UnsignedLength clearance =
+            mData.settings.getMinCopperCopperClearance();
+        Item& item = addItem(mItems, Object::circle(circle, &dev), &layer,
+                             &layer, std::nullopt, std::nullopt, clearance);
+        gen.addCircle(circle, transform);
+        gen.takePathsTo(item.copperArea);
+        gen.addCircle(circle, transform, getClearanceOffset(*clearance));
+        gen.takePathsTo(item.clearanceArea);
+      }
+    }
+
+    // Stroke texts.
+    for (const Data::StrokeText& st : dev.strokeTexts) {
+      // Layer does not need to be transformed!
+      if (mData.copperLayers.contains(st.layer)) {
+        const UnsignedLength clearance =
+            mData.settings.getMinCopperCopperClearance();
+        Item& item =
+            addItem(mItems, Object::strokeText(st, &dev), st.layer, st.layer,
+                    std::nullopt, std::nullopt, clearance);
+        gen.addStrokeText(st);
+        gen.takePathsTo(item.copperArea);
+        gen.addStrokeText(st, getClearanceOffset(*clearance));
+        gen.takePathsTo(item.clearanceArea);
+      }
+    }
+  }
+
+  // Build the spatial index.
+  for (int i = 0; i < mItems.count(); ++i) {
+    updateBounds(mItems[i]);
+    addToGrid(i);
+  }
+}
+
+BoardCopperClearanceIndex::~BoardCopperClearanceIndex() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+bool BoardCopperClearanceIndex::isCheckEnabled(const Data& data) noexcept {
+  if (data.settings.getMinCopperCopperClearance() > 0) {
+    return true;
+  }
+  for (const auto& nc : data.netClasses) {
+    if (nc.minCopperCopperClearance > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+RuleCheckMessageList BoardCopperClearanceIndex::checkAll() const {
+  QVector<Violation> violations;
+  for (int i = 0; i < mItems.count(); ++i) {
+    for (int k = i + 1; k < mItems.count(); ++k) {
+      checkPair(mItems.at(i), mItems.at(k), violations);
+    }
+  }
+  return createMessages(violations);
+}
+
+RuleCheckMessageList BoardCopperClearanceIndex::checkSegment(
+    const Data::Segment& segment) const {
+  if (mItems.isEmpty()) {
+    return RuleCheckMessageList();
+  }
+
+  // Pads are not checked since they are not moved when drawing traces.
+  QVector<Item> items;
+  addSegmentItems(items, segment, false);
+
+  QVector<Violation> violations;
+  QVector<int> candidates;
+  for (Item& item : items) {
+    updateBounds(item);
+    if (item.bounds.left > item.bounds.right) {
+      continue;  // Empty item.
+    }
+
+    // Collect all indexed items in the neighbourhood.
+    candidates = mLargeItems;
+    for (int x = getGridCell(item.bounds.left);
+         x <= getGridCell(item.bounds.right); ++x) {
+      for (int y = getGridCell(item.bounds.top);
+           y <= getGridCell(item.bounds.bottom); ++y) {
+        auto it = mGrid.find(getGridKey(x, y));
+        if (it != mGrid.end()) {
+          candidates += *it;
+        }
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+
+    // Check them, except the (possibly outdated) objects of the same segment.
+    for (int index : candidates) {
+      const Item& other = mItems.at(index);
+      if (other.segment != segment.uuid) {
+        checkPair(item, other, violations);
+      }
+    }
+  }
+  return createMessages(violations);
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardCopperClearanceIndex::addSegmentItems(QVector<Item>& items,
+                                                const Data::Segment& segment,
+                                                bool withPads) const {
+  const UnsignedLength clearance =
+      mData.getMinCopperCopperClearance(segment.netClass);
+  BoardClipperPathGenerator gen(mMaxArcTolerance);
+
+  // Pads.
+  if (withPads) {
+    for (const Data::Pad& pad : segment.pads) {
+      addPadItems(items, pad, Object::pad(pad, segment), segment.uuid);
+    }
+  }
+
+  // Vias.
+  for (const Data::Via& via : segment.vias) {
+    Item& item = addItem(items, Object::via(via, segment), via.startLayer,
+                         via.endLayer, segment.net, segment.uuid, clearance);
+    gen.addVia(via);
+    gen.takePathsTo(item.copperArea);
+    gen.addVia(via, getClearanceOffset(*clearance));
+    gen.takePathsTo(item.clearanceArea);
+  }
+
+  // Traces.
+  for (const Data::Trace& trace : segment.traces) {
+    if (mData.copperLayers.contains(trace.layer)) {
+      Item& item =
+          addItem(items, Object::trace(trace, segment), trace.layer,
+                  trace.layer, segment.net, segment.uuid, clearance);
+      gen.addTrace(trace);
+      gen.takePathsTo(item.copperArea);
+      gen.addTrace(trace, getClearanceOffset(*clearance));
+      gen.takePathsTo(item.clearanceArea);
+    }
+  }
+}
+
+void BoardCopperClearanceIndex::addPadItems(
+    QVector<Item>& items, const Data::Pad& pad, const Object& obj,
+    const std::optional<Uuid>& segment) const {
+  const UnsignedLength clearance = std::max(
+      pad.copperClearance, mData.getMinCopperCopperClearance(pad.netClass));
+  BoardClipperPathGenerator gen(mMaxArcTolerance);
+  for (const Layer* layer : mData.copperLayers) {
+    if (!pad.geometries.value(layer).isEmpty()) {
+      Item& item =
+          addItem(items, obj, layer, layer, pad.net, segment, clearance);
+      gen.addPad(pad, *layer);
+      gen.takePathsTo(item.copperArea);
+      gen.addPad(pad, *layer, getClearanceOffset(*clearance));
+      gen.takePathsTo(item.clearanceArea);
+    }
+  }
+}
+
+BoardCopperClearanceIndex::Item& BoardCopperClearanceIndex::addItem(
+    QVector<Item>& items, const Object& obj, const Layer* startLayer,
+    const Layer* endLayer, const std::optional<Uuid>& net,
+    const std::optional<Uuid>& segment, const UnsignedLength& clearance) const {
+  items.append(Item{obj,
+                    startLayer,
+                    endLayer,
+                    net,
+                    segment,
+                    *clearance,
+                    {},
+                    {},
+                    ClipperLib::IntRect()});
+  return items.last();
+}
+
+void BoardCopperClearanceIndex::addToGrid(int index) noexcept {
+  const ClipperLib::IntRect& bounds = mItems.at(index).bounds;
+  if (bounds.left > bounds.right) {
+    return;  // Empty item, can't violate any clearance.
+  }
+  const int left = getGridCell(bounds.left);
+  const int right = getGridCell(bounds.right);
+  const int top = getGridCell(bounds.top);
+  const int bottom = getGridCell(bounds.bottom);
+  if ((static_cast<qint64>(right - left + 1) * (bottom - top + 1)) >
+      kMaxCellsPerItem) {
+    mLargeItems.append(index);
+    return;
+  }
+  for (int x = left; x <= right; ++x) {
+    for (int y = top; y <= bottom; ++y) {
+      mGrid[getGridKey(x, y)].append(index);
+    }
+  }
+}
+
+void BoardCopperClearanceIndex::checkPair(
+    const Item& item1, const Item& item2,
+    QVector<Violation>& violations) const {
+  if ((item1.clearance <= 0) && (item2.clearance <= 0)) {
+    return;
+  }
+  if (item1.net && item2.net && (*item1.net == *item2.net)) {
+    return;
+  }
+  if (!boundsOverlap(item1.bounds, item2.bounds)) {
+    return;  // Cheap pre-check to avoid expensive polygon operations.
+  }
+
+  // Check for overlapping layer spans.
+  QSet<const Layer*> layers;
+  const int first = std::max(item1.startLayer->getCopperNumber(),
+                             item2.startLayer->getCopperNumber());
+  const int last = std::min(item1.endLayer->getCopperNumber(),
+                            item2.endLayer->getCopperNumber());
+  for (int i = first; i <= last; ++i) {
+    const Layer* layer = Layer::copper(i);
+    if (mData.copperLayers.contains(layer)) {
+      layers.insert(layer);
+    }
+  }
+  if (layers.isEmpty()) {
+    return;
+  }
+
+  // Check for intersections.
+  auto checkForIntersections = [](const Item& a, const Item& b,
+                                  QVector<Path>& locations) {
+    const std::unique_ptr<ClipperLib::PolyTree> intersections =
+        ClipperHelpers::intersectToTree(a.copperArea, b.clearanceArea,
+                                        ClipperLib::pftEvenOdd,
+                                        ClipperLib::pftEvenOdd);
+    locations.append(
+        ClipperHelpers::convert(ClipperHelpers::flattenTree(*intersections)));
+  };
+  QVector<Path> locations;
+  checkForIntersections(item1, item2, locations);
+  // Perform the check the other way around only if:
+  //  - Either the two items have individual clearances
+  //  - Or there are any intersections -> show both violations in UI
+  if ((item1.clearance != item2.clearance) || (!locations.isEmpty())) {
+    checkForIntersections(item2, item1, locations);
+  }
+  if (!locations.isEmpty()) {
+    addViolation(violations,
+                 Violation{item1.object, item2.object, layers,
+                           std::max(item1.clearance, item2.clearance),
+                           locations});
+  }
+}
+
+Length BoardCopperClearanceIndex::getClearanceOffset(
+    const Length& clearance) const noexcept {
+  // Subtract a tolerance to avoid false-positives due to inaccuracies.
+  const Length tolerance = mMaxArcTolerance + Length(1);
+  return std::max(clearance - tolerance, Length(0));
+}
+
+void BoardCopperClearanceIndex::updateBounds(Item& item) noexcept {
+  ClipperLib::IntRect& bounds = item.bounds;
+  bounds.left = bounds.top = std::numeric_limits<ClipperLib::cInt>::max();
+  bounds.right = bounds.bottom = std::numeric_limits<ClipperLib::cInt>::min();
+  for (const ClipperLib::Paths* paths :
+       {&item.copperArea, &item.clearanceArea}) {
+    for (const ClipperLib::Path& path : *paths) {
+      for (const ClipperLib::IntPoint& p : path) {
+        bounds.left = std::min(bounds.left, p.X);
+        bounds.right = std::max(bounds.right, p.X);
+        bounds.top = std::min(bounds.top, p.Y);
+        bounds.bottom = std::max(bounds.bottom, p.Y);
+      }
+    }
+  }
+}
+
+bool BoardCopperClearanceIndex::boundsOverlap(
+    const ClipperLib::IntRect& a, const ClipperLib::IntRect& b) noexcept {
+  return (a.left <= b.right) && (b.left <= a.right) && (a.top <= b.bottom) &&
+      (b.top <= a.bottom);
+}
+
+void BoardCopperClearanceIndex::addViolation(QVector<Violation>& violations,
+                                             const Violation& violation) {
+  // Emit messages only once per object1<->object2 pair.
+  for (Violation& v : violations) {
+    if (((violation.obj1 == v.obj1) && (violation.obj2 == v.obj2)) ||
+        ((violation.obj1 == v.obj2) && (violation.obj2 == v.obj1))) {
+      // Merge with existing violation.
+      v.layers |= violation.layers;
+      v.clearance = std::max(v.clearance, violation.clearance);
+      v.locations += violation.locations;
+      return;
+    }
+  }
+  violations.append(violation);
+}
+
+RuleCheckMessageList BoardCopperClearanceIndex::createMessages(
+    const QVector<Violation>& violations) {
+  RuleCheckMessageList messages;
+  for (const Violation& violation : violations) {
+    messages.append(std::make_shared<DrcMsgCopperCopperClearanceViolation>(
+        violation.obj1, violation.obj2, violation.layers, violation.clearance,
+        violation.locations));
+  }
+  return messages;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,172 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_BOARDCOPPERCLEARANCEINDEX_H
+#define LIBREPCB_CORE_BOARDCOPPERCLEARANCEINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../../rulecheck/rulecheckmessage.h"
+#include "boarddesignrulecheckdata.h"
+#include "boarddesignrulecheckmessages.h"
+
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class BoardCopperClearanceIndex
+ ******************************************************************************/
+
+/**
+ * @brief Spatial index of all copper objects of a board for fast copper
+ *        clearance checks
+ *
+ * The constructor calculates the copper area and the clearance area of every
+ * copper object contained in the passed data and sorts them into a uniform
+ * grid. This is the expensive part, afterwards the index can be used for:
+ *
+ *   - #checkAll(): The copper clearance check of the whole board, as used by
+ *     ::librepcb::BoardDesignRuleCheck.
+ *   - #checkSegment(): A check restricted to the traces & vias of a single
+ *     net segment, against all objects in their neighbourhood. This is fast
+ *     enough to be run on every mouse move while drawing a trace, with the
+ *     index built only once when starting to draw.
+ *
+ * @note  The index holds its own (implicitly shared) copy of the data, thus
+ *        it can be built in a worker thread and then be used in another one.
+ *        All `const` methods are thread-safe.
+ */
+class BoardCopperClearanceIndex final {
+public:
+  // Types
+  using Data = BoardDesignRuleCheckData;
+  using Object = DrcMsgCopperCopperClearanceViolation::Object;
+  struct Item {
+    Object object;
+    const Layer* startLayer;
+    const Layer* endLayer;
+    std::optional<Uuid> net;  // nullopt = no net
+    std::optional<Uuid> segment;  // nullopt = not part of a net segment
+    Length clearance;  // Either from object, net class or DRC settings.
+    ClipperLib::Paths copperArea;  // Exact copper outlines
+    ClipperLib::Paths clearanceArea;  // Copper outlines + clearance - tolerance
+    ClipperLib::IntRect bounds;  // Bounding box of both areas
+  };
+
+  // Constructors / Destructor
+  BoardCopperClearanceIndex() = delete;
+  BoardCopperClearanceIndex(const BoardCopperClearanceIndex& other) = delete;
+  BoardCopperClearanceIndex(const Data& data,
+                            const PositiveLength& maxArcTolerance);
+  ~BoardCopperClearanceIndex() noexcept;
+
+  // Getters
+  const Data& getData() const noexcept { return mData; }
+  const QVector<Item>& getItems() const noexcept { return mItems; }
+
+  // General Methods
+
+  /**
+   * @brief Check whether any copper clearance is configured at all
+   *
+   * @param data  The data to check.
+   *
+   * @return If `false`, an index built from this data is empty and won't
+   *         report any violation.
+   */
+  static bool isCheckEnabled(const Data& data) noexcept;
+
+  /**
+   * @brief Check the clearances between all indexed copper objects
+   *
+   * @return One message per violating pair of objects.
+   */
+  RuleCheckMessageList checkAll() const;
+
+  /**
+   * @brief Check the clearances of the traces & vias of a net segment
+   *
+   * Only the traces & vias of the passed segment are checked, against all
+   * indexed objects which are not part of the same segment (identified by
+   * its UUID). Thus the segment may contain different (e.g. temporary)
+   * objects than the segment in the indexed data.
+   *
+   * @param segment   The segment to check.
+   *
+   * @return One message per violating pair of objects.
+   */
+  RuleCheckMessageList checkSegment(const Data::Segment& segment) const;
+
+  // Operator Overloadings
+  BoardCopperClearanceIndex& operator=(const BoardCopperClearanceIndex& rhs) =
+      delete;
+
+private:  // Types
+  struct Violation {
+    Object obj1;
+    Object obj2;
+    QSet<const Layer*> layers;
+    Length clearance;
+    QVector<Path> locations;
+  };
+
+private:  // Methods
+  void addSegmentItems(QVector<Item>& items, const Data::Segment& segment,
+                       bool withPads) const;
+  void addPadItems(QVector<Item>& items, const Data::Pad& pad,
+                   const Object& obj, const std::optional<Uuid>& segment) const;
+  Item& addItem(QVector<Item>& items, const Object& obj,
+                const Layer* startLayer, const Layer* endLayer,
+                const std::optional<Uuid>& net,
+                const std::optional<Uuid>& segment,
+                const UnsignedLength& clearance) const;
+  void addToGrid(int index) noexcept;
+  void checkPair(const Item& item1, const Item& item2,
+                 QVector<Violation>& violations) const;
+  Length getClearanceOffset(const Length& clearance) const noexcept;
+  static void updateBounds(Item& item) noexcept;
+  static bool boundsOverlap(const ClipperLib::IntRect& a,
+                            const ClipperLib::IntRect& b) noexcept;
+  static void addViolation(QVector<Violation>& violations,
+                           const Violation& violation);
+  static RuleCheckMessageList createMessages(
+      const QVector<Violation>& violations);
+
+private:  // Data
+  const Data mData;
+  const PositiveLength mMaxArcTolerance;
+  QVector<Item> mItems;
+  QHash<quint64, QVector<int>> mGrid;  ///< Item indices per grid cell
+  QVector<int> mLargeItems;  ///< Items too large to be put into the grid
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -26,13 +26,15 @@
 #include "../../../geometry/via.h"
 #include "../../../types/layer.h"
 #include "../../../utils/clipperhelpers.h"
+#include "../../../utils/taskscheduler.h"
+#include "../../../utils/tracer.h"
 #include "../board.h"
 #include "../boardplanefragmentsbuilder.h"
 #include "boardclipperpathgenerator.h"
+#include "boardcopperclearanceindex.h"
 #include "boarddesignrulecheckmessages.h"
 #include "polyclipping/clipper.hpp"
 
-#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -40,6 +42,11 @@
  ******************************************************************************/
 namespace librepcb {
 
+static TaskScheduler::Priority getTaskPriority(bool quick) noexcept {
+  return quick ? TaskScheduler::Priority::Interactive
+               : TaskScheduler::Priority::Normal;
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -68,11 +75,13 @@ void BoardDesignRuleCheck::start(Board& board,
   // Start time measurement.
   auto timer = std::make_shared<QElapsedTimer>();
   timer->start();
+  LIBREPCB_TRACE_ZONE("DRC::start");
 
   // Force rebuilding planes. Not parallelized with DRC check yet because
   // it's very tricky. Planes haven an impact on air wires which we have
   // to collect right now as the board cannot be accessed later from a thread.
   if (!quick) {
+    LIBREPCB_TRACE_ZONE("DRC::rebuildPlanes");
     emitStatus(tr("Rebuild planes..."));
     BoardPlaneFragmentsBuilder builder;
     if (builder.start(board)) {
@@ -86,16 +95,24 @@ void BoardDesignRuleCheck::start(Board& board,
   // but this has not been parallelized yet so we have to run it synchronously
   // in the main thread now.
   if (!quick) {
+    LIBREPCB_TRACE_ZONE("DRC::rebuildAirWires");
     board.forceAirWiresRebuild();
   }
   emitProgress(10);
 
   // Copy all relevant data for thread-safe access.
-  std::shared_ptr<Data> data = std::make_shared<Data>(board, settings, quick);
+  std::shared_ptr<Data> data;
+  {
+    LIBREPCB_TRACE_ZONE("DRC::copyBoardData");
+    data = std::make_shared<Data>(board, settings, quick);
+  }
   emitProgress(12);
 
-  // Pass data to new thread.
-  mFuture = QtConcurrent::run(&BoardDesignRuleCheck::run, this, data, timer);
+  // Pass data to new thread. The quick check is run while the user is editing
+  // the board, thus it has a higher priority than a full DRC.
+  mFuture = TaskScheduler::instance().run(
+      TaskScheduler::Group::Drc, getTaskPriority(quick),
+      [this, data, timer]() { return run(data, timer); });
 }
 
 bool BoardDesignRuleCheck::isRunning() const noexcept {
@@ -149,6 +166,7 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::tryRunJob(
 BoardDesignRuleCheck::Result BoardDesignRuleCheck::run(
     std::shared_ptr<const Data> data,
     std::shared_ptr<QElapsedTimer> timer) noexcept {
+  LIBREPCB_TRACE_ZONE("DRC::run");
   emitProgress(15);
 
   // Prepare calculated job data.
@@ -201,11 +219,13 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::run(
       result.messages.append(jobResult.messages);
       result.errors.append(jobResult.errors);
     }
-    void start() {
-      future = QtConcurrent::run(
+    void start(TaskScheduler::Priority priority) {
+      future = TaskScheduler::instance().run(
+          TaskScheduler::Group::Drc, priority,
           std::bind(&BoardDesignRuleCheck::tryRunJob, drc, function, weight));
     }
     void fetchResult(Result& result) {
+      TaskScheduler::instance().waitForFinished(future);
       const Result jobResult = future.result();
       result.messages.append(jobResult.messages);
       result.errors.append(jobResult.errors);
@@ -303,7 +323,7 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::run(
   // because they are at the front of the list.
   for (Job& job : jobs) {
     if ((job.stage == Stage::Stage1) || (job.stage == Stage::Independent)) {
-      job.start();
+      job.start(getTaskPriority(data->quick));
     }
   }
 
@@ -319,7 +339,7 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::run(
   // Start all stage 2 jobs.
   for (Job& job : jobs) {
     if (job.stage == Stage::Stage2) {
-      job.start();
+      job.start(getTaskPriority(data->quick));
     }
   }
 
@@ -339,6 +359,7 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::run(
 
   // Finished!
   result.elapsedTimeMs = timer->elapsed();
+  LIBREPCB_TRACE_COUNTER("DRC messages", result.messages.count());
   qDebug() << (data->quick ? "Quick check" : "DRC")
            << (result.errors.isEmpty() ? "succeeded" : "failed") << "after"
            << result.elapsedTimeMs << "ms.";
@@ -353,6 +374,7 @@ BoardDesignRuleCheck::Result BoardDesignRuleCheck::run(
 void BoardDesignRuleCheck::prepareCopperPaths(const Data& data,
                                               CalculatedJobData& calcData,
                                               const Layer& layer) {
+  LIBREPCB_TRACE_ZONE("DRC::prepareCopperPaths");
   emitStatus(tr("Prepare '%1'...").arg(layer.getNameTr()));
   BoardClipperPathGenerator gen(maxArcTolerance());
   gen.addCopper(data, layer, {}, data.quick);
@@ -362,349 +384,21 @@ void BoardDesignRuleCheck::prepareCopperPaths(const Data& data,
 
 RuleCheckMessageList BoardDesignRuleCheck::checkCopperCopperClearances(
     const Data& data) {
-  RuleCheckMessageList messages;
+  LIBREPCB_TRACE_ZONE("DRC::checkCopperCopperClearances");
 
   // Skip this check if no minimum copper clearances are configured.
-  bool anyClearanceSet = data.settings.getMinCopperCopperClearance() > 0;
-  for (const auto& nc : data.netClasses) {
-    if (nc.minCopperCopperClearance > 0) {
-      anyClearanceSet = true;
-    }
-  }
-  if (!anyClearanceSet) {
-    return messages;
+  if (!BoardCopperClearanceIndex::isCheckEnabled(data)) {
+    return RuleCheckMessageList();
   }
 
   emitStatus(tr("Check copper clearances..."));
-
-  // Subtract a tolerance to avoid false-positives due to inaccuracies.
-  const Length tolerance = maxArcTolerance() + Length(1);
-
-  // Determine the area of each copper object.
-  struct Item {
-    DrcMsgCopperCopperClearanceViolation::Object object;
-    const Layer* startLayer;
-    const Layer* endLayer;
-    std::optional<Uuid> net;  // nullopt = no net
-    Length clearance;  // Either from object, net class or DRC settings.
-    ClipperLib::Paths copperArea;  // Exact copper outlines
-    ClipperLib::Paths clearanceArea;  // Copper outlines + clearance - tolerance
-  };
-  typedef QList<Item> Items;
-  Items items;
-
-  // Helper for pads.
-  BoardClipperPathGenerator gen(maxArcTolerance());
-  auto addPad = [&](const Data::Pad& pad,
-                    const DrcMsgCopperCopperClearanceViolation::Object& obj) {
-    const UnsignedLength padClearance = std::max(
-        pad.copperClearance, data.getMinCopperCopperClearance(pad.netClass));
-    for (const Layer* layer : data.copperLayers) {
-      if (!pad.geometries.value(layer).isEmpty()) {
-        auto it = items.insert(
-            items.end(),
-            Item{obj, layer, layer, pad.net, *padClearance, {}, {}});
-        gen.addPad(pad, *layer);
-        gen.takePathsTo(it->copperArea);
-        gen.addPad(pad, *layer, std::max(padClearance - tolerance, Length(0)));
-        gen.takePathsTo(it->clearanceArea);
-      }
-    }
-  };
-
-  // Net segments.
-  for (const Data::Segment& ns : data.segments) {
-    const UnsignedLength clearance =
-        data.getMinCopperCopperClearance(ns.netClass);
-
-    // Pads.
-    for (const Data::Pad& pad : ns.pads) {
-      addPad(pad, DrcMsgCopperCopperClearanceViolation::Object::pad(pad, ns));
-    }
-
-    // vias.
-    for (const Data::Via& via : ns.vias) {
-      auto it = items.insert(
-          items.end(),
-          Item{DrcMsgCopperCopperClearanceViolation::Object::via(via, ns),
-               via.startLayer,
-               via.endLayer,
-               ns.net,
-               *clearance,
-               {},
-               {}});
-      gen.addVia(via);
-      gen.takePathsTo(it->copperArea);
-      gen.addVia(via, std::max(clearance - tolerance, Length(0)));
-      gen.takePathsTo(it->clearanceArea);
-    }
-
-    // Net lines.
-    for (const Data::Trace& trace : ns.traces) {
-      if (data.copperLayers.contains(trace.layer)) {
-        auto it = items.insert(
-            items.end(),
-            Item{DrcMsgCopperCopperClearanceViolation::Object::trace(trace, ns),
-                 trace.layer,
-                 trace.layer,
-                 ns.net,
-                 *clearance,
-                 {},
-                 {}});
-        gen.addTrace(trace);
-        gen.takePathsTo(it->copperArea);
-        gen.addTrace(trace, std::max(clearance - tolerance, Length(0)));
-        gen.takePathsTo(it->clearanceArea);
-      }
-    }
-  }
-
-  // Planes.
-  if (!data.quick) {
-    for (const Data::Plane& plane : data.planes) {
-      if (data.copperLayers.contains(plane.layer)) {
-        const UnsignedLength clearance =
-            data.getMinCopperCopperClearance(plane.netClass);
-        auto it = items.insert(
-            items.end(),
-            Item{DrcMsgCopperCopperClearanceViolation::Object::plane(plane),
-                 plane.layer,
-                 plane.layer,
-                 plane.net,
-                 *clearance,
-                 {},
-                 {}});
-        gen.addPlane(plane.fragments);
-        gen.takePathsTo(it->copperArea);
-        it->clearanceArea = it->copperArea;
-        ClipperHelpers::offset(it->clearanceArea,
-                               std::max(clearance - tolerance, Length(0)),
-                               maxArcTolerance());
-      }
-    }
-  }
-
-  // Board polygons.
-  for (const Data::Polygon& polygon : data.polygons) {
-    if (data.copperLayers.contains(polygon.layer)) {
-      const UnsignedLength clearance =
-          data.settings.getMinCopperCopperClearance();
-      auto it = items.insert(
-          items.end(),
-          Item{DrcMsgCopperCopperClearanceViolation::Object::polygon(polygon,
-                                                                     nullptr),
-               polygon.layer,
-               polygon.layer,
-               std::nullopt,
-               *clearance,
-               {},
-               {}});
-      gen.addPolygon(polygon.path, polygon.lineWidth, polygon.filled);
-      gen.takePathsTo(it->copperArea);
-      it->clearanceArea = it->copperArea;
-      ClipperHelpers::offset(it->clearanceArea,
-                             std::max(clearance - tolerance, Length(0)),
-                             maxArcTolerance());
-    }
-  }
-
-  // Board stroke texts.
-  for (const Data::StrokeText& st : data.strokeTexts) {
-    if (data.copperLayers.contains(st.layer)) {
-      const UnsignedLength clearance =
-          data.settings.getMinCopperCopperClearance();
-      auto it = items.insert(
-          items.end(),
-          Item{DrcMsgCopperCopperClearanceViolation::Object::strokeText(
-                   st, nullptr),
-               st.layer,
-               st.layer,
-               std::nullopt,
-               *clearance,
-               {},
-               {}});
-      gen.addStrokeText(st);
-      gen.takePathsTo(it->copperArea);
-      gen.addStrokeText(st, std::max(clearance - tolerance, Length(0)));
-      gen.takePathsTo(it->clearanceArea);
-    }
-  }
-
-  // Devices.
-  for (const Data::Device& dev : data.devices) {
-    const Transform transform(dev.position, dev.rotation, dev.mirror);
-
-    // Pads.
-    for (const Data::Pad& pad : dev.pads) {
-      addPad(
-          pad,
-          DrcMsgCopperCopperClearanceViolation::Object::footprintPad(pad, dev));
-    }
-
-    // Polygons.
-    for (const Data::Polygon& polygon : dev.polygons) {
-      const Layer& layer = transform.map(*polygon.layer);
-      if (data.copperLayers.contains(&layer)) {
-        const UnsignedLength clearance =
-            data.settings.getMinCopperCopperClearance();
-        auto it = items.insert(
-            items.end(),
-            Item{DrcMsgCopperCopperClearanceViolation::Object::polygon(polygon,
-                                                                       &dev),
-                 &layer,
-                 &layer,
-                 std::nullopt,
-                 *clearance,
-                 {},
-                 {}});
-        gen.addPolygon(transform.map(polygon.path), polygon.lineWidth,
-                       polygon.filled);
-        gen.takePathsTo(it->copperArea);
-        it->clearanceArea = it->copperArea;
-        ClipperHelpers::offset(it->clearanceArea,
-                               std::max(clearance - tolerance, Length(0)),
-                               maxArcTolerance());
-      }
-    }
-
-    // Circles.
-    for (const Data::Circle& circle : dev.circles) {
-      const Layer& layer = transform.map(*circle.layer);
-      if (data.copperLayers.contains(&layer)) {
-        const UnsignedLength clearance =
-            data.settings.getMinCopperCopperClearance();
-        auto it = items.insert(
-            items.end(),
-            Item{DrcMsgCopperCopperClearanceViolation::Object::circle(circle,
-                                                                      &dev),
-                 &layer,
-                 &layer,
-                 std::nullopt,
-                 *clearance,
-                 {},
-                 {}});
-        gen.addCircle(circle, transform);
-        gen.takePathsTo(it->copperArea);
-        gen.addCircle(circle, transform,
-                      std::max(clearance - tolerance, Length(0)));
-        gen.takePathsTo(it->clearanceArea);
-      }
-    }
-
-    // Stroke texts.
-    for (const Data::StrokeText& st : dev.strokeTexts) {
-      // Layer does not need to be transformed!
-      if (data.copperLayers.contains(st.layer)) {
-        const UnsignedLength clearance =
-            data.settings.getMinCopperCopperClearance();
-        auto it = items.insert(
-            items.end(),
-            Item{DrcMsgCopperCopperClearanceViolation::Object::strokeText(st,
-                                                                          &dev),
-                 st.layer,
-                 st.layer,
-                 std::nullopt,
-                 *clearance,
-                 {},
-                 {}});
-        gen.addStrokeText(st);
-        gen.takePathsTo(it->copperArea);
-        gen.addStrokeText(st, std::max(clearance - tolerance, Length(0)));
-        gen.takePathsTo(it->clearanceArea);
-      }
-    }
-  }
-
-  // Helper to check for overlapping layer spans.
-  QSet<const Layer*> overlappingLayers;
-  auto layersOverlap = [&data, &overlappingLayers](
-                           const Layer* start1, const Layer* end1,
-                           const Layer* start2, const Layer* end2) {
-    overlappingLayers.clear();
-    const int first =
-        std::max(start1->getCopperNumber(), start2->getCopperNumber());
-    const int last = std::min(end1->getCopperNumber(), end2->getCopperNumber());
-    for (int i = first; i <= last; ++i) {
-      const Layer* layer = Layer::copper(i);
-      if (data.copperLayers.contains(layer)) {
-        overlappingLayers.insert(layer);
-      }
-    }
-    return !overlappingLayers.isEmpty();
-  };
-
-  // Helper to check for intersections.
-  auto checkForIntersections = [](Items::Iterator& it1, Items::Iterator& it2,
-                                  QVector<Path>& locations) {
-    const std::unique_ptr<ClipperLib::PolyTree> intersections =
-        ClipperHelpers::intersectToTree(it1->copperArea, it2->clearanceArea,
-                                        ClipperLib::pftEvenOdd,
-                                        ClipperLib::pftEvenOdd);
-    locations.append(
-        ClipperHelpers::convert(ClipperHelpers::flattenTree(*intersections)));
-  };
-
-  // Structure to memorize violations since we want to
-  // emit messages only once per object1<->object2 pair.
-  struct Violation {
-    DrcMsgCopperCopperClearanceViolation::Object obj1;
-    DrcMsgCopperCopperClearanceViolation::Object obj2;
-    QSet<const Layer*> layers;
-    Length clearance;
-    QVector<Path> locations;
-  };
-  QVector<Violation> violations;
-  auto addViolation = [&violations](const Violation& violation) {
-    for (Violation& v : violations) {
-      if (((violation.obj1 == v.obj1) && (violation.obj2 == v.obj2)) ||
-          ((violation.obj1 == v.obj2) && (violation.obj2 == v.obj1))) {
-        // Merge with existing violation.
-        v.layers |= violation.layers;
-        v.clearance = std::max(v.clearance, violation.clearance);
-        v.locations += violation.locations;
-        return;
-      }
-    }
-    violations.append(violation);
-  };
-
-  // Now check for intersections.
-  auto lastItem = items.isEmpty() ? items.end() : std::prev(items.end());
-  for (auto it1 = items.begin(); it1 != lastItem; it1++) {
-    for (auto it2 = it1 + 1; it2 != items.end(); it2++) {
-      if (((it1->clearance > 0) || (it2->clearance > 0)) &&
-          ((it1->net != it2->net) || (!it1->net) || (!it2->net)) &&
-          layersOverlap(it1->startLayer, it1->endLayer, it2->startLayer,
-                        it2->endLayer)) {
-        QVector<Path> locations;
-        checkForIntersections(it1, it2, locations);
-        // Perform the check the other way around only if:
-        //  - Either the two items have individual clearances
-        //  - Or there are any intersections -> show both violations in UI
-        if ((it1->clearance != it2->clearance) || (!locations.isEmpty())) {
-          checkForIntersections(it2, it1, locations);
-        }
-        if (!locations.isEmpty()) {
-          addViolation(Violation{it1->object, it2->object, overlappingLayers,
-                                 std::max(it1->clearance, it2->clearance),
-                                 locations});
-        }
-      }
-    }
-  }
-
-  // Emit messages.
-  for (const Violation& violation : violations) {
-    messages.append(std::make_shared<DrcMsgCopperCopperClearanceViolation>(
-        violation.obj1, violation.obj2, violation.layers, violation.clearance,
-        violation.locations));
-  }
-
-  return messages;
+  const BoardCopperClearanceIndex index(data, maxArcTolerance());
+  return index.checkAll();
 }
 
 RuleCheckMessageList BoardDesignRuleCheck::checkCopperBoardClearances(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkCopperBoardClearances");
   RuleCheckMessageList messages;
 
   const UnsignedLength clearance = data.settings.getMinCopperBoardClearance();
@@ -868,6 +562,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkCopperBoardClearances(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkCopperHoleClearances(
     const Data& data, const CalculatedJobData& calcData) {
+  LIBREPCB_TRACE_ZONE("DRC::checkCopperHoleClearances");
   RuleCheckMessageList messages;
 
   const UnsignedLength clearance = data.settings.getMinCopperNpthClearance();
@@ -925,6 +620,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkCopperHoleClearances(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkDrillDrillClearances(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkDrillDrillClearances");
   RuleCheckMessageList messages;
 
   const UnsignedLength clearance = data.settings.getMinDrillDrillClearance();
@@ -1019,6 +715,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkDrillDrillClearances(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkDrillBoardClearances(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkDrillBoardClearances");
   RuleCheckMessageList messages;
 
   const UnsignedLength clearance = data.settings.getMinDrillBoardClearance();
@@ -1106,6 +803,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkDrillBoardClearances(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkSilkscreenStopmaskClearances(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkSilkscreenStopmaskClearances");
   RuleCheckMessageList messages;
 
   const UnsignedLength clearance =
@@ -1199,6 +897,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkSilkscreenStopmaskClearances(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkMinimumCopperWidth(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkMinimumCopperWidth");
   RuleCheckMessageList messages;
   emitStatus(tr("Check copper widths..."));
   checkMinimumWidth(messages, data, data.settings.getMinCopperWidth(),
@@ -1210,6 +909,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkMinimumCopperWidth(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkMinimumPthAnnularRing(
     const Data& data, const CalculatedJobData& calcData) {
+  LIBREPCB_TRACE_ZONE("DRC::checkMinimumPthAnnularRing");
   RuleCheckMessageList messages;
 
   const UnsignedLength annularWidth = data.settings.getMinPthAnnularRing();
@@ -1294,6 +994,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkMinimumPthAnnularRing(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkMinimumNpthDrillDiameter(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkMinimumNpthDrillDiameter");
   RuleCheckMessageList messages;
 
   const UnsignedLength minDiameter = data.settings.getMinNpthDrillDiameter();
@@ -1330,6 +1031,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkMinimumNpthDrillDiameter(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkMinimumNpthSlotWidth(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkMinimumNpthSlotWidth");
   RuleCheckMessageList messages;
 
   const UnsignedLength minWidth = data.settings.getMinNpthSlotWidth();
@@ -1365,6 +1067,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkMinimumNpthSlotWidth(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkMinimumPthDrillDiameter(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkMinimumPthDrillDiameter");
   RuleCheckMessageList messages;
   emitStatus(tr("Check PTH drill diameters..."));
   const UnsignedLength minDiameter = data.settings.getMinPthDrillDiameter();
@@ -1416,6 +1119,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkMinimumPthDrillDiameter(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkMinimumPthSlotWidth(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkMinimumPthSlotWidth");
   RuleCheckMessageList messages;
 
   const UnsignedLength minWidth = data.settings.getMinPthSlotWidth();
@@ -1460,6 +1164,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkMinimumPthSlotWidth(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkMinimumSilkscreenWidth(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkMinimumSilkscreenWidth");
   RuleCheckMessageList messages;
 
   const UnsignedLength minWidth = data.settings.getMinSilkscreenWidth();
@@ -1478,6 +1183,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkMinimumSilkscreenWidth(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkMinimumSilkscreenTextHeight(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkMinimumSilkscreenTextHeight");
   RuleCheckMessageList messages;
 
   const UnsignedLength minHeight = data.settings.getMinSilkscreenTextHeight();
@@ -1507,6 +1213,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkMinimumSilkscreenTextHeight(
 }
 
 RuleCheckMessageList BoardDesignRuleCheck::checkZones(const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkZones");
   RuleCheckMessageList messages;
   emitStatus(tr("Check keepout zones..."));
 
@@ -1763,6 +1470,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkZones(const Data& data) {
 }
 
 RuleCheckMessageList BoardDesignRuleCheck::checkVias(const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkVias");
   RuleCheckMessageList messages;
   emitStatus(tr("Check for useless or disallowed vias..."));
 
@@ -1796,6 +1504,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkVias(const Data& data) {
 
 RuleCheckMessageList BoardDesignRuleCheck::checkAllowedNpthSlots(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkAllowedNpthSlots");
   RuleCheckMessageList messages;
   emitStatus(tr("Check for disallowed NPTH slots..."));
 
@@ -1829,6 +1538,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkAllowedNpthSlots(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkAllowedPthSlots(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkAllowedPthSlots");
   RuleCheckMessageList messages;
   emitStatus(tr("Check for disallowed PTH slots..."));
 
@@ -1869,6 +1579,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkAllowedPthSlots(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkInvalidPadConnections(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkInvalidPadConnections");
   RuleCheckMessageList messages;
   emitStatus(tr("Check pad connections..."));
 
@@ -1914,6 +1625,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkInvalidPadConnections(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkDeviceClearances(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkDeviceClearances");
   RuleCheckMessageList messages;
   emitStatus(tr("Check device clearances..."));
 
@@ -1969,6 +1681,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkDeviceClearances(
 }
 
 RuleCheckMessageList BoardDesignRuleCheck::checkBoardOutline(const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkBoardOutline");
   RuleCheckMessageList messages;
   emitStatus(tr("Check board outline..."));
 
@@ -2047,6 +1760,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkBoardOutline(const Data& data) {
 
 RuleCheckMessageList BoardDesignRuleCheck::checkBoardCutouts(
     const Data& data, const CalculatedJobData& calcData) {
+  LIBREPCB_TRACE_ZONE("DRC::checkBoardCutouts");
   RuleCheckMessageList messages;
   emitStatus(tr("Check board cutouts..."));
 
@@ -2177,6 +1891,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkBoardCutouts(
 }
 
 RuleCheckMessageList BoardDesignRuleCheck::checkUsedLayers(const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkUsedLayers");
   emitStatus(tr("Check used layers..."));
 
   // Determine all used copper layers.
@@ -2237,6 +1952,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkUsedLayers(const Data& data) {
 
 RuleCheckMessageList BoardDesignRuleCheck::checkForUnplacedComponents(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkForUnplacedComponents");
   // The actual check is already done in start(), so we only need to create the
   // messages.
   RuleCheckMessageList messages;
@@ -2251,6 +1967,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkForUnplacedComponents(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkForMissingConnections(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkForMissingConnections");
   emitStatus(tr("Check for missing connections..."));
 
   auto convertAnchor = [&data](const Data::AirWireAnchor& anchor) {
@@ -2297,6 +2014,7 @@ RuleCheckMessageList BoardDesignRuleCheck::checkForMissingConnections(
 
 RuleCheckMessageList BoardDesignRuleCheck::checkForStaleObjects(
     const Data& data) {
+  LIBREPCB_TRACE_ZONE("DRC::checkForStaleObjects");
   RuleCheckMessageList messages;
   emitStatus(tr("Check for stale objects..."));
   for (const Data::Segment& ns : data.segments) {
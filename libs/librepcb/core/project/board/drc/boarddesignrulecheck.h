@@ -90,6 +90,13 @@ public:
    */
   void cancel() noexcept;
 
+  /**
+   * Returns the maximum allowed arc tolerance when flattening arcs.
+   */
+  static PositiveLength maxArcTolerance() noexcept {
+    return PositiveLength(5000);
+  }
+
 signals:
   void started();
   void progressPercent(int percent);
@@ -162,13 +169,6 @@ private:  // Methods
   void emitProgress(int percent) noexcept;
   void emitStatus(const QString& status) noexcept;
 
-  /**
-   * Returns the maximum allowed arc tolerance when flattening arcs.
-   */
-  static PositiveLength maxArcTolerance() noexcept {
-    return PositiveLength(5000);
-  }
-
 private:  // Data
   QMutex mMutex;
   int mProgressTotal = 0;  // Only for progress range 20..100%
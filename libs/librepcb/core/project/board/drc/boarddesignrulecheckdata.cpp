@@ -125,30 +125,10 @@ BoardDesignRuleCheckData::BoardDesignRuleCheckData(
                                     np->getNetLines().count()});
     }
     foreach (const BI_NetLine* nl, ns->getNetLines()) {
-      nsd.traces.append(Trace{nl->getUuid(), nl->getP1().getPosition(),
-                              nl->getP2().getPosition(), nl->getWidth(),
-                              &nl->getLayer()});
+      nsd.traces.append(convertTrace(*nl));
     }
     foreach (const BI_Via* biVia, ns->getVias()) {
-      QSet<const Layer*> connectedLayers;
-
-      // Add all the layers of traces directly connected to the current via to
-      // the connectedLayers set. The via may be connected to more layers
-      // through other mechanisms like planes, but identifying those connections
-      // can be expensive, so it's not done here.
-      foreach (const BI_NetLine* nl, biVia->getNetLines()) {
-        connectedLayers.insert(&nl->getLayer());
-      }
-
-      const librepcb::Via& via = biVia->getVia();
-      nsd.vias.insert(
-          biVia->getUuid(),
-          Via{biVia->getUuid(), biVia->getPosition(),
-              biVia->getActualDrillDiameter(), biVia->getActualSize(),
-              connectedLayers, &via.getStartLayer(), &via.getEndLayer(),
-              biVia->getDrillLayerSpan(), via.isBuried(), via.isBlind(),
-              biVia->getStopMaskDiameterTop(),
-              biVia->getStopMaskDiameterBottom()});
+      nsd.vias.insert(biVia->getUuid(), convertVia(*biVia));
     }
     foreach (const BI_Pad* biPad, ns->getPads()) {
       nsd.pads.insert(biPad->getUuid(), convertPad(biPad));
@@ -281,6 +261,43 @@ BoardDesignRuleCheckData::BoardDesignRuleCheckData(
   }
 }
 
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+BoardDesignRuleCheckData::Trace BoardDesignRuleCheckData::convertTrace(
+    const BI_NetLine& netLine) noexcept {
+  return Trace{netLine.getUuid(), netLine.getP1().getPosition(),
+               netLine.getP2().getPosition(), netLine.getWidth(),
+               &netLine.getLayer()};
+}
+
+BoardDesignRuleCheckData::Via BoardDesignRuleCheckData::convertVia(
+    const BI_Via& via) noexcept {
+  // Add all the layers of traces directly connected to the current via to
+  // the connectedLayers set. The via may be connected to more layers
+  // through other mechanisms like planes, but identifying those connections
+  // can be expensive, so it's not done here.
+  QSet<const Layer*> connectedLayers;
+  foreach (const BI_NetLine* nl, via.getNetLines()) {
+    connectedLayers.insert(&nl->getLayer());
+  }
+
+  const librepcb::Via& data = via.getVia();
+  return Via{via.getUuid(),
+             via.getPosition(),
+             via.getActualDrillDiameter(),
+             via.getActualSize(),
+             connectedLayers,
+             &data.getStartLayer(),
+             &data.getEndLayer(),
+             via.getDrillLayerSpan(),
+             data.isBuried(),
+             data.isBlind(),
+             via.getStopMaskDiameterTop(),
+             via.getStopMaskDiameterBottom()};
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -35,6 +35,8 @@
  ******************************************************************************/
 namespace librepcb {
 
+class BI_NetLine;
+class BI_Via;
 class Board;
 class Layer;
 
@@ -201,6 +203,10 @@ struct BoardDesignRuleCheckData final {
                            const BoardDesignRuleCheckSettings& drcSettings,
                            bool quickCheck) noexcept;
 
+  // Static Methods
+  static Trace convertTrace(const BI_NetLine& netLine) noexcept;
+  static Via convertVia(const BI_Via& via) noexcept;
+
   // Helper Methods
   UnsignedLength getMinCopperCopperClearance(
       const std::optional<Uuid> netClass) const noexcept {
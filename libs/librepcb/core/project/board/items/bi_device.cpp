@@ -25,6 +25,7 @@
 #include "../../../library/cmp/component.h"
 #include "../../../library/dev/device.h"
 #include "../../../library/dev/part.h"
+#include "../../../library/pkg/footprint.h"
 #include "../../../library/pkg/package.h"
 #include "../../../library/sym/symbol.h"
 #include "../../../utils/scopeguardlist.h"
@@ -295,16 +296,20 @@ void BI_Device::removeStrokeText(BI_StrokeText& text) {
 
 void BI_Device::setPosition(const Point& pos) noexcept {
   if (pos != mPosition) {
+    addBoundsToBatchUpdateRegion();
     mPosition = pos;
-    onEdited.notify(Event::PositionChanged);
+    addBoundsToBatchUpdateRegion();
+    mBoard.notifyItemEdited(*this, Event::PositionChanged);
     mBoard.invalidatePlanes();
   }
 }
 
 void BI_Device::setRotation(const Angle& rot) noexcept {
   if (rot != mRotation) {
+    addBoundsToBatchUpdateRegion();
     mRotation = rot;
-    onEdited.notify(Event::RotationChanged);
+    addBoundsToBatchUpdateRegion();
+    mBoard.notifyItemEdited(*this, Event::RotationChanged);
     mBoard.invalidatePlanes();
   }
 }
@@ -314,8 +319,10 @@ void BI_Device::setMirrored(bool mirror) {
     if (isUsed()) {
       throw LogicError(__FILE__, __LINE__);
     }
+    addBoundsToBatchUpdateRegion();
     mMirrored = mirror;
-    onEdited.notify(Event::MirroredChanged);
+    addBoundsToBatchUpdateRegion();
+    mBoard.notifyItemEdited(*this, Event::MirroredChanged);
     mBoard.invalidatePlanes();
   }
 }
@@ -446,6 +453,32 @@ void BI_Device::updateHoleStopMaskOffsets() noexcept {
   }
 }
 
+void BI_Device::addBoundsToBatchUpdateRegion() noexcept {
+  if (!mBoard.isBatchUpdateActive()) {
+    return;
+  }
+
+  // Calculating the footprint bounds is expensive, so do it only once.
+  if (!mLibFootprintBounds) {
+    const std::pair<Point, Point> rect =
+        mLibFootprint->calculateBoundingRect(false);
+    Point min = rect.first;
+    Point max = rect.second;
+    for (const FootprintPad& pad : mLibFootprint->getPads()) {
+      // Large enough for any pad rotation.
+      const Length size = std::max(*pad.getWidth(), *pad.getHeight());
+      const Point p1 = pad.getPosition() - Point(size, size);
+      const Point p2 = pad.getPosition() + Point(size, size);
+      min = Point(std::min(min.getX(), p1.getX()),
+                  std::min(min.getY(), p1.getY()));
+      max = Point(std::max(max.getX(), p2.getX()),
+                  std::max(max.getY(), p2.getY()));
+    }
+    mLibFootprintBounds = Path::rect(min, max);
+  }
+  mBoard.addToBatchUpdateRegion(Transform(*this).map(*mLibFootprintBounds));
+}
+
 const QStringList& BI_Device::getLocaleOrder() const noexcept {
   return getProject().getLocaleOrder();
 }
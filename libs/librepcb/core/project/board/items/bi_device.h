@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../../../attribute/attribute.h"
+#include "../../../geometry/path.h"
 #include "../../../geometry/stroketext.h"
 #include "../../../types/uuid.h"
 #include "../../../utils/signalslot.h"
@@ -148,6 +149,7 @@ signals:
 private:
   bool checkAttributesValidity() const noexcept;
   void updateHoleStopMaskOffsets() noexcept;
+  void addBoundsToBatchUpdateRegion() noexcept;
   const QStringList& getLocaleOrder() const noexcept;
 
   // General
@@ -168,6 +170,9 @@ private:
   QMap<Uuid, BI_Pad*> mPads;  ///< key: footprint pad UUID
   QMap<Uuid, BI_StrokeText*> mStrokeTexts;
   QHash<Uuid, std::optional<Length>> mHoleStopMaskOffsets;
+
+  /// Footprint bounds incl. pads, calculated on the first batch update
+  std::optional<Path> mLibFootprintBounds;
 };
 
 /*******************************************************************************
@@ -63,8 +63,12 @@ bool BI_Hole::setDiameter(const PositiveLength& diameter) noexcept {
 }
 
 bool BI_Hole::setPath(const NonEmptyPath& path) noexcept {
+  const NonEmptyPath oldPath = mData.getPath();
   if (mData.setPath(path)) {
-    onEdited.notify(Event::PathChanged);
+    const Length margin = mData.getDiameter() / 2;
+    mBoard.addToBatchUpdateRegion(*oldPath, margin);
+    mBoard.addToBatchUpdateRegion(*path, margin);
+    mBoard.notifyItemEdited(*this, Event::PathChanged);
     mBoard.invalidatePlanes();
     return true;
   } else {
@@ -216,7 +216,14 @@ void BI_NetLine::removeFromBoard() {
 }
 
 void BI_NetLine::updatePositions() noexcept {
-  onEdited.notify(Event::PositionsChanged);
+  addBoundsToBatchUpdateRegion();
+  mBoard.notifyItemEdited(*this, Event::PositionsChanged);
+}
+
+void BI_NetLine::addBoundsToBatchUpdateRegion() noexcept {
+  if (mBoard.isBatchUpdateActive()) {
+    mBoard.addToBatchUpdateRegion(getSceneOutline());
+  }
 }
 
 /*******************************************************************************
@@ -111,6 +111,7 @@ public:
   void addToBoard() override;
   void removeFromBoard() override;
   void updatePositions() noexcept;
+  void addBoundsToBatchUpdateRegion() noexcept;
 
   // Operator Overloadings
   BI_NetLine& operator=(const BI_NetLine& rhs) = delete;
@@ -64,12 +64,18 @@ TraceAnchor BI_NetPoint::toTraceAnchor() const noexcept {
  ******************************************************************************/
 
 void BI_NetPoint::setPosition(const Point& position) noexcept {
+  if (position == mJunction.getPosition()) {
+    return;
+  }
+  foreach (BI_NetLine* netLine, mRegisteredNetLines) {
+    netLine->addBoundsToBatchUpdateRegion();  // Old net line geometry.
+  }
   if (mJunction.setPosition(position)) {
     foreach (BI_NetLine* netLine, mRegisteredNetLines) {
       netLine->updatePositions();
       mBoard.invalidatePlanes(&netLine->getLayer());
     }
-    onEdited.notify(Event::PositionChanged);
+    mBoard.notifyItemEdited(*this, Event::PositionChanged);
     if (NetSignal* netsignal = mNetSegment.getNetSignal()) {
       mBoard.scheduleAirWiresRebuild(netsignal);
     }
@@ -448,9 +448,14 @@ void BI_Pad::updateTransform() noexcept {
   }
 
   if (position != mPosition) {
+    addBoundsToBatchUpdateRegion();
+    foreach (BI_NetLine* netLine, mRegisteredNetLines) {
+      netLine->addBoundsToBatchUpdateRegion();  // Old net line geometry.
+    }
     mPosition = position;
+    addBoundsToBatchUpdateRegion();
     mBoard.scheduleAirWiresRebuild(getNetSignal());
-    onEdited.notify(Event::PositionChanged);
+    mBoard.notifyItemEdited(*this, Event::PositionChanged);
     foreach (BI_NetLine* netLine, mRegisteredNetLines) {
       netLine->updatePositions();
     }
@@ -458,12 +463,12 @@ void BI_Pad::updateTransform() noexcept {
   }
   if (rotation != mRotation) {
     mRotation = rotation;
-    onEdited.notify(Event::RotationChanged);
+    mBoard.notifyItemEdited(*this, Event::RotationChanged);
     invalidatePlanes();
   }
   if (mirrored != mMirrored) {
     mMirrored = mirrored;
-    onEdited.notify(Event::MirroredChanged);
+    mBoard.notifyItemEdited(*this, Event::MirroredChanged);
     updateGeometries();
   }
 }
@@ -521,6 +526,12 @@ void BI_Pad::updateGeometries() noexcept {
   }
 }
 
+void BI_Pad::addBoundsToBatchUpdateRegion() noexcept {
+  // Large enough for any pad rotation.
+  mBoard.addToBatchUpdateRegion(
+      mPosition, std::max(*mProperties.getWidth(), *mProperties.getHeight()));
+}
+
 void BI_Pad::invalidatePlanes() noexcept {
   if (mProperties.isTht()) {
     mBoard.invalidatePlanes();
@@ -180,6 +180,7 @@ private:  // Methods
   void updateTransform() noexcept;
   void updateText() noexcept;
   void updateGeometries() noexcept;
+  void addBoundsToBatchUpdateRegion() noexcept;
   void invalidatePlanes() noexcept;
   QString getLibraryDeviceName() const noexcept;
   QString getComponentInstanceName() const noexcept;
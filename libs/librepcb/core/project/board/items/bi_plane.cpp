@@ -71,8 +71,10 @@ BI_Plane::~BI_Plane() noexcept {
 
 void BI_Plane::setOutline(const Path& outline) noexcept {
   if (outline != mOutline) {
+    mBoard.addToBatchUpdateRegion(mOutline);
     mOutline = outline;
-    onEdited.notify(Event::OutlineChanged);
+    mBoard.addToBatchUpdateRegion(mOutline);
+    mBoard.notifyItemEdited(*this, Event::OutlineChanged);
     mBoard.invalidatePlanes(mLayer);
   }
 }
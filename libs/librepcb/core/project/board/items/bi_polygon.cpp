@@ -70,8 +70,12 @@ bool BI_Polygon::setLineWidth(const UnsignedLength& width) noexcept {
 }
 
 bool BI_Polygon::setPath(const Path& path) noexcept {
+  const Path oldPath = mData.getPath();
   if (mData.setPath(path)) {
-    onEdited.notify(Event::PathChanged);
+    const Length margin = mData.getLineWidth() / 2;
+    mBoard.addToBatchUpdateRegion(oldPath, margin);
+    mBoard.addToBatchUpdateRegion(path, margin);
+    mBoard.notifyItemEdited(*this, Event::PathChanged);
     invalidatePlanes(mData.getLayer());
     return true;
   } else {
@@ -26,6 +26,7 @@
 #include "../../../font/strokefontpool.h"
 #include "../../../font/stroketextpathbuilder.h"
 #include "../../../types/layer.h"
+#include "../../../utils/transform.h"
 #include "../../project.h"
 #include "../../projectattributelookup.h"
 #include "../board.h"
@@ -84,8 +85,11 @@ bool BI_StrokeText::setText(const QString& text) noexcept {
 }
 
 bool BI_StrokeText::setPosition(const Point& pos) noexcept {
+  const Transform oldTransform(mData);
   if (mData.setPosition(pos)) {
-    onEdited.notify(Event::PositionChanged);
+    addBoundsToBatchUpdateRegion(oldTransform);
+    addBoundsToBatchUpdateRegion(Transform(mData));
+    mBoard.notifyItemEdited(*this, Event::PositionChanged);
     invalidatePlanes(mData.getLayer());
     return true;
   } else {
@@ -94,9 +98,12 @@ bool BI_StrokeText::setPosition(const Point& pos) noexcept {
 }
 
 bool BI_StrokeText::setRotation(const Angle& rotation) noexcept {
+  const Transform oldTransform(mData);
   if (mData.setRotation(rotation)) {
-    onEdited.notify(Event::RotationChanged);
+    addBoundsToBatchUpdateRegion(oldTransform);
+    mBoard.notifyItemEdited(*this, Event::RotationChanged);
     updatePaths();  // Auto-rotation might have changed.
+    addBoundsToBatchUpdateRegion(Transform(mData));
     invalidatePlanes(mData.getLayer());
     return true;
   } else {
@@ -153,9 +160,12 @@ bool BI_StrokeText::setAlign(const Alignment& align) noexcept {
 }
 
 bool BI_StrokeText::setMirrored(bool mirrored) noexcept {
+  const Transform oldTransform(mData);
   if (mData.setMirrored(mirrored)) {
-    onEdited.notify(Event::MirroredChanged);
+    addBoundsToBatchUpdateRegion(oldTransform);
+    mBoard.notifyItemEdited(*this, Event::MirroredChanged);
     updatePaths();  // Auto-rotation might have changed.
+    addBoundsToBatchUpdateRegion(Transform(mData));
     invalidatePlanes(mData.getLayer());
     return true;
   } else {
@@ -226,11 +236,16 @@ void BI_StrokeText::removeFromBoard() {
  ******************************************************************************/
 
 void BI_StrokeText::updateText() noexcept {
-  const QString text = AttributeSubstitutor::substitute(
-      mData.getText(),
-      mDevice ? ProjectAttributeLookup(*mDevice,
-                                       mDevice->getParts(std::nullopt).value(0))
-              : ProjectAttributeLookup(mBoard, nullptr));
+  // Texts without any variable don't need to be substituted, which avoids
+  // setting up the attribute lookup on every attribute change.
+  const QString text = (!mData.getText().contains("{{"))
+      ? mData.getText()
+      : AttributeSubstitutor::substitute(
+            mData.getText(),
+            mDevice ? ProjectAttributeLookup(
+                          *mDevice, mDevice->getParts(std::nullopt).value(0))
+                    : ProjectAttributeLookup(mBoard, nullptr));
+  // Only re-stroke the text if the substituted text has actually changed.
   if (text != mSubstitutedText) {
     mSubstitutedText = text;
     updatePaths();
@@ -244,11 +259,21 @@ void BI_StrokeText::updatePaths() noexcept {
       mData.getRotation(), mData.getAutoRotate(), mSubstitutedText);
   if (paths != mPaths) {
     mPaths = paths;
-    onEdited.notify(Event::PathsChanged);
+    mBoard.notifyItemEdited(*this, Event::PathsChanged);
     invalidatePlanes(mData.getLayer());
   }
 }
 
+void BI_StrokeText::addBoundsToBatchUpdateRegion(
+    const Transform& transform) noexcept {
+  if (mBoard.isBatchUpdateActive()) {
+    const Length margin = mData.getStrokeWidth() / 2;
+    for (const Path& path : mPaths) {
+      mBoard.addToBatchUpdateRegion(transform.map(path), margin);
+    }
+  }
+}
+
 void BI_StrokeText::invalidatePlanes(const Layer& layer) noexcept {
   if (layer.isCopper()) {
     mBoard.invalidatePlanes(&layer);
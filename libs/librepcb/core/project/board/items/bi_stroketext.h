@@ -38,6 +38,7 @@ class BI_Device;
 class Board;
 class Path;
 class StrokeFont;
+class Transform;
 
 /*******************************************************************************
  *  Class BI_StrokeText
@@ -102,6 +103,7 @@ public:
 private:  // Methods
   void updateText() noexcept;
   void updatePaths() noexcept;
+  void addBoundsToBatchUpdateRegion(const Transform& transform) noexcept;
   void invalidatePlanes(const Layer& layer) noexcept;
 
 private:  // Data
@@ -122,7 +122,15 @@ void BI_Via::setLayers(const Layer& from, const Layer& to) {
 }
 
 void BI_Via::setPosition(const Point& position) noexcept {
+  if (position == mVia.getPosition()) {
+    return;
+  }
+  addBoundsToBatchUpdateRegion();
+  foreach (BI_NetLine* netLine, mRegisteredNetLines) {
+    netLine->addBoundsToBatchUpdateRegion();  // Old net line geometry.
+  }
   if (mVia.setPosition(position)) {
+    addBoundsToBatchUpdateRegion();
     foreach (BI_NetLine* netLine, mRegisteredNetLines) {
       netLine->updatePositions();
     }
@@ -130,7 +138,7 @@ void BI_Via::setPosition(const Point& position) noexcept {
     if (NetSignal* netsignal = mNetSegment.getNetSignal()) {
       mBoard.scheduleAirWiresRebuild(netsignal);
     }
-    onEdited.notify(Event::PositionChanged);
+    mBoard.notifyItemEdited(*this, Event::PositionChanged);
   }
 }
 
@@ -227,6 +235,10 @@ void BI_Via::updateActualDrillAndSize() noexcept {
   }
 }
 
+void BI_Via::addBoundsToBatchUpdateRegion() noexcept {
+  mBoard.addToBatchUpdateRegion(mVia.getPosition(), mActualSize / 2);
+}
+
 void BI_Via::updateStopMaskDiameters() noexcept {
   Length dia(0);
   if (const auto& value = mVia.getExposureConfig().getOffset()) {
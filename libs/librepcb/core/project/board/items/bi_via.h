@@ -119,6 +119,7 @@ public:
 private:  // Methods
   void updateActualDrillAndSize() noexcept;
   void updateStopMaskDiameters() noexcept;
+  void addBoundsToBatchUpdateRegion() noexcept;
 
 private:  // Data
   Via mVia;
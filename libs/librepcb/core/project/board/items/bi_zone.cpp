@@ -71,8 +71,11 @@ bool BI_Zone::setRules(Zone::Rules rules) noexcept {
 }
 
 bool BI_Zone::setOutline(const Path& outline) noexcept {
+  const Path oldOutline = mData.getOutline();
   if (mData.setOutline(outline)) {
-    onEdited.notify(Event::OutlineChanged);
+    mBoard.addToBatchUpdateRegion(oldOutline);
+    mBoard.addToBatchUpdateRegion(outline);
+    mBoard.notifyItemEdited(*this, Event::OutlineChanged);
     mBoard.invalidatePlanes(mData.getLayers());
     return true;
   } else {
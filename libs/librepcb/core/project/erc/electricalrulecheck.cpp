@@ -22,19 +22,6 @@
  ******************************************************************************/
 #include "electricalrulecheck.h"
 
-#include "../../library/cmp/component.h"
-#include "../../library/cmp/componentsignal.h"
-#include "../circuit/circuit.h"
-#include "../circuit/componentinstance.h"
-#include "../circuit/componentsignalinstance.h"
-#include "../circuit/netclass.h"
-#include "../circuit/netsignal.h"
-#include "../project.h"
-#include "../schematic/items/si_netpoint.h"
-#include "../schematic/items/si_netsegment.h"
-#include "../schematic/items/si_symbol.h"
-#include "../schematic/items/si_symbolpin.h"
-#include "../schematic/schematic.h"
 #include "electricalrulecheckmessages.h"
 
 #include <QtCore>
@@ -48,8 +35,7 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-ElectricalRuleCheck::ElectricalRuleCheck(const Project& project) noexcept
-  : mProject(project) {
+ElectricalRuleCheck::ElectricalRuleCheck() noexcept {
 }
 
 ElectricalRuleCheck::~ElectricalRuleCheck() noexcept {
@@ -59,14 +45,81 @@ ElectricalRuleCheck::~ElectricalRuleCheck() noexcept {
  *  General Methods
  ******************************************************************************/
 
-RuleCheckMessageList ElectricalRuleCheck::runChecks() const {
-  mOpenNetSignals.clear();
+RuleCheckMessageList ElectricalRuleCheck::runChecks(
+    const ElectricalRuleCheckData& data) {
+  // The kept messages can only be re-used if the changes refer to the
+  // snapshot of the last run.
+  const bool incremental = data.baseId && (data.baseId == mDataId);
+  mDataId = std::nullopt;
 
   RuleCheckMessageList msgs;
-  checkNetClasses(msgs);
-  checkNetSignals(msgs);
-  checkComponents(msgs);
-  checkSchematics(msgs);
+  checkNetClasses(data, msgs);
+
+  QSet<Uuid> openNetSignals;
+  QHash<Uuid, RuleCheckMessageList> netSignalMessages;
+  for (const ElectricalRuleCheckData::NetSignal& net : data.netSignals) {
+    if (net.realComponentSignals < 2) {
+      openNetSignals.insert(net.uuid);
+    }
+    RuleCheckMessageList& netMsgs = netSignalMessages[net.uuid];
+    if (incremental && (!data.changes.netSignals.contains(net.uuid)) &&
+        mNetSignalMessages.contains(net.uuid)) {
+      netMsgs = mNetSignalMessages.value(net.uuid);
+    } else {
+      checkNetSignal(data, net, netMsgs);
+    }
+    msgs.append(netMsgs);
+  }
+
+  QHash<Uuid, RuleCheckMessageList> componentMessages;
+  for (const ElectricalRuleCheckData::Component& cmp : data.components) {
+    RuleCheckMessageList& cmpMsgs = componentMessages[cmp.uuid];
+    if (incremental && (!data.changes.components.contains(cmp.uuid)) &&
+        mComponentMessages.contains(cmp.uuid)) {
+      cmpMsgs = mComponentMessages.value(cmp.uuid);
+    } else {
+      checkComponent(cmp, cmpMsgs);
+    }
+    msgs.append(cmpMsgs);
+  }
+
+  // The net segment checks also depend on whether their net is open, thus
+  // schematics containing a net whose state has changed are checked again.
+  const QSet<Uuid> toggledNetSignals =
+      (openNetSignals - mOpenNetSignals) + (mOpenNetSignals - openNetSignals);
+  QHash<Uuid, RuleCheckMessageList> schematicMessages;
+  for (const ElectricalRuleCheckData::Schematic& schematic : data.schematics) {
+    RuleCheckMessageList& schematicMsgs = schematicMessages[schematic.uuid];
+    bool modified = (!incremental) ||
+        data.changes.schematics.contains(schematic.uuid) ||
+        (!mSchematicMessages.contains(schematic.uuid));
+    for (const ElectricalRuleCheckData::NetSegment& segment :
+         schematic.netSegments) {
+      if (toggledNetSignals.contains(segment.net)) {
+        modified = true;
+      }
+    }
+    if (!modified) {
+      schematicMsgs = mSchematicMessages.value(schematic.uuid);
+    } else {
+      for (const ElectricalRuleCheckData::Symbol& symbol : schematic.symbols) {
+        checkSymbol(symbol, schematicMsgs);
+      }
+      for (const ElectricalRuleCheckData::NetSegment& segment :
+           schematic.netSegments) {
+        checkNetSegment(segment, openNetSignals.contains(segment.net),
+                        schematicMsgs);
+      }
+    }
+    msgs.append(schematicMsgs);
+  }
+
+  // Keep only the messages of items which still exist.
+  mNetSignalMessages = netSignalMessages;
+  mComponentMessages = componentMessages;
+  mSchematicMessages = schematicMessages;
+  mOpenNetSignals = openNetSignals;
+  mDataId = data.id;
   return msgs;
 }
 
@@ -74,125 +127,83 @@ RuleCheckMessageList ElectricalRuleCheck::runChecks() const {
  *  Private Methods
  ******************************************************************************/
 
-void ElectricalRuleCheck::checkNetClasses(RuleCheckMessageList& msgs) const {
+void ElectricalRuleCheck::checkNetClasses(const ElectricalRuleCheckData& data,
+                                          RuleCheckMessageList& msgs) {
   // Don't warn if there's only one netclass, as we need one to be used as
   // default when adding a new wire.
-  if (mProject.getCircuit().getNetClasses().count() <= 1) {
+  if (data.netClasses.count() <= 1) {
     return;
   }
 
-  foreach (const NetClass* netClass, mProject.getCircuit().getNetClasses()) {
-    if (!netClass->isUsed()) {
-      msgs.append(std::make_shared<ErcMsgUnusedNetClass>(*netClass));
-    }
-  }
-}
-
-void ElectricalRuleCheck::checkNetSignals(RuleCheckMessageList& msgs) const {
-  foreach (const NetSignal* net, mProject.getCircuit().getNetSignals()) {
-    // Raise a warning if the net signal is connected to less then two component
-    // signals. But do not count component signals of schematic-only components
-    // since these are just "virtual" connections, i.e. not represented by a
-    // real pad (see https://github.com/LibrePCB/LibrePCB/issues/739).
-    const QList<ComponentSignalInstance*>& sigs = net->getComponentSignals();
-    int registeredRealComponentCount = sigs.count();
-    if (registeredRealComponentCount >= 2) {  // Optimization
-      foreach (const ComponentSignalInstance* sig, sigs) {
-        if (sig->getComponentInstance().getLibComponent().isSchematicOnly()) {
-          --registeredRealComponentCount;
-        }
-      }
-    }
-    if (registeredRealComponentCount < 2) {
-      mOpenNetSignals.insert(net);
-      msgs.append(std::make_shared<ErcMsgOpenNet>(*net));
+  for (const ElectricalRuleCheckData::NetClass& netClass : data.netClasses) {
+    if (!netClass.used) {
+      msgs.append(std::make_shared<ErcMsgUnusedNetClass>(netClass));
     }
   }
 }
 
-void ElectricalRuleCheck::checkComponents(RuleCheckMessageList& msgs) const {
-  foreach (const ComponentInstance* cmp,
-           mProject.getCircuit().getComponentInstances()) {
-    checkComponentSignals(*cmp, msgs);
-
-    // Check for unplaced gates.
-    for (const ComponentSymbolVariantItem& gate :
-         cmp->getSymbolVariant().getSymbolItems()) {
-      if (!cmp->getSymbols().contains(gate.getUuid())) {
-        if (gate.isRequired()) {
-          msgs.append(std::make_shared<ErcMsgUnplacedRequiredGate>(*cmp, gate));
-        } else {
-          msgs.append(std::make_shared<ErcMsgUnplacedOptionalGate>(*cmp, gate));
-        }
-      }
-    }
+void ElectricalRuleCheck::checkNetSignal(
+    const ElectricalRuleCheckData& data,
+    const ElectricalRuleCheckData::NetSignal& net, RuleCheckMessageList& msgs) {
+  // Raise a warning if the net signal is connected to less then two component
+  // signals (not counting schematic-only components).
+  if (net.realComponentSignals < 2) {
+    msgs.append(std::make_shared<ErcMsgOpenNet>(net, data.getLocation(net)));
   }
 }
 
-void ElectricalRuleCheck::checkComponentSignals(
-    const ComponentInstance& cmp, RuleCheckMessageList& msgs) const {
-  foreach (const ComponentSignalInstance* sig, cmp.getSignals()) {
+void ElectricalRuleCheck::checkComponent(
+    const ElectricalRuleCheckData::Component& cmp, RuleCheckMessageList& msgs) {
+  for (const ElectricalRuleCheckData::ComponentSignal& sig :
+       cmp.componentSignals) {
     // Check for forced net name conflict.
-    const QString netName =
-        sig->getNetSignal() ? (*sig->getNetSignal()->getName()) : QString();
-    if ((sig->getCompSignal().isRequired()) && (!sig->getNetSignal())) {
-      msgs.append(std::make_shared<ErcMsgUnconnectedRequiredSignal>(*sig));
-    } else if (sig->isNetSignalNameForced() &&
-               (sig->getForcedNetSignalName() != netName)) {
-      msgs.append(std::make_shared<ErcMsgForcedNetSignalNameConflict>(*sig));
+    if (sig.required && (!sig.net)) {
+      msgs.append(std::make_shared<ErcMsgUnconnectedRequiredSignal>(cmp, sig));
+    } else if (sig.forcedNetName && (*sig.forcedNetName != sig.netName)) {
+      msgs.append(
+          std::make_shared<ErcMsgForcedNetSignalNameConflict>(cmp, sig));
     }
   }
-}
-
-void ElectricalRuleCheck::checkSchematics(RuleCheckMessageList& msgs) const {
-  foreach (const Schematic* schematic, mProject.getSchematics()) {
-    checkSymbols(*schematic, msgs);
-    checkNetSegments(*schematic, msgs);
-  }
-}
 
-void ElectricalRuleCheck::checkSymbols(const Schematic& schematic,
-                                       RuleCheckMessageList& msgs) const {
-  foreach (const SI_Symbol* symbol, schematic.getSymbols()) {
-    checkPins(*symbol, msgs);
+  // Check for unplaced gates.
+  for (const ElectricalRuleCheckData::Gate& gate : cmp.gates) {
+    if (!gate.placed) {
+      if (gate.required) {
+        msgs.append(std::make_shared<ErcMsgUnplacedRequiredGate>(cmp, gate));
+      } else {
+        msgs.append(std::make_shared<ErcMsgUnplacedOptionalGate>(cmp, gate));
+      }
+    }
   }
 }
 
-void ElectricalRuleCheck::checkPins(const SI_Symbol& symbol,
-                                    RuleCheckMessageList& msgs) const {
-  foreach (const SI_SymbolPin* pin, symbol.getPins()) {
-    if ((pin->getNetLines().isEmpty()) && (pin->getCompSigInstNetSignal())) {
-      msgs.append(std::make_shared<ErcMsgConnectedPinWithoutWire>(*pin));
+void ElectricalRuleCheck::checkSymbol(
+    const ElectricalRuleCheckData::Symbol& symbol, RuleCheckMessageList& msgs) {
+  for (const ElectricalRuleCheckData::Pin& pin : symbol.pins) {
+    if ((!pin.hasWires) && pin.hasNet) {
+      msgs.append(std::make_shared<ErcMsgConnectedPinWithoutWire>(symbol, pin));
     }
   }
 }
 
-void ElectricalRuleCheck::checkNetSegments(const Schematic& schematic,
-                                           RuleCheckMessageList& msgs) const {
-  foreach (const SI_NetSegment* netSegment, schematic.getNetSegments()) {
-    checkNetPoints(*netSegment, msgs);
-
-    // If there are no net labels, check for any open wire. But only if there's
-    // no "open net" warning on the net raised, since this would be quite a
-    // duplicate warning.
-    if (netSegment->getNetLabels().isEmpty() &&
-        (!mOpenNetSignals.contains(&netSegment->getNetSignal()))) {
-      foreach (const SI_NetLine* netLine, netSegment->getNetLines()) {
-        if (netLine->getP1().isOpen() || netLine->getP2().isOpen()) {
-          msgs.append(
-              std::make_shared<ErcMsgOpenWireInSegment>(*netSegment, *netLine));
-          break;
-        }
-      }
+void ElectricalRuleCheck::checkNetSegment(
+    const ElectricalRuleCheckData::NetSegment& seg, bool isOpenNet,
+    RuleCheckMessageList& msgs) {
+  for (const ElectricalRuleCheckData::NetPoint& netPoint : seg.netPoints) {
+    if (!netPoint.hasWires) {
+      msgs.append(std::make_shared<ErcMsgUnconnectedJunction>(seg, netPoint));
     }
   }
-}
 
-void ElectricalRuleCheck::checkNetPoints(const SI_NetSegment& netSegment,
-                                         RuleCheckMessageList& msgs) const {
-  foreach (const SI_NetPoint* netPoint, netSegment.getNetPoints()) {
-    if (netPoint->getNetLines().isEmpty()) {
-      msgs.append(std::make_shared<ErcMsgUnconnectedJunction>(*netPoint));
+  // If there are no net labels, check for any open wire. But only if there's
+  // no "open net" warning on the net raised, since this would be quite a
+  // duplicate warning.
+  if ((!seg.hasNetLabels) && (!isOpenNet)) {
+    for (const ElectricalRuleCheckData::NetLine& netLine : seg.netLines) {
+      if (netLine.open) {
+        msgs.append(std::make_shared<ErcMsgOpenWireInSegment>(seg, netLine));
+        break;
+      }
     }
   }
 }
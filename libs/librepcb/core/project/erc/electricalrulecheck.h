@@ -24,56 +24,66 @@
  *  Includes
  ******************************************************************************/
 #include "../../rulecheck/rulecheckmessage.h"
+#include "electricalrulecheckdata.h"
 
 #include <QtCore>
 
+#include <optional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 
-class ComponentInstance;
-class NetSignal;
-class Project;
-class SI_NetSegment;
-class SI_Symbol;
-class Schematic;
-
 /*******************************************************************************
  *  Class ElectricalRuleCheck
  ******************************************************************************/
 
 /**
- * @brief The ElectricalRuleCheck class checks a ::librepcb::Board for
- *        design rule violations
+ * @brief The ElectricalRuleCheck class checks a ::librepcb::Project for
+ *        electrical rule violations
+ *
+ * The checks operate on a ::librepcb::ElectricalRuleCheckData snapshot of the
+ * project, thus they can be run in a worker thread. The messages of the last
+ * run are kept per net signal, component and schematic. If the next snapshot
+ * was created incrementally from the snapshot of the last run, only the
+ * modified items are checked again and the kept messages of all other items
+ * are re-used. Otherwise all items are checked.
+ *
+ * @note A single object must not be used from multiple threads concurrently.
  */
 class ElectricalRuleCheck final {
 public:
   // Constructors / Destructor
-  explicit ElectricalRuleCheck(const Project& project) noexcept;
+  ElectricalRuleCheck() noexcept;
+  ElectricalRuleCheck(const ElectricalRuleCheck& other) = delete;
   ~ElectricalRuleCheck() noexcept;
 
   // General Methods
-  RuleCheckMessageList runChecks() const;
+  RuleCheckMessageList runChecks(const ElectricalRuleCheckData& data);
+
+  // Operator Overloadings
+  ElectricalRuleCheck& operator=(const ElectricalRuleCheck& rhs) = delete;
 
 private:  // Methods
-  void checkNetClasses(RuleCheckMessageList& msgs) const;
-  void checkNetSignals(RuleCheckMessageList& msgs) const;
-  void checkComponents(RuleCheckMessageList& msgs) const;
-  void checkComponentSignals(const ComponentInstance& cmp,
-                             RuleCheckMessageList& msgs) const;
-  void checkSchematics(RuleCheckMessageList& msgs) const;
-  void checkSymbols(const Schematic& schematic,
-                    RuleCheckMessageList& msgs) const;
-  void checkPins(const SI_Symbol& symbol, RuleCheckMessageList& msgs) const;
-  void checkNetSegments(const Schematic& schematic,
-                        RuleCheckMessageList& msgs) const;
-  void checkNetPoints(const SI_NetSegment& netSegment,
-                      RuleCheckMessageList& msgs) const;
+  static void checkNetClasses(const ElectricalRuleCheckData& data,
+                              RuleCheckMessageList& msgs);
+  static void checkNetSignal(const ElectricalRuleCheckData& data,
+                             const ElectricalRuleCheckData::NetSignal& net,
+                             RuleCheckMessageList& msgs);
+  static void checkComponent(const ElectricalRuleCheckData::Component& cmp,
+                             RuleCheckMessageList& msgs);
+  static void checkSymbol(const ElectricalRuleCheckData::Symbol& symbol,
+                          RuleCheckMessageList& msgs);
+  static void checkNetSegment(const ElectricalRuleCheckData::NetSegment& seg,
+                              bool isOpenNet, RuleCheckMessageList& msgs);
 
 private:  // Data
-  const Project& mProject;
-  mutable QSet<const NetSignal*> mOpenNetSignals;
+  std::optional<quint64> mDataId;  ///< Snapshot ID of the last run, if any
+  QHash<Uuid, RuleCheckMessageList> mNetSignalMessages;
+  QHash<Uuid, RuleCheckMessageList> mComponentMessages;
+  QHash<Uuid, RuleCheckMessageList> mSchematicMessages;
+  QSet<Uuid> mOpenNetSignals;
 };
 
 /*******************************************************************************
@@ -0,0 +1,306 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "electricalrulecheckdata.h"
+
+#include "../../library/cmp/component.h"
+#include "../../library/cmp/componentsignal.h"
+#include "../../library/cmp/componentsymbolvariantitem.h"
+#include "../../library/sym/symbolpin.h"
+#include "../circuit/circuit.h"
+#include "../circuit/componentinstance.h"
+#include "../circuit/componentsignalinstance.h"
+#include "../circuit/netclass.h"
+#include "../circuit/netsignal.h"
+#include "../project.h"
+#include "../schematic/items/si_netline.h"
+#include "../schematic/items/si_netpoint.h"
+#include "../schematic/items/si_netsegment.h"
+#include "../schematic/items/si_symbol.h"
+#include "../schematic/items/si_symbolpin.h"
+#include "../schematic/schematic.h"
+
+#include <QtCore>
+
+#include <atomic>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Helpers
+ ******************************************************************************/
+
+static quint64 createId() noexcept {
+  static std::atomic<quint64> nextId(0);
+  return nextId++;
+}
+
+template <typename T>
+static QHash<Uuid, const T*> createIndex(const QList<T>& items) noexcept {
+  QHash<Uuid, const T*> index;
+  index.reserve(items.count());
+  for (const T& item : items) {
+    index.insert(item.uuid, &item);
+  }
+  return index;
+}
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ElectricalRuleCheckData::ElectricalRuleCheckData(
+    const Project& project) noexcept
+  : id(createId()), baseId(), changes() {
+  build(project, nullptr);
+}
+
+ElectricalRuleCheckData::ElectricalRuleCheckData(
+    const Project& project, const ElectricalRuleCheckData& base,
+    const Changes& changes) noexcept
+  : id(createId()), baseId(base.id), changes(changes) {
+  build(project, &base);
+}
+
+/*******************************************************************************
+ *  Location Helpers
+ ******************************************************************************/
+
+ElectricalRuleCheckData::Location ElectricalRuleCheckData::getLocation(
+    const NetSignal& net) const noexcept {
+  for (const Schematic& schematic : schematics) {
+    for (const NetSegment& segment : schematic.netSegments) {
+      if ((segment.net == net.uuid) && (!segment.netLines.isEmpty())) {
+        Location location{segment.schematic, {}};
+        for (const NetLine& netLine : segment.netLines) {
+          location.paths.append(Path::obround(
+              netLine.p1, netLine.p2, PositiveLength(netLine.width + 1)));
+        }
+        return location;
+      }
+    }
+  }
+  for (const Component& component : components) {
+    for (const ComponentSignal& signal : component.componentSignals) {
+      if (signal.net == net.uuid) {
+        const Location location = getLocation(component, signal);
+        if (location.schematic) {
+          return location;
+        }
+      }
+    }
+  }
+  return Location();
+}
+
+ElectricalRuleCheckData::Location ElectricalRuleCheckData::getLocation(
+    const Component& component) noexcept {
+  if (!component.symbol) {
+    return Location();
+  }
+  return Location{
+      component.symbol->schematic,
+      {Path::circle(PositiveLength(2000000))
+           .translated(component.symbol->position)},
+  };
+}
+
+ElectricalRuleCheckData::Location ElectricalRuleCheckData::getLocation(
+    const Component& component, const ComponentSignal& signal) noexcept {
+  if (!signal.pin) {
+    return getLocation(component);
+  }
+  return Location{
+      signal.pin->schematic,
+      {Path::circle(PositiveLength(1100000)).translated(signal.pin->position)},
+  };
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void ElectricalRuleCheckData::build(
+    const Project& project, const ElectricalRuleCheckData* base) noexcept {
+  const Circuit& circuit = project.getCircuit();
+
+  // Net classes are few and cheap, thus always read from the project.
+  for (const librepcb::NetClass* netClass : circuit.getNetClasses()) {
+    netClasses.append(NetClass{
+        netClass->getUuid(),
+        *netClass->getName(),
+        netClass->isUsed(),
+    });
+  }
+
+  const QHash<Uuid, const NetSignal*> baseNetSignals =
+      base ? createIndex(base->netSignals) : QHash<Uuid, const NetSignal*>();
+  for (const librepcb::NetSignal* net : circuit.getNetSignals()) {
+    const NetSignal* baseNet = baseNetSignals.value(net->getUuid());
+    if (baseNet && (!changes.netSignals.contains(net->getUuid()))) {
+      netSignals.append(*baseNet);
+    } else {
+      netSignals.append(createNetSignal(*net));
+    }
+  }
+
+  const QHash<Uuid, const Component*> baseComponents =
+      base ? createIndex(base->components) : QHash<Uuid, const Component*>();
+  for (const ComponentInstance* cmp : circuit.getComponentInstances()) {
+    const Component* baseCmp = baseComponents.value(cmp->getUuid());
+    if (baseCmp && (!changes.components.contains(cmp->getUuid()))) {
+      components.append(*baseCmp);
+    } else {
+      components.append(createComponent(*cmp));
+    }
+  }
+
+  const QHash<Uuid, const Schematic*> baseSchematics =
+      base ? createIndex(base->schematics) : QHash<Uuid, const Schematic*>();
+  for (const librepcb::Schematic* sch : project.getSchematics()) {
+    const Schematic* baseSch = baseSchematics.value(sch->getUuid());
+    if (baseSch && (!changes.schematics.contains(sch->getUuid()))) {
+      schematics.append(*baseSch);
+    } else {
+      schematics.append(createSchematic(*sch));
+    }
+  }
+}
+
+ElectricalRuleCheckData::NetSignal ElectricalRuleCheckData::createNetSignal(
+    const librepcb::NetSignal& net) noexcept {
+  // Do not count component signals of schematic-only components since
+  // these are just "virtual" connections, i.e. not represented by a real
+  // pad (see https://github.com/LibrePCB/LibrePCB/issues/739).
+  int realComponentSignals = 0;
+  for (const ComponentSignalInstance* sig : net.getComponentSignals()) {
+    if (!sig->getComponentInstance().getLibComponent().isSchematicOnly()) {
+      ++realComponentSignals;
+    }
+  }
+  return NetSignal{
+      net.getUuid(),
+      *net.getName(),
+      realComponentSignals,
+  };
+}
+
+ElectricalRuleCheckData::Component ElectricalRuleCheckData::createComponent(
+    const ComponentInstance& cmp) noexcept {
+  Component component{
+      cmp.getUuid(),
+      *cmp.getName(),
+      {},
+      {},
+      std::nullopt,
+  };
+  for (const SI_Symbol* sym : cmp.getSymbols()) {
+    component.symbol =
+        Anchor{sym->getSchematic().getUuid(), sym->getPosition()};
+    break;
+  }
+  for (const ComponentSignalInstance* sig : cmp.getSignals()) {
+    const librepcb::NetSignal* net = sig->getNetSignal();
+    std::optional<Anchor> pin;
+    for (const SI_SymbolPin* symbolPin : sig->getRegisteredSymbolPins()) {
+      pin = Anchor{symbolPin->getSchematic().getUuid(),
+                   symbolPin->getPosition()};
+      break;
+    }
+    component.componentSignals.append(ComponentSignal{
+        sig->getCompSignal().getUuid(),
+        *sig->getCompSignal().getName(),
+        sig->getCompSignal().isRequired(),
+        net ? std::make_optional(net->getUuid()) : std::nullopt,
+        net ? (*net->getName()) : QString(),
+        sig->isNetSignalNameForced()
+            ? std::make_optional(sig->getForcedNetSignalName())
+            : std::nullopt,
+        pin,
+    });
+  }
+  for (const ComponentSymbolVariantItem& gate :
+       cmp.getSymbolVariant().getSymbolItems()) {
+    component.gates.append(Gate{
+        gate.getUuid(),
+        *gate.getSuffix(),
+        gate.isRequired(),
+        cmp.getSymbols().contains(gate.getUuid()),
+    });
+  }
+  return component;
+}
+
+ElectricalRuleCheckData::Schematic ElectricalRuleCheckData::createSchematic(
+    const librepcb::Schematic& sch) noexcept {
+  Schematic schematic{sch.getUuid(), {}, {}};
+  for (const SI_Symbol* sym : sch.getSymbols()) {
+    Symbol symbol{sym->getUuid(), sch.getUuid(), sym->getName(), {}};
+    for (const SI_SymbolPin* pin : sym->getPins()) {
+      symbol.pins.append(Pin{
+          pin->getLibPin().getUuid(),
+          pin->getName(),
+          pin->getPosition(),
+          !pin->getNetLines().isEmpty(),
+          pin->getCompSigInstNetSignal() != nullptr,
+      });
+    }
+    schematic.symbols.append(symbol);
+  }
+  for (const SI_NetSegment* seg : sch.getNetSegments()) {
+    NetSegment segment{
+        seg->getUuid(),
+        sch.getUuid(),
+        seg->getNetSignal().getUuid(),
+        *seg->getNetSignal().getName(),
+        !seg->getNetLabels().isEmpty(),
+        {},
+        {},
+    };
+    for (const SI_NetLine* netLine : seg->getNetLines()) {
+      segment.netLines.append(NetLine{
+          netLine->getP1().getPosition(),
+          netLine->getP2().getPosition(),
+          *netLine->getWidth(),
+          netLine->getP1().isOpen() || netLine->getP2().isOpen(),
+      });
+    }
+    for (const SI_NetPoint* netPoint : seg->getNetPoints()) {
+      segment.netPoints.append(NetPoint{
+          netPoint->getUuid(),
+          netPoint->getPosition(),
+          !netPoint->getNetLines().isEmpty(),
+      });
+    }
+    schematic.netSegments.append(segment);
+  }
+  return schematic;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,206 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_ELECTRICALRULECHECKDATA_H
+#define LIBREPCB_CORE_ELECTRICALRULECHECKDATA_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../geometry/path.h"
+#include "../../types/length.h"
+#include "../../types/point.h"
+#include "../../types/uuid.h"
+
+#include <QtCore>
+
+#include <optional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class ComponentInstance;
+class NetSignal;
+class Project;
+class Schematic;
+
+/*******************************************************************************
+ *  Class ElectricalRuleCheckData
+ ******************************************************************************/
+
+/**
+ * @brief Input data structure for ::librepcb::ElectricalRuleCheck
+ *
+ * A snapshot of all the project data needed by the ERC, so the checks can be
+ * run in a worker thread without accessing the project. Since the snapshot is
+ * created in the main thread, it only contains cheap data. The marker
+ * locations of messages are built by the checks (see #getLocation()), i.e.
+ * only for items which actually lead to a message.
+ *
+ * A snapshot can also be created incrementally from a previous snapshot and
+ * the items modified since then (see ::librepcb::ElectricalRuleCheckTracker).
+ * Only the modified items are read from the project, all others are copied
+ * from the previous snapshot. The modified items are kept in #changes to
+ * allow the ERC re-checking only them.
+ */
+struct ElectricalRuleCheckData final {
+  struct Changes {
+    QSet<Uuid> netSignals;
+    QSet<Uuid> components;
+    QSet<Uuid> schematics;
+
+    bool isEmpty() const noexcept {
+      return netSignals.isEmpty() && components.isEmpty() &&
+          schematics.isEmpty();
+    }
+  };
+  struct Location {
+    std::optional<Uuid> schematic;
+    QVector<Path> paths;
+  };
+  struct Anchor {
+    Uuid schematic;
+    Point position;
+  };
+  struct NetClass {
+    Uuid uuid;
+    QString name;
+    bool used;
+  };
+  struct NetSignal {
+    Uuid uuid;
+    QString name;
+    int realComponentSignals;  // Without schematic-only components.
+  };
+  struct ComponentSignal {
+    Uuid uuid;  // Library component signal.
+    QString name;
+    bool required;
+    std::optional<Uuid> net;
+    QString netName;  // Empty if no net.
+    std::optional<QString> forcedNetName;
+    std::optional<Anchor> pin;  // First symbol pin, if any.
+  };
+  struct Gate {
+    Uuid uuid;
+    QString suffix;
+    bool required;
+    bool placed;
+  };
+  struct Component {
+    Uuid uuid;
+    QString name;
+    QList<ComponentSignal> componentSignals;
+    QList<Gate> gates;
+    std::optional<Anchor> symbol;  // First symbol, if any.
+  };
+  struct Pin {
+    Uuid uuid;  // Library symbol pin.
+    QString name;
+    Point position;
+    bool hasWires;
+    bool hasNet;
+  };
+  struct Symbol {
+    Uuid uuid;
+    Uuid schematic;
+    QString name;
+    QList<Pin> pins;
+  };
+  struct NetLine {
+    Point p1;
+    Point p2;
+    Length width;
+    bool open;  // At least one end is open.
+  };
+  struct NetPoint {
+    Uuid uuid;
+    Point position;
+    bool hasWires;
+  };
+  struct NetSegment {
+    Uuid uuid;
+    Uuid schematic;
+    Uuid net;
+    QString netName;
+    bool hasNetLabels;
+    QList<NetLine> netLines;
+    QList<NetPoint> netPoints;
+  };
+  struct Schematic {
+    Uuid uuid;
+    QList<Symbol> symbols;
+    QList<NetSegment> netSegments;
+  };
+
+  // NOTE: The implicitly shared Qt containers make copying this structure
+  // (e.g. to pass it to a worker thread) a lightweight operation.
+  quint64 id;  ///< Unique ID of this snapshot
+  std::optional<quint64> baseId;  ///< ID of the snapshot #changes refer to
+  Changes changes;  ///< Items modified since the base snapshot
+  QList<NetClass> netClasses;
+  QList<NetSignal> netSignals;
+  QList<Component> components;
+  QList<Schematic> schematics;
+
+  // Constructors / Destructor
+
+  /**
+   * @brief Create a snapshot of the whole project
+   *
+   * @param project The project to create the snapshot from.
+   */
+  explicit ElectricalRuleCheckData(const Project& project) noexcept;
+
+  /**
+   * @brief Update a previous snapshot
+   *
+   * @param project The project to create the snapshot from.
+   * @param base    The previous snapshot of the same project.
+   * @param changes The items modified since `base` was created. Items which
+   *                are not contained in `base` are always read from the
+   *                project.
+   */
+  ElectricalRuleCheckData(const Project& project,
+                          const ElectricalRuleCheckData& base,
+                          const Changes& changes) noexcept;
+
+  // Location Helpers
+  Location getLocation(const NetSignal& net) const noexcept;
+  static Location getLocation(const Component& component) noexcept;
+  static Location getLocation(const Component& component,
+                              const ComponentSignal& signal) noexcept;
+
+private:  // Methods
+  void build(const Project& project,
+             const ElectricalRuleCheckData* base) noexcept;
+  static NetSignal createNetSignal(const librepcb::NetSignal& net) noexcept;
+  static Component createComponent(const ComponentInstance& cmp) noexcept;
+  static Schematic createSchematic(const librepcb::Schematic& sch) noexcept;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -22,18 +22,7 @@
  ******************************************************************************/
 #include "electricalrulecheckmessages.h"
 
-#include "../../library/cmp/componentsignal.h"
-#include "../../library/cmp/componentsymbolvariantitem.h"
-#include "../../library/sym/symbolpin.h"
-#include "../circuit/componentinstance.h"
-#include "../circuit/componentsignalinstance.h"
-#include "../circuit/netclass.h"
-#include "../circuit/netsignal.h"
-#include "../schematic/items/si_netpoint.h"
-#include "../schematic/items/si_netsegment.h"
-#include "../schematic/items/si_symbol.h"
-#include "../schematic/items/si_symbolpin.h"
-#include "../schematic/schematic.h"
+#include <QtCore>
 
 /*******************************************************************************
  *  Namespace
@@ -44,101 +33,41 @@ namespace librepcb {
  *  ErcMsgBase
  ******************************************************************************/
 
-bool ErcMsgBase::setLocation(const NetSignal& net) noexcept {
-  for (const SI_NetSegment* seg : net.getSchematicNetSegments()) {
-    if (setLocation(*seg)) {
-      return true;
-    }
-  }
-  for (const ComponentSignalInstance* cmpSig : net.getComponentSignals()) {
-    if (setLocation(*cmpSig)) {
-      return true;
-    }
-  }
-  return false;
-}
-
-bool ErcMsgBase::setLocation(const ComponentInstance& component) noexcept {
-  for (const SI_Symbol* sym : component.getSymbols()) {
-    setLocation(*sym);
-    return true;
-  }
-  return false;
-}
-
-bool ErcMsgBase::setLocation(const ComponentSignalInstance& signal) noexcept {
-  for (const SI_SymbolPin* pin : signal.getRegisteredSymbolPins()) {
-    setLocation(*pin);
-    return true;
-  }
-  return setLocation(signal.getComponentInstance());
-}
-
-void ErcMsgBase::setLocation(const SI_Symbol& symbol) noexcept {
-  mSchematic = symbol.getSchematic().getUuid();
-  mLocations.append(
-      Path::circle(PositiveLength(2000000)).translated(symbol.getPosition()));
-}
-
-void ErcMsgBase::setLocation(const SI_SymbolPin& pin) noexcept {
-  mLocations.append(
-      Path::circle(PositiveLength(1100000)).translated(pin.getPosition()));
-  mSchematic = pin.getSchematic().getUuid();
-}
-
-bool ErcMsgBase::setLocation(const SI_NetSegment& segment) noexcept {
-  for (const SI_NetLine* nl : segment.getNetLines()) {
-    mLocations.append(Path::obround(nl->getP1().getPosition(),
-                                    nl->getP2().getPosition(),
-                                    PositiveLength(nl->getWidth() + 1)));
-  }
-  if (!segment.getNetLines().isEmpty()) {
-    mSchematic = segment.getSchematic().getUuid();
-    return true;
-  }
-  return false;
-}
-
-void ErcMsgBase::setLocation(const SI_NetPoint& netPoint) noexcept {
-  mSchematic = netPoint.getSchematic().getUuid();
-  mLocations.append(
-      Path::circle(PositiveLength(1100000)).translated(netPoint.getPosition()));
-}
-
-void ErcMsgBase::setLocation(const SI_NetLine& netLine) noexcept {
-  mSchematic = netLine.getSchematic().getUuid();
-  mLocations.append(Path::obround(netLine.getP1().getPosition(),
-                                  netLine.getP2().getPosition(),
-                                  PositiveLength(netLine.getWidth() + 1)));
+void ErcMsgBase::setLocation(
+    const ElectricalRuleCheckData::Location& location) noexcept {
+  mSchematic = location.schematic;
+  mLocations = location.paths;
 }
 
 /*******************************************************************************
  *  ErcMsgUnusedNetClass
  ******************************************************************************/
 
-ErcMsgUnusedNetClass::ErcMsgUnusedNetClass(const NetClass& netClass) noexcept
-  : ErcMsgBase(Severity::Hint,
-               tr("Unused net class: '%1'").arg(*netClass.getName()),
+ErcMsgUnusedNetClass::ErcMsgUnusedNetClass(
+    const ElectricalRuleCheckData::NetClass& netClass) noexcept
+  : ErcMsgBase(Severity::Hint, tr("Unused net class: '%1'").arg(netClass.name),
                tr("There are no nets assigned to the net class, so you "
                   "could remove it."),
                "unused_netclass") {
-  mApproval->appendChild("netclass", netClass.getUuid());
+  mApproval->appendChild("netclass", netClass.uuid);
 }
 
 /*******************************************************************************
  *  ErcMsgOpenNet
  ******************************************************************************/
 
-ErcMsgOpenNet::ErcMsgOpenNet(const NetSignal& net) noexcept
+ErcMsgOpenNet::ErcMsgOpenNet(
+    const ElectricalRuleCheckData::NetSignal& net,
+    const ElectricalRuleCheckData::Location& location) noexcept
   : ErcMsgBase(Severity::Warning,
-               tr("Less than two pins in net: '%1'").arg(*net.getName()),
+               tr("Less than two pins in net: '%1'").arg(net.name),
                tr("The net is connected to less than two pins, so it "
                   "does not represent an electrical connection. Check if "
                   "you missed to connect more pins."),
                "open_net") {
-  mApproval->appendChild("net", net.getUuid());
+  mApproval->appendChild("net", net.uuid);
 
-  setLocation(net);
+  setLocation(location);
 }
 
 /*******************************************************************************
@@ -146,18 +75,22 @@ ErcMsgOpenNet::ErcMsgOpenNet(const NetSignal& net) noexcept
  ******************************************************************************/
 
 ErcMsgOpenWireInSegment::ErcMsgOpenWireInSegment(
-    const SI_NetSegment& segment, const SI_NetLine& openWire) noexcept
+    const ElectricalRuleCheckData::NetSegment& segment,
+    const ElectricalRuleCheckData::NetLine& openWire) noexcept
   : ErcMsgBase(
-        Severity::Warning,
-        tr("Open wire in net: '%1'").arg(*segment.getNetSignal().getName()),
+        Severity::Warning, tr("Open wire in net: '%1'").arg(segment.netName),
         tr("The wire has an open (unconnected) end with no net "
            "label attached, thus is looks like a mistake. Check "
            "if a connection to another wire or pin is missing (denoted by a "
            "cross mark)."),
         "open_wire") {
-  mApproval->appendChild("segment", segment.getUuid());
+  mApproval->appendChild("segment", segment.uuid);
 
-  setLocation(openWire);
+  setLocation(ElectricalRuleCheckData::Location{
+      segment.schematic,
+      {Path::obround(openWire.p1, openWire.p2,
+                     PositiveLength(openWire.width + 1))},
+  });
 }
 
 /*******************************************************************************
@@ -165,22 +98,22 @@ ErcMsgOpenWireInSegment::ErcMsgOpenWireInSegment(
  ******************************************************************************/
 
 ErcMsgUnconnectedRequiredSignal::ErcMsgUnconnectedRequiredSignal(
-    const ComponentSignalInstance& signal) noexcept
+    const ElectricalRuleCheckData::Component& component,
+    const ElectricalRuleCheckData::ComponentSignal& signal) noexcept
   : ErcMsgBase(Severity::Error,
                tr("Unconnected component signal: '%1:%2'")
-                   .arg(*signal.getComponentInstance().getName(),
-                        *signal.getCompSignal().getName()),
+                   .arg(component.name, signal.name),
                tr("The component signal is marked as required, but is "
                   "not connected to any net. Add a wire to the "
                   "corresponding symbol pin to connect it to a net."),
                "unconnected_required_signal") {
   mApproval->ensureLineBreak();
-  mApproval->appendChild("component", signal.getComponentInstance().getUuid());
+  mApproval->appendChild("component", component.uuid);
   mApproval->ensureLineBreak();
-  mApproval->appendChild("signal", signal.getCompSignal().getUuid());
+  mApproval->appendChild("signal", signal.uuid);
   mApproval->ensureLineBreak();
 
-  setLocation(signal);
+  setLocation(ElectricalRuleCheckData::getLocation(component, signal));
 }
 
 /*******************************************************************************
@@ -188,31 +121,25 @@ ErcMsgUnconnectedRequiredSignal::ErcMsgUnconnectedRequiredSignal(
  ******************************************************************************/
 
 ErcMsgForcedNetSignalNameConflict::ErcMsgForcedNetSignalNameConflict(
-    const ComponentSignalInstance& signal) noexcept
+    const ElectricalRuleCheckData::Component& component,
+    const ElectricalRuleCheckData::ComponentSignal& signal) noexcept
   : ErcMsgBase(
         Severity::Error,
         tr("Net name conflict: '%1' != '%2' ('%3:%4')")
-            .arg(getSignalNet(signal), signal.getForcedNetSignalName(),
-                 *signal.getComponentInstance().getName(),
-                 *signal.getCompSignal().getName()),
+            .arg(signal.netName, signal.forcedNetName.value_or(QString()),
+                 component.name, signal.name),
         tr("The component signal requires the attached net to be named '%1', "
            "but it is named '%2'. Either rename the net manually or remove "
            "this connection.")
-            .arg(signal.getForcedNetSignalName(), getSignalNet(signal)),
+            .arg(signal.forcedNetName.value_or(QString()), signal.netName),
         "forced_net_name_conflict") {
   mApproval->ensureLineBreak();
-  mApproval->appendChild("component", signal.getComponentInstance().getUuid());
+  mApproval->appendChild("component", component.uuid);
   mApproval->ensureLineBreak();
-  mApproval->appendChild("signal", signal.getCompSignal().getUuid());
+  mApproval->appendChild("signal", signal.uuid);
   mApproval->ensureLineBreak();
 
-  setLocation(signal);
-}
-
-QString ErcMsgForcedNetSignalNameConflict::getSignalNet(
-    const ComponentSignalInstance& signal) noexcept {
-  return (signal.getNetSignal() ? (*signal.getNetSignal()->getName())
-                                : QString());
+  setLocation(ElectricalRuleCheckData::getLocation(component, signal));
 }
 
 /*******************************************************************************
@@ -220,22 +147,22 @@ QString ErcMsgForcedNetSignalNameConflict::getSignalNet(
  ******************************************************************************/
 
 ErcMsgUnplacedRequiredGate::ErcMsgUnplacedRequiredGate(
-    const ComponentInstance& component,
-    const ComponentSymbolVariantItem& gate) noexcept
+    const ElectricalRuleCheckData::Component& component,
+    const ElectricalRuleCheckData::Gate& gate) noexcept
   : ErcMsgBase(Severity::Error,
                tr("Unplaced required gate: '%1:%2'")
-                   .arg(*component.getName(), *gate.getSuffix()),
+                   .arg(component.name, gate.suffix),
                tr("The gate '%1' of '%2' is marked as required, but it "
                   "is not added to the schematic.")
-                   .arg(*gate.getSuffix(), *component.getName()),
+                   .arg(gate.suffix, component.name),
                "unplaced_required_gate") {
   mApproval->ensureLineBreak();
-  mApproval->appendChild("component", component.getUuid());
+  mApproval->appendChild("component", component.uuid);
   mApproval->ensureLineBreak();
-  mApproval->appendChild("gate", gate.getUuid());
+  mApproval->appendChild("gate", gate.uuid);
   mApproval->ensureLineBreak();
 
-  setLocation(component);
+  setLocation(ElectricalRuleCheckData::getLocation(component));
 }
 
 /*******************************************************************************
@@ -243,22 +170,21 @@ ErcMsgUnplacedRequiredGate::ErcMsgUnplacedRequiredGate(
  ******************************************************************************/
 
 ErcMsgUnplacedOptionalGate::ErcMsgUnplacedOptionalGate(
-    const ComponentInstance& component,
-    const ComponentSymbolVariantItem& gate) noexcept
+    const ElectricalRuleCheckData::Component& component,
+    const ElectricalRuleCheckData::Gate& gate) noexcept
   : ErcMsgBase(
         Severity::Warning,
-        tr("Unplaced gate: '%1:%2'")
-            .arg(*component.getName(), *gate.getSuffix()),
+        tr("Unplaced gate: '%1:%2'").arg(component.name, gate.suffix),
         tr("The optional gate '%1' of '%2' is not added to the schematic.")
-            .arg(*gate.getSuffix(), *component.getName()),
+            .arg(gate.suffix, component.name),
         "unplaced_optional_gate") {
   mApproval->ensureLineBreak();
-  mApproval->appendChild("component", component.getUuid());
+  mApproval->appendChild("component", component.uuid);
   mApproval->ensureLineBreak();
-  mApproval->appendChild("gate", gate.getUuid());
+  mApproval->appendChild("gate", gate.uuid);
   mApproval->ensureLineBreak();
 
-  setLocation(component);
+  setLocation(ElectricalRuleCheckData::getLocation(component));
 }
 
 /*******************************************************************************
@@ -266,24 +192,27 @@ ErcMsgUnplacedOptionalGate::ErcMsgUnplacedOptionalGate(
  ******************************************************************************/
 
 ErcMsgConnectedPinWithoutWire::ErcMsgConnectedPinWithoutWire(
-    const SI_SymbolPin& pin) noexcept
+    const ElectricalRuleCheckData::Symbol& symbol,
+    const ElectricalRuleCheckData::Pin& pin) noexcept
   : ErcMsgBase(
         Severity::Warning,
-        tr("Connected pin without wire: '%1:%2'")
-            .arg(pin.getSymbol().getName(), pin.getName()),
+        tr("Connected pin without wire: '%1:%2'").arg(symbol.name, pin.name),
         tr("The pin is electrically connected to a net, but has no wire "
            "attached so this connection is not visible in the schematic. Add a "
            "wire to make the connection visible."),
         "connected_pin_without_wire") {
   mApproval->ensureLineBreak();
-  mApproval->appendChild("schematic", pin.getSchematic().getUuid());
+  mApproval->appendChild("schematic", symbol.schematic);
   mApproval->ensureLineBreak();
-  mApproval->appendChild("symbol", pin.getSymbol().getUuid());
+  mApproval->appendChild("symbol", symbol.uuid);
   mApproval->ensureLineBreak();
-  mApproval->appendChild("pin", pin.getLibPin().getUuid());
+  mApproval->appendChild("pin", pin.uuid);
   mApproval->ensureLineBreak();
 
-  setLocation(pin);
+  setLocation(ElectricalRuleCheckData::Location{
+      symbol.schematic,
+      {Path::circle(PositiveLength(1100000)).translated(pin.position)},
+  });
 }
 
 /*******************************************************************************
@@ -291,25 +220,28 @@ ErcMsgConnectedPinWithoutWire::ErcMsgConnectedPinWithoutWire(
  ******************************************************************************/
 
 ErcMsgUnconnectedJunction::ErcMsgUnconnectedJunction(
-    const SI_NetPoint& netPoint) noexcept
+    const ElectricalRuleCheckData::NetSegment& segment,
+    const ElectricalRuleCheckData::NetPoint& netPoint) noexcept
   : ErcMsgBase(
         Severity::Hint,
-        tr("Unconnected junction in net: '%1'")
-            .arg(*netPoint.getNetSignalOfNetSegment().getName()),
+        tr("Unconnected junction in net: '%1'").arg(segment.netName),
         "There's an invisible junction in the schematic without any wire "
         "attached. This should not happen, please report it as a bug. But "
         "no worries, this issue is not harmful at all so you can safely "
         "ignore this message.",
         "unconnected_junction") {
   mApproval->ensureLineBreak();
-  mApproval->appendChild("schematic", netPoint.getSchematic().getUuid());
+  mApproval->appendChild("schematic", segment.schematic);
   mApproval->ensureLineBreak();
-  mApproval->appendChild("netsegment", netPoint.getNetSegment().getUuid());
+  mApproval->appendChild("netsegment", segment.uuid);
   mApproval->ensureLineBreak();
-  mApproval->appendChild("junction", netPoint.getUuid());
+  mApproval->appendChild("junction", netPoint.uuid);
   mApproval->ensureLineBreak();
 
-  setLocation(netPoint);
+  setLocation(ElectricalRuleCheckData::Location{
+      segment.schematic,
+      {Path::circle(PositiveLength(1100000)).translated(netPoint.position)},
+  });
 }
 
 /*******************************************************************************
@@ -25,6 +25,7 @@
  ******************************************************************************/
 #include "../../rulecheck/rulecheckmessage.h"
 #include "../../types/uuid.h"
+#include "electricalrulecheckdata.h"
 
 #include <QtCore>
 
@@ -35,17 +36,6 @@
  ******************************************************************************/
 namespace librepcb {
 
-class ComponentInstance;
-class ComponentSignalInstance;
-class ComponentSymbolVariantItem;
-class NetClass;
-class NetSignal;
-class SI_NetLine;
-class SI_NetPoint;
-class SI_NetSegment;
-class SI_Symbol;
-class SI_SymbolPin;
-
 /*******************************************************************************
  *  Class ErcMsgBase
  ******************************************************************************/
@@ -54,8 +44,8 @@ class SI_SymbolPin;
  * @brief Base class for all ERC messages
  *
  * Provides the functionality for the "go to problem" feature for all ERC
- * messages. Constructors of derived classes can just call one of the
- * #setLocation() methods to specify the location of the problem.
+ * messages. Constructors of derived classes can just call #setLocation() to
+ * specify the location of the problem.
  */
 class ErcMsgBase : public RuleCheckMessage {
   Q_DECLARE_TR_FUNCTIONS(ErcMsgBase)
@@ -78,14 +68,7 @@ public:
   }
 
 protected:
-  bool setLocation(const NetSignal& net) noexcept;
-  bool setLocation(const ComponentInstance& component) noexcept;
-  bool setLocation(const ComponentSignalInstance& signal) noexcept;
-  void setLocation(const SI_Symbol& symbol) noexcept;
-  void setLocation(const SI_SymbolPin& pin) noexcept;
-  bool setLocation(const SI_NetSegment& segment) noexcept;
-  void setLocation(const SI_NetPoint& netPoint) noexcept;
-  void setLocation(const SI_NetLine& netLine) noexcept;
+  void setLocation(const ElectricalRuleCheckData::Location& location) noexcept;
 
   std::optional<Uuid> mSchematic;
 };
@@ -103,7 +86,8 @@ class ErcMsgUnusedNetClass final : public ErcMsgBase {
 public:
   // Constructors / Destructor
   ErcMsgUnusedNetClass() = delete;
-  explicit ErcMsgUnusedNetClass(const NetClass& netClass) noexcept;
+  explicit ErcMsgUnusedNetClass(
+      const ElectricalRuleCheckData::NetClass& netClass) noexcept;
   ErcMsgUnusedNetClass(const ErcMsgUnusedNetClass& other) noexcept
     : ErcMsgBase(other) {}
   virtual ~ErcMsgUnusedNetClass() noexcept {}
@@ -122,7 +106,8 @@ class ErcMsgOpenNet final : public ErcMsgBase {
 public:
   // Constructors / Destructor
   ErcMsgOpenNet() = delete;
-  explicit ErcMsgOpenNet(const NetSignal& net) noexcept;
+  ErcMsgOpenNet(const ElectricalRuleCheckData::NetSignal& net,
+                const ElectricalRuleCheckData::Location& location) noexcept;
   ErcMsgOpenNet(const ErcMsgOpenNet& other) noexcept : ErcMsgBase(other) {}
   virtual ~ErcMsgOpenNet() noexcept {}
 };
@@ -140,8 +125,9 @@ class ErcMsgOpenWireInSegment final : public ErcMsgBase {
 public:
   // Constructors / Destructor
   ErcMsgOpenWireInSegment() = delete;
-  explicit ErcMsgOpenWireInSegment(const SI_NetSegment& segment,
-                                   const SI_NetLine& openWire) noexcept;
+  explicit ErcMsgOpenWireInSegment(
+      const ElectricalRuleCheckData::NetSegment& segment,
+      const ElectricalRuleCheckData::NetLine& openWire) noexcept;
   ErcMsgOpenWireInSegment(const ErcMsgOpenWireInSegment& other) noexcept
     : ErcMsgBase(other) {}
   virtual ~ErcMsgOpenWireInSegment() noexcept {}
@@ -161,7 +147,8 @@ public:
   // Constructors / Destructor
   ErcMsgUnconnectedRequiredSignal() = delete;
   explicit ErcMsgUnconnectedRequiredSignal(
-      const ComponentSignalInstance& signal) noexcept;
+      const ElectricalRuleCheckData::Component& component,
+      const ElectricalRuleCheckData::ComponentSignal& signal) noexcept;
   ErcMsgUnconnectedRequiredSignal(
       const ErcMsgUnconnectedRequiredSignal& other) noexcept
     : ErcMsgBase(other) {}
@@ -182,14 +169,12 @@ public:
   // Constructors / Destructor
   ErcMsgForcedNetSignalNameConflict() = delete;
   explicit ErcMsgForcedNetSignalNameConflict(
-      const ComponentSignalInstance& signal) noexcept;
+      const ElectricalRuleCheckData::Component& component,
+      const ElectricalRuleCheckData::ComponentSignal& signal) noexcept;
   ErcMsgForcedNetSignalNameConflict(
       const ErcMsgForcedNetSignalNameConflict& other) noexcept
     : ErcMsgBase(other) {}
   virtual ~ErcMsgForcedNetSignalNameConflict() noexcept {}
-
-private:
-  static QString getSignalNet(const ComponentSignalInstance& signal) noexcept;
 };
 
 /*******************************************************************************
@@ -206,8 +191,8 @@ public:
   // Constructors / Destructor
   ErcMsgUnplacedRequiredGate() = delete;
   explicit ErcMsgUnplacedRequiredGate(
-      const ComponentInstance& component,
-      const ComponentSymbolVariantItem& gate) noexcept;
+      const ElectricalRuleCheckData::Component& component,
+      const ElectricalRuleCheckData::Gate& gate) noexcept;
   ErcMsgUnplacedRequiredGate(const ErcMsgUnplacedRequiredGate& other) noexcept
     : ErcMsgBase(other) {}
   virtual ~ErcMsgUnplacedRequiredGate() noexcept {}
@@ -227,8 +212,8 @@ public:
   // Constructors / Destructor
   ErcMsgUnplacedOptionalGate() = delete;
   explicit ErcMsgUnplacedOptionalGate(
-      const ComponentInstance& component,
-      const ComponentSymbolVariantItem& gate) noexcept;
+      const ElectricalRuleCheckData::Component& component,
+      const ElectricalRuleCheckData::Gate& gate) noexcept;
   ErcMsgUnplacedOptionalGate(const ErcMsgUnplacedOptionalGate& other) noexcept
     : ErcMsgBase(other) {}
   virtual ~ErcMsgUnplacedOptionalGate() noexcept {}
@@ -247,7 +232,9 @@ class ErcMsgConnectedPinWithoutWire final : public ErcMsgBase {
 public:
   // Constructors / Destructor
   ErcMsgConnectedPinWithoutWire() = delete;
-  explicit ErcMsgConnectedPinWithoutWire(const SI_SymbolPin& pin) noexcept;
+  explicit ErcMsgConnectedPinWithoutWire(
+      const ElectricalRuleCheckData::Symbol& symbol,
+      const ElectricalRuleCheckData::Pin& pin) noexcept;
   ErcMsgConnectedPinWithoutWire(
       const ErcMsgConnectedPinWithoutWire& other) noexcept
     : ErcMsgBase(other) {}
@@ -267,7 +254,9 @@ class ErcMsgUnconnectedJunction final : public ErcMsgBase {
 public:
   // Constructors / Destructor
   ErcMsgUnconnectedJunction() = delete;
-  explicit ErcMsgUnconnectedJunction(const SI_NetPoint& netPoint) noexcept;
+  explicit ErcMsgUnconnectedJunction(
+      const ElectricalRuleCheckData::NetSegment& segment,
+      const ElectricalRuleCheckData::NetPoint& netPoint) noexcept;
   ErcMsgUnconnectedJunction(const ErcMsgUnconnectedJunction& other) noexcept
     : ErcMsgBase(other) {}
   virtual ~ErcMsgUnconnectedJunction() noexcept {}
@@ -0,0 +1,300 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "electricalrulechecktracker.h"
+
+#include "../circuit/circuit.h"
+#include "../circuit/componentinstance.h"
+#include "../circuit/componentsignalinstance.h"
+#include "../circuit/netsignal.h"
+#include "../project.h"
+#include "../schematic/items/si_netsegment.h"
+#include "../schematic/schematic.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ElectricalRuleCheckTracker::ElectricalRuleCheckTracker(
+    Project& project) noexcept
+  : QObject(nullptr),
+    mProject(project),
+    mSchematics(),
+    mChanges(),
+    mOnSymbolEditedSlot(*this, &ElectricalRuleCheckTracker::symbolEdited),
+    mOnNetPointEditedSlot(*this, &ElectricalRuleCheckTracker::netPointEdited),
+    mOnNetLineEditedSlot(*this, &ElectricalRuleCheckTracker::netLineEdited) {
+  Circuit& circuit = mProject.getCircuit();
+  connect(&circuit, &Circuit::netSignalAdded, this, [this](NetSignal& net) {
+    attachNetSignal(net);
+    netSignalModified(&net);
+  });
+  connect(&circuit, &Circuit::netSignalRemoved, this, [this](NetSignal& net) {
+    detachNetSignal(net);
+    netSignalModified(&net);
+  });
+  connect(&circuit, &Circuit::componentAdded, this,
+          [this](ComponentInstance& cmp) {
+            attachComponent(cmp);
+            componentModified(cmp);
+          });
+  connect(&circuit, &Circuit::componentRemoved, this,
+          [this](ComponentInstance& cmp) {
+            detachComponent(cmp);
+            componentModified(cmp);
+          });
+  for (NetSignal* net : circuit.getNetSignals()) {
+    attachNetSignal(*net);
+  }
+  for (ComponentInstance* cmp : circuit.getComponentInstances()) {
+    attachComponent(*cmp);
+  }
+
+  // Note: Get the schematics before connecting to the project signals since
+  // loading pending schematics emits Project::schematicAdded().
+  mSchematics = mProject.getSchematics();
+  for (Schematic* schematic : mSchematics) {
+    attachSchematic(*schematic);
+  }
+  connect(&mProject, &Project::schematicAdded, this, [this](int index) {
+    if (Schematic* schematic = mProject.getSchematicByIndex(index)) {
+      mSchematics.insert(index, schematic);
+      attachSchematic(*schematic);
+    }
+  });
+  connect(&mProject, &Project::schematicRemoved, this, [this](int index) {
+    if ((index >= 0) && (index < mSchematics.count())) {
+      detachSchematic(*mSchematics.takeAt(index));
+    }
+  });
+
+  // Attaching the items above marked them as modified, but that's not
+  // relevant since the first snapshot is created from scratch anyway.
+  mChanges = ElectricalRuleCheckData::Changes();
+}
+
+ElectricalRuleCheckTracker::~ElectricalRuleCheckTracker() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+ElectricalRuleCheckData::Changes
+    ElectricalRuleCheckTracker::takeChanges() noexcept {
+  ElectricalRuleCheckData::Changes changes = mChanges;
+  mChanges = ElectricalRuleCheckData::Changes();
+  return changes;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void ElectricalRuleCheckTracker::attachNetSignal(NetSignal& net) noexcept {
+  connect(&net, &NetSignal::nameChanged, this,
+          [this, &net]() { netSignalRenamed(net); });
+}
+
+void ElectricalRuleCheckTracker::detachNetSignal(NetSignal& net) noexcept {
+  disconnect(&net, nullptr, this, nullptr);
+}
+
+void ElectricalRuleCheckTracker::attachComponent(
+    ComponentInstance& cmp) noexcept {
+  // Note: This signal is also emitted if the name or the project attributes
+  // have been changed, which affects the names & forced net names.
+  connect(&cmp, &ComponentInstance::attributesChanged, this,
+          [this, &cmp]() { componentModified(cmp); });
+  for (ComponentSignalInstance* sig : cmp.getSignals()) {
+    connect(sig, &ComponentSignalInstance::netSignalChanged, this,
+            [this, &cmp](NetSignal* from, NetSignal* to) {
+              netSignalModified(from);
+              netSignalModified(to);
+              componentModified(cmp);
+            });
+  }
+}
+
+void ElectricalRuleCheckTracker::detachComponent(
+    ComponentInstance& cmp) noexcept {
+  disconnect(&cmp, nullptr, this, nullptr);
+  for (ComponentSignalInstance* sig : cmp.getSignals()) {
+    disconnect(sig, nullptr, this, nullptr);
+  }
+}
+
+void ElectricalRuleCheckTracker::attachSchematic(
+    Schematic& schematic) noexcept {
+  connect(&schematic, &Schematic::symbolAdded, this, [this](SI_Symbol& sym) {
+    attachSymbol(sym);
+    symbolModified(sym);
+  });
+  connect(&schematic, &Schematic::symbolRemoved, this, [this](SI_Symbol& sym) {
+    sym.onEdited.detach(mOnSymbolEditedSlot);
+    symbolModified(sym);
+  });
+  connect(&schematic, &Schematic::netSegmentAdded, this,
+          [this](SI_NetSegment& segment) {
+            attachNetSegment(segment);
+            netSegmentModified(segment);
+          });
+  connect(&schematic, &Schematic::netSegmentRemoved, this,
+          [this](SI_NetSegment& segment) {
+            detachNetSegment(segment);
+            netSegmentModified(segment);
+          });
+  for (SI_Symbol* symbol : schematic.getSymbols()) {
+    attachSymbol(*symbol);
+    symbolModified(*symbol);
+  }
+  for (SI_NetSegment* segment : schematic.getNetSegments()) {
+    attachNetSegment(*segment);
+    netSegmentModified(*segment);
+  }
+  mChanges.schematics.insert(schematic.getUuid());
+}
+
+void ElectricalRuleCheckTracker::detachSchematic(
+    Schematic& schematic) noexcept {
+  disconnect(&schematic, nullptr, this, nullptr);
+  for (SI_Symbol* symbol : schematic.getSymbols()) {
+    symbol->onEdited.detach(mOnSymbolEditedSlot);
+    symbolModified(*symbol);
+  }
+  for (SI_NetSegment* segment : schematic.getNetSegments()) {
+    detachNetSegment(*segment);
+    netSegmentModified(*segment);
+  }
+  mChanges.schematics.insert(schematic.getUuid());
+}
+
+void ElectricalRuleCheckTracker::attachSymbol(SI_Symbol& symbol) noexcept {
+  symbol.onEdited.attach(mOnSymbolEditedSlot);
+}
+
+void ElectricalRuleCheckTracker::attachNetSegment(
+    SI_NetSegment& segment) noexcept {
+  auto attachItems = [this](const QList<SI_NetPoint*>& netPoints,
+                            const QList<SI_NetLine*>& netLines) {
+    for (SI_NetPoint* netPoint : netPoints) {
+      netPoint->onEdited.attach(mOnNetPointEditedSlot);
+    }
+    for (SI_NetLine* netLine : netLines) {
+      netLine->onEdited.attach(mOnNetLineEditedSlot);
+    }
+  };
+  connect(&segment, &SI_NetSegment::netPointsAndNetLinesAdded, this,
+          [this, &segment, attachItems](const QList<SI_NetPoint*>& netPoints,
+                                        const QList<SI_NetLine*>& netLines) {
+            attachItems(netPoints, netLines);
+            netSegmentModified(segment);
+          });
+  connect(&segment, &SI_NetSegment::netPointsAndNetLinesRemoved, this,
+          [this, &segment]() { netSegmentModified(segment); });
+  connect(&segment, &SI_NetSegment::netLabelAdded, this,
+          [this, &segment]() { netSegmentModified(segment); });
+  connect(&segment, &SI_NetSegment::netLabelRemoved, this,
+          [this, &segment]() { netSegmentModified(segment); });
+  attachItems(segment.getNetPoints().values(), segment.getNetLines().values());
+}
+
+void ElectricalRuleCheckTracker::detachNetSegment(
+    SI_NetSegment& segment) noexcept {
+  disconnect(&segment, nullptr, this, nullptr);
+}
+
+void ElectricalRuleCheckTracker::netSignalModified(
+    const NetSignal* net) noexcept {
+  if (net) {
+    mChanges.netSignals.insert(net->getUuid());
+  }
+}
+
+void ElectricalRuleCheckTracker::netSignalRenamed(
+    const NetSignal& net) noexcept {
+  // The net name is also contained in the component signals and net
+  // segments of the net.
+  netSignalModified(&net);
+  for (const ComponentSignalInstance* sig : net.getComponentSignals()) {
+    mChanges.components.insert(sig->getComponentInstance().getUuid());
+  }
+  for (const SI_NetSegment* segment : net.getSchematicNetSegments()) {
+    mChanges.schematics.insert(segment->getSchematic().getUuid());
+  }
+}
+
+void ElectricalRuleCheckTracker::componentModified(
+    const ComponentInstance& cmp) noexcept {
+  // The symbols contain the component name and the nets may have their
+  // message located at a pin of the component.
+  mChanges.components.insert(cmp.getUuid());
+  for (const SI_Symbol* symbol : cmp.getSymbols()) {
+    mChanges.schematics.insert(symbol->getSchematic().getUuid());
+  }
+  for (const ComponentSignalInstance* sig : cmp.getSignals()) {
+    netSignalModified(sig->getNetSignal());
+  }
+}
+
+void ElectricalRuleCheckTracker::symbolModified(
+    const SI_Symbol& symbol) noexcept {
+  mChanges.schematics.insert(symbol.getSchematic().getUuid());
+  componentModified(symbol.getComponentInstance());
+}
+
+void ElectricalRuleCheckTracker::netSegmentModified(
+    const SI_NetSegment& segment) noexcept {
+  mChanges.schematics.insert(segment.getSchematic().getUuid());
+  netSignalModified(&segment.getNetSignal());
+}
+
+void ElectricalRuleCheckTracker::symbolEdited(
+    const SI_Symbol& obj, SI_Symbol::Event event) noexcept {
+  Q_UNUSED(event);
+  symbolModified(obj);
+}
+
+void ElectricalRuleCheckTracker::netPointEdited(
+    const SI_NetPoint& obj, SI_NetPoint::Event event) noexcept {
+  Q_UNUSED(event);
+  netSegmentModified(obj.getNetSegment());
+}
+
+void ElectricalRuleCheckTracker::netLineEdited(
+    const SI_NetLine& obj, SI_NetLine::Event event) noexcept {
+  Q_UNUSED(event);
+  netSegmentModified(obj.getNetSegment());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
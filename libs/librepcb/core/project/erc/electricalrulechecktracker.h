@@ -0,0 +1,126 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_ELECTRICALRULECHECKTRACKER_H
+#define LIBREPCB_CORE_ELECTRICALRULECHECKTRACKER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../schematic/items/si_netline.h"
+#include "../schematic/items/si_netpoint.h"
+#include "../schematic/items/si_symbol.h"
+#include "electricalrulecheckdata.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class ComponentInstance;
+class NetSignal;
+class Project;
+class SI_NetSegment;
+class Schematic;
+
+/*******************************************************************************
+ *  Class ElectricalRuleCheckTracker
+ ******************************************************************************/
+
+/**
+ * @brief Tracks the project items modified since the last ERC run
+ *
+ * Connects to the modification signals of the circuit and the schematics to
+ * collect the net signals, components and schematics whose
+ * ::librepcb::ElectricalRuleCheckData snapshot is outdated. Besides the
+ * modified item itself, all items referring to it are added as well (e.g.
+ * the schematics and net signals of a moved symbol, since the location of
+ * their messages depends on it).
+ *
+ * The collected changes allow to update the previous snapshot incrementally
+ * and to re-check only the modified items.
+ */
+class ElectricalRuleCheckTracker final : public QObject {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  ElectricalRuleCheckTracker() = delete;
+  ElectricalRuleCheckTracker(const ElectricalRuleCheckTracker& other) = delete;
+  explicit ElectricalRuleCheckTracker(Project& project) noexcept;
+  ~ElectricalRuleCheckTracker() noexcept;
+
+  // Getters
+  const ElectricalRuleCheckData::Changes& getChanges() const noexcept {
+    return mChanges;
+  }
+
+  // General Methods
+
+  /**
+   * @brief Get all changes collected so far and reset them
+   *
+   * @return The changes since the last call.
+   */
+  ElectricalRuleCheckData::Changes takeChanges() noexcept;
+
+  // Operator Overloadings
+  ElectricalRuleCheckTracker& operator=(
+      const ElectricalRuleCheckTracker& rhs) = delete;
+
+private:  // Methods
+  void attachNetSignal(NetSignal& net) noexcept;
+  void detachNetSignal(NetSignal& net) noexcept;
+  void attachComponent(ComponentInstance& cmp) noexcept;
+  void detachComponent(ComponentInstance& cmp) noexcept;
+  void attachSchematic(Schematic& schematic) noexcept;
+  void detachSchematic(Schematic& schematic) noexcept;
+  void attachSymbol(SI_Symbol& symbol) noexcept;
+  void attachNetSegment(SI_NetSegment& segment) noexcept;
+  void detachNetSegment(SI_NetSegment& segment) noexcept;
+  void netSignalModified(const NetSignal* net) noexcept;
+  void netSignalRenamed(const NetSignal& net) noexcept;
+  void componentModified(const ComponentInstance& cmp) noexcept;
+  void symbolModified(const SI_Symbol& symbol) noexcept;
+  void netSegmentModified(const SI_NetSegment& segment) noexcept;
+  void symbolEdited(const SI_Symbol& obj, SI_Symbol::Event event) noexcept;
+  void netPointEdited(const SI_NetPoint& obj,
+                      SI_NetPoint::Event event) noexcept;
+  void netLineEdited(const SI_NetLine& obj, SI_NetLine::Event event) noexcept;
+
+private:  // Data
+  Project& mProject;
+  QList<Schematic*> mSchematics;  ///< To know which schematic was removed
+  ElectricalRuleCheckData::Changes mChanges;
+
+  // Slots
+  SI_Symbol::OnEditedSlot mOnSymbolEditedSlot;
+  SI_NetPoint::OnEditedSlot mOnNetPointEditedSlot;
+  SI_NetLine::OnEditedSlot mOnNetLineEditedSlot;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
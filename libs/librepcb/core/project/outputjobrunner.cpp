@@ -46,8 +46,12 @@
 #include "../job/netlistoutputjob.h"
 #include "../job/pickplaceoutputjob.h"
 #include "../job/projectjsonoutputjob.h"
+#include "../serialization/sexpression.h"
 #include "../types/layer.h"
+#include "../utils/scopeguard.h"
+#include "../utils/taskscheduler.h"
 #include "../utils/toolbox.h"
+#include "../utils/tracer.h"
 #include "board/board.h"
 #include "board/boardd356netlistexport.h"
 #include "board/boardfabricationoutputsettings.h"
@@ -76,7 +80,11 @@ namespace librepcb {
  ******************************************************************************/
 
 OutputJobRunner::OutputJobRunner(Project& project) noexcept
-  : QObject(nullptr), mProject(project), mWriter() {
+  : QObject(nullptr),
+    mProject(project),
+    mWriter(),
+    mMaxConcurrentJobs(1),
+    mSkipUnchangedJobs(false) {
   setOutputDirectory(mProject.getCurrentOutputDir());
 }
 
@@ -91,7 +99,7 @@ const FilePath& OutputJobRunner::getOutputDirectory() const noexcept {
   return mWriter->getDirectoryPath();
 }
 
-const QMultiHash<Uuid, FilePath>& OutputJobRunner::getWrittenFiles()
+QMultiHash<Uuid, FilePath> OutputJobRunner::getWrittenFiles()
     const noexcept {
   return mWriter->getWrittenFiles();
 }
@@ -108,16 +116,26 @@ void OutputJobRunner::setOutputDirectory(const FilePath& fp) noexcept {
           &OutputJobRunner::aboutToRemoveFile);
 }
 
+void OutputJobRunner::setMaxConcurrentJobs(int count) noexcept {
+  mMaxConcurrentJobs = std::max(count, 1);
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
 void OutputJobRunner::run(const QVector<std::shared_ptr<OutputJob>>& jobs) {
+  LIBREPCB_TRACE_ZONE("OutputJobRunner::run");
   mWriter->loadIndex();  // can throw
-  foreach (const auto& job, jobs) {
-    emit jobStarted(job);
-    run(*job);  // can throw
-    qApp->processEvents();  // Avoid freeze due to blocking loop.
+  mFingerprints.clear();
+  if (mSkipUnchangedJobs) {
+    LIBREPCB_TRACE_ZONE("OutputJobRunner::calcFingerprints");
+    mFingerprints = calcFingerprints(jobs);  // can throw
+  }
+  if ((mMaxConcurrentJobs > 1) && (jobs.count() > 1)) {
+    runConcurrently(jobs);  // can throw
+  } else {
+    runSequentially(jobs);  // can throw
   }
   mWriter->storeIndex();  // can throw
 }
@@ -228,7 +246,222 @@ GraphicsExport::Pages OutputJobRunner::buildPages(const GraphicsOutputJob& job,
  *  Private Methods
  ******************************************************************************/
 
+void OutputJobRunner::runSequentially(
+    const QVector<std::shared_ptr<OutputJob>>& jobs) {
+  foreach (const auto& job, jobs) {
+    if (reuseOutput(*job)) {
+      emit jobSkipped(job);
+      continue;
+    }
+    emit jobStarted(job);
+    run(*job);  // can throw
+    qApp->processEvents();  // Avoid freeze due to blocking loop.
+  }
+}
+
+void OutputJobRunner::runConcurrently(
+    const QVector<std::shared_ptr<OutputJob>>& jobs) {
+  // Schematics and boards might not be loaded yet, but loading them must
+  // not happen in the worker threads.
+  mProject.loadPendingSchematics();  // can throw
+  mProject.loadPendingBoards();  // can throw
+
+  // Rebuilding planes modifies the boards, which must not happen while other
+  // jobs are reading them. Thus rebuild all planes upfront, then the jobs
+  // will not need to rebuild anything anymore.
+  foreach (Board* board, mProject.getBoards()) {
+    rebuildOutdatedPlanes(*board);  // can throw
+  }
+
+  const QVector<QSet<int>> dependencies = getDependencies(jobs);
+  QVector<QFuture<void>> futures(jobs.count());
+  QVector<bool> started(jobs.count(), false);
+  QVector<bool> finished(jobs.count(), false);
+  QSemaphore finishedSemaphore;
+  TaskScheduler& scheduler = TaskScheduler::instance();
+  scheduler.setConcurrencyLimit(TaskScheduler::Group::OutputJobs,
+                                mMaxConcurrentJobs);
+
+  // In case of errors, don't start any further jobs but wait for the running
+  // jobs before leaving this method.
+  CancellationToken token;
+  auto sg = scopeGuard([&scheduler, &token, &futures]() {
+    token.cancel();
+    for (const QFuture<void>& future : futures) {
+      try {
+        scheduler.waitForFinished(future);  // can throw
+      } catch (...) {
+        // Only the first error is reported.
+      }
+    }
+  });
+
+  int finishedCount = 0;
+  while (finishedCount < jobs.count()) {
+    // Check for finished jobs, in the order of the list to get deterministic
+    // error messages.
+    for (int i = 0; i < jobs.count(); ++i) {
+      if (started.at(i) && (!finished.at(i)) && futures.at(i).isFinished()) {
+        futures[i].waitForFinished();  // rethrows exception of job
+        finished[i] = true;
+        ++finishedCount;
+      }
+    }
+
+    // Start all jobs whose dependencies are finished.
+    for (int i = 0; i < jobs.count(); ++i) {
+      if ((!started.at(i)) &&
+          std::all_of(dependencies.at(i).begin(), dependencies.at(i).end(),
+                      [&finished](int dep) { return finished.at(dep); })) {
+        std::shared_ptr<OutputJob> job = jobs.at(i);
+        started[i] = true;
+        if (reuseOutput(*job)) {
+          emit jobSkipped(job);
+          finished[i] = true;
+          ++finishedCount;
+          continue;
+        }
+        emit jobStarted(job);
+        futures[i] = scheduler.run(
+            TaskScheduler::Group::OutputJobs, TaskScheduler::Priority::Normal,
+            [this, job, &finishedSemaphore]() {
+              auto releaseSg =
+                  scopeGuard([&]() { finishedSemaphore.release(); });
+              run(*job);  // can throw
+            },
+            token);
+      }
+    }
+
+    // Wait until any job is finished, but still deliver queued signals
+    // emitted by the worker threads.
+    if (finishedCount < jobs.count()) {
+      finishedSemaphore.tryAcquire(1, 100);
+    }
+    qApp->processEvents();
+  }
+}
+
+QVector<QSet<int>> OutputJobRunner::getDependencies(
+    const QVector<std::shared_ptr<OutputJob>>& jobs) noexcept {
+  QVector<QSet<int>> dependencies(jobs.count());
+  for (int i = 0; i < jobs.count(); ++i) {
+    const bool exclusive = isExclusiveJob(*jobs.at(i));
+    const QSet<Uuid> dependencyUuids = jobs.at(i)->getDependencies();
+    for (int k = 0; k < i; ++k) {
+      if (exclusive || isExclusiveJob(*jobs.at(k)) ||
+          dependencyUuids.contains(jobs.at(k)->getUuid())) {
+        dependencies[i].insert(k);
+      }
+    }
+  }
+  return dependencies;
+}
+
+bool OutputJobRunner::isExclusiveJob(const OutputJob& job) noexcept {
+  // The LPPZ job saves the project, i.e. modifies it. The copy job might read
+  // files from the output directory (which is usually located within the
+  // project) written by previous jobs. So these jobs must not run
+  // concurrently with any other job.
+  return dynamic_cast<const LppzOutputJob*>(&job) ||
+      dynamic_cast<const CopyOutputJob*>(&job);
+}
+
+void OutputJobRunner::emitWarning(const QString& msg) noexcept {
+  // This might be called from a worker thread, but receivers shall be called
+  // in our thread.
+  QMetaObject::invokeMethod(
+      this, [this, msg]() { emit warning(msg); }, Qt::AutoConnection);
+}
+
+QHash<Uuid, QString> OutputJobRunner::calcFingerprints(
+    const QVector<std::shared_ptr<OutputJob>>& jobs) const {
+  const QByteArray projectHash = calcProjectHash();  // can throw
+  QHash<Uuid, QString> fingerprints;
+  foreach (const auto& job, jobs) {
+    // The copy job might read arbitrary files, even from the output
+    // directory, so its inputs are unknown.
+    if (dynamic_cast<const CopyOutputJob*>(job.get())) {
+      continue;
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(Application::getVersion().toUtf8());
+    hash.addData(Application::getGitRevision().toUtf8());
+    hash.addData(projectHash);
+    std::unique_ptr<SExpression> node = SExpression::createList("job");
+    job->serialize(*node);  // can throw
+    hash.addData(node->toByteArray());
+
+    // Jobs depending on other jobs are only unchanged if their dependencies
+    // are unchanged too.
+    bool valid = true;
+    foreach (const Uuid& dependency,
+             Toolbox::sortedQSet(job->getDependencies())) {
+      const QString dependencyFingerprint = fingerprints.value(dependency);
+      if (dependencyFingerprint.isEmpty()) {
+        valid = false;
+        break;
+      }
+      hash.addData(dependencyFingerprint.toUtf8());
+    }
+    if (valid) {
+      fingerprints.insert(job->getUuid(),
+                          QString::fromLatin1(hash.result().toHex()));
+    }
+  }
+  return fingerprints;
+}
+
+QByteArray OutputJobRunner::calcProjectHash() const {
+  // If the output directory is located within the project, its content must
+  // be ignored.
+  QString outputDir;
+  if (mWriter->getDirectoryPath().isLocatedInDir(mProject.getPath())) {
+    outputDir = mWriter->getDirectoryPath().toRelative(mProject.getPath());
+  }
+
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  hashProjectDir(hash, QString(), outputDir);  // can throw
+  return hash.result();
+}
+
+void OutputJobRunner::hashProjectDir(QCryptographicHash& hash,
+                                     const QString& dir,
+                                     const QString& outputDir) const {
+  const QString prefix = dir.isEmpty() ? QString() : (dir % "/");
+  foreach (const QString& name,
+           Toolbox::sorted(mProject.getDirectory().getFiles(dir))) {
+    const QString path = prefix % name;
+    // Ignore files not affecting any outputs, same as for *.lppz export.
+    if (!path.endsWith(".user.lp")) {
+      const QByteArray content =
+          mProject.getDirectory().read(path);  // can throw
+      hash.addData(path.toUtf8());
+      hash.addData(QByteArray::number(content.size()));
+      hash.addData(content);
+    }
+  }
+  foreach (const QString& name,
+           Toolbox::sorted(mProject.getDirectory().getDirs(dir))) {
+    const QString path = prefix % name;
+    if ((path != "output") && (path != "logs") && (path != outputDir)) {
+      hashProjectDir(hash, path, outputDir);  // can throw
+    }
+  }
+}
+
+bool OutputJobRunner::reuseOutput(const OutputJob& job) noexcept {
+  if (!mSkipUnchangedJobs) {
+    return false;
+  }
+  return mWriter->reuseFiles(job.getUuid(), mFingerprints.value(job.getUuid()));
+}
+
 void OutputJobRunner::run(const OutputJob& job) {
+  // Invalidate the fingerprint until the job succeeded.
+  mWriter->setFingerprint(job.getUuid(), QString());
+
   const int countBefore = mWriter->getWrittenFiles().count(job.getUuid());
   if (auto ptr = dynamic_cast<const GraphicsOutputJob*>(&job)) {
     runImpl(*ptr);
@@ -263,13 +496,15 @@ void OutputJobRunner::run(const OutputJob& job) {
   }
   const int countAfter = mWriter->getWrittenFiles().count(job.getUuid());
   mWriter->removeObsoleteFiles(job.getUuid());  // can throw
+  mWriter->setFingerprint(job.getUuid(), mFingerprints.value(job.getUuid()));
   if (countAfter <= countBefore) {
-    emit warning(
+    emitWarning(
         tr("No output files were generated, check the job configuration."));
   }
 }
 
 void OutputJobRunner::runImpl(const GraphicsOutputJob& job) {
+  LIBREPCB_TRACE_ZONE("OutputJob::Graphics");
   // Build pages.
   QStringList errors;
   const GraphicsExport::Pages pages =
@@ -329,6 +564,7 @@ void OutputJobRunner::runImpl(const GraphicsOutputJob& job) {
 }
 
 void OutputJobRunner::runImpl(const GerberExcellonOutputJob& job) {
+  LIBREPCB_TRACE_ZONE("OutputJob::GerberExcellon");
   // Build settings.
   BoardFabricationOutputSettings settings;
   settings.setOutputBasePath(mWriter->getDirectoryPath().toStr() % "/" %
@@ -355,23 +591,32 @@ void OutputJobRunner::runImpl(const GerberExcellonOutputJob& job) {
   // Determine boards.
   const QList<Board*> boards = getBoards(job.getBoards());
 
-  // Perform export.
+  // Rebuild planes to be sure no outdated planes are exported!
   foreach (Board* board, boards) {
-    // Rebuild planes to be sure no outdated planes are exported!
     rebuildOutdatedPlanes(*board);  // can throw
+  }
 
-    // Now actually export Gerber/Excellon.
-    BoardGerberExport grbExport(*board);
-    grbExport.setRemoveObsoleteFiles(false);  // must be done by this runner!
-    grbExport.setBeforeWriteCallback([this, &job](const FilePath& fp) {
+  // Now actually export Gerber/Excellon. The files of all boards are
+  // generated concurrently, but written sequentially in a deterministic
+  // order.
+  std::vector<std::unique_ptr<BoardGerberExport>> exports;
+  foreach (const Board* board, boards) {
+    auto grbExport = std::make_unique<BoardGerberExport>(*board);
+    grbExport->setRemoveObsoleteFiles(false);  // must be done by this runner!
+    grbExport->setBeforeWriteCallback([this, &job](const FilePath& fp) {
       mWriter->beginWritingFile(job.getUuid(),
                                 fp.toRelative(mWriter->getDirectoryPath()));
     });
-    grbExport.exportPcbLayers(settings);  // can throw
+    grbExport->startPcbLayersExport(settings);  // can throw
+    exports.push_back(std::move(grbExport));
+  }
+  for (const auto& grbExport : exports) {
+    grbExport->finishPcbLayersExport();  // can throw
   }
 }
 
 void OutputJobRunner::runImpl(const PickPlaceOutputJob& job) {
+  LIBREPCB_TRACE_ZONE("OutputJob::PickPlace");
   const QList<Board*> boards = getBoards(job.getBoards());
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants());
@@ -408,7 +653,7 @@ void OutputJobRunner::runImpl(const PickPlaceOutputJob& job) {
     typeFilter.insert(PickPlaceDataItem::Type::Other);
   }
   if (typeFilter.isEmpty()) {
-    emit warning(
+    emitWarning(
         tr("No technologies selected, thus the output files won't "
            "contain any entries."));
   }
@@ -445,6 +690,7 @@ void OutputJobRunner::runImpl(const PickPlaceOutputJob& job) {
 }
 
 void OutputJobRunner::runImpl(const GerberX3OutputJob& job) {
+  LIBREPCB_TRACE_ZONE("OutputJob::GerberX3");
   const QList<Board*> boards = getBoards(job.getBoards());
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants());
@@ -505,6 +751,7 @@ void OutputJobRunner::runImpl(const GerberX3OutputJob& job) {
 }
 
 void OutputJobRunner::runImpl(const NetlistOutputJob& job) {
+  LIBREPCB_TRACE_ZONE("OutputJob::Netlist");
   const QList<Board*> boards = getBoards(job.getBoards());
   foreach (const Board* board, boards) {
     const FilePath fp = mWriter->beginWritingFile(
@@ -528,6 +775,7 @@ void OutputJobRunner::runImpl(const NetlistOutputJob& job) {
 }
 
 void OutputJobRunner::runImpl(const BomOutputJob& job) {
+  LIBREPCB_TRACE_ZONE("OutputJob::Bom");
   const QList<Board*> boards = getBoards(job.getBoards(), false);
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants());
@@ -562,6 +810,7 @@ void OutputJobRunner::runImpl(const BomOutputJob& job) {
 }
 
 void OutputJobRunner::runImpl(const InteractiveHtmlBomOutputJob& job) {
+  LIBREPCB_TRACE_ZONE("OutputJob::InteractiveHtmlBom");
   const QList<Board*> boards = getBoards(job.getBoards());
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants());
@@ -610,6 +859,7 @@ void OutputJobRunner::runImpl(const InteractiveHtmlBomOutputJob& job) {
 }
 
 void OutputJobRunner::runImpl(const Board3DOutputJob& job) {
+  LIBREPCB_TRACE_ZONE("OutputJob::Board3D");
   const QList<Board*> boards = getBoards(job.getBoards());
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants(), false);
@@ -649,6 +899,7 @@ void OutputJobRunner::runImpl(const Board3DOutputJob& job) {
 }
 
 void OutputJobRunner::runImpl(const ProjectJsonOutputJob& job) {
+  LIBREPCB_TRACE_ZONE("OutputJob::ProjectJson");
   // Determine output file.
   const FilePath fp = mWriter->beginWritingFile(
       job.getUuid(),
@@ -665,6 +916,7 @@ void OutputJobRunner::runImpl(const ProjectJsonOutputJob& job) {
 }
 
 void OutputJobRunner::runImpl(const LppzOutputJob& job) {
+  LIBREPCB_TRACE_ZONE("OutputJob::Lppz");
   // Determine output file.
   const FilePath fp = mWriter->beginWritingFile(
       job.getUuid(),
@@ -702,6 +954,7 @@ void OutputJobRunner::runImpl(const LppzOutputJob& job) {
 }
 
 void OutputJobRunner::runImpl(const CopyOutputJob& job) {
+  LIBREPCB_TRACE_ZONE("OutputJob::Copy");
   const QList<Board*> boards = getBoards(job.getBoards(), false);
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants(), false);
@@ -750,6 +1003,7 @@ void OutputJobRunner::runImpl(const CopyOutputJob& job) {
 }
 
 void OutputJobRunner::runImpl(const ArchiveOutputJob& job) {
+  LIBREPCB_TRACE_ZONE("OutputJob::Archive");
   // Determine output file.
   const FilePath fp = mWriter->beginWritingFile(
       job.getUuid(),
@@ -779,7 +1033,7 @@ void OutputJobRunner::runImpl(const ArchiveOutputJob& job) {
     }
   }
   if (job.getInputJobs().isEmpty()) {
-    emit warning(
+    emitWarning(
         tr("No input jobs selected, thus the resulting archive will "
            "be empty."));
   }
@@ -912,6 +1166,7 @@ QVector<std::shared_ptr<AssemblyVariant>> OutputJobRunner::getAssemblyVariants(
 }
 
 void OutputJobRunner::rebuildOutdatedPlanes(Board& board) {
+  QMutexLocker lock(&mPlanesMutex);
   const auto layers = board.getCopperLayers();
   BoardPlaneFragmentsBuilder builder;
   if (builder.start(board, &layers)) {
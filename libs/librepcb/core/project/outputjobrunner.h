@@ -60,6 +60,12 @@ class ProjectJsonOutputJob;
 
 /**
  * @brief The OutputJobRunner class
+ *
+ * By default, jobs are run one after another. With
+ * #setMaxConcurrentJobs(), independent jobs are run concurrently in the
+ * ::librepcb::TaskScheduler while jobs depending on others (e.g.
+ * ::librepcb::ArchiveOutputJob) are started as soon as their dependencies are
+ * finished.
  */
 class OutputJobRunner final : public QObject {
   Q_OBJECT
@@ -73,11 +79,43 @@ public:
 
   // Getters
   const FilePath& getOutputDirectory() const noexcept;
-  const QMultiHash<Uuid, FilePath>& getWrittenFiles() const noexcept;
+  QMultiHash<Uuid, FilePath> getWrittenFiles() const noexcept;
+  int getMaxConcurrentJobs() const noexcept { return mMaxConcurrentJobs; }
+  bool getSkipUnchangedJobs() const noexcept { return mSkipUnchangedJobs; }
 
   // Setters
   void setOutputDirectory(const FilePath& fp) noexcept;
 
+  /**
+   * @brief Set the maximum number of jobs to run concurrently
+   *
+   * @param count   Maximum number of concurrent jobs. 1 (the default) runs
+   *                all jobs sequentially.
+   *
+   * @attention If more than one job is allowed, the project must not be
+   *            modified by anyone else while #run() is in progress since the
+   *            jobs are reading it from worker threads. Therefore this should
+   *            only be used if there is no editor open for the project (e.g.
+   *            in the command line interface).
+   */
+  void setMaxConcurrentJobs(int count) noexcept;
+
+  /**
+   * @brief Skip jobs whose inputs did not change since the last run
+   *
+   * If enabled, a fingerprint of the inputs of each job (the job settings
+   * and all project files) is compared with the fingerprint stored in the
+   * output directory index. If they are equal and all output files of the
+   * last run still exist, the job is skipped.
+   *
+   * @param skip  Whether unchanged jobs shall be skipped. Defaults to false.
+   *
+   * @attention The fingerprint is calculated from the project files, so
+   *            this must only be enabled if the project in memory is not
+   *            modified compared to its files.
+   */
+  void setSkipUnchangedJobs(bool skip) noexcept { mSkipUnchangedJobs = skip; }
+
   // General Methods
   void run(const QVector<std::shared_ptr<OutputJob>>& jobs);
   QList<FilePath> findUnknownFiles(const QSet<Uuid>& knownJobs) const;
@@ -91,6 +129,7 @@ public:
 
 signals:
   void jobStarted(std::shared_ptr<const OutputJob> job);
+  void jobSkipped(std::shared_ptr<const OutputJob> job);
   void aboutToWriteFile(const FilePath& fp);
   void aboutToRemoveFile(const FilePath& fp);
   void warning(const QString& msg);
@@ -98,6 +137,18 @@ signals:
                     std::shared_ptr<QPicture> picture);
 
 private:  // Methods
+  void runSequentially(const QVector<std::shared_ptr<OutputJob>>& jobs);
+  void runConcurrently(const QVector<std::shared_ptr<OutputJob>>& jobs);
+  static QVector<QSet<int>> getDependencies(
+      const QVector<std::shared_ptr<OutputJob>>& jobs) noexcept;
+  static bool isExclusiveJob(const OutputJob& job) noexcept;
+  void emitWarning(const QString& msg) noexcept;
+  QHash<Uuid, QString> calcFingerprints(
+      const QVector<std::shared_ptr<OutputJob>>& jobs) const;
+  QByteArray calcProjectHash() const;
+  void hashProjectDir(QCryptographicHash& hash, const QString& dir,
+                      const QString& outputDir) const;
+  bool reuseOutput(const OutputJob& job) noexcept;
   void run(const OutputJob& job);
   void runImpl(const GraphicsOutputJob& job);
   void runImpl(const GerberExcellonOutputJob& job);
@@ -119,11 +170,15 @@ private:  // Methods
       bool includeNullInAll) const;
   QVector<std::shared_ptr<AssemblyVariant>> getAssemblyVariants(
       const OutputJob::ObjectSet<Uuid>& set) const;
-  static void rebuildOutdatedPlanes(Board& board);
+  void rebuildOutdatedPlanes(Board& board);
 
 private:  // Data
   Project& mProject;
   QScopedPointer<OutputDirectoryWriter> mWriter;
+  int mMaxConcurrentJobs;
+  bool mSkipUnchangedJobs;
+  QHash<Uuid, QString> mFingerprints;  ///< Fingerprints of the current run
+  QMutex mPlanesMutex;  ///< Serializes #rebuildOutdatedPlanes()
 };
 
 /*******************************************************************************
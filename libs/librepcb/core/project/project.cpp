@@ -85,6 +85,10 @@ Project::Project(std::unique_ptr<TransactionalDirectory> directory,
 Project::~Project() noexcept {
   // free the allocated memory in the reverse order of their allocation
 
+  // never load anything while closing the project
+  mPendingSchematicsLoader = nullptr;
+  mPendingBoardsLoader = nullptr;
+
   // delete all boards and schematics (and catch all thrown exceptions)
   foreach (Board* board, mBoards) {
     try {
@@ -183,7 +187,7 @@ void Project::setDefaultLockComponentAssembly(bool newLock) noexcept {
 }
 
 bool Project::setErcMessageApprovals(
-    const QSet<SExpression>& approvals) noexcept {
+    const QSet<ApprovalKey>& approvals) noexcept {
   if (approvals != mErcMessageApprovals) {
     mErcMessageApprovals = approvals;
     emit ercMessageApprovalsChanged(mErcMessageApprovals);
@@ -193,7 +197,7 @@ bool Project::setErcMessageApprovals(
   }
 }
 
-bool Project::setErcMessageApproved(const SExpression& approval,
+bool Project::setErcMessageApproved(const ApprovalKey& approval,
                                     bool approved) noexcept {
   if (approved && (!mErcMessageApprovals.contains(approval))) {
     mErcMessageApprovals.insert(approval);
@@ -216,6 +220,7 @@ int Project::getSchematicIndex(const Schematic& schematic) const noexcept {
 }
 
 Schematic* Project::getSchematicByUuid(const Uuid& uuid) const noexcept {
+  ensureSchematicsLoaded();
   foreach (Schematic* schematic, mSchematics) {
     if (schematic->getUuid() == uuid) return schematic;
   }
@@ -223,6 +228,7 @@ Schematic* Project::getSchematicByUuid(const Uuid& uuid) const noexcept {
 }
 
 Schematic* Project::getSchematicByName(const QString& name) const noexcept {
+  ensureSchematicsLoaded();
   foreach (Schematic* schematic, mSchematics) {
     if (schematic->getName() == name) return schematic;
   }
@@ -230,6 +236,7 @@ Schematic* Project::getSchematicByName(const QString& name) const noexcept {
 }
 
 void Project::addSchematic(Schematic& schematic, int newIndex) {
+  loadPendingSchematics();  // can throw
   if ((mSchematics.contains(&schematic)) || (&schematic.getProject() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -304,6 +311,7 @@ int Project::getBoardIndex(const Board& board) const noexcept {
 }
 
 Board* Project::getBoardByUuid(const Uuid& uuid) const noexcept {
+  ensureBoardsLoaded();
   foreach (Board* board, mBoards) {
     if (board->getUuid() == uuid) return board;
   }
@@ -311,6 +319,7 @@ Board* Project::getBoardByUuid(const Uuid& uuid) const noexcept {
 }
 
 Board* Project::getBoardByName(const QString& name) const noexcept {
+  ensureBoardsLoaded();
   foreach (Board* board, mBoards) {
     if (board->getName() == name) return board;
   }
@@ -318,6 +327,7 @@ Board* Project::getBoardByName(const QString& name) const noexcept {
 }
 
 void Project::addBoard(Board& board, int newIndex) {
+  loadPendingBoards();  // can throw
   if ((mBoards.contains(&board)) || (&board.getProject() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -378,6 +388,40 @@ void Project::removeBoard(Board& board, bool deleteBoard) {
   }
 }
 
+/*******************************************************************************
+ *  Lazy Loading
+ ******************************************************************************/
+
+void Project::loadPendingSchematics() const {
+  if (mPendingSchematicsLoader) {
+    // Reset the callback before invoking it since it adds the schematics
+    // with addSchematic(), which would invoke it again.
+    const std::function<void()> loader = mPendingSchematicsLoader;
+    mPendingSchematicsLoader = nullptr;
+    try {
+      loader();  // can throw
+    } catch (const Exception& e) {
+      mLazyLoadingErrors.append(e.getMsg());
+      throw;
+    }
+  }
+}
+
+void Project::loadPendingBoards() const {
+  if (mPendingBoardsLoader) {
+    // Reset the callback before invoking it since it adds the boards with
+    // addBoard(), which would invoke it again.
+    const std::function<void()> loader = mPendingBoardsLoader;
+    mPendingBoardsLoader = nullptr;
+    try {
+      loader();  // can throw
+    } catch (const Exception& e) {
+      mLazyLoadingErrors.append(e.getMsg());
+      throw;
+    }
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -385,6 +429,18 @@ void Project::removeBoard(Board& board, bool deleteBoard) {
 void Project::save() {
   qDebug() << "Save project files to transactional file system...";
 
+  // Saving without all schematics and boards would remove them from the
+  // project, so load them now if not done yet.
+  loadPendingSchematics();  // can throw
+  loadPendingBoards();  // can throw
+  if (!mLazyLoadingErrors.isEmpty()) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        tr("The project cannot be saved because it was not loaded "
+           "completely:\n\n%1")
+            .arg(mLazyLoadingErrors.join("\n")));
+  }
+
   // Version file.
   mDirectory->write(
       ".librepcb-project",
@@ -479,10 +535,10 @@ void Project::save() {
   // ERC.
   {
     std::unique_ptr<SExpression> root = SExpression::createList("librepcb_erc");
-    foreach (const SExpression& node,
+    foreach (const ApprovalKey& approval,
              Toolbox::sortedQSet(mErcMessageApprovals)) {
       root->ensureLineBreak();
-      root->appendChild(node);
+      root->appendChild(approval.getNode());
     }
     root->ensureLineBreak();
     mDirectory->write("circuit/erc.lp", root->toByteArray());
@@ -599,6 +655,22 @@ Version Project::getProjectFileFormatVersion(const FilePath& dir) {
  *  Private Methods
  ******************************************************************************/
 
+void Project::ensureSchematicsLoaded() const noexcept {
+  try {
+    loadPendingSchematics();  // can throw
+  } catch (const Exception& e) {
+    qCritical() << "Failed to load schematics:" << e.getMsg();
+  }
+}
+
+void Project::ensureBoardsLoaded() const noexcept {
+  try {
+    loadPendingBoards();  // can throw
+  } catch (const Exception& e) {
+    qCritical() << "Failed to load boards:" << e.getMsg();
+  }
+}
+
 void Project::updatePrimaryBoard() {
   Board* primary = mBoards.value(0);
   if (mPrimaryBoard != primary) {
@@ -27,6 +27,7 @@
 #include "../fileio/directorylock.h"
 #include "../fileio/transactionaldirectory.h"
 #include "../job/outputjob.h"
+#include "../rulecheck/approvalkey.h"
 #include "../types/elementname.h"
 #include "../types/fileproofname.h"
 #include "../types/uuid.h"
@@ -34,6 +35,8 @@
 
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -250,7 +253,7 @@ public:
    *
    * @return Approval nodes
    */
-  const QSet<SExpression>& getErcMessageApprovals() const noexcept {
+  const QSet<ApprovalKey>& getErcMessageApprovals() const noexcept {
     return mErcMessageApprovals;
   }
 
@@ -259,7 +262,10 @@ public:
    *
    * @return Primary board (nullptr if there are no boards)
    */
-  const QPointer<Board>& getPrimaryBoard() noexcept { return mPrimaryBoard; }
+  const QPointer<Board>& getPrimaryBoard() noexcept {
+    ensureBoardsLoaded();
+    return mPrimaryBoard;
+  }
 
   // Setters
 
@@ -350,7 +356,7 @@ public:
    * @retval false      If approvals have not been modified (no change)
    * @retval true       If approvals have been moified
    */
-  bool setErcMessageApprovals(const QSet<SExpression>& approvals) noexcept;
+  bool setErcMessageApprovals(const QSet<ApprovalKey>& approvals) noexcept;
 
   /**
    * @brief Set a single ERC message as approved or not
@@ -361,7 +367,7 @@ public:
    * @retval false      If approvals have not been modified (no change).
    * @retval true       If approvals have been moified.
    */
-  bool setErcMessageApproved(const SExpression& approval,
+  bool setErcMessageApproved(const ApprovalKey& approval,
                              bool approved) noexcept;
 
   // Schematic Methods
@@ -379,6 +385,7 @@ public:
    * @return A QList with all schematics
    */
   const QList<Schematic*>& getSchematics() const noexcept {
+    ensureSchematicsLoaded();
     return mSchematics;
   }
 
@@ -391,6 +398,7 @@ public:
    * invalid
    */
   Schematic* getSchematicByIndex(int index) const noexcept {
+    ensureSchematicsLoaded();
     return mSchematics.value(index, nullptr);
   }
 
@@ -448,7 +456,10 @@ public:
    *
    * @return A QList with all boards
    */
-  const QList<Board*>& getBoards() const noexcept { return mBoards; }
+  const QList<Board*>& getBoards() const noexcept {
+    ensureBoardsLoaded();
+    return mBoards;
+  }
 
   /**
    * @brief Get the board at a specific index
@@ -458,6 +469,7 @@ public:
    * @return A pointer to the specified board, or nullptr if index is invalid
    */
   Board* getBoardByIndex(int index) const noexcept {
+    ensureBoardsLoaded();
     return mBoards.value(index, nullptr);
   }
 
@@ -501,6 +513,64 @@ public:
    */
   void removeBoard(Board& board, bool deleteBoard = false);
 
+  // Lazy Loading
+
+  /**
+   * @brief Defer loading the schematics until they are accessed the first time
+   *
+   * Used by ::librepcb::ProjectLoader to avoid loading schematics which are
+   * never used. The loader is invoked at most once, either explicitly by
+   * #loadPendingSchematics() or implicitly by any schematic related method.
+   *
+   * @warning Schematics must be loaded in the thread owning this object,
+   *          so call #loadPendingSchematics() before accessing them from
+   *          other threads. Also any component instance might be reported
+   *          as unplaced until the schematics are loaded.
+   *
+   * @param loader  Callback to load and add all schematics.
+   */
+  void setPendingSchematicsLoader(std::function<void()> loader) noexcept {
+    mPendingSchematicsLoader = loader;
+  }
+
+  /**
+   * @brief Defer loading the boards until they are accessed the first time
+   *
+   * Same as #setPendingSchematicsLoader(), but for boards.
+   *
+   * @param loader  Callback to load and add all boards.
+   */
+  void setPendingBoardsLoader(std::function<void()> loader) noexcept {
+    mPendingBoardsLoader = loader;
+  }
+
+  /**
+   * @brief Load the schematics now if they were not loaded yet
+   *
+   * @throw Exception     If loading the schematics failed.
+   */
+  void loadPendingSchematics() const;
+
+  /**
+   * @brief Load the boards now if they were not loaded yet
+   *
+   * @throw Exception     If loading the boards failed.
+   */
+  void loadPendingBoards() const;
+
+  /**
+   * @brief Get errors which occurred while loading schematics or boards
+   *
+   * When schematics or boards are loaded implicitly on first access, errors
+   * cannot be reported to the caller. Instead they are collected here and
+   * the project refuses to be saved.
+   *
+   * @return Error messages (empty if no error occurred)
+   */
+  const QStringList& getLazyLoadingErrors() const noexcept {
+    return mLazyLoadingErrors;
+  }
+
   // General Methods
 
   /**
@@ -537,7 +607,7 @@ signals:
    *
    * @param approvals   The new approvals
    */
-  void ercMessageApprovalsChanged(const QSet<SExpression>& approvals);
+  void ercMessageApprovalsChanged(const QSet<ApprovalKey>& approvals);
 
   /**
    * @brief This signal is emitted after a schematic was added to the project
@@ -576,6 +646,8 @@ signals:
   void primaryBoardChanged(const QPointer<Board>& board);
 
 private:  // Methods
+  void ensureSchematicsLoaded() const noexcept;
+  void ensureBoardsLoaded() const noexcept;
   void updatePrimaryBoard();
 
 private:  // Data
@@ -655,7 +727,14 @@ private:  // Data
   QList<Board*> mRemovedBoards;
 
   /// All approved ERC messages
-  QSet<SExpression> mErcMessageApprovals;
+  QSet<ApprovalKey> mErcMessageApprovals;
+
+  /// Callbacks to load the schematics and boards on first access
+  mutable std::function<void()> mPendingSchematicsLoader;
+  mutable std::function<void()> mPendingBoardsLoader;
+
+  /// Errors occurred while loading schematics or boards on first access
+  mutable QStringList mLazyLoadingErrors;
 
   // Cached properties
   QPointer<Board> mPrimaryBoard;
@@ -23,6 +23,7 @@
 #include "projectloader.h"
 
 #include "../application.h"
+#include "../fileio/transactionaldirectory.h"
 #include "../fileio/versionfile.h"
 #include "../library/cmp/component.h"
 #include "../library/dev/device.h"
@@ -31,6 +32,8 @@
 #include "../library/sym/symbol.h"
 #include "../serialization/fileformatmigration.h"
 #include "../types/pcbcolor.h"
+#include "../utils/scopeguard.h"
+#include "../utils/tracer.h"
 #include "board/board.h"
 #include "board/boarddesignrules.h"
 #include "board/boardfabricationoutputsettings.h"
@@ -186,10 +189,11 @@ QByteArray ProjectLoader::MigrationLog::toHtml(
  ******************************************************************************/
 
 ProjectLoader::ProjectLoader(QObject* parent) noexcept
-  : QObject(parent), mAutoAssignDeviceModels(false) {
+  : QObject(parent), mAutoAssignDeviceModels(false), mLazyLoading(false) {
 }
 
 ProjectLoader::~ProjectLoader() noexcept {
+  cancelTasks();
 }
 
 /*******************************************************************************
@@ -200,10 +204,14 @@ std::unique_ptr<Project> ProjectLoader::open(
     std::unique_ptr<TransactionalDirectory> directory,
     const QString& filename) {
   Q_ASSERT(directory);
+  LIBREPCB_TRACE_ZONE("ProjectLoader::open");
   mMigrationLog = std::nullopt;
+  mTimings.clear();
 
   QElapsedTimer timer;
   timer.start();
+  QElapsedTimer phaseTimer;
+  phaseTimer.start();
   const FilePath fp = directory->getAbsPath(filename);
   qDebug().nospace() << "Open project " << fp.toNative() << "...";
 
@@ -274,36 +282,94 @@ std::unique_ptr<Project> ProjectLoader::open(
             .arg(Application::getFileFormatVersion().toStr());
     directory->write(logFileName, html);
   }
-
-  // Load project.
+  finishPhase("migration", phaseTimer);
+
+  // In case of errors, wait for all pending tasks before leaving.
+  auto sg = scopeGuard([this]() {
+    cancelTasks();
+    mParsedFiles.clear();
+  });
+
+  // Load project. The files are parsed concurrently in the background while
+  // the objects are created sequentially in the order of their dependencies.
+  // Lazy loading is not possible if the project needs to be upgraded because
+  // all the files need to be re-written.
+  const bool lazy = mLazyLoading && (!mMigrationLog);
   std::unique_ptr<Project> p(new Project(std::move(directory), filename));
+  const QStringList files = {
+      "project/metadata.lp", "project/settings.lp", "project/jobs.lp",
+      "circuit/circuit.lp",  "circuit/erc.lp",
+  };
+  foreach (const QString& fp, files) {
+    startParsing(p->getDirectory(), fp);
+  }
+  if (!lazy) {
+    startParsingIndex(p->getDirectory(), "schematics/schematics.lp",
+                      "schematic");
+    startParsingIndex(p->getDirectory(), "boards/boards.lp", "board");
+  }
   loadMetadata(*p);
   loadSettings(*p);
   loadOutputJobs(*p);
+  finishPhase("metadata", phaseTimer);
   loadLibrary(*p);
+  finishPhase("library", phaseTimer);
   loadCircuit(*p);
   loadErc(*p);
-  loadSchematics(*p);
-  loadBoards(*p);
+  finishPhase("circuit", phaseTimer);
+  if (lazy) {
+    // Note: The project owns the callbacks, so the raw pointer stays valid.
+    Project* project = p.get();
+    const bool autoAssignDeviceModels = mAutoAssignDeviceModels;
+    p->setPendingSchematicsLoader([project]() {
+      ProjectLoader loader;
+      loader.startParsingIndex(project->getDirectory(),
+                               "schematics/schematics.lp", "schematic");
+      loader.loadSchematics(*project);  // can throw
+    });
+    p->setPendingBoardsLoader([project, autoAssignDeviceModels]() {
+      ProjectLoader loader;
+      loader.setAutoAssignDeviceModels(autoAssignDeviceModels);
+      loader.startParsingIndex(project->getDirectory(), "boards/boards.lp",
+                               "board");
+      loader.loadBoards(*project);  // can throw
+    });
+    qDebug() << "Schematics and boards will be loaded on first access.";
+  } else {
+    loadSchematics(*p);
+    finishPhase("schematics", phaseTimer);
+    loadBoards(*p);
+    finishPhase("boards", phaseTimer);
+  }
   loadProjectUserSettings(*p);
+  finishPhase("user settings", phaseTimer);
 
   // If the file format was migrated, clean up obsolete ERC messages.
   if (mMigrationLog) {
     qInfo() << "Running ERC to clean up obsolete message approvals...";
-    ElectricalRuleCheck erc(*p);
-    const RuleCheckMessageList msgs = erc.runChecks();
-    const QSet<SExpression> approvals = RuleCheckMessage::getAllApprovals(msgs);
+    ElectricalRuleCheck erc;
+    const RuleCheckMessageList msgs =
+        erc.runChecks(ElectricalRuleCheckData(*p));
+    const QSet<ApprovalKey> approvals =
+        RuleCheckMessage::getAllApprovals(msgs);
     p->setErcMessageApprovals(p->getErcMessageApprovals() & approvals);
+    finishPhase("erc", phaseTimer);
   }
 
   // Make sure the files are formatted correctly. Also handle possible errors
   // during serialization now instead of later.
   if (mMigrationLog) {
     p->save();
+    finishPhase("save", phaseTimer);
   }
 
   // Done!
+  QStringList timings;
+  for (const auto& pair : mTimings) {
+    timings.append(QString("%1: %2 ms").arg(pair.first).arg(pair.second));
+  }
   qDebug() << "Successfully opened project in" << timer.elapsed() << "ms.";
+  qDebug().noquote() << "Load time breakdown:" << timings.join(", ");
   return p;
 }
 
@@ -311,11 +377,85 @@ std::unique_ptr<Project> ProjectLoader::open(
  *  Private Methods
  ******************************************************************************/
 
+template <typename Func>
+auto ProjectLoader::startTask(Func func) noexcept {
+  // The user is usually waiting for the project to be opened.
+  auto future = TaskScheduler::instance().run(
+      TaskScheduler::Group::ProjectLoad, TaskScheduler::Priority::Interactive,
+      func, mCancellation);
+  mTasks.append(QFuture<void>(future));
+  return future;
+}
+
+void ProjectLoader::cancelTasks() noexcept {
+  // Don't start any further tasks, but wait for the running ones.
+  mCancellation.cancel();
+  for (const QFuture<void>& future : mTasks) {
+    try {
+      TaskScheduler::instance().waitForFinished(future);  // can throw
+    } catch (...) {
+      // Errors are reported when accessing the results.
+    }
+  }
+  mTasks.clear();
+  mCancellation = CancellationToken();
+}
+
+void ProjectLoader::startParsing(TransactionalDirectory& dir,
+                                 const QString& path) noexcept {
+  const FilePath fp = dir.getAbsPath(path);
+  if (mParsedFiles.contains(fp.toStr())) {
+    return;
+  }
+  std::shared_ptr<TransactionalFileSystem> fs = dir.getFileSystem();
+  const QString dirPath = dir.getPath();
+  mParsedFiles.insert(fp.toStr(), startTask([fs, dirPath, path, fp]() {
+    LIBREPCB_TRACE_ZONE("ProjectLoader::parse");
+    const TransactionalDirectory directory(fs, dirPath);
+    return std::shared_ptr<const SExpression>(
+        SExpression::parse(directory.read(path), fp));  // can throw
+  }));
+}
+
+void ProjectLoader::startParsingIndex(TransactionalDirectory& dir,
+                                      const QString& path,
+                                      const QString& childName) noexcept {
+  // The files listed in the index can only be parsed after the index file.
+  startParsing(dir, path);
+  try {
+    const std::shared_ptr<const SExpression> root =
+        mParsedFiles.value(dir.getAbsPath(path).toStr()).result();  // can throw
+    foreach (const SExpression* node, root->getChildren(childName)) {
+      startParsing(dir, node->getChild("@0").getValue());  // can throw
+    }
+  } catch (const Exception&) {
+    // Errors are reported later when actually loading the files.
+  }
+}
+
+std::shared_ptr<const SExpression> ProjectLoader::parse(
+    TransactionalDirectory& dir, const QString& path) {
+  const FilePath fp = dir.getAbsPath(path);
+  if (mParsedFiles.contains(fp.toStr())) {
+    return mParsedFiles.take(fp.toStr()).result();  // can throw
+  }
+  return SExpression::parse(dir.read(path), fp);  // can throw
+}
+
+void ProjectLoader::finishPhase(const char* name,
+                                QElapsedTimer& timer) noexcept {
+#if LIBREPCB_ENABLE_TRACING
+  Tracer& tracer = Tracer::instance();
+  const qint64 endNs = tracer.getTimestampNs();
+  tracer.addZone(name, endNs - timer.nsecsElapsed(), endNs);
+#endif
+  mTimings.append(std::make_pair(QString(name), timer.restart()));
+}
+
 void ProjectLoader::loadMetadata(Project& p) {
   qDebug() << "Load project metadata...";
-  const QString fp = "project/metadata.lp";
-  const std::unique_ptr<const SExpression> root = SExpression::parse(
-      p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
+  const std::shared_ptr<const SExpression> root =
+      parse(p.getDirectory(), "project/metadata.lp");  // can throw
 
   p.setUuid(deserialize<Uuid>(root->getChild("@0")));
   p.setName(deserialize<ElementName>(root->getChild("name/@0")));
@@ -329,9 +469,8 @@ void ProjectLoader::loadMetadata(Project& p) {
 
 void ProjectLoader::loadSettings(Project& p) {
   qDebug() << "Load project settings...";
-  const QString fp = "project/settings.lp";
-  const std::unique_ptr<const SExpression> root = SExpression::parse(
-      p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
+  const std::shared_ptr<const SExpression> root =
+      parse(p.getDirectory(), "project/settings.lp");  // can throw
 
   {
     QStringList l;
@@ -368,9 +507,8 @@ void ProjectLoader::loadSettings(Project& p) {
 
 void ProjectLoader::loadOutputJobs(Project& p) {
   qDebug() << "Load output jobs...";
-  const QString fp = "project/jobs.lp";
-  const std::unique_ptr<const SExpression> root = SExpression::parse(
-      p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
+  const std::shared_ptr<const SExpression> root =
+      parse(p.getDirectory(), "project/jobs.lp");  // can throw
   p.getOutputJobs() = deserialize<OutputJobList>(*root);
   qDebug() << "Successfully loaded output jobs.";
 }
@@ -378,49 +516,76 @@ void ProjectLoader::loadOutputJobs(Project& p) {
 void ProjectLoader::loadLibrary(Project& p) {
   qDebug() << "Load project library...";
 
-  loadLibraryElements<Symbol>(p, "sym", "symbols", &ProjectLibrary::addSymbol);
-  loadLibraryElements<Package>(p, "pkg", "packages",
-                               &ProjectLibrary::addPackage);
-  loadLibraryElements<Component>(p, "cmp", "components",
-                                 &ProjectLibrary::addComponent);
-  loadLibraryElements<Device>(p, "dev", "devices", &ProjectLibrary::addDevice);
+  // The library elements are independent of each other, thus they are opened
+  // concurrently. Only adding them to the library is done sequentially.
+  auto symbols = openLibraryElements<Symbol>(p, "sym");
+  auto packages = openLibraryElements<Package>(p, "pkg");
+  auto components = openLibraryElements<Component>(p, "cmp");
+  auto devices = openLibraryElements<Device>(p, "dev");
+  addLibraryElements<Symbol>(p, symbols, "symbols",
+                             &ProjectLibrary::addSymbol);
+  addLibraryElements<Package>(p, packages, "packages",
+                              &ProjectLibrary::addPackage);
+  addLibraryElements<Component>(p, components, "components",
+                                &ProjectLibrary::addComponent);
+  addLibraryElements<Device>(p, devices, "devices", &ProjectLibrary::addDevice);
 
   qDebug() << "Successfully loaded project library.";
 }
 
 template <typename ElementType>
-void ProjectLoader::loadLibraryElements(
-    Project& p, const QString& dirname, const QString& type,
-    void (ProjectLibrary::*addFunction)(ElementType&)) {
+QVector<QFuture<std::unique_ptr<ElementType>>>
+    ProjectLoader::openLibraryElements(Project& p,
+                                       const QString& dirname) noexcept {
+  // The opened objects must live in this thread, not in the worker threads.
+  QThread* thread = QThread::currentThread();
+  std::shared_ptr<TransactionalFileSystem> fs =
+      p.getLibrary().getDirectory().getFileSystem();
+
   // Search all subdirectories which have a valid UUID as directory name.
-  int count = 0;
+  QVector<QFuture<std::unique_ptr<ElementType>>> futures;
   foreach (const QString& sub, p.getLibrary().getDirectory().getDirs(dirname)) {
-    std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
-        p.getLibrary().getDirectory(), dirname % "/" % sub));
+    TransactionalDirectory dir(p.getLibrary().getDirectory(),
+                               dirname % "/" % sub);
 
     // Check if directory is a valid library element.
-    if (!LibraryBaseElement::isValidElementDirectory<ElementType>(*dir, "")) {
+    if (!LibraryBaseElement::isValidElementDirectory<ElementType>(dir, "")) {
       qWarning() << "Invalid directory in project library, ignoring it:"
-                 << dir->getAbsPath().toNative();
+                 << dir.getAbsPath().toNative();
       continue;
     }
 
     // Load the library element.
-    ElementType* element =
-        ElementType::open(std::move(dir)).release();  // can throw
+    const QString path = dir.getPath();
+    futures.append(startTask([fs, path, thread]() {
+      std::unique_ptr<ElementType> element =
+          ElementType::open(std::unique_ptr<TransactionalDirectory>(
+              new TransactionalDirectory(fs, path)));  // can throw
+      element->getDirectory().moveToThread(thread);
+      element->moveToThread(thread);
+      return element;
+    }));
+  }
+  return futures;
+}
+
+template <typename ElementType>
+void ProjectLoader::addLibraryElements(
+    Project& p, QVector<QFuture<std::unique_ptr<ElementType>>>& futures,
+    const QString& type, void (ProjectLibrary::*addFunction)(ElementType&)) {
+  for (QFuture<std::unique_ptr<ElementType>>& future : futures) {
+    ElementType* element = future.takeResult().release();  // can throw
     (p.getLibrary().*addFunction)(*element);
-    ++count;
   }
 
   qDebug().nospace().noquote()
-      << "Successfully loaded " << count << " " << type << ".";
+      << "Successfully loaded " << futures.count() << " " << type << ".";
 }
 
 void ProjectLoader::loadCircuit(Project& p) {
   qDebug() << "Load circuit...";
-  const QString fp = "circuit/circuit.lp";
-  const std::unique_ptr<const SExpression> root = SExpression::parse(
-      p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
+  const std::shared_ptr<const SExpression> root =
+      parse(p.getDirectory(), "circuit/circuit.lp");  // can throw
 
   // Load assembly variants.
   foreach (const SExpression* node, root->getChildren("variant")) {
@@ -517,14 +682,13 @@ void ProjectLoader::loadCircuit(Project& p) {
 
 void ProjectLoader::loadErc(Project& p) {
   qDebug() << "Load ERC approvals...";
-  const QString fp = "circuit/erc.lp";
-  const std::unique_ptr<const SExpression> root = SExpression::parse(
-      p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
+  const std::shared_ptr<const SExpression> root =
+      parse(p.getDirectory(), "circuit/erc.lp");  // can throw
 
   // Load approvals.
-  QSet<SExpression> approvals;
+  QSet<ApprovalKey> approvals;
   foreach (const SExpression* node, root->getChildren("approved")) {
-    approvals.insert(*node);
+    approvals.insert(ApprovalKey(*node));
   }
   p.setErcMessageApprovals(approvals);
 
@@ -533,9 +697,8 @@ void ProjectLoader::loadErc(Project& p) {
 
 void ProjectLoader::loadSchematics(Project& p) {
   qDebug() << "Load schematics...";
-  const QString fp = "schematics/schematics.lp";
-  const std::unique_ptr<const SExpression> indexRoot = SExpression::parse(
-      p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
+  const std::shared_ptr<const SExpression> indexRoot =
+      parse(p.getDirectory(), "schematics/schematics.lp");  // can throw
   foreach (const SExpression* indexNode, indexRoot->getChildren("schematic")) {
     loadSchematic(p, indexNode->getChild("@0").getValue());
   }
@@ -547,8 +710,8 @@ void ProjectLoader::loadSchematic(Project& p, const QString& relativeFilePath) {
   const FilePath fp = FilePath::fromRelative(p.getPath(), relativeFilePath);
   std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
       p.getDirectory(), fp.getParentDir().toRelative(p.getPath())));
-  const std::unique_ptr<const SExpression> root =
-      SExpression::parse(dir->read(fp.getFilename()), fp);
+  const std::shared_ptr<const SExpression> root =
+      parse(*dir, fp.getFilename());  // can throw
 
   Schematic* schematic =
       new Schematic(p, std::move(dir), fp.getParentDir().getFilename(),
@@ -702,9 +865,8 @@ void ProjectLoader::loadSchematicUserSettings(Schematic& s) {
 
 void ProjectLoader::loadBoards(Project& p) {
   qDebug() << "Load boards...";
-  const QString fp = "boards/boards.lp";
-  const std::unique_ptr<const SExpression> indexRoot = SExpression::parse(
-      p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
+  const std::shared_ptr<const SExpression> indexRoot =
+      parse(p.getDirectory(), "boards/boards.lp");  // can throw
   foreach (const SExpression* node, indexRoot->getChildren("board")) {
     loadBoard(p, node->getChild("@0").getValue());
   }
@@ -715,8 +877,8 @@ void ProjectLoader::loadBoard(Project& p, const QString& relativeFilePath) {
   const FilePath fp = FilePath::fromRelative(p.getPath(), relativeFilePath);
   std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
       p.getDirectory(), fp.getParentDir().toRelative(p.getPath())));
-  const std::unique_ptr<const SExpression> root =
-      SExpression::parse(dir->read(fp.getFilename()), fp);
+  const std::shared_ptr<const SExpression> root =
+      parse(*dir, fp.getFilename());  // can throw
 
   Board* board = new Board(p, std::move(dir), fp.getParentDir().getFilename(),
                            deserialize<Uuid>(root->getChild("@0")),
@@ -756,9 +918,9 @@ void ProjectLoader::loadBoard(Project& p, const QString& relativeFilePath) {
     const SExpression& node = root->getChild("design_rule_check");
     const Version approvalsVersion =
         deserialize<Version>(node.getChild("approvals_version/@0"));
-    QSet<SExpression> approvals;
+    QSet<ApprovalKey> approvals;
     foreach (const SExpression* child, node.getChildren("approved")) {
-      approvals.insert(*child);
+      approvals.insert(ApprovalKey(*child));
     }
     board->setDrcSettings(BoardDesignRuleCheckSettings(node));
     board->loadDrcMessageApprovals(approvalsVersion, approvals);
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../serialization/fileformatmigration.h"
+#include "../utils/taskscheduler.h"
 
 #include <QtCore>
 
@@ -74,6 +75,20 @@ public:
     mAutoAssignDeviceModels = v;
   }
 
+  /**
+   * @brief Enable or disable lazy loading of schematics and boards
+   *
+   * If enabled, schematics and boards are loaded on first access instead of
+   * when opening the project (see ::librepcb::Project::getSchematics() and
+   * ::librepcb::Project::getBoards()). This is intended for read-only
+   * usage where only some parts of a project are needed. If the project
+   * needs to be migrated to a newer file format, everything is loaded
+   * immediately anyway.
+   *
+   * @param v   Whether lazy loading is enabled or not (default: disabled).
+   */
+  void setLazyLoading(bool v) noexcept { mLazyLoading = v; }
+
   // General Methods
   std::unique_ptr<Project> open(
       std::unique_ptr<TransactionalDirectory> directory,
@@ -82,18 +97,40 @@ public:
     return mMigrationLog;
   }
 
+  /**
+   * @brief Get the duration of each phase of the last #open() call
+   *
+   * @return Phase names and their durations in milliseconds, in the order
+   *         they were executed.
+   */
+  const QVector<std::pair<QString, qint64>>& getTimings() const noexcept {
+    return mTimings;
+  }
+
   // Operator Overloadings
   ProjectLoader& operator=(const ProjectLoader& rhs) = delete;
 
 private:  // Methods
+  template <typename Func>
+  auto startTask(Func func) noexcept;
+  void cancelTasks() noexcept;
+  void startParsing(TransactionalDirectory& dir, const QString& path) noexcept;
+  void startParsingIndex(TransactionalDirectory& dir, const QString& path,
+                         const QString& childName) noexcept;
+  std::shared_ptr<const SExpression> parse(TransactionalDirectory& dir,
+                                           const QString& path);
+  void finishPhase(const char* name, QElapsedTimer& timer) noexcept;
   void loadMetadata(Project& p);
   void loadSettings(Project& p);
   void loadOutputJobs(Project& p);
   void loadLibrary(Project& p);
   template <typename ElementType>
-  void loadLibraryElements(Project& p, const QString& dirname,
-                           const QString& type,
-                           void (ProjectLibrary::*addFunction)(ElementType&));
+  QVector<QFuture<std::unique_ptr<ElementType>>> openLibraryElements(
+      Project& p, const QString& dirname) noexcept;
+  template <typename ElementType>
+  void addLibraryElements(
+      Project& p, QVector<QFuture<std::unique_ptr<ElementType>>>& futures,
+      const QString& type, void (ProjectLibrary::*addFunction)(ElementType&));
   void loadCircuit(Project& p);
   void loadErc(Project& p);
   void loadSchematics(Project& p);
@@ -111,7 +148,18 @@ private:  // Methods
 
 private:  // Data
   bool mAutoAssignDeviceModels;
+  bool mLazyLoading;
   std::optional<MigrationLog> mMigrationLog;
+  QVector<std::pair<QString, qint64>> mTimings;
+
+  /// Token to cancel the tasks in #mTasks which are not started yet
+  CancellationToken mCancellation;
+
+  /// Tasks parsing files and opening library elements concurrently
+  QVector<QFuture<void>> mTasks;
+
+  /// Files being parsed in #mTasks, key is the absolute file path
+  QHash<QString, QFuture<std::shared_ptr<const SExpression>>> mParsedFiles;
 };
 
 /*******************************************************************************
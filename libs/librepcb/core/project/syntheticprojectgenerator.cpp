@@ -0,0 +1,463 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "syntheticprojectgenerator.h"
+
+#include "../exceptions.h"
+#include "../fileio/transactionaldirectory.h"
+#include "../fileio/transactionalfilesystem.h"
+#include "../geometry/netlabel.h"
+#include "../geometry/path.h"
+#include "../geometry/polygon.h"
+#include "../geometry/text.h"
+#include "../geometry/via.h"
+#include "../library/cmp/component.h"
+#include "../library/dev/device.h"
+#include "../library/pkg/package.h"
+#include "../library/sym/symbol.h"
+#include "../types/layer.h"
+#include "board/board.h"
+#include "board/items/bi_device.h"
+#include "board/items/bi_netline.h"
+#include "board/items/bi_netpoint.h"
+#include "board/items/bi_netsegment.h"
+#include "board/items/bi_pad.h"
+#include "board/items/bi_plane.h"
+#include "board/items/bi_polygon.h"
+#include "board/items/bi_via.h"
+#include "circuit/assemblyvariant.h"
+#include "circuit/circuit.h"
+#include "circuit/componentinstance.h"
+#include "circuit/componentsignalinstance.h"
+#include "circuit/netclass.h"
+#include "circuit/netsignal.h"
+#include "project.h"
+#include "projectlibrary.h"
+#include "schematic/items/si_netlabel.h"
+#include "schematic/items/si_netline.h"
+#include "schematic/items/si_netpoint.h"
+#include "schematic/items/si_netsegment.h"
+#include "schematic/items/si_symbol.h"
+#include "schematic/items/si_symbolpin.h"
+#include "schematic/schematic.h"
+
+#include <QtCore>
+
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+SyntheticProjectGenerator::SyntheticProjectGenerator(const Options& options,
+                                                     quint32 seed) noexcept
+  : mOptions(options), mRandom(seed), mStatistics() {
+}
+
+SyntheticProjectGenerator::~SyntheticProjectGenerator() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+std::unique_ptr<Project> SyntheticProjectGenerator::generate(
+    const FilePath& fp) {
+  validateOptions();  // can throw
+  mStatistics = Statistics();
+
+  std::shared_ptr<TransactionalFileSystem> fs =
+      TransactionalFileSystem::openRW(fp.getParentDir());  // can throw
+  std::unique_ptr<Project> project = Project::create(
+      std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(fs)),
+      fp.getFilename());  // can throw
+  Circuit& circuit = project->getCircuit();
+  const Device& libDev = addLibraryElements(*project);  // can throw
+  const Component* libCmp =
+      project->getLibrary().getComponent(libDev.getComponentUuid());
+  Q_ASSERT(libCmp);
+
+  // Add nets.
+  QList<NetSignal*> nets;
+  NetClass& netClass = *circuit.getNetClasses().first();
+  for (int i = 0; i < mOptions.netCount; ++i) {
+    NetSignal* net =
+        new NetSignal(circuit, createUuid(), netClass,
+                      CircuitIdentifier(QString("N%1").arg(i + 1)), false);
+    circuit.addNetSignal(*net);  // can throw
+    nets.append(net);
+  }
+  mStatistics.nets = nets.count();
+
+  // Add components. The first pin is connected round-robin to make sure every
+  // net is used, the second one to a random net to get long airwires.
+  QList<ComponentInstance*> components;
+  const QSet<Uuid> assemblyVariants =
+      circuit.getAssemblyVariants().getUuidSet();
+  for (int i = 0; i < mOptions.componentCount; ++i) {
+    ComponentInstance* cmp = new ComponentInstance(
+        circuit, createUuid(), *libCmp,
+        libCmp->getSymbolVariants().first()->getUuid(),
+        CircuitIdentifier(QString("R%1").arg(i + 1)));  // can throw
+    cmp->setAssemblyOptions(ComponentAssemblyOptionList{
+        std::make_shared<ComponentAssemblyOption>(
+            libDev.getUuid(), libDev.getAttributes(), assemblyVariants,
+            PartList{}),
+    });
+    circuit.addComponentInstance(*cmp);  // can throw
+    for (int k = 0; k < libCmp->getSignals().count(); ++k) {
+      NetSignal* net = (k == 0) ? nets.at(i % nets.count())
+                                : nets.at(mRandom.bounded(nets.count()));
+      ComponentSignalInstance* sig =
+          cmp->getSignalInstance(libCmp->getSignals().at(k)->getUuid());
+      Q_ASSERT(sig);
+      sig->setNetSignal(net);  // can throw
+    }
+    components.append(cmp);
+  }
+  mStatistics.components = components.count();
+
+  addSchematics(*project, components);  // can throw
+  addBoard(*project, libDev, nets, components);  // can throw
+
+  project->save();  // can throw
+  fs->save();  // can throw
+  return project;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+Uuid SyntheticProjectGenerator::createUuid(QRandomGenerator& random) noexcept {
+  // Set version (4) and variant (DCE) bits to get a valid UUID.
+  const quint64 high = (random.generate64() & ~quint64(0xF000)) | 0x4000;
+  const quint64 low =
+      (random.generate64() & ~(quint64(0x3) << 62)) | (quint64(0x2) << 62);
+  const QString hex = QString("%1%2")
+                          .arg(high, 16, 16, QChar('0'))
+                          .arg(low, 16, 16, QChar('0'));
+  return Uuid::fromString(QString("%1-%2-%3-%4-%5")
+                              .arg(hex.mid(0, 8), hex.mid(8, 4),
+                                   hex.mid(12, 4), hex.mid(16, 4),
+                                   hex.mid(20, 12)));
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void SyntheticProjectGenerator::validateOptions() const {
+  auto check = [](bool valid, const QString& name, int value) {
+    if (!valid) {
+      throw RuntimeError(__FILE__, __LINE__,
+                         tr("Invalid value for '%1': %2").arg(name).arg(value));
+    }
+  };
+  check(mOptions.componentCount >= 0, "components", mOptions.componentCount);
+  check(mOptions.netCount >= 1, "nets", mOptions.netCount);
+  check((mOptions.innerLayerCount >= 0) &&
+            (mOptions.innerLayerCount <= Layer::innerCopperCount()),
+        "inner layers", mOptions.innerLayerCount);
+  check(mOptions.schematicCount >= 1, "schematics", mOptions.schematicCount);
+  check(mOptions.planeCount >= 0, "planes", mOptions.planeCount);
+  check((mOptions.tracePercent >= 0) && (mOptions.tracePercent <= 100),
+        "traces", mOptions.tracePercent);
+  check((mOptions.viaPercent >= 0) && (mOptions.viaPercent <= 100), "vias",
+        mOptions.viaPercent);
+}
+
+const Device& SyntheticProjectGenerator::addLibraryElements(
+    Project& project) {
+  const Version version = Version::fromString("0.1");
+  const QString author = "LibrePCB";
+  const ElementName name("Resistor");
+  const QList<CircuitIdentifier> pinNames = {CircuitIdentifier("1"),
+                                             CircuitIdentifier("2")};
+
+  // Symbol with the pins on the left and right side of a rectangle.
+  std::unique_ptr<Symbol> sym(
+      new Symbol(createUuid(), version, author, name, "", ""));
+  const UnsignedLength pinLength(2540000);
+  for (int i = 0; i < pinNames.count(); ++i) {
+    sym->getPins().append(std::make_shared<SymbolPin>(
+        createUuid(), pinNames.at(i), Point((i == 0) ? -5080000 : 5080000, 0),
+        pinLength, (i == 0) ? Angle::deg0() : Angle::deg180(),
+        SymbolPin::getDefaultNamePosition(pinLength), Angle::deg0(),
+        SymbolPin::getDefaultNameHeight(),
+        SymbolPin::getDefaultNameAlignment()));
+  }
+  sym->getPolygons().append(std::make_shared<Polygon>(
+      createUuid(), Layer::symbolOutlines(), UnsignedLength(254000), false,
+      true, Path::centeredRect(PositiveLength(5080000),
+                               PositiveLength(2540000))));
+  sym->getTexts().append(std::make_shared<Text>(
+      createUuid(), Layer::symbolNames(), "{{NAME}}", Point(0, 1905000),
+      Angle::deg0(), PositiveLength(2540000),
+      Alignment(HAlign::center(), VAlign::bottom()), false));
+  sym->getTexts().append(std::make_shared<Text>(
+      createUuid(), Layer::symbolValues(), "{{VALUE}}", Point(0, -1905000),
+      Angle::deg0(), PositiveLength(2540000),
+      Alignment(HAlign::center(), VAlign::top()), false));
+
+  // Component with one signal per symbol pin.
+  std::unique_ptr<Component> cmp(
+      new Component(createUuid(), version, author, name, "", ""));
+  cmp->setPrefixes(NormDependentPrefixMap(ComponentPrefix("R")));
+  auto symbolItem = std::make_shared<ComponentSymbolVariantItem>(
+      createUuid(), sym->getUuid(), Point(0, 0), Angle::deg0(), true,
+      ComponentSymbolVariantItemSuffix(""));
+  for (int i = 0; i < pinNames.count(); ++i) {
+    auto signal = std::make_shared<ComponentSignal>(
+        createUuid(), pinNames.at(i), SignalRole::passive(), QString(), false,
+        false, false);
+    cmp->getSignals().append(signal);
+    symbolItem->getPinSignalMap().append(
+        std::make_shared<ComponentPinSignalMapItem>(
+            sym->getPins().at(i)->getUuid(), signal->getUuid(),
+            CmpSigPinDisplayType::componentSignal()));
+  }
+  auto symbolVariant = std::make_shared<ComponentSymbolVariant>(
+      createUuid(), "", ElementName("default"), "");
+  symbolVariant->getSymbolItems().append(symbolItem);
+  cmp->getSymbolVariants().append(symbolVariant);
+
+  // Package with THT pads, thus traces can be connected on any copper layer.
+  std::unique_ptr<Package> pkg(new Package(createUuid(), version, author, name,
+                                           "", "", Package::AssemblyType::Tht));
+  auto footprint =
+      std::make_shared<Footprint>(createUuid(), ElementName("default"), "");
+  for (int i = 0; i < pinNames.count(); ++i) {
+    auto pkgPad = std::make_shared<PackagePad>(createUuid(), pinNames.at(i));
+    pkg->getPads().append(pkgPad);
+    footprint->getPads().append(std::make_shared<FootprintPad>(
+        createUuid(), pkgPad->getUuid(),
+        Point((i == 0) ? -1270000 : 1270000, 0), Angle::deg0(),
+        FootprintPad::Shape::RoundedRect, PositiveLength(1600000),
+        PositiveLength(1600000), UnsignedLimitedRatio(Ratio::fromPercent(100)),
+        Path(), MaskConfig::automatic(), MaskConfig::off(), UnsignedLength(0),
+        FootprintPad::ComponentSide::Top, FootprintPad::Function::StandardPad,
+        PadHoleList{std::make_shared<PadHole>(
+            createUuid(), PositiveLength(800000),
+            makeNonEmptyPath(Point(0, 0)))}));
+  }
+  footprint->getPolygons().append(std::make_shared<Polygon>(
+      createUuid(), Layer::topLegend(), UnsignedLength(200000), false, false,
+      Path::centeredRect(PositiveLength(4600000), PositiveLength(2200000))));
+  pkg->getFootprints().append(footprint);
+
+  // Device mapping the pads to the component signals.
+  std::unique_ptr<Device> dev(new Device(createUuid(), version, author, name,
+                                         "", "", cmp->getUuid(),
+                                         pkg->getUuid()));
+  for (int i = 0; i < pinNames.count(); ++i) {
+    dev->getPadSignalMap().append(std::make_shared<DevicePadSignalMapItem>(
+        pkg->getPads().at(i)->getUuid(), cmp->getSignals().at(i)->getUuid()));
+  }
+
+  ProjectLibrary& library = project.getLibrary();
+  library.addSymbol(*sym.release());  // can throw
+  library.addPackage(*pkg.release());  // can throw
+  library.addComponent(*cmp.release());  // can throw
+  Device* devPtr = dev.release();
+  library.addDevice(*devPtr);  // can throw
+  return *devPtr;
+}
+
+void SyntheticProjectGenerator::addSchematics(
+    Project& project, const QList<ComponentInstance*>& components) {
+  for (int s = 0; s < mOptions.schematicCount; ++s) {
+    Schematic* schematic = new Schematic(
+        project,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        QString("sheet_%1").arg(s + 1), createUuid(),
+        ElementName(QString("Sheet %1").arg(s + 1)));  // can throw
+    project.addSchematic(*schematic);  // can throw
+    ++mStatistics.schematics;
+
+    // Place the symbols of this sheet in a grid and connect each pin with a
+    // short wire to a net label.
+    const int first = s * components.count() / mOptions.schematicCount;
+    const int last = (s + 1) * components.count() / mOptions.schematicCount;
+    const int columns = std::max(qCeil(std::sqrt(last - first)), 1);
+    for (int i = first; i < last; ++i) {
+      ComponentInstance& cmp = *components.at(i);
+      const Point pos(Length(20320000) * ((i - first) % columns),
+                      Length(-12700000) * ((i - first) / columns));
+      SI_Symbol* symbol = new SI_Symbol(
+          *schematic, createUuid(), cmp,
+          cmp.getSymbolVariant().getSymbolItems().first()->getUuid(), pos,
+          Angle::deg0(), false, true);  // can throw
+      schematic->addSymbol(*symbol);  // can throw
+      // Iterate over the library pins for a deterministic order.
+      for (const SymbolPin& libPin : symbol->getLibSymbol().getPins()) {
+        SI_SymbolPin* pin = symbol->getPin(libPin.getUuid());
+        NetSignal* net = pin ? pin->getCompSigInstNetSignal() : nullptr;
+        if (!net) continue;
+        const bool left = pin->getPosition().getX() < pos.getX();
+        const Point labelPos =
+            pin->getPosition() + Point(left ? -2540000 : 2540000, 0);
+        SI_NetSegment* segment =
+            new SI_NetSegment(*schematic, createUuid(), *net);
+        schematic->addNetSegment(*segment);  // can throw
+        SI_NetPoint* netPoint =
+            new SI_NetPoint(*segment, createUuid(), labelPos);
+        SI_NetLine* netLine = new SI_NetLine(*segment, createUuid(), *pin,
+                                             *netPoint, UnsignedLength(158750));
+        segment->addNetPointsAndNetLines({netPoint}, {netLine});  // can throw
+        segment->addNetLabel(*new SI_NetLabel(
+            *segment,
+            NetLabel(createUuid(), labelPos, Angle::deg0(), left)));
+        ++mStatistics.netLabels;
+      }
+    }
+  }
+}
+
+void SyntheticProjectGenerator::addBoard(
+    Project& project, const Device& libDev, const QList<NetSignal*>& nets,
+    const QList<ComponentInstance*>& components) {
+  Board* board = new Board(
+      project,
+      std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+      "default", createUuid(), ElementName("default"));  // can throw
+  project.addBoard(*board);  // can throw
+  board->setInnerLayerCount(mOptions.innerLayerCount);
+  QList<const Layer*> copperLayers = {&Layer::topCopper(), &Layer::botCopper()};
+  for (int i = 1; i <= mOptions.innerLayerCount; ++i) {
+    copperLayers.append(Layer::innerCopper(i));
+  }
+
+  // Place the devices in a grid of square cells.
+  const Length cellSize(5000000);
+  const int count = components.count();
+  const int columns = std::max(qCeil(std::sqrt(count)), 1);
+  const int rows = std::max((count + columns - 1) / columns, 1);
+  const Point boardSize(cellSize * (columns + 2), cellSize * (rows + 2));
+  board->addPolygon(*new BI_Polygon(
+      *board,
+      BoardPolygonData(createUuid(), Layer::boardOutlines(), UnsignedLength(0),
+                       Path::rect(Point(0, 0), boardSize), false, false,
+                       false)));
+  const Package* libPkg =
+      project.getLibrary().getPackage(libDev.getPackageUuid());
+  Q_ASSERT(libPkg);
+  const Uuid footprintUuid = libPkg->getFootprints().first()->getUuid();
+  QHash<const NetSignal*, QList<BI_Pad*>> netPads;
+  for (int i = 0; i < count; ++i) {
+    const Point pos(cellSize * (1 + (i % columns)) + cellSize / 2,
+                    cellSize * (1 + (i / columns)) + cellSize / 2);
+    const Angle rotation =
+        (mRandom.bounded(2) == 0) ? Angle::deg0() : Angle::deg90();
+    BI_Device* device =
+        new BI_Device(*board, *components.at(i), libDev.getUuid(),
+                      footprintUuid, pos, rotation, false, false, true,
+                      true);  // can throw
+    board->addDeviceInstance(*device);  // can throw
+    for (const FootprintPad& fptPad : device->getLibFootprint().getPads()) {
+      BI_Pad* pad = device->getPad(fptPad.getUuid());
+      if (NetSignal* net = pad ? pad->getNetSignal() : nullptr) {
+        netPads[net].append(pad);
+      }
+    }
+  }
+
+  // Connect consecutive pads of each net with traces.
+  for (NetSignal* net : nets) {
+    const QList<BI_Pad*> pads = netPads.value(net);
+    for (int i = 1; i < pads.count(); ++i) {
+      if (static_cast<int>(mRandom.bounded(100)) < mOptions.tracePercent) {
+        addTrace(*board, *net, copperLayers, *pads.at(i - 1),
+                 *pads.at(i));  // can throw
+      }
+    }
+  }
+
+  // Add planes covering the whole board, alternating through the layers.
+  const Path planeOutline =
+      Path::rect(Point(1000000, 1000000), boardSize - Point(1000000, 1000000));
+  for (int i = 0; i < mOptions.planeCount; ++i) {
+    board->addPlane(*new BI_Plane(*board, createUuid(),
+                                  *copperLayers.at(i % copperLayers.count()),
+                                  nets.at(i % nets.count()),
+                                  planeOutline));  // can throw
+    ++mStatistics.planes;
+  }
+}
+
+void SyntheticProjectGenerator::addTrace(Board& board, NetSignal& net,
+                                         const QList<const Layer*>& layers,
+                                         BI_Pad& a, BI_Pad& b) {
+  const Point p1 = a.getPosition();
+  const Point p2 = b.getPosition();
+  Point corner(p2.getX(), p1.getY());
+  if ((corner == p1) || (corner == p2)) {
+    corner = (p1 + p2) / 2;
+  }
+  const Layer* layer1 = layers.at(mRandom.bounded(layers.count()));
+  const Layer* layer2 = layer1;
+  const PositiveLength width(randomLength(Length(150000), Length(300000)));
+  const bool addVia =
+      static_cast<int>(mRandom.bounded(100)) < mOptions.viaPercent;
+
+  BI_NetSegment* segment = new BI_NetSegment(board, createUuid(), &net);
+  board.addNetSegment(*segment);  // can throw
+  QList<BI_Via*> vias;
+  QList<BI_NetPoint*> netPoints;
+  BI_NetLineAnchor* middle = nullptr;
+  if (addVia) {
+    BI_Via* via = new BI_Via(
+        *segment,
+        Via(createUuid(), Layer::topCopper(), Layer::botCopper(), corner,
+            PositiveLength(300000), PositiveLength(600000), MaskConfig::off()));
+    vias.append(via);
+    middle = via;
+    layer2 = layers.at(mRandom.bounded(layers.count()));
+  } else {
+    BI_NetPoint* netPoint = new BI_NetPoint(*segment, createUuid(), corner);
+    netPoints.append(netPoint);
+    middle = netPoint;
+  }
+  const QList<BI_NetLine*> netLines = {
+      new BI_NetLine(*segment, createUuid(), a, *middle, *layer1, width),
+      new BI_NetLine(*segment, createUuid(), *middle, b, *layer2, width),
+  };
+  segment->addElements({}, vias, netPoints, netLines);  // can throw
+  mStatistics.traces += netLines.count();
+  mStatistics.vias += vias.count();
+}
+
+Length SyntheticProjectGenerator::randomLength(const Length& min,
+                                               const Length& max) noexcept {
+  return Length(min.toNm() + mRandom.bounded(max.toNm() - min.toNm()));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
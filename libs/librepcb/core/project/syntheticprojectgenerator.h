@@ -0,0 +1,157 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_SYNTHETICPROJECTGENERATOR_H
+#define LIBREPCB_CORE_SYNTHETICPROJECTGENERATOR_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../types/length.h"
+#include "../types/uuid.h"
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class BI_Pad;
+class Board;
+class ComponentInstance;
+class Device;
+class FilePath;
+class Layer;
+class NetSignal;
+class Project;
+
+/*******************************************************************************
+ *  Class SyntheticProjectGenerator
+ ******************************************************************************/
+
+/**
+ * @brief Generates large, valid projects for stress testing
+ *
+ * The generated project contains a two-pin component (with symbol, package
+ * and device in the project library) instantiated many times, distributed
+ * over several schematic sheets and placed in a grid on a single board.
+ * Every pin is connected to a net, in the schematics with a short wire and a
+ * net label, on the board (partially) with traces and vias. In addition,
+ * planes covering the whole board can be added.
+ *
+ * The content only depends on the options and the seed, so the same input
+ * always leads to the same schematics and boards. Only the few UUIDs created
+ * by ::librepcb::Project::create() (project, net class, assembly variant) are
+ * random.
+ */
+class SyntheticProjectGenerator final {
+  Q_DECLARE_TR_FUNCTIONS(SyntheticProjectGenerator)
+
+public:
+  // Types
+  struct Options {
+    int componentCount = 100;  ///< Number of two-pin components
+    int netCount = 50;  ///< Number of nets the pins are connected to
+    int innerLayerCount = 0;  ///< Number of inner copper layers
+    int schematicCount = 1;  ///< Number of schematic sheets
+    int planeCount = 2;  ///< Number of planes, alternating the layers
+    int tracePercent = 100;  ///< Percentage of connections routed by traces
+    int viaPercent = 50;  ///< Percentage of routed connections with via
+  };
+
+  struct Statistics {
+    int components = 0;
+    int nets = 0;
+    int schematics = 0;
+    int netLabels = 0;
+    int traces = 0;
+    int vias = 0;
+    int planes = 0;
+  };
+
+  // Constructors / Destructor
+  SyntheticProjectGenerator() = delete;
+  SyntheticProjectGenerator(const SyntheticProjectGenerator& other) = delete;
+  explicit SyntheticProjectGenerator(const Options& options,
+                                     quint32 seed = 0) noexcept;
+  ~SyntheticProjectGenerator() noexcept;
+
+  // Getters
+  const Options& getOptions() const noexcept { return mOptions; }
+  const Statistics& getStatistics() const noexcept { return mStatistics; }
+
+  // General Methods
+
+  /**
+   * @brief Create and save a new project
+   *
+   * @param fp  File path of the project file to create (*.lpp). The parent
+   *            directory must not contain a project yet.
+   *
+   * @return The created (and already saved) project.
+   *
+   * @throw Exception if the options are invalid or the project could not be
+   *                  created.
+   */
+  std::unique_ptr<Project> generate(const FilePath& fp);
+
+  // Static Methods
+
+  /**
+   * @brief Create a deterministic (version 4) UUID
+   *
+   * @param random  The random generator to derive the UUID from.
+   *
+   * @return A valid UUID derived from the random generator state.
+   */
+  static Uuid createUuid(QRandomGenerator& random) noexcept;
+
+  // Operator Overloadings
+  SyntheticProjectGenerator& operator=(const SyntheticProjectGenerator& rhs) =
+      delete;
+
+private:  // Methods
+  void validateOptions() const;
+  Uuid createUuid() noexcept { return createUuid(mRandom); }
+  const Device& addLibraryElements(Project& project);
+  void addSchematics(Project& project,
+                     const QList<ComponentInstance*>& components);
+  void addBoard(Project& project, const Device& libDev,
+                const QList<NetSignal*>& nets,
+                const QList<ComponentInstance*>& components);
+  void addTrace(Board& board, NetSignal& net, const QList<const Layer*>& layers,
+                BI_Pad& a, BI_Pad& b);
+  Length randomLength(const Length& min, const Length& max) noexcept;
+
+private:  // Data
+  const Options mOptions;
+  QRandomGenerator mRandom;
+  Statistics mStatistics;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "approvalkey.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Non-Member Functions
+ ******************************************************************************/
+
+static void addToHash(QCryptographicHash& hash, const QString& str) noexcept {
+  // Prefix with the length to avoid ambiguities between adjacent strings.
+  const QByteArray utf8 = str.toUtf8();
+  const quint32 size = qToLittleEndian(static_cast<quint32>(utf8.size()));
+  hash.addData(QByteArrayView(reinterpret_cast<const char*>(&size),
+                              sizeof(size)));
+  hash.addData(utf8);
+}
+
+static void addToHash(QCryptographicHash& hash,
+                      const SExpression& node) noexcept {
+  const char type = static_cast<char>(node.getType());
+  hash.addData(QByteArrayView(&type, 1));
+  switch (node.getType()) {
+    case SExpression::Type::List: {
+      addToHash(hash, node.getName());
+      const quint32 count =
+          qToLittleEndian(static_cast<quint32>(node.getChildCount()));
+      hash.addData(QByteArrayView(reinterpret_cast<const char*>(&count),
+                                  sizeof(count)));
+      for (int i = 0; i < static_cast<int>(node.getChildCount()); ++i) {
+        addToHash(hash, node.getChild(i));
+      }
+      break;
+    }
+    case SExpression::Type::Token:
+    case SExpression::Type::String:
+      addToHash(hash, node.getValue());
+      break;
+    case SExpression::Type::LineBreak:
+      break;
+    default:
+      Q_ASSERT(false);
+      break;
+  }
+}
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ApprovalKey::ApprovalKey(const SExpression& node) noexcept
+  : mNode(std::make_shared<const SExpression>(node)), mHigh(0), mLow(0) {
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  addToHash(hash, node);
+  const QByteArray result = hash.result();
+  Q_ASSERT(result.size() == 16);
+  mHigh = qFromBigEndian<quint64>(result.constData());
+  mLow = qFromBigEndian<quint64>(result.constData() + 8);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
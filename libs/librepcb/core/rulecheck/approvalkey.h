@@ -0,0 +1,100 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_APPROVALKEY_H
+#define LIBREPCB_CORE_APPROVALKEY_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../serialization/sexpression.h"
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class ApprovalKey
+ ******************************************************************************/
+
+/**
+ * @brief Compact identifier of a rule check message approval
+ *
+ * Approvals are stored as ::librepcb::SExpression nodes in the files, but
+ * comparing and hashing whole S-Expression trees is expensive when
+ * building or intersecting sets of thousands of approvals. Therefore this
+ * class calculates a 128-bit hash of the node once at construction and uses
+ * only that hash for equality comparison and `qHash()`. The node itself is
+ * shared implicitly and only needed for serialization and sorting.
+ */
+class ApprovalKey final {
+public:
+  // Constructors / Destructor
+  ApprovalKey() = delete;
+  ApprovalKey(const ApprovalKey& other) noexcept = default;
+  explicit ApprovalKey(const SExpression& node) noexcept;
+  ~ApprovalKey() noexcept = default;
+
+  // Getters
+  const SExpression& getNode() const noexcept { return *mNode; }
+
+  // General Methods
+  std::size_t hash(std::size_t seed) const noexcept {
+    return ::qHash(mLow, seed);
+  }
+
+  // Operator Overloadings
+  bool operator==(const ApprovalKey& rhs) const noexcept {
+    return (mHigh == rhs.mHigh) && (mLow == rhs.mLow);
+  }
+  bool operator!=(const ApprovalKey& rhs) const noexcept {
+    return !(*this == rhs);
+  }
+  bool operator<(const ApprovalKey& rhs) const noexcept {
+    return (*mNode) < (*rhs.mNode);
+  }
+  ApprovalKey& operator=(const ApprovalKey& rhs) noexcept = default;
+
+private:  // Data
+  std::shared_ptr<const SExpression> mNode;
+  quint64 mHigh;
+  quint64 mLow;
+};
+
+/*******************************************************************************
+ *  Non-Member Functions
+ ******************************************************************************/
+
+inline std::size_t qHash(const ApprovalKey& key,
+                         std::size_t seed = 0) noexcept {
+  return key.hash(seed);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -36,7 +36,8 @@ RuleCheckMessage::RuleCheckMessage(const RuleCheckMessage& other) noexcept
     mMessage(other.mMessage),
     mDescription(other.mDescription),
     mApproval(new SExpression(*other.mApproval)),
-    mLocations(other.mLocations) {
+    mLocations(other.mLocations),
+    mApprovalKey(other.mApprovalKey) {
 }
 
 RuleCheckMessage::RuleCheckMessage(Severity severity, const QString& msg,
@@ -47,7 +48,8 @@ RuleCheckMessage::RuleCheckMessage(Severity severity, const QString& msg,
     mMessage(msg),
     mDescription(description),
     mApproval(SExpression::createList("approved")),
-    mLocations(locations) {
+    mLocations(locations),
+    mApprovalKey() {
   mApproval->appendChild(SExpression::createToken(approvalName));  // snake_case
 }
 
@@ -62,6 +64,13 @@ const QIcon& RuleCheckMessage::getSeverityIcon() const noexcept {
   return getSeverityIcon(mSeverity);
 }
 
+const ApprovalKey& RuleCheckMessage::getApprovalKey() const noexcept {
+  if (!mApprovalKey) {
+    mApprovalKey.emplace(*mApproval);
+  }
+  return *mApprovalKey;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -89,12 +98,13 @@ const QIcon& RuleCheckMessage::getSeverityIcon(Severity severity) noexcept {
   return icon[severity];
 }
 
-QSet<SExpression> RuleCheckMessage::getAllApprovals(
+QSet<ApprovalKey> RuleCheckMessage::getAllApprovals(
     const QVector<std::shared_ptr<const RuleCheckMessage>>& messages) noexcept {
-  QSet<SExpression> approvals;
+  QSet<ApprovalKey> approvals;
+  approvals.reserve(messages.count());
   foreach (const auto& msg, messages) {
     Q_ASSERT(msg);
-    approvals.insert(msg->getApproval());
+    approvals.insert(msg->getApprovalKey());
   }
   return approvals;
 }
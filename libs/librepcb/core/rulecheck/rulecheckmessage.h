@@ -25,10 +25,12 @@
  ******************************************************************************/
 #include "../geometry/path.h"
 #include "../serialization/sexpression.h"
+#include "approvalkey.h"
 
 #include <QtCore>
 
 #include <memory>
+#include <optional>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -63,6 +65,7 @@ public:
   const QString& getMessage() const noexcept { return mMessage; }
   const QString& getDescription() const noexcept { return mDescription; }
   const SExpression& getApproval() const noexcept { return *mApproval; }
+  const ApprovalKey& getApprovalKey() const noexcept;
   const QVector<Path>& getLocations() const noexcept { return mLocations; }
 
   // General Methods
@@ -78,7 +81,7 @@ public:
   // Static Methods
   static QString getSeverityTr(Severity severity) noexcept;
   static const QIcon& getSeverityIcon(Severity severity) noexcept;
-  static QSet<SExpression> getAllApprovals(
+  static QSet<ApprovalKey> getAllApprovals(
       const QVector<std::shared_ptr<const RuleCheckMessage>>&
           messages) noexcept;
 
@@ -99,6 +102,11 @@ protected:  // Data
   QString mDescription;
   std::unique_ptr<SExpression> mApproval;
   QVector<Path> mLocations;
+
+private:  // Data
+  /// Lazily created from #mApproval since subclasses modify it in their
+  /// constructors (thus #getApprovalKey() is not thread-safe)
+  mutable std::optional<ApprovalKey> mApprovalKey;
 };
 
 typedef QVector<std::shared_ptr<const RuleCheckMessage>> RuleCheckMessageList;
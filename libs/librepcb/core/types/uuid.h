@@ -69,7 +69,7 @@ public:
    *
    * @param other     Another ::librepcb::Uuid object
    */
-  Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+  Uuid(const Uuid& other) noexcept : mHigh(other.mHigh), mLow(other.mLow) {}
 
   /**
    * @brief Destructor
@@ -86,9 +86,13 @@ public:
   /**
    * @brief Get the UUID as a string (without braces)
    *
+   * @note  The string is generated on every call since only the 128-bit
+   *        value is stored, so avoid calling this in performance critical
+   *        code.
+   *
    * @return The UUID as a string
    */
-  QString toStr() const noexcept { return mUuid; }
+  QString toStr() const noexcept;
 
   //@{
   /**
@@ -96,20 +100,37 @@ public:
    *
    * @param rhs   The other object to compare
    *
-   * @return Result of comparing the UUIDs as strings
+   * @return Result of comparing the UUIDs (same order as comparing them as
+   *         strings)
    */
   Uuid& operator=(const Uuid& rhs) noexcept {
-    mUuid = rhs.mUuid;
+    mHigh = rhs.mHigh;
+    mLow = rhs.mLow;
     return *this;
   }
-  bool operator==(const Uuid& rhs) const noexcept { return mUuid == rhs.mUuid; }
-  bool operator!=(const Uuid& rhs) const noexcept { return mUuid != rhs.mUuid; }
-  bool operator<(const Uuid& rhs) const noexcept { return mUuid < rhs.mUuid; }
-  bool operator>(const Uuid& rhs) const noexcept { return mUuid > rhs.mUuid; }
-  bool operator<=(const Uuid& rhs) const noexcept { return mUuid <= rhs.mUuid; }
-  bool operator>=(const Uuid& rhs) const noexcept { return mUuid >= rhs.mUuid; }
+  bool operator==(const Uuid& rhs) const noexcept {
+    return (mHigh == rhs.mHigh) && (mLow == rhs.mLow);
+  }
+  bool operator!=(const Uuid& rhs) const noexcept { return !(*this == rhs); }
+  bool operator<(const Uuid& rhs) const noexcept {
+    return (mHigh < rhs.mHigh) || ((mHigh == rhs.mHigh) && (mLow < rhs.mLow));
+  }
+  bool operator>(const Uuid& rhs) const noexcept { return rhs < *this; }
+  bool operator<=(const Uuid& rhs) const noexcept { return !(rhs < *this); }
+  bool operator>=(const Uuid& rhs) const noexcept { return !(*this < rhs); }
   //@}
 
+  /**
+   * @brief Calculate the hash of this UUID
+   *
+   * @param seed    Hash seed.
+   *
+   * @return Hash of the 128-bit value
+   */
+  std::size_t hash(std::size_t seed = 0) const noexcept {
+    return qHashMulti(seed, mHigh, mLow);
+  }
+
   // Static Methods
 
   /**
@@ -153,14 +174,28 @@ public:
 
 private:  // Methods
   /**
-   * @brief Constructor which creates a Uuid object from a string
+   * @brief Constructor which creates a Uuid object from its 128-bit value
+   *
+   * @param high      The upper 64 bits (first 16 characters of the string)
+   * @param low       The lower 64 bits (last 16 characters of the string)
+   */
+  Uuid(quint64 high, quint64 low) noexcept : mHigh(high), mLow(low) {}
+
+  /**
+   * @brief Parse and validate a UUID string
+   *
+   * @param str       The string to parse
    *
-   * @param str       The uuid as a string (lowercase and without braces)
+   * @return The parsed UUID, or std::nullopt if the string is not valid
    */
-  explicit Uuid(const QString& str) noexcept : mUuid(str) {}
+  static std::optional<Uuid> parse(const QString& str) noexcept;
 
 private:  // Data
-  QString mUuid;  ///< Guaranteed to always contain a valid UUID
+  // Guaranteed to always contain a valid UUID. Stored as plain integers
+  // rather than as a string to get fast comparisons and hashes, as UUIDs
+  // are used as keys in lots of containers.
+  quint64 mHigh;
+  quint64 mLow;
 };
 
 /*******************************************************************************
@@ -178,7 +213,7 @@ inline QDebug operator<<(QDebug stream, const Uuid& uuid) noexcept {
 }
 
 inline std::size_t qHash(const Uuid& key, std::size_t seed = 0) noexcept {
-  return ::qHash(key.toStr(), seed);
+  return key.hash(seed);
 }
 
 }  // namespace librepcb
@@ -186,7 +221,7 @@ inline std::size_t qHash(const Uuid& key, std::size_t seed = 0) noexcept {
 namespace std {
 inline size_t qHash(const optional<librepcb::Uuid>& key,
                     size_t seed = 0) noexcept {
-  return ::qHash(key ? key->toStr() : QString(), seed);
+  return key ? key->hash(seed) : ::qHash(0, seed);
 }
 }  // namespace std
 
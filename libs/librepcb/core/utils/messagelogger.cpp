@@ -59,12 +59,16 @@ QString MessageLogger::Message::toRichText(bool colorized,
  ******************************************************************************/
 
 MessageLogger::MessageLogger(bool record, QObject* parent) noexcept
-  : QObject(parent), mMutex(), mParent(), mRecord(record) {
+  : QObject(parent), mMutex(), mParent(), mRecord(record), mPrint(true) {
 }
 
 MessageLogger::MessageLogger(MessageLogger* parentLogger, const QString& group,
                              bool record, QObject* parent) noexcept
-  : QObject(parent), mMutex(), mParent(parentLogger), mRecord(record) {
+  : QObject(parent),
+    mMutex(),
+    mParent(parentLogger),
+    mRecord(record),
+    mPrint(true) {
   if (!group.isEmpty()) {
     mPrefix = "[" % group % "] ";
   }
@@ -107,6 +111,15 @@ QString MessageLogger::getMessagesRichText(bool colorized) const noexcept {
   return l.join("<br>");
 }
 
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void MessageLogger::setPrintMessages(bool print) noexcept {
+  QMutexLocker lock(&mMutex);
+  mPrint = print;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -120,7 +133,7 @@ void MessageLogger::log(QtMsgType type, const QString& msg) noexcept {
   QMutexLocker lock(&mMutex);
   if (mParent) {
     mParent->log(type, mPrefix % msg);
-  } else {
+  } else if (mPrint) {
     qt_message_output(type, QMessageLogContext(), msg);
   }
   const Message obj{type, msg};
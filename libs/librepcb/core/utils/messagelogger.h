@@ -83,6 +83,19 @@ public:
   QStringList getMessagesPlain() const noexcept;
   QString getMessagesRichText(bool colorized = true) const noexcept;
 
+  // Setters
+
+  /**
+   * @brief Enable or disable printing messages of a top-level logger
+   *
+   * By default, a top-level logger prints all messages with
+   * `qt_message_output()`. Disabling it is useful to only record messages
+   * in a worker thread and log them later in another logger.
+   *
+   * @param print   Whether messages shall be printed or not.
+   */
+  void setPrintMessages(bool print) noexcept;
+
   // General Methods
   void clear() noexcept;
   void log(QtMsgType type, const QString& msg) noexcept;
@@ -102,6 +115,7 @@ private:  // Data
   QPointer<MessageLogger> mParent;
   QString mPrefix;
   bool mRecord;
+  bool mPrint;
   QList<Message> mMessages;
 };
 
@@ -0,0 +1,208 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "taskscheduler.h"
+
+#include "scopeguard.h"
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+// The scheduler whose task is currently executed by the calling thread.
+static thread_local TaskScheduler* sCurrentScheduler = nullptr;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+TaskScheduler::TaskScheduler(int maxThreadCount) noexcept
+  : mPool(), mMutex(), mIdleCondition(), mGroups() {
+  mPool.setObjectName("TaskScheduler");
+  setMaxThreadCount(maxThreadCount);
+
+  // Subsystems which must not run concurrently to themselves.
+  mGroups[static_cast<int>(Group::LibraryScan)].limit = 1;
+  mGroups[static_cast<int>(Group::Scene3D)].limit = 1;
+
+  // Subsystems which don't benefit from more threads than CPU cores, even if
+  // the pool got enlarged.
+  const int cores = QThread::idealThreadCount();
+  mGroups[static_cast<int>(Group::Models3D)].limit = cores;
+  mGroups[static_cast<int>(Group::ProjectLoad)].limit = cores;
+
+  // Opening library elements in the background must not occupy all cores
+  // while the user is working.
+  mGroups[static_cast<int>(Group::Library)].limit = qBound(1, cores / 2, 4);
+
+  // Output jobs run sequentially unless configured otherwise by the runner.
+  mGroups[static_cast<int>(Group::OutputJobs)].limit = 1;
+}
+
+TaskScheduler::~TaskScheduler() noexcept {
+  waitForDone();
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+TaskScheduler& TaskScheduler::instance() noexcept {
+  static TaskScheduler scheduler;
+  return scheduler;
+}
+
+int TaskScheduler::getMaxThreadCount() const noexcept {
+  return mPool.maxThreadCount();
+}
+
+int TaskScheduler::getConcurrencyLimit(Group group) const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mGroups.at(static_cast<int>(group)).limit;
+}
+
+int TaskScheduler::getQueuedTasksCount(Group group) const noexcept {
+  QMutexLocker lock(&mMutex);
+  int count = 0;
+  for (const auto& queue : mGroups.at(static_cast<int>(group)).queues) {
+    count += queue.count();
+  }
+  return count;
+}
+
+int TaskScheduler::getRunningTasksCount(Group group) const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mGroups.at(static_cast<int>(group)).running;
+}
+
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void TaskScheduler::setMaxThreadCount(int count) noexcept {
+  mPool.setMaxThreadCount((count > 0) ? count : QThread::idealThreadCount());
+}
+
+void TaskScheduler::setConcurrencyLimit(Group group, int limit) noexcept {
+  QMutexLocker lock(&mMutex);
+  GroupData& data = mGroups[static_cast<int>(group)];
+  data.limit = std::max(limit, 0);
+  dispatch(data);  // In case the limit was increased.
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+bool TaskScheduler::waitForDone(int msecs) noexcept {
+  QDeadlineTimer deadline(msecs);
+  QMutexLocker lock(&mMutex);
+  auto isIdle = [this]() {
+    for (const GroupData& data : mGroups) {
+      if (data.running > 0) return false;
+      for (const auto& queue : data.queues) {
+        if (!queue.isEmpty()) return false;
+      }
+    }
+    return true;
+  };
+  while (!isIdle()) {
+    if (!mIdleCondition.wait(&mMutex, deadline)) {
+      return false;
+    }
+  }
+  lock.unlock();
+  return mPool.waitForDone(static_cast<int>(deadline.remainingTime()));
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void TaskScheduler::enqueue(Group group, Priority priority,
+                            std::function<void()> func) noexcept {
+  QMutexLocker lock(&mMutex);
+  GroupData& data = mGroups[static_cast<int>(group)];
+  data.queues[static_cast<int>(priority)].enqueue(
+      [this, group, priority, func]() { execute(group, priority, func); });
+  dispatch(data);
+}
+
+void TaskScheduler::dispatch(GroupData& data) noexcept {
+  // Note: Must be called with the mutex locked.
+  while ((data.limit <= 0) || (data.running < data.limit)) {
+    // Start the queued task with the highest priority.
+    bool started = false;
+    for (int i = static_cast<int>(data.queues.size()) - 1; i >= 0; --i) {
+      if (!data.queues[i].isEmpty()) {
+        ++data.running;
+        mPool.start(data.queues[i].dequeue(), i);
+        started = true;
+        break;
+      }
+    }
+    if (!started) {
+      break;
+    }
+  }
+}
+
+void TaskScheduler::execute(Group group, Priority priority,
+                            const std::function<void()>& func) noexcept {
+  QThread* thread = QThread::currentThread();
+  const QThread::Priority threadPriority = thread->priority();
+  if (priority == Priority::Background) {
+    thread->setPriority(QThread::LowestPriority);
+  }
+  TaskScheduler* previousScheduler = sCurrentScheduler;
+  sCurrentScheduler = this;
+  func();  // Does not throw, exceptions are passed to the future.
+  sCurrentScheduler = previousScheduler;
+  if (priority == Priority::Background) {
+    thread->setPriority((threadPriority != QThread::InheritPriority)
+                            ? threadPriority
+                            : QThread::NormalPriority);
+  }
+
+  QMutexLocker lock(&mMutex);
+  GroupData& data = mGroups[static_cast<int>(group)];
+  --data.running;
+  dispatch(data);
+  mIdleCondition.wakeAll();
+}
+
+void TaskScheduler::waitImpl(const std::function<void()>& wait) {
+  if (sCurrentScheduler == this) {
+    mPool.releaseThread();
+    auto sg = scopeGuard([this]() { mPool.reserveThread(); });
+    wait();  // can throw
+  } else {
+    wait();  // can throw
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,264 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_TASKSCHEDULER_H
+#define LIBREPCB_CORE_TASKSCHEDULER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class CancellationToken
+ ******************************************************************************/
+
+/**
+ * @brief Shared flag to request cancellation of a background task
+ *
+ * Copies of a token share the same flag, so the token can be passed to a
+ * task while the owner keeps a copy to cancel it. Tasks passed to
+ * ::librepcb::TaskScheduler::run() are not started at all if their token
+ * was cancelled before, running tasks need to check #isCancelled()
+ * periodically.
+ */
+class CancellationToken final {
+public:
+  // Constructors / Destructor
+  CancellationToken() noexcept
+    : mCancelled(std::make_shared<std::atomic<bool>>(false)) {}
+  CancellationToken(const CancellationToken& other) noexcept = default;
+  ~CancellationToken() noexcept = default;
+
+  // General Methods
+  bool isCancelled() const noexcept { return mCancelled->load(); }
+  void cancel() const noexcept { mCancelled->store(true); }
+
+  // Operator Overloadings
+  CancellationToken& operator=(const CancellationToken& rhs) noexcept =
+      default;
+
+private:  // Data
+  std::shared_ptr<std::atomic<bool>> mCancelled;
+};
+
+/*******************************************************************************
+ *  Class TaskScheduler
+ ******************************************************************************/
+
+/**
+ * @brief Process-wide scheduler for background tasks
+ *
+ * All background work should be run through the global #instance() (instead
+ * of `QtConcurrent::run()` or dedicated threads) to share a single thread
+ * pool with the following features:
+ *
+ *   - Priority classes: Queued tasks with a higher ::Priority are started
+ *     first, so interactive work (e.g. the quick DRC) is not stuck behind
+ *     bulk work (e.g. the library scan). Tasks of ::Priority::Background
+ *     additionally run with the lowest OS thread priority.
+ *   - Per-subsystem concurrency limits: Each task belongs to a ::Group which
+ *     may limit the number of its concurrently running tasks. Further tasks
+ *     of that group are kept queued in the scheduler and thus don't occupy
+ *     threads of the pool.
+ *   - Cancellation: Tasks are not started if their ::CancellationToken or
+ *     their returned `QFuture` got cancelled before.
+ *
+ * Tasks which wait for other tasks (e.g. the DRC waiting for its jobs) must
+ * do so with #waitForFinished() to not block a worker thread of the pool.
+ *
+ * @note  This class is thread-safe.
+ */
+class TaskScheduler final {
+public:
+  // Types
+  enum class Priority : int {
+    Background = 0,  ///< Bulk work nobody is actively waiting for
+    Normal = 1,  ///< Default priority
+    Interactive = 2,  ///< Work the user is actively waiting for
+  };
+  enum class Group : int {
+    Default = 0,
+    Drc,  ///< Design rule checks
+    Planes,  ///< Plane fragments calculation
+    Export,  ///< Graphics/STEP/output file generation
+    Fonts,  ///< Loading stroke fonts
+    LibraryScan,  ///< Workspace library scanner
+    Import,  ///< Import from other EDA tools
+    Scene3D,  ///< Building 3D scenes
+    Models3D,  ///< Loading & tesselating 3D models
+    ProjectLoad,  ///< Parsing project files & opening their library
+    OutputJobs,  ///< Running output jobs
+    Library,  ///< Opening & processing library elements
+    _Count,  ///< Number of groups (not a valid group)
+  };
+
+  // Constructors / Destructor
+
+  /**
+   * @brief Constructor
+   *
+   * @param maxThreadCount  Size of the thread pool (0 = number of CPU cores).
+   *
+   * @note  Usually the global #instance() shall be used, separate instances
+   *        are mainly useful for testing.
+   */
+  explicit TaskScheduler(int maxThreadCount = 0) noexcept;
+  TaskScheduler(const TaskScheduler& other) = delete;
+  ~TaskScheduler() noexcept;
+
+  // Getters
+  static TaskScheduler& instance() noexcept;
+  int getMaxThreadCount() const noexcept;
+  int getConcurrencyLimit(Group group) const noexcept;
+  int getQueuedTasksCount(Group group) const noexcept;
+  int getRunningTasksCount(Group group) const noexcept;
+
+  // Setters
+
+  /**
+   * @brief Set the size of the thread pool
+   *
+   * @param count   Number of threads, or 0 to use the number of CPU cores.
+   */
+  void setMaxThreadCount(int count) noexcept;
+
+  /**
+   * @brief Limit the number of concurrently running tasks of a group
+   *
+   * @param group   The group to limit.
+   * @param limit   Maximum number of running tasks, or 0 for no limit
+   *                (i.e. only limited by the size of the thread pool).
+   */
+  void setConcurrencyLimit(Group group, int limit) noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Run a function asynchronously
+   *
+   * @param group     The subsystem the task belongs to.
+   * @param priority  The priority class of the task.
+   * @param func      The function to run (must be copyable). Exceptions
+   *                  are rethrown when accessing the result of the future.
+   * @param token     Optional token to cancel the task before it is started.
+   *
+   * @return A future for the return value of `func`. If the task got
+   *         cancelled before it was started, the future is cancelled and
+   *         does not contain a result.
+   */
+  template <typename Func>
+  auto run(Group group, Priority priority, Func func,
+           const CancellationToken& token = CancellationToken())
+      -> QFuture<std::invoke_result_t<Func>> {
+    using Result = std::invoke_result_t<Func>;
+    auto promise = std::make_shared<QPromise<Result>>();
+    QFuture<Result> future = promise->future();
+    promise->start();
+    enqueue(group, priority, [promise, func, token]() mutable {
+      if (promise->isCanceled() || token.isCancelled()) {
+        promise->future().cancel();
+      } else {
+        try {
+          if constexpr (std::is_void_v<Result>) {
+            func();
+          } else {
+            promise->addResult(func());
+          }
+        } catch (const QException& e) {
+          promise->setException(e);
+        } catch (...) {
+          promise->setException(
+              QUnhandledException(std::current_exception()));
+        }
+      }
+      promise->finish();
+    });
+    return future;
+  }
+
+  /**
+   * @brief Wait until a future is finished
+   *
+   * If called from within a task of this scheduler, the calling worker
+   * thread is released while waiting so the awaited tasks can still be
+   * started even if all threads of the pool are busy.
+   *
+   * @param future  The future to wait for. Any exception of the
+   *                corresponding task is rethrown.
+   */
+  template <typename T>
+  void waitForFinished(const QFuture<T>& future) {
+    QFuture<T> f = future;
+    waitImpl([&f]() { f.waitForFinished(); });  // can throw
+  }
+
+  /**
+   * @brief Wait until all queued and running tasks are finished
+   *
+   * @param msecs   Timeout in milliseconds, or -1 to wait forever.
+   *
+   * @retval true   All tasks finished.
+   * @retval false  Timeout occurred.
+   */
+  bool waitForDone(int msecs = -1) noexcept;
+
+  // Operator Overloadings
+  TaskScheduler& operator=(const TaskScheduler& rhs) = delete;
+
+private:  // Types
+  struct GroupData {
+    int limit = 0;
+    int running = 0;
+    std::array<QQueue<std::function<void()>>, 3> queues;  ///< By priority
+  };
+
+private:  // Methods
+  void enqueue(Group group, Priority priority,
+               std::function<void()> func) noexcept;
+  void dispatch(GroupData& data) noexcept;
+  void execute(Group group, Priority priority,
+               const std::function<void()>& func) noexcept;
+  void waitImpl(const std::function<void()>& wait);
+
+private:  // Data
+  QThreadPool mPool;
+  mutable QMutex mMutex;
+  QWaitCondition mIdleCondition;
+  std::array<GroupData, static_cast<int>(Group::_Count)> mGroups;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
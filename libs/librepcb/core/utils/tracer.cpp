@@ -0,0 +1,183 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "tracer.h"
+
+#include "../fileio/fileutils.h"
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+Tracer::Tracer() noexcept
+  : mClock(),
+    mEnabled(false),
+    mNextThreadId(0),
+    mMutex(),
+    mMaxEvents(0),
+    mDroppedEvents(0),
+    mEvents(),
+    mThreadNames() {
+  mClock.start();
+}
+
+Tracer::~Tracer() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QVector<Tracer::Event> Tracer::getEvents() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mEvents;
+}
+
+QMap<int, QString> Tracer::getThreadNames() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mThreadNames;
+}
+
+int Tracer::getDroppedEventsCount() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mDroppedEvents;
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void Tracer::start(int maxEvents) noexcept {
+  {
+    QMutexLocker lock(&mMutex);
+    mMaxEvents = std::max(maxEvents, 0);
+    mDroppedEvents = 0;
+    mEvents.clear();
+    mEvents.reserve(std::min(mMaxEvents, 100000));
+  }
+  mEnabled.store(true);
+}
+
+void Tracer::stop() noexcept {
+  mEnabled.store(false);
+}
+
+void Tracer::addZone(const char* name, qint64 startNs, qint64 endNs) noexcept {
+  if (isEnabled()) {
+    append(Event{name, 'X', getCurrentThreadId(), startNs, endNs - startNs, 0});
+  }
+}
+
+void Tracer::addCounter(const char* name, qint64 value) noexcept {
+  if (isEnabled()) {
+    append(
+        Event{name, 'C', getCurrentThreadId(), getTimestampNs(), 0, value});
+  }
+}
+
+QByteArray Tracer::toChromeTraceJson() const noexcept {
+  auto escape = [](const QString& str) {
+    QString s = str;
+    s.replace("\\", "\\\\").replace("\"", "\\\"");
+    return s.toUtf8();
+  };
+  auto micros = [](qint64 ns) {
+    return QByteArray::number(ns / 1000.0, 'f', 3);
+  };
+
+  QMutexLocker lock(&mMutex);
+  const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+  QByteArrayList lines;
+  lines.reserve(mEvents.count() + mThreadNames.count() + 1);
+  for (auto it = mThreadNames.begin(); it != mThreadNames.end(); ++it) {
+    lines.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" % pid %
+                 ",\"tid\":" % QByteArray::number(it.key()) %
+                 ",\"args\":{\"name\":\"" % escape(it.value()) % "\"}}");
+  }
+  for (const Event& e : mEvents) {
+    QByteArray line = "{\"name\":\"" % escape(QString::fromUtf8(e.name)) %
+        "\",\"cat\":\"librepcb\",\"ph\":\"" % QByteArray(1, e.phase) %
+        "\",\"ts\":" % micros(e.timestampNs) % ",\"pid\":" % pid %
+        ",\"tid\":" % QByteArray::number(e.threadId);
+    if (e.phase == 'X') {
+      line += ",\"dur\":" % micros(e.durationNs);
+    } else {
+      line += ",\"args\":{\"value\":" % QByteArray::number(e.value) % "}";
+    }
+    lines.append(line % "}");
+  }
+  if (mDroppedEvents > 0) {
+    lines.append("{\"name\":\"dropped_events\",\"ph\":\"M\",\"pid\":" % pid %
+                 ",\"args\":{\"count\":" % QByteArray::number(mDroppedEvents) %
+                 "}}");
+  }
+  return "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" %
+      lines.join(",\n") % "\n]}\n";
+}
+
+void Tracer::writeChromeTrace(const FilePath& fp) const {
+  FileUtils::writeFile(fp, toChromeTraceJson());  // can throw
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+int Tracer::getCurrentThreadId() noexcept {
+  thread_local int id = -1;
+  if (id < 0) {
+    id = mNextThreadId.fetch_add(1);
+    QString name;
+    QThread* thread = QThread::currentThread();
+    if (QCoreApplication::instance() &&
+        (thread == QCoreApplication::instance()->thread())) {
+      name = "Main Thread";
+    } else if (thread && (!thread->objectName().isEmpty())) {
+      name = QString("%1 %2").arg(thread->objectName()).arg(id);
+    } else {
+      name = QString("Thread %1").arg(id);
+    }
+    QMutexLocker lock(&mMutex);
+    mThreadNames.insert(id, name);
+  }
+  return id;
+}
+
+void Tracer::append(const Event& event) noexcept {
+  QMutexLocker lock(&mMutex);
+  if (mEvents.count() < mMaxEvents) {
+    mEvents.append(event);
+  } else {
+    ++mDroppedEvents;
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,197 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_TRACER_H
+#define LIBREPCB_CORE_TRACER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "librepcb_build_env.h"
+
+#include <QtCore>
+
+#include <atomic>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class FilePath;
+
+/*******************************************************************************
+ *  Class Tracer
+ ******************************************************************************/
+
+/**
+ * @brief Lightweight in-process tracer for performance analysis
+ *
+ * Records timed zones and counters of all threads into memory and exports
+ * them in the Chrome trace event format, which can be opened with
+ * `chrome://tracing` or https://ui.perfetto.dev/.
+ *
+ * Tracing is disabled by default at runtime and needs to be enabled with
+ * #start(). While disabled, a zone costs only an atomic load. In addition,
+ * all instrumentation macros ::LIBREPCB_TRACE_ZONE and
+ * ::LIBREPCB_TRACE_COUNTER compile to nothing if the CMake option
+ * `LIBREPCB_ENABLE_TRACING` is turned off.
+ *
+ * @note  All event names must be string literals (or at least have static
+ *        storage duration) since only the pointers are stored.
+ *
+ * @note  This class is thread-safe.
+ */
+class Tracer final {
+public:
+  // Types
+  struct Event {
+    const char* name;
+    char phase;  ///< 'X' for complete zones, 'C' for counters
+    int threadId;
+    qint64 timestampNs;
+    qint64 durationNs;  ///< Only for zones
+    qint64 value;  ///< Only for counters
+  };
+
+  // Constructors / Destructor
+  Tracer(const Tracer& other) = delete;
+  ~Tracer() noexcept;
+
+  // Getters
+  static Tracer& instance() noexcept {
+    static Tracer tracer;
+    return tracer;
+  }
+  bool isEnabled() const noexcept {
+    return mEnabled.load(std::memory_order_relaxed);
+  }
+  qint64 getTimestampNs() const noexcept { return mClock.nsecsElapsed(); }
+  QVector<Event> getEvents() const noexcept;
+  QMap<int, QString> getThreadNames() const noexcept;
+  int getDroppedEventsCount() const noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Clear all recorded events and start recording
+   *
+   * @param maxEvents   Maximum number of events to record. Further events
+   *                    are dropped to keep memory usage bounded.
+   */
+  void start(int maxEvents = 1000000) noexcept;
+
+  /**
+   * @brief Stop recording (recorded events are kept)
+   */
+  void stop() noexcept;
+
+  void addZone(const char* name, qint64 startNs, qint64 endNs) noexcept;
+  void addCounter(const char* name, qint64 value) noexcept;
+
+  /**
+   * @brief Export all recorded events in the Chrome trace event format
+   *
+   * @return JSON file content
+   */
+  QByteArray toChromeTraceJson() const noexcept;
+
+  /**
+   * @brief Write all recorded events to a Chrome trace file
+   *
+   * @param fp    Output file path (typically with suffix `*.json`).
+   */
+  void writeChromeTrace(const FilePath& fp) const;  // can throw
+
+  // Operator Overloadings
+  Tracer& operator=(const Tracer& rhs) = delete;
+
+private:  // Methods
+  Tracer() noexcept;
+  int getCurrentThreadId() noexcept;
+  void append(const Event& event) noexcept;
+
+private:  // Data
+  QElapsedTimer mClock;
+  std::atomic<bool> mEnabled;
+  std::atomic<int> mNextThreadId;
+  mutable QMutex mMutex;
+  int mMaxEvents;
+  int mDroppedEvents;
+  QVector<Event> mEvents;
+  QMap<int, QString> mThreadNames;
+};
+
+/*******************************************************************************
+ *  Class TraceZone
+ ******************************************************************************/
+
+/**
+ * @brief RAII helper recording a ::librepcb::Tracer zone for its lifetime
+ *
+ * Use the macro ::LIBREPCB_TRACE_ZONE instead of instantiating this class
+ * directly, to allow compiling out tracing completely.
+ */
+class TraceZone final {
+public:
+  explicit TraceZone(const char* name) noexcept
+    : mName(Tracer::instance().isEnabled() ? name : nullptr),
+      mStartNs(mName ? Tracer::instance().getTimestampNs() : 0) {}
+  TraceZone(const TraceZone& other) = delete;
+  ~TraceZone() noexcept {
+    if (mName) {
+      Tracer& tracer = Tracer::instance();
+      tracer.addZone(mName, mStartNs, tracer.getTimestampNs());
+    }
+  }
+  TraceZone& operator=(const TraceZone& rhs) = delete;
+
+private:
+  const char* const mName;
+  const qint64 mStartNs;
+};
+
+/*******************************************************************************
+ *  Macros
+ ******************************************************************************/
+
+#if LIBREPCB_ENABLE_TRACING
+#define LIBREPCB_TRACE_CONCAT_IMPL(a, b) a##b
+#define LIBREPCB_TRACE_CONCAT(a, b) LIBREPCB_TRACE_CONCAT_IMPL(a, b)
+/// Record a zone from this line until the end of the enclosing scope
+#define LIBREPCB_TRACE_ZONE(name) \
+  const ::librepcb::TraceZone LIBREPCB_TRACE_CONCAT(traceZone, __LINE__)(name)
+/// Record the current value of a counter
+#define LIBREPCB_TRACE_COUNTER(name, value)                       \
+  do {                                                            \
+    ::librepcb::Tracer& tracer_ = ::librepcb::Tracer::instance(); \
+    if (tracer_.isEnabled()) tracer_.addCounter(name, value);     \
+  } while (false)
+#else
+#define LIBREPCB_TRACE_ZONE(name) static_cast<void>(0)
+#define LIBREPCB_TRACE_COUNTER(name, value) static_cast<void>(0)
+#endif
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -42,6 +42,8 @@
 #include <QtCore>
 #include <QtSql>
 
+#include <array>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -366,6 +368,114 @@ QHash<FilePath, Uuid> WorkspaceLibraryDb::getAll(const QString& elementsTable,
   return elements;
 }
 
+QList<WorkspaceLibraryDb::ElementInfo> WorkspaceLibraryDb::getAllInfos(
+    const QString& elementsTable, bool isCategory,
+    const QStringList& localeOrder, const FilePath& lib) const {
+  SQLiteDatabase::TransactionScopeGuard sg(*mDb);  // Atomic queries!
+
+  // All queries are filtered the same way.
+  QString filter;
+  if (lib.isValid()) {
+    filter =
+        "INNER JOIN libraries ON %elements.library_id = libraries.id "
+        "WHERE libraries.filepath = :filepath";
+  }
+  auto prepare = [&](const QString& sql) {
+    QSqlQuery query = mDb->prepareQuery(sql % " " % filter,
+                                        {
+                                            {"%elements", elementsTable},
+                                        });
+    if (lib.isValid()) {
+      query.bindValue(":filepath", lib.toRelative(mLibrariesPath));
+    }
+    mDb->exec(query);
+    return query;
+  };
+
+  // Get the elements themselves.
+  QHash<int, ElementInfo> elements;
+  {
+    QSqlQuery query = prepare(
+        "SELECT %elements.id, %elements.filepath, %elements.uuid, "
+        "%elements.version, %elements.deprecated" %
+        QString(isCategory ? ", %elements.parent_uuid" : "") %
+        " FROM %elements");
+    while (query.next()) {
+      const FilePath filepath(
+          FilePath::fromRelative(mLibrariesPath, query.value(1).toString()));
+      if (!filepath.isValid()) {
+        throw LogicError(__FILE__, __LINE__);
+      }
+      elements.insert(
+          query.value(0).toInt(),
+          ElementInfo{
+              filepath,
+              Uuid::fromString(query.value(2).toString()),  // can throw
+              Version::fromString(query.value(3).toString()),  // can throw
+              query.value(4).toBool(),
+              QString(),
+              QString(),
+              QString(),
+              isCategory ? Uuid::tryFromString(query.value(5).toString())
+                         : std::optional<Uuid>(),
+              QSet<Uuid>(),
+          });
+    }
+  }
+
+  // Get translations of all elements.
+  {
+    QSqlQuery query = prepare(
+        "SELECT %elements_tr.element_id, locale, name, description, keywords "
+        "FROM %elements_tr "
+        "INNER JOIN %elements ON %elements.id = %elements_tr.element_id");
+    QHash<int, QVector<std::array<QString, 4>>> translations;
+    while (query.next()) {
+      translations[query.value(0).toInt()].append({
+          query.value(1).toString(),
+          query.value(2).toString(),
+          query.value(3).toString(),
+          query.value(4).toString(),
+      });
+    }
+    for (auto it = translations.begin(); it != translations.end(); ++it) {
+      auto elementIt = elements.find(it.key());
+      if (elementIt == elements.end()) {
+        continue;
+      }
+      // Using LocalizedDescriptionMap for all values since it allows empty
+      // strings (in contrast to LocalizedNameMap, which is more restrictive).
+      LocalizedDescriptionMap nameMap(QString{});
+      LocalizedDescriptionMap descriptionMap(QString{});
+      LocalizedDescriptionMap keywordsMap(QString{});
+      for (const auto& row : *it) {
+        if (!row[1].isNull()) nameMap.insert(row[0], row[1]);
+        if (!row[2].isNull()) descriptionMap.insert(row[0], row[2]);
+        if (!row[3].isNull()) keywordsMap.insert(row[0], row[3]);
+      }
+      elementIt->name = nameMap.value(localeOrder);
+      elementIt->description = descriptionMap.value(localeOrder);
+      elementIt->keywords = keywordsMap.value(localeOrder);
+    }
+  }
+
+  // Get categories of all elements.
+  if (!isCategory) {
+    QSqlQuery query = prepare(
+        "SELECT %elements_cat.element_id, category_uuid FROM %elements_cat "
+        "INNER JOIN %elements ON %elements.id = %elements_cat.element_id");
+    while (query.next()) {
+      auto elementIt = elements.find(query.value(0).toInt());
+      if (elementIt != elements.end()) {
+        elementIt->categories.insert(
+            Uuid::fromString(query.value(1).toString()));  // can throw
+      }
+    }
+  }
+
+  return elements.values();
+}
+
 FilePath WorkspaceLibraryDb::getLatestVersionFilePath(
     const QMultiMap<Version, FilePath>& list) const noexcept {
   if (list.isEmpty())
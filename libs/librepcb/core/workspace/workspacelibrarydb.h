@@ -42,6 +42,7 @@ namespace librepcb {
 class Component;
 class ComponentCategory;
 class Device;
+class Library;
 class Package;
 class PackageCategory;
 class SQLiteDatabase;
@@ -102,6 +103,21 @@ public:
     }
   };
 
+  /**
+   * @brief Metadata of a library element, as returned by #getAllInfos()
+   */
+  struct ElementInfo {
+    FilePath filePath;
+    Uuid uuid;
+    Version version;
+    bool deprecated;
+    QString name;  ///< Empty if there are no translations
+    QString description;
+    QString keywords;
+    std::optional<Uuid> parent;  ///< Parent category (categories only)
+    QSet<Uuid> categories;  ///< Assigned categories (elements only)
+  };
+
   // Constructors / Destructor
   WorkspaceLibraryDb() = delete;
   WorkspaceLibraryDb(const WorkspaceLibraryDb& other) = delete;
@@ -174,6 +190,35 @@ public:
     return getAll(getTable<ElementType>(), lib);
   }
 
+  /**
+   * @brief Get metadata, translations and categories of many elements at once
+   *
+   * Returns the same information as calling #getMetadata(),
+   * #getTranslations(), #getCategoryMetadata() and #getCategoriesOf() for
+   * each element, but needs only a few database queries in total. So this
+   * should be preferred to populate lists or trees of elements.
+   *
+   * @tparam ElementType  Type of the library element (must not be Library).
+   *
+   * @param localeOrder   Locale order for the translations (highest
+   *                      priority first).
+   * @param lib           If valid, only elements from this library are
+   *                      returned.
+   *
+   * @return Information about all elements matching the criteria, in no
+   *         particular order.
+   */
+  template <typename ElementType>
+  QList<ElementInfo> getAllInfos(const QStringList& localeOrder,
+                                 const FilePath& lib = FilePath()) const {
+    static_assert(!std::is_same<ElementType, Library>::value,
+                  "Unsupported ElementType");
+    constexpr bool isCategory =
+        std::is_same<ElementType, ComponentCategory>::value ||
+        std::is_same<ElementType, PackageCategory>::value;
+    return getAllInfos(getTable<ElementType>(), isCategory, localeOrder, lib);
+  }
+
   /**
    * @brief Get an element of a specific UUID and the highest version
    *
@@ -480,6 +525,10 @@ private:
                                       const FilePath& lib) const;
   QHash<FilePath, Uuid> getAll(const QString& elementsTable,
                                const FilePath& lib) const;
+  QList<ElementInfo> getAllInfos(const QString& elementsTable,
+                                 bool isCategory,
+                                 const QStringList& localeOrder,
+                                 const FilePath& lib) const;
   FilePath getLatestVersionFilePath(
       const QMultiMap<Version, FilePath>& list) const noexcept;
   QList<Uuid> find(const QString& elementsTable, const QString& keyword) const;
@@ -33,6 +33,7 @@
 #include "../library/sym/symbol.h"
 #include "../sqlitedatabase.h"
 #include "../utils/toolbox.h"
+#include "../utils/tracer.h"
 #include "workspacelibrarydbwriter.h"
 
 #include <QtCore>
@@ -48,34 +49,23 @@ namespace librepcb {
 
 WorkspaceLibraryScanner::WorkspaceLibraryScanner(
     const FilePath& librariesPath, const FilePath& dbFilePath) noexcept
-  : QThread(nullptr),
+  : QObject(nullptr),
     mLibrariesPath(librariesPath),
     mDbFilePath(dbFilePath),
-    mSemaphore(0),
-    mAbort(false),
+    mCancelToken(),
+    mFuture(),
     mLastProgressPercent(100) {
   connect(
       this, &WorkspaceLibraryScanner::scanProgressUpdate, this,
       [this](int percent) { mLastProgressPercent = percent; },
       Qt::QueuedConnection);
-
-  // Run thread with the lowest priority to not risk blocking the GUI thread.
-  // In manual tests with Qt6Quick it was observed that any higher priority
-  // sometimes freezes the GUI significantly.
-  start(QThread::LowestPriority);
 }
 
 WorkspaceLibraryScanner::~WorkspaceLibraryScanner() noexcept {
-  mAbort = true;
-  mSemaphore.release();
-  if (!wait(2000)) {
-    qWarning() << "Failed to abort the library scanner worker thread, trying "
-                  "to terminate it...";
-    terminate();
-    if (!wait(2000)) {
-      qCritical() << "Failed to terminate the library scanner worker thread!";
-    }
-  }
+  // Since scans are run strictly sequentially, waiting for the most recent
+  // scan also waits for any previous (cancelled) scan.
+  mCancelToken.cancel();
+  mFuture.waitForFinished();
 }
 
 /*******************************************************************************
@@ -83,29 +73,25 @@ WorkspaceLibraryScanner::~WorkspaceLibraryScanner() noexcept {
  ******************************************************************************/
 
 void WorkspaceLibraryScanner::startScan() noexcept {
-  mSemaphore.release();
+  // Abort the running scan (if any). The library scan group of the scheduler
+  // runs only one task at a time, so the new scan starts after the old one
+  // has been stopped. Run with background priority to not risk blocking the
+  // GUI thread. In manual tests with Qt6Quick it was observed that any higher
+  // thread priority sometimes freezes the GUI significantly.
+  mCancelToken.cancel();
+  mCancelToken = CancellationToken();
+  const CancellationToken token = mCancelToken;
+  mFuture = TaskScheduler::instance().run(
+      TaskScheduler::Group::LibraryScan, TaskScheduler::Priority::Background,
+      [this, token]() { scan(token); });
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-void WorkspaceLibraryScanner::run() noexcept {
-  qDebug() << "Workspace library scanner thread started.";
-
-  while (true) {
-    mSemaphore.acquire();
-    if (mAbort) {
-      break;
-    } else {
-      scan();
-    }
-  }
-
-  qDebug() << "Workspace library scanner thread stopped.";
-}
-
-void WorkspaceLibraryScanner::scan() noexcept {
+void WorkspaceLibraryScanner::scan(const CancellationToken& token) noexcept {
+  LIBREPCB_TRACE_ZONE("LibraryScanner::scan");
   try {
     QElapsedTimer timer;
     timer.start();
@@ -144,38 +130,42 @@ void WorkspaceLibraryScanner::scan() noexcept {
     int count = 0;
     qreal percent = 1;
     foreach (const std::shared_ptr<Library>& lib, libraries) {
+      LIBREPCB_TRACE_ZONE("LibraryScanner::scanLibrary");
       FilePath fp = lib->getDirectory().getAbsPath();
       Q_ASSERT(libIds.contains(fp));
       int libId = libIds[fp];
-      if (mAbort || (mSemaphore.available() > 0)) break;
+      if (token.isCancelled()) break;
       count += addElementsToDb<ComponentCategory>(
-          writer, fp, lib->searchForElements<ComponentCategory>(), libId);
+          writer, fp, lib->searchForElements<ComponentCategory>(), libId,
+          token);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
+      if (token.isCancelled()) break;
       count += addElementsToDb<PackageCategory>(
-          writer, fp, lib->searchForElements<PackageCategory>(), libId);
+          writer, fp, lib->searchForElements<PackageCategory>(), libId,
+          token);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Symbol>(writer, fp,
-                                       lib->searchForElements<Symbol>(), libId);
+      if (token.isCancelled()) break;
+      count += addElementsToDb<Symbol>(
+          writer, fp, lib->searchForElements<Symbol>(), libId, token);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
+      if (token.isCancelled()) break;
       count += addElementsToDb<Package>(
-          writer, fp, lib->searchForElements<Package>(), libId);
+          writer, fp, lib->searchForElements<Package>(), libId, token);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
+      if (token.isCancelled()) break;
       count += addElementsToDb<Component>(
-          writer, fp, lib->searchForElements<Component>(), libId);
+          writer, fp, lib->searchForElements<Component>(), libId, token);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Device>(writer, fp,
-                                       lib->searchForElements<Device>(), libId);
+      if (token.isCancelled()) break;
+      count += addElementsToDb<Device>(
+          writer, fp, lib->searchForElements<Device>(), libId, token);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
     }
 
     // commit transaction
-    if ((!mAbort) && (mSemaphore.available() == 0)) {
+    if (!token.isCancelled()) {
       transactionGuard.commit();  // can throw
+      LIBREPCB_TRACE_COUNTER("Library elements", count);
       qDebug() << "Workspace library scan succeeded:" << count << "elements in"
                << timer.elapsed() << "ms.";
       emit scanSucceeded(count);
@@ -274,10 +264,11 @@ template <typename ElementType>
 int WorkspaceLibraryScanner::addElementsToDb(WorkspaceLibraryDbWriter& writer,
                                              const FilePath& libPath,
                                              const QStringList& dirs,
-                                             int libId) {
+                                             int libId,
+                                             const CancellationToken& token) {
   int count = 0;
   foreach (const QString& dirpath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
+    if (token.isCancelled()) break;
     const FilePath fp = libPath.getPathTo(dirpath);
     try {
       std::unique_ptr<ElementType> element =
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../fileio/filepath.h"
+#include "../utils/taskscheduler.h"
 
 #include <QtCore>
 
@@ -45,11 +46,14 @@ class WorkspaceLibraryDbWriter;
 /**
  * @brief The WorkspaceLibraryScanner class
  *
- * @warning Be very careful with dependencies to other objects as the #run()
+ * Scans are run as background tasks of the ::librepcb::TaskScheduler. Starting
+ * a new scan cancels the currently running scan.
+ *
+ * @warning Be very careful with dependencies to other objects as the #scan()
  * method is executed in a separate thread! Keep the number of dependencies as
  * small as possible and consider thread synchronization and object lifetimes.
  */
-class WorkspaceLibraryScanner final : public QThread {
+class WorkspaceLibraryScanner final : public QObject {
   Q_OBJECT
 
 public:
@@ -79,8 +83,7 @@ signals:
   void scanInProgressChanged(bool inProgress);
 
 private:  // Methods
-  void run() noexcept override;
-  void scan() noexcept;
+  void scan(const CancellationToken& token) noexcept;
   void getLibrariesOfDirectory(const QString& root,
                                QList<std::shared_ptr<Library>>& libs) noexcept;
 
@@ -89,7 +92,8 @@ private:  // Methods
       const QList<std::shared_ptr<Library>>& libs);
   template <typename ElementType>
   int addElementsToDb(WorkspaceLibraryDbWriter& writer, const FilePath& libPath,
-                      const QStringList& dirs, int libId);
+                      const QStringList& dirs, int libId,
+                      const CancellationToken& token);
   template <typename ElementType>
   int addElementToDb(WorkspaceLibraryDbWriter& writer, int libId,
                      const ElementType& element);
@@ -108,8 +112,8 @@ private:  // Methods
 private:  // Data
   const FilePath mLibrariesPath;  ///< Path to workspace libraries directory.
   const FilePath mDbFilePath;  ///< Path to the SQLite database file.
-  QSemaphore mSemaphore;
-  volatile bool mAbort;
+  CancellationToken mCancelToken;  ///< Token of the most recent scan.
+  QFuture<void> mFuture;  ///< Future of the most recent scan.
   int mLastProgressPercent;
 };
 
@@ -22,9 +22,9 @@
  ******************************************************************************/
 #include "openglscenebuilder.h"
 
+#include "opengltrianglebuffer.h"
 #include "opengltriangleobject.h"
 
-#include <librepcb/core/3d/occmodel.h>
 #include <librepcb/core/exceptions.h>
 #include <librepcb/core/fileio/filesystem.h>
 #include <librepcb/core/fileio/fileutils.h>
@@ -32,10 +32,11 @@
 #include <librepcb/core/types/pcbcolor.h>
 #include <librepcb/core/utils/clipperhelpers.h>
 #include <librepcb/core/utils/scopeguard.h>
+#include <librepcb/core/utils/taskscheduler.h>
 #include <librepcb/core/utils/toolbox.h>
+#include <librepcb/core/utils/tracer.h>
 #include <librepcb_build_env.h>
 
-#include <QtConcurrent>
 #include <QtCore>
 
 #if USE_GLU
@@ -64,7 +65,11 @@ namespace editor {
  ******************************************************************************/
 
 OpenGlSceneBuilder::OpenGlSceneBuilder(QObject* parent) noexcept
-  : QObject(parent), mMaxArcTolerance(5000), mFuture(), mAbort(false) {
+  : QObject(parent),
+    mMaxArcTolerance(5000),
+    mTesselationCache(),
+    mFuture(),
+    mAbort(false) {
   qRegisterMetaType<std::shared_ptr<OpenGlObject>>();
 }
 
@@ -78,7 +83,9 @@ OpenGlSceneBuilder::~OpenGlSceneBuilder() noexcept {
 
 void OpenGlSceneBuilder::start(std::shared_ptr<SceneData3D> data) noexcept {
   cancel();
-  mFuture = QtConcurrent::run(&OpenGlSceneBuilder::run, this, data);
+  mFuture = TaskScheduler::instance().run(
+      TaskScheduler::Group::Scene3D, TaskScheduler::Priority::Background,
+      [this, data]() { run(data); });
 }
 
 bool OpenGlSceneBuilder::isBusy() const noexcept {
@@ -104,6 +111,7 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
   // Note: This method is called from a different thread, thus be careful with
   //       calling other methods to only call thread-safe methods!
 
+  LIBREPCB_TRACE_ZONE("OpenGlSceneBuilder::run");
   QElapsedTimer timer;
   timer.start();
   qDebug() << "Start building board 3D scene in worker thread...";
@@ -275,16 +283,67 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
       if (mAbort) return;
     }
 
-    // Add/update devices.
+    // Add/update devices. Devices with an already known STEP model are
+    // published immediately, all others are grouped by their STEP model which
+    // are then loaded & tesselated in parallel. The groups of devices get
+    // published in order as soon as their model is ready.
     QSet<Uuid> deviceUuids;
+    QList<QByteArray> modelsToLoad;
+    QHash<QByteArray, QList<SceneData3D::DeviceData>> pendingDevices;
     if (std::shared_ptr<FileSystem> fs = data->getFileSystem()) {
       for (const auto& obj : data->getDevices()) {
         const QByteArray content = fs->readIfExists(obj.stepFile);
-        publishDevice(obj, content, d + 0.067, scaleFactor);
+        auto it = mStepModels.constFind(content);
+        if (it != mStepModels.constEnd()) {
+          publishDevice(obj, *it, d + 0.067, scaleFactor);
+        } else {
+          if (!pendingDevices.contains(content)) {
+            modelsToLoad.append(content);
+          }
+          pendingDevices[content].append(obj);
+        }
         deviceUuids.insert(obj.uuid);
         if (mAbort) return;
       }
     }
+    if (!modelsToLoad.isEmpty()) {
+      TaskScheduler& scheduler = TaskScheduler::instance();
+      CancellationToken token;
+      QVector<QFuture<StepModel>> futures;
+      auto futuresSg = scopeGuard([&scheduler, &token, &futures]() {
+        // Don't start any further loads, but wait for the running ones since
+        // they access this object.
+        token.cancel();
+        for (const QFuture<StepModel>& future : futures) {
+          scheduler.waitForFinished(future);
+        }
+      });
+      foreach (const QByteArray& content, modelsToLoad) {
+        const QString name = pendingDevices.value(content).first().name;
+        futures.append(scheduler.run(
+            TaskScheduler::Group::Models3D, TaskScheduler::Priority::Background,
+            [this, content, name]() {
+              return mAbort ? StepModel() : loadStepModel(content, name);
+            },
+            token));
+      }
+      for (int i = 0; i < modelsToLoad.count(); ++i) {
+        scheduler.waitForFinished(futures.at(i));
+        if (mAbort) return;
+        // Each color of a model gets its own vertex buffer which is shared
+        // by all devices using this model.
+        const StepModel model = futures.at(i).result();
+        StepModelBuffers buffers;
+        for (auto it = model.begin(); it != model.end(); it++) {
+          buffers.insert(it.key(),
+                         std::make_shared<OpenGlTriangleBuffer>(it.value()));
+        }
+        mStepModels.insert(modelsToLoad.at(i), buffers);
+        foreach (const auto& obj, pendingDevices.value(modelsToLoad.at(i))) {
+          publishDevice(obj, buffers, d + 0.067, scaleFactor);
+        }
+      }
+    }
 
     // Remove all no longer existing devices.
     foreach (const Uuid& uuid, Toolbox::toSet(mDevices.keys()) - deviceUuids) {
@@ -420,25 +479,24 @@ void OpenGlSceneBuilder::publishTriangleData(
   }
 }
 
-void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
-                                       const QByteArray& stepContent, qreal z,
-                                       qreal scaleFactor) {
+OpenGlSceneBuilder::StepModel OpenGlSceneBuilder::loadStepModel(
+    const QByteArray& stepContent, const QString& name) const noexcept {
+  LIBREPCB_TRACE_ZONE("OpenGlSceneBuilder::loadStepModel");
   StepModel model;
-  if (mStepModels.contains(stepContent)) {
-    model = mStepModels.value(stepContent);
-  } else {
-    if (stepContent.size()) {
-      try {
-        std::unique_ptr<OccModel> occModel = OccModel::loadStep(stepContent);
-        model = occModel->tesselate();
-      } catch (const Exception& e) {
-        qCritical().nospace()
-            << "Failed to draw 3D model of " << obj.name << ": " << e.getMsg();
-      }
+  if (stepContent.size()) {
+    try {
+      model = mTesselationCache.tesselate(stepContent);  // can throw
+    } catch (const Exception& e) {
+      qCritical().nospace()
+          << "Failed to draw 3D model of " << name << ": " << e.getMsg();
     }
-    mStepModels.insert(stepContent, model);
   }
+  return model;
+}
 
+void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
+                                       const StepModelBuffers& model, qreal z,
+                                       qreal scaleFactor) {
   QMatrix4x4 m;
   m.scale(scaleFactor);
   m.translate(obj.transform.getPosition().getX().toMm(),
@@ -463,19 +521,15 @@ void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
     }
   }
   for (auto it = model.begin(); it != model.end(); it++) {
-    QVector<QVector3D> vertices = it.value();
-    for (auto& vertex : vertices) {
-      vertex = m.map(vertex);
-    }
     std::shared_ptr<OpenGlTriangleObject> obj = items.value(it.key());
     QColor color = QColor::fromRgbF(
         std::get<0>(it.key()), std::get<1>(it.key()), std::get<2>(it.key()));
     if (obj) {
-      obj->setData(color, vertices);
+      obj->setData(color, it.value(), m);
       emit objectUpdated(obj);
     } else {
       obj = std::make_shared<OpenGlTriangleObject>(OpenGlObject::Type::Device);
-      obj->setData(color, vertices);
+      obj->setData(color, it.value(), m);
       items[it.key()] = obj;
       emit objectAdded(obj);
     }
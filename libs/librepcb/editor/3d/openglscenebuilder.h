@@ -26,6 +26,7 @@
 #include "openglobject.h"
 
 #include <librepcb/core/3d/scenedata3d.h>
+#include <librepcb/core/3d/tesselationcache.h>
 #include <polyclipping/clipper.hpp>
 
 #include <QtCore>
@@ -38,6 +39,7 @@
 namespace librepcb {
 namespace editor {
 
+class OpenGlTriangleBuffer;
 class OpenGlTriangleObject;
 
 /*******************************************************************************
@@ -54,6 +56,7 @@ public:
   // Types
   typedef std::tuple<qreal, qreal, qreal> Color;
   typedef QMap<Color, QVector<QVector3D>> StepModel;
+  typedef QMap<Color, std::shared_ptr<OpenGlTriangleBuffer>> StepModelBuffers;
 
   // Constructors / Destructor
   OpenGlSceneBuilder(QObject* parent = nullptr) noexcept;
@@ -107,18 +110,22 @@ private:  // Methods
   void publishTriangleData(const QString& id, OpenGlObject::Type type,
                            const QColor& color,
                            const QVector<QVector3D>& triangles);
+  StepModel loadStepModel(const QByteArray& stepContent,
+                          const QString& name) const noexcept;
   void publishDevice(const SceneData3D::DeviceData& obj,
-                     const QByteArray& stepContent, qreal z, qreal scaleFactor);
+                     const StepModelBuffers& model, qreal z,
+                     qreal scaleFactor);
 
 private:  // Data
   const PositiveLength mMaxArcTolerance;
+  const TesselationCache mTesselationCache;
   QFuture<void> mFuture;
   bool mAbort;
 
   // Thread data.
   QHash<QString, std::shared_ptr<OpenGlTriangleObject>> mBoardObjects;
   QHash<Uuid, QMap<Color, std::shared_ptr<OpenGlTriangleObject>>> mDevices;
-  QHash<QByteArray, StepModel> mStepModels;  ///< Cache
+  QHash<QByteArray, StepModelBuffers> mStepModels;  ///< In-memory cache
 };
 
 /*******************************************************************************
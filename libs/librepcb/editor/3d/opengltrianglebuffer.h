@@ -0,0 +1,88 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_EDITOR_OPENGLTRIANGLEBUFFER_H
+#define LIBREPCB_EDITOR_OPENGLTRIANGLEBUFFER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+#include <QtOpenGL>
+
+#include <optional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+
+/*******************************************************************************
+ *  Class OpenGlTriangleBuffer
+ ******************************************************************************/
+
+/**
+ * @brief OpenGL vertex buffer containing triangles
+ *
+ * The vertex data is passed from any thread but uploaded to the GPU lazily in
+ * the rendering thread. A buffer can be shared between multiple
+ * ::librepcb::editor::OpenGlTriangleObject instances, each of them drawing
+ * the same triangles with its own transformation. This way, repeated objects
+ * (e.g. many devices with the same 3D model) occupy GPU memory only once.
+ */
+class OpenGlTriangleBuffer final {
+public:
+  // Constructors / Destructor
+  OpenGlTriangleBuffer() noexcept;
+  explicit OpenGlTriangleBuffer(const QVector<QVector3D>& data) noexcept;
+  OpenGlTriangleBuffer(const OpenGlTriangleBuffer& other) = delete;
+  ~OpenGlTriangleBuffer() noexcept;
+
+  // General Methods
+  void setData(const QVector<QVector3D>& data) noexcept;
+
+  /**
+   * @brief Upload pending data (if any) and bind the buffer
+   *
+   * @attention Must be called from the thread owning the OpenGL context.
+   *
+   * @return Number of vertices contained in the buffer.
+   */
+  int bind() noexcept;
+
+  // Operator Overloadings
+  OpenGlTriangleBuffer& operator=(const OpenGlTriangleBuffer& rhs) = delete;
+
+private:  // Data
+  QOpenGLBuffer mBuffer;
+  int mCount;
+
+  QMutex mMutex;
+  std::optional<QVector<QVector3D>> mNewTriangles;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace librepcb
+
+#endif
@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "opengltriangleobject.h"
 
+#include "opengltrianglebuffer.h"
+
 #include <QtCore>
 #include <QtOpenGL>
 
@@ -37,15 +39,14 @@ namespace editor {
 
 OpenGlTriangleObject::OpenGlTriangleObject(Type type) noexcept
   : OpenGlObject(type),
-    mBuffer(QOpenGLBuffer::VertexBuffer),
-    mCount(0),
     mMutex(),
     mColor(Qt::black),
-    mNewTriangles() {
+    mBuffer(std::make_shared<OpenGlTriangleBuffer>()),
+    mOwnsBuffer(true),
+    mTransform() {
 }
 
 OpenGlTriangleObject::~OpenGlTriangleObject() noexcept {
-  mBuffer.destroy();
 }
 
 /*******************************************************************************
@@ -56,36 +57,50 @@ void OpenGlTriangleObject::setData(const QColor& color,
                                    const QVector<QVector3D>& data) noexcept {
   QMutexLocker lock(&mMutex);
   mColor = color;
-  mNewTriangles = data;
+  // Reuse the own buffer to keep the allocated OpenGL buffer, but never
+  // modify a buffer which is shared with other objects.
+  if (!mOwnsBuffer) {
+    mBuffer = std::make_shared<OpenGlTriangleBuffer>();
+    mOwnsBuffer = true;
+  }
+  mBuffer->setData(data);
+  mTransform.setToIdentity();
+}
+
+void OpenGlTriangleObject::setData(
+    const QColor& color, const std::shared_ptr<OpenGlTriangleBuffer>& buffer,
+    const QMatrix4x4& transform) noexcept {
+  Q_ASSERT(buffer);
+  QMutexLocker lock(&mMutex);
+  mColor = color;
+  mBuffer = buffer;
+  mOwnsBuffer = false;
+  mTransform = transform;
 }
 
 void OpenGlTriangleObject::draw(QOpenGLFunctions& gl,
                                 QOpenGLShaderProgram& program,
                                 qreal alpha) noexcept {
-  // Update buffer, if needed.
+  QColor color;
+  std::shared_ptr<OpenGlTriangleBuffer> buffer;
+  QMatrix4x4 transform;
   {
     QMutexLocker lock(&mMutex);
-    if (!mBuffer.isCreated()) {
-      mBuffer.create();
-    }
-    mBuffer.bind();
-    if (mNewTriangles) {
-      mBuffer.allocate(mNewTriangles->data(),
-                       mNewTriangles->count() * sizeof(QVector3D));
-      mCount = mNewTriangles->count();
-      mNewTriangles = std::nullopt;
-    }
+    color = mColor;
+    buffer = mBuffer;
+    transform = mTransform;
   }
 
-  QColor color = mColor;
   color.setAlphaF(color.alphaF() * alpha);
   program.setAttributeValue("a_color", color);
+  program.setUniformValue("model_matrix", transform);
 
-  mBuffer.bind();
+  // Upload the buffer, if needed.
+  const int count = buffer->bind();
   int vertexLocation = program.attributeLocation("a_position");
   program.enableAttributeArray(vertexLocation);
   program.setAttributeBuffer(vertexLocation, GL_FLOAT, 0, 3, sizeof(QVector3D));
-  gl.glDrawArrays(GL_TRIANGLES, 0, mCount);
+  gl.glDrawArrays(GL_TRIANGLES, 0, count);
 }
 
 /*******************************************************************************
@@ -28,7 +28,7 @@
 #include <QtCore>
 #include <QtOpenGL>
 
-#include <optional>
+#include <memory>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -36,12 +36,18 @@
 namespace librepcb {
 namespace editor {
 
+class OpenGlTriangleBuffer;
+
 /*******************************************************************************
  *  Class OpenGlTriangleObject
  ******************************************************************************/
 
 /**
- * @brief Asynchronously generates a 3D board scene for OpenGL rendering
+ * @brief 3D object consisting of triangles with a single color
+ *
+ * The triangles are stored in a ::librepcb::editor::OpenGlTriangleBuffer
+ * which may be shared between several objects, each of them drawing it with
+ * its own transformation (instancing).
  */
 class OpenGlTriangleObject final : public OpenGlObject {
 public:
@@ -53,6 +59,9 @@ public:
 
   // General Methods
   void setData(const QColor& color, const QVector<QVector3D>& data) noexcept;
+  void setData(const QColor& color,
+               const std::shared_ptr<OpenGlTriangleBuffer>& buffer,
+               const QMatrix4x4& transform) noexcept;
   virtual void draw(QOpenGLFunctions& gl, QOpenGLShaderProgram& program,
                     qreal alpha) noexcept override;
 
@@ -60,12 +69,11 @@ public:
   OpenGlTriangleObject& operator=(const OpenGlTriangleObject& rhs) = delete;
 
 private:  // Data
-  QOpenGLBuffer mBuffer;
-  int mCount;
-
   QMutex mMutex;
   QColor mColor;
-  std::optional<QVector<QVector3D>> mNewTriangles;
+  std::shared_ptr<OpenGlTriangleBuffer> mBuffer;
+  bool mOwnsBuffer;
+  QMatrix4x4 mTransform;
 };
 
 /*******************************************************************************
@@ -25,6 +25,7 @@
 #include "../utils/slinthelpers.h"
 
 #include <librepcb/core/application.h>
+#include <librepcb/core/utils/tracer.h>
 
 #include <QtCore>
 
@@ -133,6 +134,7 @@ void SlintOpenGlView::setAlpha(
 }
 
 slint::Image SlintOpenGlView::render(float width, float height) noexcept {
+  LIBREPCB_TRACE_ZONE("SlintOpenGlView::render");
   mViewSize = QSizeF(width, height);
   const QSize size(qCeil(width), qCeil(height));
 
@@ -28,10 +28,10 @@
 #include "ui_graphicsexportdialog.h"
 
 #include <librepcb/core/export/graphicsexport.h>
+#include <librepcb/core/utils/taskscheduler.h>
 #include <librepcb/core/utils/toolbox.h>
 #include <librepcb/core/workspace/theme.h>
 
-#include <QtConcurrent>
 #include <QtCore>
 #include <QtPrintSupport>
 
@@ -130,8 +130,9 @@ GraphicsExportDialog::GraphicsExportDialog(
     connect(mPrinterWatcher.data(),
             &QFutureWatcher<QList<QPrinterInfo>>::finished, this,
             &GraphicsExportDialog::printersAvailable);
-    mPrinterWatcher->setFuture(
-        QtConcurrent::run(&QPrinterInfo::availablePrinters));
+    mPrinterWatcher->setFuture(TaskScheduler::instance().run(
+        TaskScheduler::Group::Default, TaskScheduler::Priority::Normal,
+        []() { return QPrinterInfo::availablePrinters(); }));
   } else {
     EditorToolbox::removeFormLayoutRow(*mUi->lblPrinter);
   }
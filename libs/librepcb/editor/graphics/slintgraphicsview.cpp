@@ -25,6 +25,8 @@
 #include "../utils/slinthelpers.h"
 #include "../widgets/if_graphicsvieweventhandler.h"
 
+#include <librepcb/core/utils/tracer.h>
+
 #include <QtCore>
 
 /*******************************************************************************
@@ -115,6 +117,7 @@ void SlintGraphicsView::setEventHandler(
 
 slint::Image SlintGraphicsView::render(GraphicsScene& scene, float width,
                                        float height) noexcept {
+  LIBREPCB_TRACE_ZONE("SlintGraphicsView::render");
   const QSize size(qCeil(width), qCeil(height));
   if ((size.width() < 2) || (size.height() < 2)) {
     return slint::Image();
@@ -256,7 +256,7 @@ bool ComponentCategoryTab::requestClose() noexcept {
  *  Protected Methods
  ******************************************************************************/
 
-std::optional<std::pair<RuleCheckMessageList, QSet<SExpression>>>
+std::optional<std::pair<RuleCheckMessageList, QSet<ApprovalKey>>>
     ComponentCategoryTab::runChecksImpl() {
   return std::make_pair(mCategory->runChecks(),
                         mCategory->getMessageApprovals());
@@ -284,7 +284,7 @@ bool ComponentCategoryTab::autoFixHelper(
   return false;
 }
 
-void ComponentCategoryTab::messageApprovalChanged(const SExpression& approval,
+void ComponentCategoryTab::messageApprovalChanged(const ApprovalKey& approval,
                                                   bool approved) noexcept {
   if (mCategory->setMessageApproved(approval, approved)) {
     if (!mManualModificationsMade) {
@@ -79,7 +79,7 @@ public:
   ComponentCategoryTab& operator=(const ComponentCategoryTab& rhs) = delete;
 
 protected:
-  std::optional<std::pair<RuleCheckMessageList, QSet<SExpression>>>
+  std::optional<std::pair<RuleCheckMessageList, QSet<ApprovalKey>>>
       runChecksImpl() override;
   bool autoFixImpl(const std::shared_ptr<const RuleCheckMessage>& msg,
                    bool checkOnly) override;
@@ -88,7 +88,7 @@ protected:
                      bool checkOnly);
   template <typename MessageType>
   bool autoFix(const MessageType& msg);
-  void messageApprovalChanged(const SExpression& approval,
+  void messageApprovalChanged(const ApprovalKey& approval,
                               bool approved) noexcept override;
   void notifyDerivedUiDataChanged() noexcept override;
 
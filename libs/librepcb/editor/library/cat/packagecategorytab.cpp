@@ -256,7 +256,7 @@ bool PackageCategoryTab::requestClose() noexcept {
  *  Protected Methods
  ******************************************************************************/
 
-std::optional<std::pair<RuleCheckMessageList, QSet<SExpression>>>
+std::optional<std::pair<RuleCheckMessageList, QSet<ApprovalKey>>>
     PackageCategoryTab::runChecksImpl() {
   return std::make_pair(mCategory->runChecks(),
                         mCategory->getMessageApprovals());
@@ -284,7 +284,7 @@ bool PackageCategoryTab::autoFixHelper(
   return false;
 }
 
-void PackageCategoryTab::messageApprovalChanged(const SExpression& approval,
+void PackageCategoryTab::messageApprovalChanged(const ApprovalKey& approval,
                                                 bool approved) noexcept {
   if (mCategory->setMessageApproved(approval, approved)) {
     if (!mManualModificationsMade) {
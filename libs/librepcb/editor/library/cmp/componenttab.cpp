@@ -396,7 +396,7 @@ bool ComponentTab::requestClose() noexcept {
  *  Protected Methods
  ******************************************************************************/
 
-std::optional<std::pair<RuleCheckMessageList, QSet<SExpression>>>
+std::optional<std::pair<RuleCheckMessageList, QSet<ApprovalKey>>>
     ComponentTab::runChecksImpl() {
   // Do not run checks during wizard mode as it would be too early.
   if (mWizardMode) {
@@ -436,7 +436,7 @@ bool ComponentTab::autoFixHelper(
   return false;
 }
 
-void ComponentTab::messageApprovalChanged(const SExpression& approval,
+void ComponentTab::messageApprovalChanged(const ApprovalKey& approval,
                                           bool approved) noexcept {
   if (mComponent->setMessageApproved(approval, approved)) {
     if (!mManualModificationsMade) {
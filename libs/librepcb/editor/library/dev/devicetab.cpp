@@ -531,7 +531,7 @@ bool DeviceTab::requestClose() noexcept {
  *  Protected Methods
  ******************************************************************************/
 
-std::optional<std::pair<RuleCheckMessageList, QSet<SExpression>>>
+std::optional<std::pair<RuleCheckMessageList, QSet<ApprovalKey>>>
     DeviceTab::runChecksImpl() {
   // Do not run checks during wizard mode as it would be too early.
   if (mWizardMode) {
@@ -564,7 +564,7 @@ bool DeviceTab::autoFixHelper(
   return false;
 }
 
-void DeviceTab::messageApprovalChanged(const SExpression& approval,
+void DeviceTab::messageApprovalChanged(const ApprovalKey& approval,
                                        bool approved) noexcept {
   if (mDevice->setMessageApproved(approval, approved)) {
     if (!mManualModificationsMade) {
@@ -93,7 +93,7 @@ public:
   DeviceTab& operator=(const DeviceTab& rhs) = delete;
 
 protected:
-  std::optional<std::pair<RuleCheckMessageList, QSet<SExpression>>>
+  std::optional<std::pair<RuleCheckMessageList, QSet<ApprovalKey>>>
       runChecksImpl() override;
   bool autoFixImpl(const std::shared_ptr<const RuleCheckMessage>& msg,
                    bool checkOnly) override;
@@ -102,7 +102,7 @@ protected:
                      bool checkOnly);
   template <typename MessageType>
   bool autoFix(const MessageType& msg);
-  void messageApprovalChanged(const SExpression& approval,
+  void messageApprovalChanged(const ApprovalKey& approval,
                               bool approved) noexcept override;
   void notifyDerivedUiDataChanged() noexcept override;
 
@@ -397,7 +397,7 @@ void LibraryTab::trigger(ui::TabAction a) noexcept {
  *  Protected Methods
  ******************************************************************************/
 
-std::optional<std::pair<RuleCheckMessageList, QSet<SExpression>>>
+std::optional<std::pair<RuleCheckMessageList, QSet<ApprovalKey>>>
     LibraryTab::runChecksImpl() {
   return std::make_pair(mLibrary.runChecks(), mLibrary.getMessageApprovals());
 }
@@ -424,7 +424,7 @@ bool LibraryTab::autoFixHelper(
   return false;
 }
 
-void LibraryTab::messageApprovalChanged(const SExpression& approval,
+void LibraryTab::messageApprovalChanged(const ApprovalKey& approval,
                                         bool approved) noexcept {
   if (mLibrary.setMessageApproved(approval, approved)) {
     mEditor.setManualModificationsMade();
@@ -605,11 +605,14 @@ template <typename CategoryType>
 void LibraryTab::loadCategories(ui::LibraryTreeViewItemType type,
                                 TreeItem& root) {
   try {
-    const auto categories =
-        mDb.getAll<CategoryType>(mLibrary.getDirectory().getAbsPath());
-    mLibCategories.insert(categories);
-    for (auto it = categories.begin(); it != categories.end(); it++) {
-      getOrCreateCategory<CategoryType>(type, *it, root);
+    const QList<WorkspaceLibraryDb::ElementInfo> categories =
+        mDb.getAllInfos<CategoryType>(mLocaleOrder,
+                                      mLibrary.getDirectory().getAbsPath());
+    for (const WorkspaceLibraryDb::ElementInfo& info : categories) {
+      mLibCategories.insert(info.uuid, info);
+    }
+    for (const WorkspaceLibraryDb::ElementInfo& info : categories) {
+      getOrCreateCategory<CategoryType>(type, info.uuid, root);
     }
   } catch (const Exception& e) {
     qCritical() << "Failed to load categories:" << e.getMsg();
@@ -628,22 +631,25 @@ std::shared_ptr<LibraryTab::TreeItem> LibraryTab::getOrCreateCategory(
   item->type = type;
   item->userData = uuid.toStr();
   try {
-    FilePath fp = mLibCategories.key(uuid);
-    if (!fp.isValid()) {
-      fp = mDb.getLatest<CategoryType>(uuid);
-      item->isExternal = true;
-    } else {
-      item->path = fp;
+    std::optional<Uuid> parentUuid;
+    auto infoIt = mLibCategories.find(uuid);
+    if (infoIt != mLibCategories.end()) {
+      item->path = infoIt->filePath;
+      item->name = infoIt->name;
       item->isExternal = false;
+      parentUuid = infoIt->parent;
+    } else {
+      // Category from another library, needs to be queried separately.
+      const FilePath fp = mDb.getLatest<CategoryType>(uuid);
+      item->isExternal = true;
+      if (fp.isValid()) {
+        mDb.getTranslations<CategoryType>(fp, mLocaleOrder, &item->name);
+        mDb.getCategoryMetadata<CategoryType>(fp, &parentUuid);
+      }
     }
-    if ((!fp.isValid()) ||
-        (!mDb.getTranslations<CategoryType>(fp, mLocaleOrder, &item->name))) {
+    if (item->name.isEmpty()) {
       item->name = tr("Unknown") % " (" % uuid.toStr() % ")";
     }
-    std::optional<Uuid> parentUuid;
-    if (fp.isValid()) {
-      mDb.getCategoryMetadata<CategoryType>(fp, &parentUuid);
-    }
     auto parent = &root;
     if (parentUuid) {
       if (auto p = getOrCreateCategory<CategoryType>(type, *parentUuid, root)) {
@@ -663,20 +669,20 @@ void LibraryTab::loadElements(ui::LibraryTreeViewItemType type,
                               ui::LibraryTreeViewItemType catType,
                               TreeItem& root, int& count) {
   try {
-    const QSet<FilePath> elements = Toolbox::toSet(
-        mDb.getAll<ElementType>(mLibrary.getDirectory().getAbsPath()).keys());
+    const QList<WorkspaceLibraryDb::ElementInfo> elements =
+        mDb.getAllInfos<ElementType>(mLocaleOrder,
+                                     mLibrary.getDirectory().getAbsPath());
     count += elements.count();
-    for (const FilePath& fp : elements) {
+    for (const WorkspaceLibraryDb::ElementInfo& info : elements) {
       auto item = std::make_shared<TreeItem>();
       item->type = type;
-      item->path = fp;
-      item->userData = fp.toStr();
-      mDb.getTranslations<ElementType>(fp, mLocaleOrder, &item->name,
-                                       &item->summary);
-      item->summary = item->summary.split("\n").first().left(200);
+      item->path = info.filePath;
+      item->userData = info.filePath.toStr();
+      item->name = info.name;
+      item->summary = info.description.split("\n").first().left(200);
 
       bool addedToCategory = false;
-      for (const Uuid& catUuid : mDb.getCategoriesOf<ElementType>(fp)) {
+      for (const Uuid& catUuid : info.categories) {
         if (auto cat =
                 getOrCreateCategory<CategoryType>(catType, catUuid, root)) {
           cat->childs.push_back(item);
@@ -686,7 +692,7 @@ void LibraryTab::loadElements(ui::LibraryTreeViewItemType type,
       if (!addedToCategory) {
         mUncategorizedRoot->childs.push_back(item);
       }
-      mLibElementsMap.insert(fp.toStr(), item);
+      mLibElementsMap.insert(info.filePath.toStr(), item);
     }
   } catch (const Exception& e) {
     qCritical() << "Failed to load elements:" << e.getMsg();
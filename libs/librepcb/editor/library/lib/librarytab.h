@@ -28,6 +28,7 @@
 #include <librepcb/core/types/elementname.h>
 #include <librepcb/core/types/uuid.h>
 #include <librepcb/core/types/version.h>
+#include <librepcb/core/workspace/workspacelibrarydb.h>
 
 #include <QtCore>
 
@@ -39,7 +40,6 @@
 namespace librepcb {
 
 class Library;
-class WorkspaceLibraryDb;
 
 namespace editor {
 
@@ -103,7 +103,7 @@ signals:
                              bool copyFrom);
 
 protected:
-  std::optional<std::pair<RuleCheckMessageList, QSet<SExpression>>>
+  std::optional<std::pair<RuleCheckMessageList, QSet<ApprovalKey>>>
       runChecksImpl() override;
   bool autoFixImpl(const std::shared_ptr<const RuleCheckMessage>& msg,
                    bool checkOnly) override;
@@ -112,7 +112,7 @@ protected:
                      bool checkOnly);
   template <typename MessageType>
   bool autoFix(const MessageType& msg);
-  void messageApprovalChanged(const SExpression& approval,
+  void messageApprovalChanged(const ApprovalKey& approval,
                               bool approved) noexcept override;
   void notifyDerivedUiDataChanged() noexcept override;
 
@@ -181,7 +181,7 @@ private:
   slint::SharedString mManufacturer;
 
   // Library content
-  QHash<FilePath, Uuid> mLibCategories;
+  QHash<Uuid, WorkspaceLibraryDb::ElementInfo> mLibCategories;
   std::shared_ptr<TreeItem> mUncategorizedRoot;
   std::shared_ptr<TreeItem> mCmpCatRoot;
   int mCmpCatElementCount;
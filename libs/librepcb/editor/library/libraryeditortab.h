@@ -36,7 +36,6 @@
  ******************************************************************************/
 namespace librepcb {
 
-class SExpression;
 class TransactionalDirectory;
 
 namespace editor {
@@ -78,11 +77,11 @@ protected:
   virtual void reloadFromDisk() {}
   void scheduleChecks() noexcept;
   void runChecks() noexcept;
-  virtual std::optional<std::pair<RuleCheckMessageList, QSet<SExpression>>>
+  virtual std::optional<std::pair<RuleCheckMessageList, QSet<ApprovalKey>>>
       runChecksImpl() = 0;
   virtual bool autoFixImpl(const std::shared_ptr<const RuleCheckMessage>& msg,
                            bool checkOnly) = 0;
-  virtual void messageApprovalChanged(const SExpression& approval,
+  virtual void messageApprovalChanged(const ApprovalKey& approval,
                                       bool approved) noexcept = 0;
   virtual void notifyDerivedUiDataChanged() noexcept = 0;
   QString getWorkspaceSettingsUserName() const noexcept;
@@ -99,8 +98,8 @@ protected:
   bool mManualModificationsMade;
 
   // Rule check
-  QSet<SExpression> mSupportedApprovals;
-  QSet<SExpression> mDisappearedApprovals;
+  QSet<ApprovalKey> mSupportedApprovals;
+  QSet<ApprovalKey> mDisappearedApprovals;
   std::shared_ptr<RuleCheckMessagesModel> mCheckMessages;
   slint::SharedString mCheckError;
   QTimer mRuleCheckDelayTimer;
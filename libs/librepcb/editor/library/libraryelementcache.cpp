@@ -31,6 +31,7 @@
 #include <librepcb/core/library/library.h>
 #include <librepcb/core/library/pkg/package.h>
 #include <librepcb/core/library/sym/symbol.h>
+#include <librepcb/core/utils/taskscheduler.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
 
 #include <QtCore>
@@ -47,11 +48,9 @@ namespace editor {
 
 LibraryElementCache::LibraryElementCache(const WorkspaceLibraryDb& db,
                                          QObject* parent) noexcept
-  : QObject(parent), mDb(&db) {
+  : QObject(parent), mDb(&db), mCache(100 * 1024), mGeneration(0) {
   // Every time the library rescan is started, it means something has changed
   // in the workspace libraries so the cached elements should be discarded.
-  // This also ensures that from time to time the memory of cached elements
-  // is freed, avoiding endless increase of memory consumption.
   connect(&db, &WorkspaceLibraryDb::scanStarted, this,
           &LibraryElementCache::reset);
 
@@ -64,94 +63,179 @@ LibraryElementCache::LibraryElementCache(const WorkspaceLibraryDb& db,
 }
 
 LibraryElementCache::~LibraryElementCache() noexcept {
+  // Skip all loads which have not been started yet and wait for the others.
+  foreach (const auto& pending, mPending) {
+    pending->watcher->disconnect(this);
+    pending->job->abort();
+  }
+  foreach (const auto& pending, mPending) {
+    pending->future.waitForFinished();
+  }
 }
 
 /*******************************************************************************
- *  General Methods
+ *  Setters
  ******************************************************************************/
 
-template <typename T>
-static void clearAndCount(T& container, int& count) noexcept {
-  count += container.count();
-  container.clear();
+void LibraryElementCache::setMaxCost(qsizetype cost) noexcept {
+  mCache.setMaxCost(cost);
 }
 
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
 void LibraryElementCache::reset() noexcept {
-  int count = 0;
-  clearAndCount(mCmpCat, count);
-  clearAndCount(mPkgCat, count);
-  clearAndCount(mSym, count);
-  clearAndCount(mPkg, count);
-  clearAndCount(mCmp, count);
-  clearAndCount(mDev, count);
+  const qsizetype count = mCache.count();
+  mCache.clear();
+  ++mGeneration;  // Don't cache the results of already running loads.
   qDebug() << "Discarded" << count << "cached library elements.";
 }
 
 std::shared_ptr<const ComponentCategory>
     LibraryElementCache::getComponentCategory(const Uuid& uuid,
                                               bool throwIfNotFound) const {
-  return getElement(mCmpCat, uuid, throwIfNotFound);
+  return getElement<ComponentCategory>(uuid, throwIfNotFound);
 }
 
 std::shared_ptr<const PackageCategory> LibraryElementCache::getPackageCategory(
     const Uuid& uuid, bool throwIfNotFound) const {
-  return getElement(mPkgCat, uuid, throwIfNotFound);
+  return getElement<PackageCategory>(uuid, throwIfNotFound);
 }
 
 std::shared_ptr<const Symbol> LibraryElementCache::getSymbol(
     const Uuid& uuid, bool throwIfNotFound) const {
-  return getElement(mSym, uuid, throwIfNotFound);
+  return getElement<Symbol>(uuid, throwIfNotFound);
 }
 
 std::shared_ptr<const Package> LibraryElementCache::getPackage(
     const Uuid& uuid, bool throwIfNotFound) const {
-  return getElement(mPkg, uuid, throwIfNotFound);
+  return getElement<Package>(uuid, throwIfNotFound);
 }
 
 std::shared_ptr<const Component> LibraryElementCache::getComponent(
     const Uuid& uuid, bool throwIfNotFound) const {
-  return getElement(mCmp, uuid, throwIfNotFound);
+  return getElement<Component>(uuid, throwIfNotFound);
 }
 
 std::shared_ptr<const Device> LibraryElementCache::getDevice(
     const Uuid& uuid, bool throwIfNotFound) const {
-  return getElement(mDev, uuid, throwIfNotFound);
+  return getElement<Device>(uuid, throwIfNotFound);
+}
+
+template <typename T>
+void LibraryElementCache::request(const Uuid& uuid, QObject* context,
+                                  Callback<T> callback) const noexcept {
+  Q_ASSERT(context);
+  const Key key{getType<T>(), uuid};
+  if (auto cached = mCache.object(key)) {
+    // Deliver asynchronously too, for consistent behavior towards the caller.
+    QMetaObject::invokeMethod(
+        context,
+        [callback, element = std::static_pointer_cast<const T>(*cached)]() {
+          callback(element, QString());
+        },
+        Qt::QueuedConnection);
+  } else if (std::shared_ptr<PendingLoad> pending = startLoad<T>(key, false)) {
+    pending->callbacks.append(std::make_pair(
+        QPointer<QObject>(context),
+        [callback](const std::shared_ptr<const LibraryBaseElement>& element,
+                   const QString& errorMsg) {
+          callback(std::static_pointer_cast<const T>(element), errorMsg);
+        }));
+  } else {
+    QMetaObject::invokeMethod(
+        context,
+        [callback, errorMsg = getNotFoundMessage<T>(uuid)]() {
+          callback(nullptr, errorMsg);
+        },
+        Qt::QueuedConnection);
+  }
+}
+
+template <typename T>
+void LibraryElementCache::prefetch(const QList<Uuid>& uuids) const noexcept {
+  // Discard outdated prefetches. Loads which are already running cannot be
+  // interrupted, but their result gets discarded.
+  const Type type = getType<T>();
+  for (auto it = mPending.begin(); it != mPending.end();) {
+    const std::shared_ptr<PendingLoad>& pending = it.value();
+    if ((it.key().type == type) && pending->prefetchOnly &&
+        (!uuids.contains(it.key().uuid))) {
+      pending->watcher->disconnect(this);
+      pending->job->abort();
+      it = mPending.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  foreach (const Uuid& uuid, uuids) {
+    const Key key{type, uuid};
+    if (!mCache.contains(key)) {
+      startLoad<T>(key, true);
+    }
+  }
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+template <typename T>
+constexpr LibraryElementCache::Type LibraryElementCache::getType() noexcept {
+  if constexpr (std::is_same_v<T, ComponentCategory>) {
+    return Type::ComponentCategory;
+  } else if constexpr (std::is_same_v<T, PackageCategory>) {
+    return Type::PackageCategory;
+  } else if constexpr (std::is_same_v<T, Symbol>) {
+    return Type::Symbol;
+  } else if constexpr (std::is_same_v<T, Package>) {
+    return Type::Package;
+  } else if constexpr (std::is_same_v<T, Component>) {
+    return Type::Component;
+  } else {
+    static_assert(std::is_same_v<T, Device>);
+    return Type::Device;
+  }
+}
+
 template <typename T>
 std::shared_ptr<const T> LibraryElementCache::getElement(
-    QHash<Uuid, std::shared_ptr<const T>>& container, const Uuid& uuid,
-    bool throwIfNotFound) const {
-  std::shared_ptr<const T> element = container.value(uuid);
+    const Uuid& uuid, bool throwIfNotFound) const {
+  const Key key{getType<T>(), uuid};
+  std::shared_ptr<const LibraryBaseElement> element;
   QString errMsg = "Unknown error, please open an bug report.";
-  if ((!element) && mDb) {
-    const bool scanInProgress = mDb->isScanInProgress();
+  if (auto cached = mCache.object(key)) {
+    element = *cached;
+  } else if (mPending.contains(key)) {
+    // The element is already being opened in background, so just wait for it
+    // instead of opening it a second time. Note that if the load has not been
+    // started yet, it is run in this thread instead of waiting for the task
+    // scheduler to start it.
+    const std::shared_ptr<PendingLoad> pending = mPending.value(key);
+    pending->job->run();
+    pending->future.waitForFinished();
+    const Result result = pending->future.result();
+    loadFinished(key);
+    element = result.element;
+    errMsg = result.errorMsg;
+  } else if (mDb) {
     try {
-      FilePath fp = mDb->getLatest<T>(uuid);
+      const FilePath fp = mDb->getLatest<T>(uuid);
       if (fp.isValid()) {
-        element.reset(T::open(std::unique_ptr<TransactionalDirectory>(
-                                  new TransactionalDirectory(
-                                      TransactionalFileSystem::openRO(fp))))
-                          .release());
-        container.insert(uuid, element);
-      } else {
-        errMsg = tr("Library element '%1' with UUID '%2' not found in "
-                    "workspace library.")
-                     .arg(T::getLongElementName())
-                     .arg(uuid.toStr());
-        if (scanInProgress) {
-          errMsg += " " %
-              tr("Please try again after the background library rescan has "
-                 "completed.");
+        const Result result = load<T>(fp, QThread::currentThread());
+        if (result.element) {
+          element = result.element;
+          mCache.insert(
+              key,
+              new std::shared_ptr<const LibraryBaseElement>(result.element),
+              result.cost);
         } else {
-          errMsg += " " %
-              tr("Please make sure that all dependent libraries are "
-                 "installed.");
+          errMsg = result.errorMsg;
         }
+      } else {
+        errMsg = getNotFoundMessage<T>(uuid);
       }
     } catch (const Exception& e) {
       qWarning() << "Failed to open library element:" << e.getMsg();
@@ -161,9 +245,171 @@ std::shared_ptr<const T> LibraryElementCache::getElement(
   if ((!element) && throwIfNotFound) {
     throw RuntimeError(__FILE__, __LINE__, errMsg);
   }
-  return element;
+  return std::static_pointer_cast<const T>(element);
 }
 
+template <typename T>
+std::shared_ptr<LibraryElementCache::PendingLoad>
+    LibraryElementCache::startLoad(const Key& key,
+                                   bool prefetch) const noexcept {
+  if (std::shared_ptr<PendingLoad> pending = mPending.value(key)) {
+    if (pending->prefetchOnly && (!prefetch)) {
+      // The prefetch might be queued behind many other prefetches, so
+      // schedule it again with normal priority. Whichever of the tasks is
+      // started first opens the element.
+      scheduleLoad(pending->job, false);
+    }
+    pending->prefetchOnly = pending->prefetchOnly && prefetch;
+    return pending;
+  }
+
+  // Determine the file path here since the database must not be accessed
+  // from other threads.
+  FilePath fp;
+  try {
+    if (mDb) {
+      fp = mDb->getLatest<T>(key.uuid);
+    }
+  } catch (const Exception& e) {
+    qWarning() << "Failed to get library element path:" << e.getMsg();
+  }
+  if (!fp.isValid()) {
+    return nullptr;
+  }
+
+  QThread* thread = this->thread();
+  auto pending = std::make_shared<PendingLoad>();
+  pending->job = std::make_shared<LoadJob>();
+  pending->job->func = [fp, thread]() { return load<T>(fp, thread); };
+  pending->job->promise.start();
+  pending->future = pending->job->promise.future();
+  pending->prefetchOnly = prefetch;
+  pending->generation = mGeneration;
+  scheduleLoad(pending->job, prefetch);
+  pending->watcher.reset(new QFutureWatcher<Result>(),
+                         [](QObject* obj) { obj->deleteLater(); });
+  connect(pending->watcher.get(), &QFutureWatcher<Result>::finished, this,
+          [this, key]() { loadFinished(key); });
+  pending->watcher->setFuture(pending->future);
+  mPending.insert(key, pending);
+  return pending;
+}
+
+void LibraryElementCache::scheduleLoad(const std::shared_ptr<LoadJob>& job,
+                                       bool prefetch) noexcept {
+  std::ignore = TaskScheduler::instance().run(
+      TaskScheduler::Group::Library,
+      prefetch ? TaskScheduler::Priority::Background
+               : TaskScheduler::Priority::Normal,
+      [job]() { job->run(); });
+}
+
+void LibraryElementCache::loadFinished(const Key& key) const noexcept {
+  const std::shared_ptr<PendingLoad> pending = mPending.take(key);
+  if (!pending) {
+    return;
+  }
+  pending->watcher->disconnect(this);
+
+  const Result result = pending->future.result();
+  if (result.element && (pending->generation == mGeneration)) {
+    mCache.insert(
+        key, new std::shared_ptr<const LibraryBaseElement>(result.element),
+        result.cost);
+  }
+  for (const auto& callback : pending->callbacks) {
+    if (callback.first) {
+      QMetaObject::invokeMethod(
+          callback.first.data(),
+          [f = callback.second, result]() {
+            f(result.element, result.errorMsg);
+          },
+          Qt::QueuedConnection);
+    }
+  }
+}
+
+template <typename T>
+QString LibraryElementCache::getNotFoundMessage(
+    const Uuid& uuid) const noexcept {
+  QString errMsg = tr("Library element '%1' with UUID '%2' not found in "
+                      "workspace library.")
+                       .arg(T::getLongElementName())
+                       .arg(uuid.toStr());
+  if (mDb && mDb->isScanInProgress()) {
+    errMsg += " " %
+        tr("Please try again after the background library rescan has "
+           "completed.");
+  } else {
+    errMsg += " " %
+        tr("Please make sure that all dependent libraries are "
+           "installed.");
+  }
+  return errMsg;
+}
+
+template <typename T>
+LibraryElementCache::Result LibraryElementCache::load(
+    const FilePath& fp, QThread* thread) noexcept {
+  Result result;
+  try {
+    std::unique_ptr<T> element =
+        T::open(std::unique_ptr<TransactionalDirectory>(
+            new TransactionalDirectory(
+                TransactionalFileSystem::openRO(fp))));  // can throw
+
+    // The opened objects must live in the cache's thread, not in the worker
+    // thread which may be destroyed at any time.
+    element->getDirectory().getFileSystem()->moveToThread(thread);
+    element->getDirectory().moveToThread(thread);
+    element->moveToThread(thread);
+    result.element.reset(element.release());
+
+    // Approximate the memory consumption by the size of the files.
+    qint64 size = 0;
+    QDirIterator it(fp.toStr(), QDir::Files | QDir::Hidden,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+      it.next();
+      size += it.fileInfo().size();
+    }
+    result.cost = std::max(size / 1024, qint64(1));
+  } catch (const Exception& e) {
+    qWarning() << "Failed to open library element:" << e.getMsg();
+    result.errorMsg = e.getMsg();
+  }
+  return result;
+}
+
+/*******************************************************************************
+ *  Explicit Template Instantiation
+ ******************************************************************************/
+
+template void LibraryElementCache::request<ComponentCategory>(
+    const Uuid&, QObject*, Callback<ComponentCategory>) const noexcept;
+template void LibraryElementCache::request<PackageCategory>(
+    const Uuid&, QObject*, Callback<PackageCategory>) const noexcept;
+template void LibraryElementCache::request<Symbol>(
+    const Uuid&, QObject*, Callback<Symbol>) const noexcept;
+template void LibraryElementCache::request<Package>(
+    const Uuid&, QObject*, Callback<Package>) const noexcept;
+template void LibraryElementCache::request<Component>(
+    const Uuid&, QObject*, Callback<Component>) const noexcept;
+template void LibraryElementCache::request<Device>(
+    const Uuid&, QObject*, Callback<Device>) const noexcept;
+template void LibraryElementCache::prefetch<ComponentCategory>(
+    const QList<Uuid>&) const noexcept;
+template void LibraryElementCache::prefetch<PackageCategory>(
+    const QList<Uuid>&) const noexcept;
+template void LibraryElementCache::prefetch<Symbol>(
+    const QList<Uuid>&) const noexcept;
+template void LibraryElementCache::prefetch<Package>(
+    const QList<Uuid>&) const noexcept;
+template void LibraryElementCache::prefetch<Component>(
+    const QList<Uuid>&) const noexcept;
+template void LibraryElementCache::prefetch<Device>(
+    const QList<Uuid>&) const noexcept;
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
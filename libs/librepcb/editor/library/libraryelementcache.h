@@ -28,6 +28,8 @@
 
 #include <QtCore>
 
+#include <atomic>
+#include <functional>
 #include <memory>
 
 /*******************************************************************************
@@ -38,6 +40,7 @@ namespace librepcb {
 class Component;
 class ComponentCategory;
 class Device;
+class LibraryBaseElement;
 class Package;
 class PackageCategory;
 class Symbol;
@@ -51,11 +54,32 @@ namespace editor {
 
 /**
  * @brief Cache for fast access to library elements
+ *
+ * Opened elements are kept in a least-recently-used cache which is bounded
+ * by a maximum cost. The cost of an element is approximated by the size of
+ * its files on disk (in KiB), so the cache does not grow endlessly when
+ * browsing through large libraries. Elements which got evicted are still
+ * valid for anyone holding a reference to them, they are just re-opened
+ * the next time they are requested.
+ *
+ * Besides the blocking getters, elements can be requested asynchronously
+ * with #request() and prefetched in background with #prefetch(). Both of
+ * them open the elements in the ::librepcb::TaskScheduler, thus not blocking
+ * the GUI. Prefetches are run with background priority, requests with
+ * normal priority.
+ *
+ * @note This class is not thread-safe and must only be used from the
+ *       thread it lives in (i.e. the main thread).
  */
 class LibraryElementCache final : public QObject {
   Q_OBJECT
 
 public:
+  // Types
+  template <typename T>
+  using Callback =
+      std::function<void(std::shared_ptr<const T> element, QString errorMsg)>;
+
   // Constructors / Destructor
   LibraryElementCache() = delete;
   LibraryElementCache(const LibraryElementCache& other) = delete;
@@ -63,6 +87,14 @@ public:
                                QObject* parent = nullptr) noexcept;
   ~LibraryElementCache() noexcept;
 
+  // Getters
+  qsizetype getMaxCost() const noexcept { return mCache.maxCost(); }
+  qsizetype getTotalCost() const noexcept { return mCache.totalCost(); }
+  qsizetype getCount() const noexcept { return mCache.count(); }
+
+  // Setters
+  void setMaxCost(qsizetype cost) noexcept;
+
   // General Methods
   void reset() noexcept;
   std::shared_ptr<const ComponentCategory> getComponentCategory(
@@ -78,6 +110,37 @@ public:
   std::shared_ptr<const Device> getDevice(const Uuid& uuid,
                                           bool throwIfNotFound) const;
 
+  /**
+   * @brief Request a library element without blocking
+   *
+   * The element is opened in a background thread (if not cached yet) and
+   * then passed to the callback. The callback is always invoked
+   * asynchronously in the thread of the context object, and it is not
+   * invoked at all if the context object has been destroyed in the
+   * meantime.
+   *
+   * @param uuid      UUID of the element to request.
+   * @param context   Context object of the callback (must not be nullptr).
+   * @param callback  Called with the element, or with nullptr and an
+   *                  error message if the element could not be opened.
+   */
+  template <typename T>
+  void request(const Uuid& uuid, QObject* context,
+               Callback<T> callback) const noexcept;
+
+  /**
+   * @brief Open library elements in background to have them cached later
+   *
+   * Intended to be called with the elements which are likely to be
+   * requested soon, e.g. the currently visible search results. Prefetches
+   * of the same element type from a previous call which have not been
+   * started yet and are not contained in the new list are discarded.
+   *
+   * @param uuids   UUIDs of the elements to prefetch, in order of priority.
+   */
+  template <typename T>
+  void prefetch(const QList<Uuid>& uuids) const noexcept;
+
   // Operator Overloadings
   LibraryElementCache& operator=(const LibraryElementCache& rhs) = delete;
 
@@ -85,20 +148,92 @@ signals:
   void scanStarted();
   void scanSucceeded();
 
+private:  // Types
+  enum class Type {
+    ComponentCategory,
+    PackageCategory,
+    Symbol,
+    Package,
+    Component,
+    Device,
+  };
+
+  struct Key {
+    Type type;
+    Uuid uuid;
+
+    bool operator==(const Key& rhs) const noexcept = default;
+    friend size_t qHash(const Key& key, size_t seed = 0) noexcept {
+      return qHashMulti(seed, static_cast<int>(key.type), key.uuid);
+    }
+  };
+
+  struct Result {
+    std::shared_ptr<const LibraryBaseElement> element;
+    qsizetype cost = 0;
+    QString errorMsg;
+  };
+
+  typedef std::function<void(const std::shared_ptr<const LibraryBaseElement>&,
+                             const QString&)>
+      PendingCallback;
+
+  /**
+   * @brief Opening of an element, possibly scheduled several times
+   *
+   * Whoever calls #run() first opens the element, all further calls (and
+   * calls after #abort()) are no-ops.
+   */
+  struct LoadJob {
+    std::function<Result()> func;
+    std::atomic_bool claimed{false};
+    QPromise<Result> promise;
+
+    void run() noexcept {
+      if (!claimed.exchange(true)) {
+        promise.addResult(func());
+        promise.finish();
+      }
+    }
+    void abort() noexcept {
+      if (!claimed.exchange(true)) {
+        promise.addResult(Result());
+        promise.finish();
+      }
+    }
+  };
+
+  struct PendingLoad {
+    std::shared_ptr<LoadJob> job;
+    QFuture<Result> future;
+    std::shared_ptr<QFutureWatcher<Result>> watcher;
+    QList<std::pair<QPointer<QObject>, PendingCallback>> callbacks;
+    bool prefetchOnly;
+    int generation;
+  };
+
 private:  // Methods
   template <typename T>
-  std::shared_ptr<const T> getElement(
-      QHash<Uuid, std::shared_ptr<const T>>& container, const Uuid& uuid,
-      bool throwIfNotFound) const;
+  std::shared_ptr<const T> getElement(const Uuid& uuid,
+                                      bool throwIfNotFound) const;
+  template <typename T>
+  std::shared_ptr<PendingLoad> startLoad(const Key& key,
+                                         bool prefetch) const noexcept;
+  static void scheduleLoad(const std::shared_ptr<LoadJob>& job,
+                           bool prefetch) noexcept;
+  void loadFinished(const Key& key) const noexcept;
+  template <typename T>
+  QString getNotFoundMessage(const Uuid& uuid) const noexcept;
+  template <typename T>
+  static Result load(const FilePath& fp, QThread* thread) noexcept;
+  template <typename T>
+  static constexpr Type getType() noexcept;
 
 private:  // Data
   QPointer<const WorkspaceLibraryDb> mDb;
-  mutable QHash<Uuid, std::shared_ptr<const ComponentCategory>> mCmpCat;
-  mutable QHash<Uuid, std::shared_ptr<const PackageCategory>> mPkgCat;
-  mutable QHash<Uuid, std::shared_ptr<const Symbol>> mSym;
-  mutable QHash<Uuid, std::shared_ptr<const Package>> mPkg;
-  mutable QHash<Uuid, std::shared_ptr<const Component>> mCmp;
-  mutable QHash<Uuid, std::shared_ptr<const Device>> mDev;
+  mutable QCache<Key, std::shared_ptr<const LibraryBaseElement>> mCache;
+  mutable QHash<Key, std::shared_ptr<PendingLoad>> mPending;
+  int mGeneration;  ///< Incremented on every reset
 };
 
 /*******************************************************************************
@@ -1908,7 +1908,7 @@ void PackageTab::reloadFromDisk() {
   refreshUiData();
 }
 
-std::optional<std::pair<RuleCheckMessageList, QSet<SExpression>>>
+std::optional<std::pair<RuleCheckMessageList, QSet<ApprovalKey>>>
     PackageTab::runChecksImpl() {
   // Do not run checks during wizard mode as it would be too early.
   if (mWizardMode) {
@@ -1971,7 +1971,7 @@ bool PackageTab::autoFixHelper(
   return false;
 }
 
-void PackageTab::messageApprovalChanged(const SExpression& approval,
+void PackageTab::messageApprovalChanged(const ApprovalKey& approval,
                                         bool approved) noexcept {
   if (mPackage->setMessageApproved(approval, approved)) {
     if (!mManualModificationsMade) {
@@ -2652,6 +2652,7 @@ void PackageTab::updateOpenGlScene() noexcept {
     if (mCurrentModel) {
       data->addDevice(mPackage->getUuid(), Transform(),
                       mCurrentModel->getFileName(),
+                      *mCurrentModel->getName(),
                       footprint->getModelPosition(),
                       footprint->getModelRotation(), QString());
     }
@@ -183,7 +183,7 @@ signals:
 protected:
   void watchedFilesModifiedChanged() noexcept override;
   void reloadFromDisk() override;
-  std::optional<std::pair<RuleCheckMessageList, QSet<SExpression>>>
+  std::optional<std::pair<RuleCheckMessageList, QSet<ApprovalKey>>>
       runChecksImpl() override;
   bool autoFixImpl(const std::shared_ptr<const RuleCheckMessage>& msg,
                    bool checkOnly) override;
@@ -194,7 +194,7 @@ protected:
   bool autoFix(const MessageType& msg);
   template <typename MessageType>
   bool fixPadFunction(const MessageType& msg);
-  void messageApprovalChanged(const SExpression& approval,
+  void messageApprovalChanged(const ApprovalKey& approval,
                               bool approved) noexcept override;
   void notifyDerivedUiDataChanged() noexcept override;
 
@@ -1313,7 +1313,7 @@ void SymbolTab::reloadFromDisk() {
   refreshUiData();
 }
 
-std::optional<std::pair<RuleCheckMessageList, QSet<SExpression>>>
+std::optional<std::pair<RuleCheckMessageList, QSet<ApprovalKey>>>
     SymbolTab::runChecksImpl() {
   // Do not run checks during wizard mode as it would be too early.
   if (mWizardMode) {
@@ -1361,7 +1361,7 @@ bool SymbolTab::autoFixHelper(
   return false;
 }
 
-void SymbolTab::messageApprovalChanged(const SExpression& approval,
+void SymbolTab::messageApprovalChanged(const ApprovalKey& approval,
                                        bool approved) noexcept {
   if (mSymbol->setMessageApproved(approval, approved)) {
     if (!mManualModificationsMade) {
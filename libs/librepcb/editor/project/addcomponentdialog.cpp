@@ -25,6 +25,7 @@
 #include "../editorcommandset.h"
 #include "../graphics/graphicslayerlist.h"
 #include "../graphics/graphicsscene.h"
+#include "../library/libraryelementcache.h"
 #include "../library/pkg/footprintgraphicsitem.h"
 #include "../library/sym/symbolgraphicsitem.h"
 #include "../modelview/partinformationdelegate.h"
@@ -45,6 +46,7 @@
 #include <librepcb/core/library/pkg/package.h>
 #include <librepcb/core/library/sym/symbol.h>
 #include <librepcb/core/utils/scopeguard.h>
+#include <librepcb/core/utils/taskscheduler.h>
 #include <librepcb/core/workspace/theme.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
 #include <librepcb/core/workspace/workspacesettings.h>
@@ -58,6 +60,20 @@
 namespace librepcb {
 namespace editor {
 
+template <typename T>
+static std::shared_ptr<T> openElement(const FilePath& fp, QThread* thread) {
+  std::unique_ptr<T> element =
+      T::open(std::unique_ptr<TransactionalDirectory>(
+          new TransactionalDirectory(
+              TransactionalFileSystem::openRO(fp))));  // can throw
+
+  // The opened objects must live in the GUI thread, not in the worker thread.
+  element->getDirectory().getFileSystem()->moveToThread(thread);
+  element->getDirectory().moveToThread(thread);
+  element->moveToThread(thread);
+  return std::shared_ptr<T>(element.release());
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -66,10 +82,12 @@ AddComponentDialog::AddComponentDialog(const WorkspaceLibraryDb& db,
                                        const WorkspaceSettings& settings,
                                        const QStringList& localeOrder,
                                        const QStringList& normOrder,
+                                       const LibraryElementCache* cache,
                                        QWidget* parent)
   : QDialog(parent),
     mDb(db),
     mSettings(settings),
+    mCache(cache),
     mLocaleOrder(localeOrder),
     mNormOrder(normOrder),
     mUi(new Ui::AddComponentDialog),
@@ -90,7 +108,8 @@ AddComponentDialog::AddComponentDialog(const WorkspaceLibraryDb& db,
     mSelectedDevice(nullptr),
     mSelectedPackage(nullptr),
     mSelectedPart(nullptr),
-    mPreviewFootprintGraphicsItem(nullptr) {
+    mPreviewFootprintGraphicsItem(nullptr),
+    mAcceptWhenOpened(false) {
   mUi->setupUi(this);
   mUi->treeComponents->setColumnCount(3);
   mUi->treeComponents->header()->setStretchLastSection(false);
@@ -231,6 +250,8 @@ AddComponentDialog::AddComponentDialog(const WorkspaceLibraryDb& db,
           this, &AddComponentDialog::schedulePartsInformationUpdate);
   connect(mUi->treeComponents->verticalScrollBar(), &QScrollBar::valueChanged,
           this, &AddComponentDialog::schedulePartsInformationUpdate);
+  connect(mUi->treeComponents->verticalScrollBar(), &QScrollBar::valueChanged,
+          this, &AddComponentDialog::prefetchVisibleElements);
   connect(&PartInformationProvider::instance(),
           &PartInformationProvider::serviceOperational, this,
           &AddComponentDialog::schedulePartsInformationUpdate);
@@ -368,6 +389,8 @@ void AddComponentDialog::treeComponents_currentItemChanged(
     QTreeWidgetItem* current, QTreeWidgetItem* previous) noexcept {
   Q_UNUSED(previous);
   mUi->lblErrorMsg->clear();
+  mRequestedComponentFp = FilePath();  // Discard outdated requests.
+  mRequestedDeviceFp = FilePath();
   try {
     if (current) {
       QTreeWidgetItem* partItem = current;
@@ -381,7 +404,29 @@ void AddComponentDialog::treeComponents_currentItemChanged(
       FilePath cmpFp = FilePath(cmpItem->data(0, Qt::UserRole).toString());
       if ((!mSelectedComponent) ||
           (mSelectedComponent->getDirectory().getAbsPath() != cmpFp)) {
-        std::shared_ptr<Component> component(
+        const std::optional<Uuid> cmpUuid =
+            Uuid::tryFromString(cmpItem->data(0, Qt::UserRole + 1).toString());
+        if (mCache && cmpUuid) {
+          // Open the component in background (it might even be prefetched
+          // already), the selection is continued when it is available.
+          setSelectedComponent(nullptr);
+          mRequestedComponentFp = cmpFp;
+          mCache->request<Component>(
+              *cmpUuid, this,
+              [this, cmpFp](std::shared_ptr<const Component> cmp,
+                            QString errorMsg) {
+                if (cmpFp != mRequestedComponentFp) return;  // Outdated.
+                mRequestedComponentFp = FilePath();
+                try {
+                  if (cmp) setSelectedComponent(cmp);  // can throw
+                } catch (const Exception& e) {
+                  errorMsg = e.getMsg();
+                }
+                requestedElementOpened(cmp && errorMsg.isEmpty(), errorMsg);
+              });
+          return;
+        }
+        std::shared_ptr<const Component> component(
             Component::open(std::unique_ptr<TransactionalDirectory>(
                                 new TransactionalDirectory(
                                     TransactionalFileSystem::openRO(cmpFp))))
@@ -392,7 +437,28 @@ void AddComponentDialog::treeComponents_currentItemChanged(
         FilePath devFp = FilePath(devItem->data(0, Qt::UserRole).toString());
         if ((!mSelectedDevice) ||
             (mSelectedDevice->getDirectory().getAbsPath() != devFp)) {
-          std::shared_ptr<Device> device(
+          const std::optional<Uuid> devUuid = Uuid::tryFromString(
+              devItem->data(0, Qt::UserRole + 1).toString());
+          if (mCache && devUuid) {
+            // Same as for the component.
+            setSelectedDevice(nullptr);
+            mRequestedDeviceFp = devFp;
+            mCache->request<Device>(
+                *devUuid, this,
+                [this, devFp](std::shared_ptr<const Device> dev,
+                              QString errorMsg) {
+                  if (devFp != mRequestedDeviceFp) return;  // Outdated.
+                  mRequestedDeviceFp = FilePath();
+                  try {
+                    if (dev) setSelectedDevice(dev);  // can throw
+                  } catch (const Exception& e) {
+                    errorMsg = e.getMsg();
+                  }
+                  requestedElementOpened(dev && errorMsg.isEmpty(), errorMsg);
+                });
+            return;
+          }
+          std::shared_ptr<const Device> device(
               Device::open(std::unique_ptr<TransactionalDirectory>(
                                new TransactionalDirectory(
                                    TransactionalFileSystem::openRO(devFp))))
@@ -435,6 +501,7 @@ void AddComponentDialog::treeComponents_itemExpanded(
     QTreeWidgetItem* item) noexcept {
   if (mUpdatePartInformationOnExpand && item && (item->childCount() > 0)) {
     updatePartsInformation();
+    prefetchVisibleElements();
   }
 }
 
@@ -527,6 +594,9 @@ void AddComponentDialog::searchComponents(
       cmpItem->setForeground(
           0, cmpIt.value().deprecated ? QBrush(Qt::red) : QBrush());
       cmpItem->setData(0, Qt::UserRole, cmpIt.key().toStr());
+      if (cmpIt.value().uuid) {
+        cmpItem->setData(0, Qt::UserRole + 1, cmpIt.value().uuid->toStr());
+      }
       for (auto devIt = cmpIt->devices.begin(); devIt != cmpIt->devices.end();
            ++devIt) {
         QTreeWidgetItem* devItem = new QTreeWidgetItem(cmpItem);
@@ -535,6 +605,9 @@ void AddComponentDialog::searchComponents(
         devItem->setForeground(
             0, devIt.value().deprecated ? QBrush(Qt::red) : QBrush());
         devItem->setData(0, Qt::UserRole, devIt.key().toStr());
+        if (devIt.value().uuid) {
+          devItem->setData(0, Qt::UserRole + 1, devIt.value().uuid->toStr());
+        }
         devItem->setText(1, devIt.value().pkgName);
         devItem->setTextAlignment(1, Qt::AlignRight);
         QFont font = devItem->font(1);
@@ -587,6 +660,8 @@ void AddComponentDialog::searchComponents(
     }
   }
 
+  prefetchVisibleElements();
+
   // Delay parts information download, but show cached information immediately
   // to avoid flicker.
   updatePartsInformation(1200);
@@ -610,6 +685,7 @@ AddComponentDialog::SearchResult AddComponentDialog::search(
     if (!cmpFp.isValid()) continue;
     QSet<Uuid> devices = mDb.getComponentDevices(cmpUuid);  // can throw
     SearchResultComponent& resCmp = result.components[cmpFp];
+    resCmp.uuid = cmpUuid;
     resCmp.match = true;
     foreach (const Uuid& devUuid, devices) {
       FilePath devFp = mDb.getLatest<Device>(devUuid);  // can throw
@@ -655,7 +731,9 @@ AddComponentDialog::SearchResult AddComponentDialog::search(
                           &pkgUuid);  // can throw
     const FilePath cmpFp = mDb.getLatest<Component>(cmpUuid);  // can throw
     if (!cmpFp.isValid()) continue;
-    SearchResultDevice& resDev = result.components[cmpFp].devices[devFp];
+    SearchResultComponent& resCmp = result.components[cmpFp];
+    resCmp.uuid = cmpUuid;
+    SearchResultDevice& resDev = resCmp.devices[devFp];
     FilePath pkgFp = mDb.getLatest<Package>(pkgUuid);  // can throw
     resDev.uuid = devUuid;
     resDev.pkgFp = pkgFp;
@@ -733,6 +811,7 @@ void AddComponentDialog::setSelectedCategory(
     cmpItem->setText(0, cmpName);
     cmpItem->setForeground(0, cmpDeprecated ? QBrush(Qt::red) : QBrush());
     cmpItem->setData(0, Qt::UserRole, cmpFp.toStr());
+    cmpItem->setData(0, Qt::UserRole + 1, cmpUuid.toStr());
     // devices
     QSet<Uuid> devices = mDb.getComponentDevices(cmpUuid);
     foreach (const Uuid& devUuid, devices) {
@@ -748,6 +827,7 @@ void AddComponentDialog::setSelectedCategory(
         devItem->setText(0, devName);
         devItem->setForeground(0, devDeprecated ? QBrush(Qt::red) : QBrush());
         devItem->setData(0, Qt::UserRole, devFp.toStr());
+        devItem->setData(0, Qt::UserRole + 1, devUuid.toStr());
         // package
         Uuid pkgUuid = Uuid::createRandom();  // only for initialization, will
                                               // be overwritten
@@ -780,6 +860,7 @@ void AddComponentDialog::setSelectedCategory(
   }
 
   mUi->treeComponents->sortByColumn(0, Qt::AscendingOrder);
+  prefetchVisibleElements();
 
   // Delay parts information download, but show cached information immediately
   // to avoid flicker.
@@ -825,29 +906,31 @@ void AddComponentDialog::setSelectedSymbVar(
   if (symbVar && (symbVar == mSelectedSymbVar)) return;
   mPreviewSymbolGraphicsItems.clear();
   mPreviewSymbols.clear();
+  mPreviewSymbolsWatcher.reset();
   mSelectedSymbVar = symbVar;
 
   if (mSelectedComponent && mSelectedSymbVar) {
+    // Open the symbols in background to not block the UI.
+    QVector<FilePath> fps;
     for (const ComponentSymbolVariantItem& item : symbVar->getSymbolItems()) {
-      FilePath symbolFp = mDb.getLatest<Symbol>(item.getSymbolUuid());
-      if (!symbolFp.isValid()) continue;  // TODO: show warning
-      std::shared_ptr<Symbol> symbol(
-          Symbol::open(std::unique_ptr<TransactionalDirectory>(
-                           new TransactionalDirectory(
-                               TransactionalFileSystem::openRO(symbolFp))))
-              .release());
-      mPreviewSymbols.append(symbol);
-
-      auto graphicsItem = std::make_shared<SymbolGraphicsItem>(
-          *symbol, *mLayers, mSelectedComponent.get(),
-          mSelectedSymbVar->getSymbolItems().get(item.getUuid()), mLocaleOrder,
-          true);
-      graphicsItem->setPosition(item.getSymbolPosition());
-      graphicsItem->setRotation(item.getSymbolRotation());
-      mPreviewSymbolGraphicsItems.append(graphicsItem);
-      mComponentPreviewScene->addItem(*graphicsItem);
-      mUi->viewComponent->zoomAll();
+      fps.append(mDb.getLatest<Symbol>(item.getSymbolUuid()));
     }
+    QThread* thread = QThread::currentThread();
+    mPreviewSymbolsWatcher.reset(
+        new QFutureWatcher<QVector<std::shared_ptr<Symbol>>>());
+    connect(mPreviewSymbolsWatcher.get(),
+            &QFutureWatcher<QVector<std::shared_ptr<Symbol>>>::finished, this,
+            &AddComponentDialog::previewSymbolsOpened);
+    mPreviewSymbolsWatcher->setFuture(TaskScheduler::instance().run(
+        TaskScheduler::Group::Default, TaskScheduler::Priority::Interactive,
+        [fps, thread]() {
+          QVector<std::shared_ptr<Symbol>> symbols;
+          for (const FilePath& fp : fps) {
+            symbols.append(fp.isValid() ? openElement<Symbol>(fp, thread)
+                                        : nullptr);  // can throw
+          }
+          return symbols;
+        }));
   }
 }
 
@@ -856,35 +939,106 @@ void AddComponentDialog::setSelectedDevice(std::shared_ptr<const Device> dev) {
 
   mUi->lblDeviceName->setText(tr("No device selected"));
   mPreviewFootprintGraphicsItem.reset();
+  mPreviewPackageWatcher.reset();
   mSelectedPackage.reset();
   setSelectedPart(nullptr);
   mSelectedDevice = dev;
 
   if (mSelectedDevice) {
+    mUi->lblDeviceName->setText(
+        *mSelectedDevice->getNames().value(mLocaleOrder));
     FilePath pkgFp = mDb.getLatest<Package>(mSelectedDevice->getPackageUuid());
     if (pkgFp.isValid()) {
-      mSelectedPackage = Package::open(std::unique_ptr<TransactionalDirectory>(
-          new TransactionalDirectory(TransactionalFileSystem::openRO(pkgFp))));
-      QString devName = *mSelectedDevice->getNames().value(mLocaleOrder);
-      QString pkgName = *mSelectedPackage->getNames().value(mLocaleOrder);
-      if (devName.contains(pkgName, Qt::CaseInsensitive)) {
-        // Package name is already contained in device name, no need to show it.
-        mUi->lblDeviceName->setText(devName);
-      } else {
-        mUi->lblDeviceName->setText(QString("%1 [%2]").arg(devName, pkgName));
-      }
-      if (mSelectedPackage->getFootprints().count() > 0) {
-        mPreviewFootprintGraphicsItem.reset(new FootprintGraphicsItem(
-            mSelectedPackage->getFootprints().first(), *mLayers,
-            Application::getDefaultStrokeFont(), &mSelectedPackage->getPads(),
-            mSelectedComponent.get(), mLocaleOrder));
-        mDevicePreviewScene->addItem(*mPreviewFootprintGraphicsItem);
-        mUi->viewDevice->zoomAll();
-      }
+      // Open the package in background to not block the UI.
+      QThread* thread = QThread::currentThread();
+      mPreviewPackageWatcher.reset(
+          new QFutureWatcher<std::shared_ptr<Package>>());
+      connect(mPreviewPackageWatcher.get(),
+              &QFutureWatcher<std::shared_ptr<Package>>::finished, this,
+              &AddComponentDialog::previewPackageOpened);
+      mPreviewPackageWatcher->setFuture(TaskScheduler::instance().run(
+          TaskScheduler::Group::Default, TaskScheduler::Priority::Interactive,
+          [pkgFp, thread]() {
+            return openElement<Package>(pkgFp, thread);  // can throw
+          }));
     }
   }
 }
 
+void AddComponentDialog::requestedElementOpened(
+    bool success, const QString& errorMsg) noexcept {
+  if (success) {
+    // Continue the selection, and accept the dialog if it was requested in
+    // the meantime.
+    treeComponents_currentItemChanged(mUi->treeComponents->currentItem(),
+                                      nullptr);
+    if (mAcceptWhenOpened && (!mRequestedComponentFp.isValid()) &&
+        (!mRequestedDeviceFp.isValid())) {
+      accept();
+    }
+  } else {
+    mUi->lblErrorMsg->setText(errorMsg);
+    mAcceptWhenOpened = false;
+  }
+}
+
+void AddComponentDialog::previewSymbolsOpened() noexcept {
+  if ((!mPreviewSymbolsWatcher) || (!mSelectedComponent) ||
+      (!mSelectedSymbVar) || (!mPreviewSymbols.isEmpty())) {
+    return;
+  }
+
+  try {
+    mPreviewSymbols = mPreviewSymbolsWatcher->result();  // can throw
+  } catch (const Exception& e) {
+    mUi->lblErrorMsg->setText(e.getMsg());
+    return;
+  }
+
+  const ComponentSymbolVariantItemList& items =
+      mSelectedSymbVar->getSymbolItems();
+  for (int i = 0; (i < mPreviewSymbols.count()) && (i < items.count()); ++i) {
+    std::shared_ptr<Symbol> symbol = mPreviewSymbols.at(i);
+    if (!symbol) continue;  // TODO: show warning
+    std::shared_ptr<const ComponentSymbolVariantItem> item = items.at(i);
+    auto graphicsItem = std::make_shared<SymbolGraphicsItem>(
+        *symbol, *mLayers, mSelectedComponent.get(), item, mLocaleOrder, true);
+    graphicsItem->setPosition(item->getSymbolPosition());
+    graphicsItem->setRotation(item->getSymbolRotation());
+    mPreviewSymbolGraphicsItems.append(graphicsItem);
+    mComponentPreviewScene->addItem(*graphicsItem);
+  }
+  mUi->viewComponent->zoomAll();
+}
+
+void AddComponentDialog::previewPackageOpened() noexcept {
+  if ((!mPreviewPackageWatcher) || (!mSelectedDevice) || mSelectedPackage) {
+    return;
+  }
+
+  try {
+    mSelectedPackage = mPreviewPackageWatcher->result();  // can throw
+  } catch (const Exception& e) {
+    mUi->lblErrorMsg->setText(e.getMsg());
+    return;
+  }
+
+  QString devName = *mSelectedDevice->getNames().value(mLocaleOrder);
+  QString pkgName = *mSelectedPackage->getNames().value(mLocaleOrder);
+  if (!devName.contains(pkgName, Qt::CaseInsensitive)) {
+    // Show the package name only if not already contained in device name.
+    mUi->lblDeviceName->setText(QString("%1 [%2]").arg(devName, pkgName));
+  }
+  if (mSelectedPackage->getFootprints().count() > 0) {
+    mPreviewFootprintGraphicsItem.reset(new FootprintGraphicsItem(
+        mSelectedPackage->getFootprints().first(), *mLayers,
+        Application::getDefaultStrokeFont(), &mSelectedPackage->getPads(),
+        mSelectedComponent.get(), mLocaleOrder));
+    mDevicePreviewScene->addItem(*mPreviewFootprintGraphicsItem);
+    mUi->viewDevice->zoomAll();
+  }
+}
+
 void AddComponentDialog::setSelectedPart(std::shared_ptr<const Part> part) {
   if (part && (part == mSelectedPart)) return;
 
@@ -911,6 +1065,31 @@ void AddComponentDialog::addPartItem(std::shared_ptr<Part> part,
   item->setFont(1, font);
 }
 
+void AddComponentDialog::prefetchVisibleElements() noexcept {
+  if (!mCache) return;
+
+  // Collect the components and devices from the top of the visible area,
+  // i.e. the ones the user is most likely selecting next.
+  QList<Uuid> components;
+  QList<Uuid> devices;
+  QTreeWidgetItem* item = mUi->treeComponents->itemAt(0, 0);
+  if (!item) {
+    item = mUi->treeComponents->topLevelItem(0);
+  }
+  for (int i = 0; item && (i < 30); ++i) {
+    const std::optional<Uuid> uuid =
+        Uuid::tryFromString(item->data(0, Qt::UserRole + 1).toString());
+    if (uuid && (!item->parent())) {
+      components.append(*uuid);
+    } else if (uuid && (!item->parent()->parent())) {
+      devices.append(*uuid);
+    }
+    item = mUi->treeComponents->itemBelow(item);
+  }
+  mCache->prefetch<Component>(components);
+  mCache->prefetch<Device>(devices);
+}
+
 void AddComponentDialog::schedulePartsInformationUpdate() noexcept {
   mUpdatePartInformationScheduled = true;
 }
@@ -1002,6 +1181,14 @@ void AddComponentDialog::updatePartsInformation(int downloadDelayMs) noexcept {
 }
 
 void AddComponentDialog::accept() noexcept {
+  // If the selected elements are still being opened, accept once they are
+  // available.
+  if (mRequestedComponentFp.isValid() || mRequestedDeviceFp.isValid()) {
+    mAcceptWhenOpened = true;
+    return;
+  }
+  mAcceptWhenOpened = false;
+
   if ((!mSelectedComponent) || (!mSelectedSymbVar)) {
     QMessageBox::information(
         this, tr("Invalid Selection"),
@@ -1009,6 +1196,12 @@ void AddComponentDialog::accept() noexcept {
     return;
   }
 
+  // The package is needed for getSelectedPackageAssemblyType().
+  if (mPreviewPackageWatcher && (!mSelectedPackage)) {
+    mPreviewPackageWatcher->waitForFinished();
+    previewPackageOpened();
+  }
+
   QDialog::accept();
 }
 
@@ -55,6 +55,7 @@ namespace editor {
 class FootprintGraphicsItem;
 class GraphicsLayerList;
 class GraphicsScene;
+class LibraryElementCache;
 class PartInformationProvider;
 class PartInformationToolTip;
 class SymbolGraphicsItem;
@@ -85,6 +86,7 @@ class AddComponentDialog final : public QDialog {
   };
 
   struct SearchResultComponent {
+    std::optional<Uuid> uuid;
     QString name;
     bool deprecated = false;
     QHash<FilePath, SearchResultDevice> devices;
@@ -103,6 +105,7 @@ public:
                               const WorkspaceSettings& settings,
                               const QStringList& localeOrder,
                               const QStringList& normOrder,
+                              const LibraryElementCache* cache = nullptr,
                               QWidget* parent = nullptr);
   ~AddComponentDialog() noexcept;
 
@@ -174,6 +177,10 @@ private:
   void setSelectedDevice(std::shared_ptr<const Device> dev);
   void setSelectedPart(std::shared_ptr<const Part> part);
   void addPartItem(std::shared_ptr<Part> part, QTreeWidgetItem* parent);
+  void requestedElementOpened(bool success, const QString& errorMsg) noexcept;
+  void previewSymbolsOpened() noexcept;
+  void previewPackageOpened() noexcept;
+  void prefetchVisibleElements() noexcept;
   void schedulePartsInformationUpdate() noexcept;
   void updatePartsInformation(int downloadDelayMs = 0) noexcept;
   virtual void accept() noexcept override;
@@ -181,6 +188,7 @@ private:
   // General
   const WorkspaceLibraryDb& mDb;
   const WorkspaceSettings& mSettings;
+  QPointer<const LibraryElementCache> mCache;  ///< Optional
   QStringList mLocaleOrder;
   QStringList mNormOrder;
   QScopedPointer<Ui::AddComponentDialog> mUi;
@@ -200,12 +208,21 @@ private:
   std::shared_ptr<const Component> mSelectedComponent;
   std::shared_ptr<const ComponentSymbolVariant> mSelectedSymbVar;
   std::shared_ptr<const Device> mSelectedDevice;
-  std::unique_ptr<Package> mSelectedPackage;
+  std::shared_ptr<Package> mSelectedPackage;
   std::shared_ptr<const Part> mSelectedPart;
   QList<std::shared_ptr<Symbol>> mPreviewSymbols;
   QList<std::shared_ptr<SymbolGraphicsItem>> mPreviewSymbolGraphicsItems;
   QScopedPointer<FootprintGraphicsItem> mPreviewFootprintGraphicsItem;
 
+  // Background loading
+  FilePath mRequestedComponentFp;  ///< Component requested from the cache
+  FilePath mRequestedDeviceFp;  ///< Device requested from the cache
+  bool mAcceptWhenOpened;  ///< Accept when the requested elements are opened
+  std::unique_ptr<QFutureWatcher<QVector<std::shared_ptr<Symbol>>>>
+      mPreviewSymbolsWatcher;
+  std::unique_ptr<QFutureWatcher<std::shared_ptr<Package>>>
+      mPreviewPackageWatcher;
+
   // Actions
   QScopedPointer<QAction> mActionCopyMpn;
 };
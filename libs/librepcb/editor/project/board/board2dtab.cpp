@@ -550,6 +550,8 @@ void Board2dTab::activate() noexcept {
   mActiveConnections.append(connect(&mProjectEditor.getUndoStack(),
                                     &UndoStack::stateModified, &mBoard,
                                     &Board::triggerAirWiresRebuild));
+  mActiveConnections.append(connect(&mBoard, &Board::batchUpdateFinished, this,
+                                    &Board2dTab::boardBatchUpdateFinished));
 
   // Unplaced component state.
   mUnplacedComponentsModel.reset(new slint::VectorModel<slint::SharedString>());
@@ -606,6 +608,7 @@ void Board2dTab::deactivate() noexcept {
   mUnplacedComponentDevicesModel.reset();
   mUnplacedComponentsModel.reset();
   mDrcLocationGraphicsItem.reset();
+  mFsmDrcMarkersGraphicsItem.reset();
   if (mScene && (mBackgroundImageGraphicsItem->scene() == mScene.get())) {
     mScene->removeItem(*mBackgroundImageGraphicsItem);
   }
@@ -1107,6 +1110,25 @@ void Board2dTab::fsmSetViewRuler(
   }
 }
 
+void Board2dTab::fsmSetViewDrcMarkers(
+    const QVector<Path>& locations) noexcept {
+  if (locations.isEmpty() || (!mScene)) {
+    mFsmDrcMarkersGraphicsItem.reset();
+    return;
+  }
+  if (!mFsmDrcMarkersGraphicsItem) {
+    const ThemeColor& color =
+        mApp.getWorkspace().getSettings().themes.getActive().getColor(
+            Theme::Color::sBoardOverlays);
+    mFsmDrcMarkersGraphicsItem.reset(new QGraphicsPathItem());
+    mFsmDrcMarkersGraphicsItem->setZValue(BoardGraphicsScene::ZValue_AirWires);
+    mFsmDrcMarkersGraphicsItem->setPen(QPen(color.getPrimaryColor(), 0));
+    mFsmDrcMarkersGraphicsItem->setBrush(color.getSecondaryColor());
+    mScene->addItem(*mFsmDrcMarkersGraphicsItem);
+  }
+  mFsmDrcMarkersGraphicsItem->setPath(Path::toQPainterPathPx(locations, true));
+}
+
 void Board2dTab::fsmSetSceneCursor(const Point& pos, bool cross,
                                    bool circle) noexcept {
   if (mScene) {
@@ -2594,6 +2616,16 @@ void Board2dTab::applyTheme() noexcept {
   onDerivedUiDataChanged.notify();
 }
 
+void Board2dTab::boardBatchUpdateFinished(
+    const std::pair<Point, Point>& region) noexcept {
+  // Note: The airwires have already been rebuilt by the board.
+  if (mScene) {
+    mScene->update(
+        QRectF(region.first.toPxQPointF(), region.second.toPxQPointF())
+            .normalized());
+  }
+}
+
 void Board2dTab::requestRepaint() noexcept {
   ++mFrameIndex;
   onDerivedUiDataChanged.notify();
@@ -151,6 +151,7 @@ public:
   void fsmSetViewInfoBoxText(const QString& text) noexcept override;
   void fsmSetViewRuler(
       const std::optional<std::pair<Point, Point>>& pos) noexcept override;
+  void fsmSetViewDrcMarkers(const QVector<Path>& locations) noexcept override;
   void fsmSetSceneCursor(const Point& pos, bool cross,
                          bool circle) noexcept override;
   QPainterPath fsmCalcPosWithTolerance(
@@ -238,6 +239,7 @@ private:
   void applyBackgroundImageSettings() noexcept;
   FilePath getBackgroundImageCacheDir() const noexcept;
   void applyTheme() noexcept;
+  void boardBatchUpdateFinished(const std::pair<Point, Point>& region) noexcept;
   void requestRepaint() noexcept;
 
 private:
@@ -319,6 +321,7 @@ private:
   std::unique_ptr<BoardGraphicsScene> mScene;
   std::unique_ptr<QTimer> mInputIdleTimer;
   std::unique_ptr<QGraphicsPathItem> mDrcLocationGraphicsItem;
+  std::unique_ptr<QGraphicsPathItem> mFsmDrcMarkersGraphicsItem;
 
   // Background image
   BackgroundImageSettings mBackgroundImageSettings;
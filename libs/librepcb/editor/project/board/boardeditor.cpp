@@ -451,7 +451,7 @@ void BoardEditor::startOrderPcbUpload(bool openBrowser) noexcept {
 void BoardEditor::setDrcResult(
     const BoardDesignRuleCheck::Result& result) noexcept {
   // Detect & remove disappeared messages.
-  const QSet<SExpression> approvals =
+  const QSet<ApprovalKey> approvals =
       RuleCheckMessage::getAllApprovals(result.messages);
   if (mBoard.updateDrcMessageApprovals(approvals, result.quick)) {
     mProjectEditor.setManualModificationsMade();
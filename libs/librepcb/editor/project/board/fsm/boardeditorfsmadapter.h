@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include <librepcb/core/geometry/path.h>
 #include <librepcb/core/types/point.h>
 
 #include <QtCore>
@@ -90,6 +91,8 @@ public:
   virtual void fsmSetViewInfoBoxText(const QString& text) noexcept = 0;
   virtual void fsmSetViewRuler(
       const std::optional<std::pair<Point, Point>>& pos) noexcept = 0;
+  virtual void fsmSetViewDrcMarkers(
+      const QVector<Path>& locations) noexcept = 0;
   virtual void fsmSetSceneCursor(const Point& pos, bool cross,
                                  bool circle) noexcept = 0;
   virtual QPainterPath fsmCalcPosWithTolerance(
@@ -41,15 +41,20 @@
 #include <librepcb/core/library/pkg/footprintpad.h>
 #include <librepcb/core/project/board/board.h>
 #include <librepcb/core/project/board/boarddesignrules.h>
+#include <librepcb/core/project/board/drc/boardcopperclearanceindex.h>
+#include <librepcb/core/project/board/drc/boarddesignrulecheck.h>
 #include <librepcb/core/project/board/items/bi_netline.h>
 #include <librepcb/core/project/board/items/bi_netpoint.h>
 #include <librepcb/core/project/board/items/bi_netsegment.h>
 #include <librepcb/core/project/board/items/bi_pad.h>
+#include <librepcb/core/project/board/items/bi_via.h>
 #include <librepcb/core/project/circuit/circuit.h>
 #include <librepcb/core/project/circuit/netsignal.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/types/layer.h>
+#include <librepcb/core/utils/taskscheduler.h>
 #include <librepcb/core/utils/toolbox.h>
+#include <librepcb/core/utils/tracer.h>
 
 #include <QtCore>
 
@@ -91,7 +96,17 @@ BoardEditorState_DrawTrace::BoardEditorState_DrawTrace(
     mPositioningNetLine1(nullptr),
     mPositioningNetPoint1(nullptr),
     mPositioningNetLine2(nullptr),
-    mPositioningNetPoint2(nullptr) {
+    mPositioningNetPoint2(nullptr),
+    mClearanceIndex(),
+    mClearanceIndexWatcher(),
+    mClearanceIndexUndoState(),
+    mClearanceIndexBuildCount(0) {
+  // Show clearance violations as soon as the index is available.
+  connect(&mClearanceIndexWatcher,
+          &QFutureWatcher<
+              std::shared_ptr<const BoardCopperClearanceIndex>>::finished,
+          this, &BoardEditorState_DrawTrace::updateClearanceViolations);
+
   // Restore client settings.
   QSettings cs;
   mCurrentAutoWidth =
@@ -117,6 +132,12 @@ bool BoardEditorState_DrawTrace::exit() noexcept {
   // Abort the currently active command
   if (!abortPositioning(true, true)) return false;
 
+  // Release the memory of the clearance index.
+  mClearanceIndexWatcher.setFuture(
+      QFuture<std::shared_ptr<const BoardCopperClearanceIndex>>());
+  mClearanceIndex = QFuture<std::shared_ptr<const BoardCopperClearanceIndex>>();
+  mClearanceIndexUndoState = std::nullopt;
+
   mAdapter.fsmSetViewCursor(std::nullopt);
   mAdapter.fsmToolLeave();
   return true;
@@ -466,6 +487,9 @@ bool BoardEditorState_DrawTrace::startPositioning(
   // Discard any temporary changes and release undo stack.
   abortBlockingToolsInOtherEditors();
 
+  // Prepare the live clearance check of the traces to be drawn.
+  updateClearanceIndex();
+
   Point posOnGrid = pos.mappedToGrid(getGridInterval());
   mTargetPos = mCursorPos.mappedToGrid(getGridInterval());
 
@@ -840,6 +864,11 @@ bool BoardEditorState_DrawTrace::addNextNetPoint(
       BI_NetPoint* nextStartPoint = mPositioningNetPoint2;
       BI_Via* nextStartVia = mTempVia;
       abortPositioning(false, false);
+      // The clearance index was up to date when the committed command was
+      // started (see startPositioning()), and the command only added items
+      // of the net which is drawn next. Since items of the same net are not
+      // checked against each other, the index can be kept.
+      mClearanceIndexUndoState = mContext.undoStack.getUniqueStateId();
       return startPositioning(scene.getBoard(), mTargetPos, true,
                               nextStartPoint, nextStartVia);
     }
@@ -858,6 +887,7 @@ bool BoardEditorState_DrawTrace::abortPositioning(
 
   try {
     mAdapter.fsmSetHighlightedNetSignals({});
+    mAdapter.fsmSetViewDrcMarkers({});
     mFixedStartAnchor = nullptr;
     mCurrentNetSegment = nullptr;
     mPositioningNetLine1 = nullptr;
@@ -947,6 +977,9 @@ void BoardEditorState_DrawTrace::updateNetpointPositions() noexcept {
   mPositioningNetLine1->setWidth(mCurrentWidth);
   mPositioningNetLine2->setWidth(mCurrentWidth);
 
+  // Show clearance violations while the trace is being placed.
+  updateClearanceViolations();
+
   // Force updating airwires immediately as they are important for creating
   // traces.
   scene->getBoard().triggerAirWiresRebuild();
@@ -1081,6 +1114,67 @@ void BoardEditorState_DrawTrace::updateNetClass() noexcept {
   }
 }
 
+void BoardEditorState_DrawTrace::updateClearanceIndex() noexcept {
+  const uint undoState = mContext.undoStack.getUniqueStateId();
+  if (mClearanceIndexUndoState == undoState) {
+    return;  // Index is still up to date.
+  }
+
+  // The board data has to be copied in the main thread, but building the
+  // index is expensive so it's done in a worker thread. Outdated builds
+  // which are still queued get skipped.
+  LIBREPCB_TRACE_ZONE("DrawTrace::updateClearanceIndex");
+  mClearanceIndex.cancel();
+  auto data = std::make_shared<const BoardDesignRuleCheckData>(
+      mContext.board, mContext.board.getDrcSettings(), true);
+  mClearanceIndex = TaskScheduler::instance().run(
+      TaskScheduler::Group::Drc, TaskScheduler::Priority::Interactive,
+      [data]() {
+        return std::make_shared<const BoardCopperClearanceIndex>(
+            *data, BoardDesignRuleCheck::maxArcTolerance());  // can throw
+      });
+  mClearanceIndexWatcher.setFuture(mClearanceIndex);
+  mClearanceIndexUndoState = undoState;
+  ++mClearanceIndexBuildCount;
+}
+
+void BoardEditorState_DrawTrace::updateClearanceViolations() noexcept {
+  QVector<Path> locations;
+  if ((mSubState == SubState_PositioningNetPoint) &&
+      mClearanceIndex.isFinished() && (mClearanceIndex.resultCount() > 0)) {
+    try {
+      LIBREPCB_TRACE_ZONE("DrawTrace::checkClearances");
+      using Data = BoardDesignRuleCheckData;
+      const NetSignal* net = mCurrentNetSegment->getNetSignal();
+      Data::Segment segment{
+          mCurrentNetSegment->getUuid(),
+          net ? net->getUuid() : std::optional<Uuid>(),
+          net ? *net->getName() : QString(),
+          net ? net->getNetClass().getUuid() : std::optional<Uuid>(),
+          {},
+          {},
+          {},
+          {},
+      };
+      for (const BI_NetLine* netLine :
+           {mPositioningNetLine1, mPositioningNetLine2}) {
+        segment.traces.append(Data::convertTrace(*netLine));
+      }
+      if (mTempVia) {
+        segment.vias.insert(mTempVia->getUuid(), Data::convertVia(*mTempVia));
+      }
+      const std::shared_ptr<const BoardCopperClearanceIndex> index =
+          mClearanceIndex.result();
+      for (const auto& msg : index->checkSegment(segment)) {
+        locations += msg->getLocations();
+      }
+    } catch (const Exception& e) {
+      qWarning() << "Failed to check trace clearances:" << e.getMsg();
+    }
+  }
+  mAdapter.fsmSetViewDrcMarkers(locations);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
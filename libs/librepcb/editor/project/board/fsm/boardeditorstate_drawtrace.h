@@ -30,6 +30,9 @@
 
 #include <QtCore>
 
+#include <memory>
+#include <optional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -41,6 +44,7 @@ class BI_NetPoint;
 class BI_NetSegment;
 class BI_Pad;
 class BI_Via;
+class BoardCopperClearanceIndex;
 class Layer;
 class NetSignal;
 
@@ -75,6 +79,11 @@ public:
   explicit BoardEditorState_DrawTrace(const Context& context) noexcept;
   virtual ~BoardEditorState_DrawTrace() noexcept;
 
+  // Getters
+  int getClearanceIndexBuildCount() const noexcept {
+    return mClearanceIndexBuildCount;
+  }
+
   // General Methods
   virtual bool entry() noexcept override;
   virtual bool exit() noexcept override;
@@ -229,6 +238,24 @@ private:
    */
   void updateNetClass() noexcept;
 
+  /**
+   * @brief Start (re)building #mClearanceIndex if the board was modified
+   *
+   * The index is built in a background task with interactive priority from
+   * a snapshot of the board. Traces committed while continuing to draw the
+   * same net don't invalidate it, see #addNextNetPoint(). After finishing a
+   * trace, the next one might belong to another net so the index is rebuilt.
+   */
+  void updateClearanceIndex() noexcept;
+
+  /**
+   * @brief Check the clearances of the currently positioned traces & via
+   *
+   * Runs synchronously against #mClearanceIndex (if already available) and
+   * shows all clearance violations in the view.
+   */
+  void updateClearanceViolations() noexcept;
+
   // State
   SubState mSubState;  ///< the current substate
   QPointer<NetClass> mCurrentNetClass;  ///< `nullptr` in idle state
@@ -254,6 +281,13 @@ private:
   BI_NetPoint* mPositioningNetPoint1;  ///< the first netpoint to place
   BI_NetLine* mPositioningNetLine2;  ///< line between p1 and p2
   BI_NetPoint* mPositioningNetPoint2;  ///< the second netpoint to place
+
+  // Live copper clearance check
+  QFuture<std::shared_ptr<const BoardCopperClearanceIndex>> mClearanceIndex;
+  QFutureWatcher<std::shared_ptr<const BoardCopperClearanceIndex>>
+      mClearanceIndexWatcher;
+  std::optional<uint> mClearanceIndexUndoState;  ///< Board state of the index
+  int mClearanceIndexBuildCount;  ///< Number of started index builds
 };
 
 /*******************************************************************************
@@ -211,6 +211,7 @@ UnsignedLength CmdDragSelectedBoardItems::getMedianLineWidth() const noexcept {
 
 void CmdDragSelectedBoardItems::snapToGrid() noexcept {
   PositiveLength grid = mScene.getBoard().getGridInterval();
+  mScene.getBoard().beginBatchUpdate();
   foreach (CmdDeviceInstanceEdit* cmd, mDeviceEditCmds) {
     cmd->snapToGrid(grid, true);
   }
@@ -240,9 +241,9 @@ void CmdDragSelectedBoardItems::snapToGrid() noexcept {
   }
   mSnappedToGrid = true;
 
-  // Force updating airwires immediately as they are important while moving
-  // items.
-  mScene.getBoard().triggerAirWiresRebuild();
+  // Sends the deferred item notifications, and the board editor rebuilds
+  // the airwires of all affected net signals.
+  mScene.getBoard().endBatchUpdate();
 }
 
 void CmdDragSelectedBoardItems::setLocked(bool locked) noexcept {
@@ -298,7 +299,8 @@ void CmdDragSelectedBoardItems::setCurrentPosition(
   }
 
   if (delta != mDeltaPos) {
-    // move selected elements
+    // Move selected elements as a batch to notify each item only once.
+    mScene.getBoard().beginBatchUpdate();
     foreach (CmdDeviceInstanceEdit* cmd, mDeviceEditCmds) {
       cmd->translate(delta - mDeltaPos, true);
     }
@@ -328,9 +330,9 @@ void CmdDragSelectedBoardItems::setCurrentPosition(
     }
     mDeltaPos = delta;
 
-    // Force updating airwires immediately as they are important while moving
-    // items.
-    mScene.getBoard().triggerAirWiresRebuild();
+    // Sends the deferred item notifications, and the board editor rebuilds
+    // the airwires of all affected net signals.
+    mScene.getBoard().endBatchUpdate();
   }
 }
 
@@ -342,6 +344,7 @@ void CmdDragSelectedBoardItems::rotate(const Angle& angle,
       : (mCenterPos + mDeltaPos);
 
   // rotate selected elements
+  mScene.getBoard().beginBatchUpdate();
   foreach (CmdDeviceInstanceEdit* cmd, mDeviceEditCmds) {
     cmd->rotate(angle, center, true);
   }
@@ -371,9 +374,9 @@ void CmdDragSelectedBoardItems::rotate(const Angle& angle,
   }
   mDeltaAngle += angle;
 
-  // Force updating airwires immediately as they are important while dragging
-  // items.
-  mScene.getBoard().triggerAirWiresRebuild();
+  // Sends the deferred item notifications, and the board editor rebuilds
+  // the airwires of all affected net signals.
+  mScene.getBoard().endBatchUpdate();
 }
 
 /*******************************************************************************
@@ -31,10 +31,10 @@
 #include <librepcb/core/exceptions.h>
 #include <librepcb/core/fileio/filepath.h>
 #include <librepcb/core/utils/messagelogger.h>
+#include <librepcb/core/utils/taskscheduler.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/eagleimport/eagleprojectimport.h>
 
-#include <QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -200,9 +200,12 @@ void NewProjectWizardPage_EagleImport::updateStatus() noexcept {
       mUi->lblMessages->setText("<font color=\"#63d0df\">" %
                                 tr("Parsing project...") % "</font>");
       mUi->lblMessages->show();
-      mFuture = QtConcurrent::run(
-          &parseAsync, std::make_shared<eagleimport::EagleProjectImport>(),
-          schFp, brdFp);
+      auto eagleImport = std::make_shared<eagleimport::EagleProjectImport>();
+      mFuture = TaskScheduler::instance().run(
+          TaskScheduler::Group::Import, TaskScheduler::Priority::Normal,
+          [eagleImport, schFp, brdFp]() {
+            return parseAsync(eagleImport, schFp, brdFp);
+          });
     } else {
       mUi->lblMessages->setText("<font color=\"red\">⚠ " %
                                 tr("Invalid file path(s).") % "</font>");
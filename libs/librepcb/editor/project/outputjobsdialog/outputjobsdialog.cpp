@@ -559,8 +559,8 @@ void OutputJobsDialog::runJob(std::shared_ptr<OutputJob> job,
     if (open) {
       // Find common base path if multiple files were generated.
       FilePath commonOutPath;
-      for (auto it = runner.getWrittenFiles().begin();
-           it != runner.getWrittenFiles().end(); ++it) {
+      const QMultiHash<Uuid, FilePath> writtenFiles = runner.getWrittenFiles();
+      for (auto it = writtenFiles.begin(); it != writtenFiles.end(); ++it) {
         if ((!job) || (!job->getDependencies().contains(it.key()))) {
           if (!commonOutPath.isValid()) {
             commonOutPath = it.value();
@@ -49,9 +49,12 @@
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/project/board/board.h>
 #include <librepcb/core/project/erc/electricalrulecheck.h>
+#include <librepcb/core/project/erc/electricalrulecheckdata.h>
+#include <librepcb/core/project/erc/electricalrulechecktracker.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/project/schematic/schematic.h>
 #include <librepcb/core/utils/scopeguard.h>
+#include <librepcb/core/utils/taskscheduler.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacesettings.h>
 
@@ -87,6 +90,12 @@ ProjectEditor::ProjectEditor(
     mActiveSchematicTabs(),
     mErcMessages(),
     mErcExecutionError(),
+    mErc(new ElectricalRuleCheck()),
+    mErcTracker(new ElectricalRuleCheckTracker(*mProject)),
+    mErcData(),
+    mErcWatcher(),
+    mErcElapsedTimer(),
+    mErcRunPending(false),
     mManualModificationsMade(false),
     mLastAutosaveStateId(mUndoStack->getUniqueStateId()),
     mAutoSaveTimer() {
@@ -187,6 +196,8 @@ ProjectEditor::ProjectEditor(
   // Setup delay timer for ERC to avoid extensive CPU load.
   mErcTimer.setSingleShot(true);
   connect(&mErcTimer, &QTimer::timeout, this, &ProjectEditor::runErc);
+  connect(&mErcWatcher, &QFutureWatcher<RuleCheckMessageList>::finished, this,
+          &ProjectEditor::ercFinished);
   scheduleErcRun();
 
   // Setup the timer for automatic backups, if enabled in the settings.
@@ -214,6 +225,10 @@ ProjectEditor::~ProjectEditor() noexcept {
   mAutoSaveTimer.stop();
   mErcTimer.stop();
 
+  // Wait until a running ERC is finished, it may still access the ERC object.
+  mErcWatcher.disconnect(this);
+  mErcWatcher.waitForFinished();
+
   // Delete all command objects in the undo stack. This mmust be done before
   // other important objects are deleted, as undo command objects can hold
   // pointers/references to them!
@@ -701,14 +716,41 @@ void ProjectEditor::scheduleErcRun() noexcept {
 }
 
 void ProjectEditor::runErc() noexcept {
+  // If the ERC is still running, run it again as soon as it is finished.
+  if (mErcWatcher.isRunning()) {
+    mErcRunPending = true;
+    return;
+  }
+  mErcRunPending = false;
+
+  // If nothing was modified since the last run, the results are still valid.
+  if (mErcData && mErcTracker->getChanges().isEmpty()) {
+    return;
+  }
+
+  // The snapshot of the project must be created in the main thread, only the
+  // checks themselves are run in the worker thread. To keep this fast, only
+  // the items modified since the last run are read from the project, and
+  // only those are checked again.
+  mErcElapsedTimer.start();
+  const ElectricalRuleCheckData::Changes changes = mErcTracker->takeChanges();
+  auto data = mErcData
+      ? std::make_shared<const ElectricalRuleCheckData>(*mProject, *mErcData,
+                                                        changes)
+      : std::make_shared<const ElectricalRuleCheckData>(*mProject);
+  mErcData = data;
+  std::shared_ptr<ElectricalRuleCheck> erc = mErc;
+  mErcWatcher.setFuture(TaskScheduler::instance().run(
+      TaskScheduler::Group::Default, TaskScheduler::Priority::Normal,
+      [erc, data]() { return erc->runChecks(*data); }));
+}
+
+void ProjectEditor::ercFinished() noexcept {
   try {
-    QElapsedTimer timer;
-    timer.start();
-    ElectricalRuleCheck erc(*mProject);
-    const auto messages = erc.runChecks();
+    const RuleCheckMessageList messages = mErcWatcher.result();
 
     // Detect disappeared messages & remove their approvals.
-    QSet<SExpression> approvals = RuleCheckMessage::getAllApprovals(messages);
+    QSet<ApprovalKey> approvals = RuleCheckMessage::getAllApprovals(messages);
     mSupportedErcApprovals |= approvals;
     mDisappearedErcApprovals = mSupportedErcApprovals - approvals;
     approvals = mProject->getErcMessageApprovals() - mDisappearedErcApprovals;
@@ -731,13 +773,17 @@ void ProjectEditor::runErc() noexcept {
     mErcMessages->setMessages(messages, approvals);
     mErcExecutionError.clear();
 
-    qDebug() << "ERC succeeded after" << timer.elapsed() << "ms.";
+    qDebug() << "ERC succeeded after" << mErcElapsedTimer.elapsed() << "ms.";
   } catch (const Exception& e) {
     mErcExecutionError = e.getMsg();
     qCritical() << "ERC failed:" << e.getMsg();
   }
 
   onUiDataChanged.notify();
+
+  if (mErcRunPending) {
+    runErc();
+  }
 }
 
 void ProjectEditor::projectSettingsChanged() noexcept {
@@ -27,7 +27,7 @@
 #include "appwindow.h"
 
 #include <librepcb/core/project/projectloader.h>
-#include <librepcb/core/serialization/sexpression.h>
+#include <librepcb/core/rulecheck/rulecheckmessage.h>
 #include <librepcb/core/utils/signalslot.h>
 
 #include <QtCore>
@@ -40,6 +40,9 @@
 namespace librepcb {
 
 class Board;
+class ElectricalRuleCheck;
+struct ElectricalRuleCheckData;
+class ElectricalRuleCheckTracker;
 class NetSignal;
 class Project;
 class RuleCheckMessage;
@@ -205,6 +208,7 @@ private:
   void openMigrationLog() noexcept;
   void scheduleErcRun() noexcept;
   void runErc() noexcept;
+  void ercFinished() noexcept;
   void projectSettingsChanged() noexcept;
 
 private:
@@ -223,10 +227,16 @@ private:
 
   // ERC
   std::shared_ptr<RuleCheckMessagesModel> mErcMessages;  // Lazy initialized
-  QSet<SExpression> mSupportedErcApprovals;
-  QSet<SExpression> mDisappearedErcApprovals;
+  QSet<ApprovalKey> mSupportedErcApprovals;
+  QSet<ApprovalKey> mDisappearedErcApprovals;
   QString mErcExecutionError;
   QTimer mErcTimer;
+  std::shared_ptr<ElectricalRuleCheck> mErc;  ///< Keeps results between runs
+  std::unique_ptr<ElectricalRuleCheckTracker> mErcTracker;
+  std::shared_ptr<const ElectricalRuleCheckData> mErcData;  ///< Last snapshot
+  QFutureWatcher<RuleCheckMessageList> mErcWatcher;
+  QElapsedTimer mErcElapsedTimer;
+  bool mErcRunPending;  ///< Re-run required after the current run finished
 
   /// Modifications bypassing the undo stack
   bool mManualModificationsMade;
@@ -27,8 +27,8 @@
 #include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/fileio/ziparchive.h>
 #include <librepcb/core/utils/scopeguard.h>
+#include <librepcb/core/utils/taskscheduler.h>
 
-#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -101,8 +101,11 @@ void ProjectReadmeRenderer::start() noexcept {
     emit runningChanged(false);
     emit finished(mWatcher->result());
   });
-  mWatcher->setFuture(
-      QtConcurrent::run(&ProjectReadmeRenderer::render, mPath, mWidth));
+  const FilePath path = mPath;
+  const int width = mWidth;
+  mWatcher->setFuture(TaskScheduler::instance().run(
+      TaskScheduler::Group::Default, TaskScheduler::Priority::Normal,
+      [path, width]() { return render(path, width); }));
 }
 
 QPixmap ProjectReadmeRenderer::render(const FilePath& fp, int width) noexcept {
@@ -40,6 +40,7 @@ class Workspace;
 
 namespace editor {
 
+class LibraryElementCache;
 class SchematicEditorFsmAdapter;
 class SchematicEditorState;
 class SchematicGraphicsScene;
@@ -61,6 +62,7 @@ public:
   /// FSM Context
   struct Context {
     Workspace& workspace;
+    const LibraryElementCache& libraryElementCache;
     Project& project;
     Schematic& schematic;
     UndoStack& undoStack;
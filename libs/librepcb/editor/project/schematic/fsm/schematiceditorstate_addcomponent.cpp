@@ -409,7 +409,7 @@ void SchematicEditorState_AddComponent::startAddingComponent(
         mAddComponentDialog.reset(new AddComponentDialog(
             mContext.workspace.getLibraryDb(), mContext.workspace.getSettings(),
             mContext.project.getLocaleOrder(), mContext.project.getNormOrder(),
-            parentWidget()));
+            &mContext.libraryElementCache, parentWidget()));
       }
       if (!searchTerm.isEmpty()) {
         mAddComponentDialog->selectComponentByKeyword(searchTerm);
@@ -201,8 +201,10 @@ SchematicTab::SchematicTab(GuiApplication& app, SchematicEditor& editor,
 
   // Build the whole schematic editor finite state machine.
   SchematicEditorFsm::Context fsmContext{
-      mApp.getWorkspace(),           mProject, mSchematic,
-      mProjectEditor.getUndoStack(), *this,
+      mApp.getWorkspace(), mApp.getLibraryElementCache(),
+      mProject,            mSchematic,
+      mProjectEditor.getUndoStack(),
+      *this,
   };
   mFsm.reset(new SchematicEditorFsm(fsmContext));
 
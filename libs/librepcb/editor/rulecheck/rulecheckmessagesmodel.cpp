@@ -66,7 +66,7 @@ void RuleCheckMessagesModel::setAutofixHandler(
 
 void RuleCheckMessagesModel::setMessages(
     const RuleCheckMessageList& messages,
-    const QSet<SExpression>& approvals) noexcept {
+    const QSet<ApprovalKey>& approvals) noexcept {
   mMessages = messages;
   mApprovals = approvals;
   mAutoFixed.clear();
@@ -89,8 +89,8 @@ std::optional<ui::RuleCheckMessageData> RuleCheckMessagesModel::row_data(
         l2s(msg->getSeverity()),  // Severity
         q2s(msg->getMessage()),  // Message
         q2s(msg->getDescription()),  // Description
-        mApprovals.contains(msg->getApproval()),  // Approved
-        mAutoFixed.contains(msg->getApproval()),  // Auto-fixed
+        mApprovals.contains(msg->getApprovalKey()),  // Approved
+        mAutoFixed.contains(msg->getApprovalKey()),  // Auto-fixed
         mAutofixHandler && mAutofixHandler(msg, true),  // Supports autofix
         mActionWindowId,  // Action window ID
         ui::RuleCheckMessageAction::None,  // Action
@@ -104,14 +104,14 @@ void RuleCheckMessagesModel::set_row_data(
     std::size_t i, const ui::RuleCheckMessageData& data) noexcept {
   if (auto msg = mMessages.value(i)) {
     mActionWindowId = data.action_window_id;
-    if (data.approved && (!mApprovals.contains(msg->getApproval()))) {
-      mApprovals.insert(msg->getApproval());
-      emit approvalChanged(msg->getApproval(), true);
+    if (data.approved && (!mApprovals.contains(msg->getApprovalKey()))) {
+      mApprovals.insert(msg->getApprovalKey());
+      emit approvalChanged(msg->getApprovalKey(), true);
       sortMessages();
       updateCounters();
-    } else if ((!data.approved) && mApprovals.contains(msg->getApproval())) {
-      mApprovals.remove(msg->getApproval());
-      emit approvalChanged(msg->getApproval(), false);
+    } else if ((!data.approved) && mApprovals.contains(msg->getApprovalKey())) {
+      mApprovals.remove(msg->getApprovalKey());
+      emit approvalChanged(msg->getApprovalKey(), false);
       sortMessages();
       updateCounters();
     } else if (data.action == ui::RuleCheckMessageAction::Highlight) {
@@ -124,11 +124,11 @@ void RuleCheckMessagesModel::set_row_data(
           [this, i, msg]() {
             if (mAutofixHandler && mAutofixHandler(msg, false)) {
               // If the message is approved, clean up the now obsolete approval.
-              if (mApprovals.contains(msg->getApproval())) {
-                mApprovals.remove(msg->getApproval());
-                emit approvalChanged(msg->getApproval(), false);
+              if (mApprovals.contains(msg->getApprovalKey())) {
+                mApprovals.remove(msg->getApprovalKey());
+                emit approvalChanged(msg->getApprovalKey(), false);
               }
-              mAutoFixed.insert(msg->getApproval());
+              mAutoFixed.insert(msg->getApprovalKey());
               if (mMessages.value(i) == msg) {
                 notify_row_changed(i);
               }
@@ -154,8 +154,8 @@ void RuleCheckMessagesModel::sortMessages() noexcept {
              const std::shared_ptr<const RuleCheckMessage>& lhs,
              const std::shared_ptr<const RuleCheckMessage>& rhs) {
         if (lhs && rhs) {
-          const bool lhsApproved = mApprovals.contains(lhs->getApproval());
-          const bool rhsApproved = mApprovals.contains(rhs->getApproval());
+          const bool lhsApproved = mApprovals.contains(lhs->getApprovalKey());
+          const bool rhsApproved = mApprovals.contains(rhs->getApprovalKey());
           if (lhsApproved != rhsApproved) {
             return rhsApproved;
           } else if (lhs->getSeverity() != rhs->getSeverity()) {
@@ -176,7 +176,7 @@ void RuleCheckMessagesModel::updateCounters() noexcept {
   int unapproved = 0;
   int errors = 0;
   for (auto msg : mMessages) {
-    if (!mApprovals.contains(msg->getApproval())) {
+    if (!mApprovals.contains(msg->getApprovalKey())) {
       ++unapproved;
     }
     if (msg->getSeverity() == RuleCheckMessage::Severity::Error) {
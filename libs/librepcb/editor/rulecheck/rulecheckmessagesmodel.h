@@ -61,7 +61,7 @@ public:
   void clear() noexcept;
   void setAutofixHandler(AutofixHandler handler) noexcept;
   void setMessages(const RuleCheckMessageList& messages,
-                   const QSet<SExpression>& approvals) noexcept;
+                   const QSet<ApprovalKey>& approvals) noexcept;
   int getUnapprovedCount() const noexcept { return mUnapprovedCount; }
   int getErrorCount() const noexcept { return mErrorCount; }
 
@@ -78,7 +78,7 @@ public:
 signals:
   void unapprovedCountChanged(int count);
   void errorCountChanged(int count);
-  void approvalChanged(const SExpression& approval, bool approved);
+  void approvalChanged(const ApprovalKey& approval, bool approved);
   void highlightRequested(std::shared_ptr<const RuleCheckMessage> msg,
                           bool zoomTo, int windowId);
 
@@ -88,8 +88,8 @@ private:
 
   AutofixHandler mAutofixHandler;
   RuleCheckMessageList mMessages;
-  QSet<SExpression> mApprovals;
-  QSet<SExpression> mAutoFixed;
+  QSet<ApprovalKey> mApprovals;
+  QSet<ApprovalKey> mAutoFixed;
   int mUnapprovedCount;
   int mErrorCount;
 
@@ -95,9 +95,9 @@ void CategoryTreeModel::refresh() noexcept {
     });
 
     if (mFilters.testFlag(Filter::CmpCat)) {
-      loadChilds<ComponentCategory>(std::nullopt, 1);  // can throw
+      loadCategories<ComponentCategory>();  // can throw
     } else if (mFilters.testFlag(Filter::PkgCat)) {
-      loadChilds<PackageCategory>(std::nullopt, 1);  // can throw
+      loadCategories<PackageCategory>();  // can throw
     }
   } catch (const Exception& e) {
     qCritical() << "Failed to refresh CategoryTreeModel:" << e.getMsg();
@@ -106,29 +106,57 @@ void CategoryTreeModel::refresh() noexcept {
 }
 
 template <typename T>
-void CategoryTreeModel::loadChilds(const std::optional<Uuid>& parent,
-                                   int level) {
-  QVector<std::pair<Uuid, QString>> childs;
-  for (auto uuid : mDb.getChilds<T>(parent)) {  // can throw
-    if (uuid == mHiddenCategory) continue;
+void CategoryTreeModel::loadCategories() {
+  // Fetch all categories at once and build the tree in memory, which is
+  // much faster than querying the children of each category separately.
+  const QList<WorkspaceLibraryDb::ElementInfo> infos = mDb.getAllInfos<T>(
+      mSettings.libraryLocaleOrder.get());  // can throw
+
+  // Determine the latest version of each category.
+  QHash<Uuid, const WorkspaceLibraryDb::ElementInfo*> latest;
+  for (const WorkspaceLibraryDb::ElementInfo& info : infos) {
+    auto it = latest.find(info.uuid);
+    if ((it == latest.end()) || ((*it)->version <= info.version)) {
+      latest.insert(info.uuid, &info);
+    }
+  }
+  QHash<Uuid, QString> names;
+  for (auto it = latest.begin(); it != latest.end(); ++it) {
+    names.insert(it.key(), (*it)->name);
+  }
 
-    const FilePath fp = mDb.getLatest<T>(uuid);  // can throw
+  // Categories with an inexistent parent are listed as root categories to
+  // ensure that all elements are discoverable.
+  QHash<std::optional<Uuid>, QSet<Uuid>> childs;
+  for (const WorkspaceLibraryDb::ElementInfo& info : infos) {
+    std::optional<Uuid> parent = info.parent;
+    if (parent && (!latest.contains(*parent))) {
+      parent = std::nullopt;
+    }
+    childs[parent].insert(info.uuid);
+  }
 
-    QString name;
-    mDb.getTranslations<T>(fp, mSettings.libraryLocaleOrder.get(),
-                           &name);  // can throw
+  loadChilds(childs, names, std::nullopt, 1);
+}
 
-    childs.append(std::make_pair(uuid, name));
+void CategoryTreeModel::loadChilds(
+    const QHash<std::optional<Uuid>, QSet<Uuid>>& childs,
+    const QHash<Uuid, QString>& names, const std::optional<Uuid>& parent,
+    int level) noexcept {
+  QVector<std::pair<Uuid, QString>> items;
+  for (const Uuid& uuid : childs.value(parent)) {
+    if (uuid == mHiddenCategory) continue;
+    items.append(std::make_pair(uuid, names.value(uuid)));
   }
 
   Toolbox::sortNumeric(
-      childs,
+      items,
       [](const QCollator& collator, const std::pair<Uuid, QString>& lhs,
          const std::pair<Uuid, QString>& rhs) {
         return collator(lhs.second, rhs.second);
       });
 
-  for (const auto& pair : childs) {
+  for (const auto& pair : items) {
     mItems.push_back(ui::TreeViewItemData{
         level,  // Level
         mIcon,  // Icon
@@ -142,7 +170,7 @@ void CategoryTreeModel::loadChilds(const std::optional<Uuid>& parent,
         false,  // Pinned
         ui::TreeViewItemAction::None,  // Action
     });
-    loadChilds<T>(pair.first, level + 1);
+    loadChilds(childs, names, pair.first, level + 1);
   }
 }
 
@@ -79,7 +79,10 @@ public:
 private:  // Methods
   void refresh() noexcept;
   template <typename T>
-  void loadChilds(const std::optional<Uuid>& parent, int level);
+  void loadCategories();
+  void loadChilds(const QHash<std::optional<Uuid>, QSet<Uuid>>& childs,
+                  const QHash<Uuid, QString>& names,
+                  const std::optional<Uuid>& parent, int level) noexcept;
 
 private:  // Data
   const WorkspaceLibraryDb& mDb;
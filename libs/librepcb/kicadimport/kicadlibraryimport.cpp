@@ -34,9 +34,9 @@
 #include <librepcb/core/library/pkg/package.h>
 #include <librepcb/core/library/sym/symbol.h>
 #include <librepcb/core/utils/messagelogger.h>
+#include <librepcb/core/utils/taskscheduler.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
 
-#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -103,6 +103,130 @@ static QList<KiCadSymbolGate> mergeSymbolGates(
   return ret;
 }
 
+/**
+ * @brief Result of parsing a KiCad file in a worker thread
+ *
+ * Messages are recorded instead of logged directly to allow replaying them
+ * in a deterministic order, independent of the thread scheduling.
+ */
+template <typename T>
+struct ParsedFile {
+  std::shared_ptr<const T> data;  ///< nullptr on error
+  QString error;
+  QList<MessageLogger::Message> messages;
+
+  void replayMessages(MessageLogger& log) const noexcept {
+    for (const MessageLogger::Message& msg : messages) {
+      log.log(msg.type, msg.message);
+    }
+  }
+};
+
+template <typename T>
+static ParsedFile<T> parseFile(const FilePath& fp) noexcept {
+  ParsedFile<T> ret;
+  MessageLogger log;
+  log.setPrintMessages(false);  // Messages are printed when replayed.
+  try {
+    std::unique_ptr<SExpression> root = SExpression::parse(
+        FileUtils::readFile(fp), fp, SExpression::Mode::Permissive);
+    ret.data = std::make_shared<T>(T::parse(*root, log));  // can throw
+  } catch (const Exception& e) {
+    ret.error = e.getMsg();
+  }
+  ret.messages = log.getMessages();
+  return ret;
+}
+
+/**
+ * @brief Worker tasks started by a parse or import run
+ *
+ * Tasks which were not started yet are cancelled on destruction, running
+ * tasks are awaited.
+ */
+class WorkerTasks final {
+public:
+  WorkerTasks() noexcept = default;
+  WorkerTasks(const WorkerTasks& other) = delete;
+  ~WorkerTasks() noexcept {
+    mToken.cancel();
+    for (const QFuture<void>& future : mFutures) {
+      try {
+        TaskScheduler::instance().waitForFinished(future);
+      } catch (...) {
+        // Errors are reported when fetching the results.
+      }
+    }
+  }
+  template <typename Func>
+  auto start(Func func) noexcept {
+    auto future = TaskScheduler::instance().run(
+        TaskScheduler::Group::Import, TaskScheduler::Priority::Normal, func,
+        mToken);
+    mFutures.append(QFuture<void>(future));
+    return future;
+  }
+  WorkerTasks& operator=(const WorkerTasks& rhs) = delete;
+
+private:
+  CancellationToken mToken;
+  QList<QFuture<void>> mFutures;
+};
+
+template <typename T>
+static T waitForResult(const QFuture<T>& future) {
+  TaskScheduler::instance().waitForFinished(future);  // can throw
+  return future.result();  // can throw
+}
+
+template <typename T>
+static QFuture<ParsedFile<T>> startParseFile(WorkerTasks& tasks,
+                                             const FilePath& fp) noexcept {
+  return tasks.start([fp]() { return parseFile<T>(fp); });
+}
+
+/**
+ * @brief Library element being written to disk in a worker thread
+ */
+struct PendingSave {
+  std::shared_ptr<LibraryBaseElement> element;
+  QFuture<void> future;
+  QStringList logGroups;
+  QString errorMsg;  ///< Contains "%1" as placeholder for the reason
+};
+
+template <typename T>
+static PendingSave startSave(WorkerTasks& tasks, std::unique_ptr<T> element,
+                             const FilePath& dstLibFp,
+                             const QStringList& logGroups,
+                             const QString& errorMsg) noexcept {
+  const FilePath fp = dstLibFp.getPathTo(T::getShortElementName())
+                          .getPathTo(element->getUuid().toStr());
+  // Note: The lambda must not share ownership to make sure the element is
+  // always destroyed in the thread it was created in.
+  LibraryBaseElement* ptr = element.get();
+  QFuture<void> future = tasks.start([ptr, fp]() {
+    TransactionalDirectory dir(TransactionalFileSystem::openRW(fp));
+    ptr->saveTo(dir);  // can throw
+    dir.getFileSystem()->save();  // can throw
+  });
+  return PendingSave{std::move(element), future, logGroups, errorMsg};
+}
+
+static bool finishSave(PendingSave& save, MessageLogger& log) noexcept {
+  try {
+    TaskScheduler::instance().waitForFinished(save.future);  // can throw
+    return true;
+  } catch (const Exception& e) {
+    QString prefix;
+    for (const QString& group : save.logGroups) {
+      prefix += "[" % group % "] ";
+    }
+    log.critical(prefix % save.errorMsg.arg(e.getMsg()));
+    return false;
+  }
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -336,8 +460,11 @@ bool KiCadLibraryImport::startScan(
   mState = State::Scanning;
   mLoadedLibsFp = libsFp;
   mLoadedShapes3dFp = shapes3dFp;
-  mFuture = QtConcurrent::run(&KiCadLibraryImport::scan, this, libsFp,
-                              shapes3dFp, log);
+  mFuture = TaskScheduler::instance().run(
+      TaskScheduler::Group::Import, TaskScheduler::Priority::Normal,
+      [this, libsFp, shapes3dFp, log]() {
+        return scan(libsFp, shapes3dFp, log);
+      });
   return true;
 }
 
@@ -351,8 +478,10 @@ bool KiCadLibraryImport::startParse(
 
   mAbort = false;
   mState = State::Parsing;
-  mFuture = QtConcurrent::run(&KiCadLibraryImport::parse, this,
-                              mFuture.result(), log);
+  std::shared_ptr<Result> result = mFuture.result();
+  mFuture = TaskScheduler::instance().run(
+      TaskScheduler::Group::Import, TaskScheduler::Priority::Normal,
+      [this, result, log]() { return parse(result, log); });
   return true;
 }
 
@@ -366,8 +495,10 @@ bool KiCadLibraryImport::startImport(
 
   mAbort = false;
   mState = State::Importing;
-  mFuture = QtConcurrent::run(&KiCadLibraryImport::import, this,
-                              mFuture.result(), log);
+  std::shared_ptr<Result> result = mFuture.result();
+  mFuture = TaskScheduler::instance().run(
+      TaskScheduler::Group::Import, TaskScheduler::Priority::Normal,
+      [this, result, log]() { return import(result, log); });
   return true;
 }
 
@@ -537,118 +668,136 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::parse(
   log->info(tr("Parsing libraries..."));
   emit progressPercent(5);
 
+  // Parse all files in parallel, but process the results in order to keep
+  // the result and the log output deterministic. Database lookups are done
+  // only in this thread.
+  WorkerTasks tasks;
+  QVector<QFuture<ParsedFile<KiCadSymbolLibrary>>> symbolLibFutures;
+  for (const SymbolLibrary& lib : result->symbolLibs) {
+    symbolLibFutures.append(
+        startParseFile<KiCadSymbolLibrary>(tasks, lib.file));
+  }
+  QVector<QVector<QFuture<ParsedFile<KiCadFootprint>>>> footprintFutures;
+  for (const FootprintLibrary& lib : result->footprintLibs) {
+    QVector<QFuture<ParsedFile<KiCadFootprint>>> futures;
+    for (const FilePath& fptFp : lib.files) {
+      futures.append(startParseFile<KiCadFootprint>(tasks, fptFp));
+    }
+    footprintFutures.append(futures);
+  }
+
   // Load symbols.
-  int i = 0;
   int symbolCount = 0;
-  for (SymbolLibrary& lib : result->symbolLibs) {
+  for (int i = 0; i < result->symbolLibs.count(); ++i) {
+    SymbolLibrary& lib = result->symbolLibs[i];
     lib.symbols.clear();  // Might be a leftover from previous run.
     if (mAbort) break;
 
     MessageLogger symLog(log.get(), lib.file.getCompleteBasename());
-    try {
-      std::unique_ptr<SExpression> root =
-          SExpression::parse(FileUtils::readFile(lib.file), lib.file,
-                             SExpression::Mode::Permissive);
-      KiCadSymbolLibrary kiLib = KiCadSymbolLibrary::parse(*root, symLog);
-      for (const auto& kiSymbol : kiLib.symbols) {
-        const QString cmpGeneratedBy = generatedBy(
-            lib.file.getCompleteBasename(),
-            {kiSymbol.extends.isEmpty() ? kiSymbol.name : kiSymbol.extends});
-        const QString devGeneratedBy =
-            generatedBy(lib.file.getCompleteBasename(), {kiSymbol.name});
-        const std::optional<KiCadProperty> footprintProp =
-            KiCadTypeConverter::findProperty(kiSymbol.properties, "footprint");
-        const QString footprintStr =
-            footprintProp ? footprintProp->value.trimmed() : QString();
-        const QStringList footprintSplit =
-            footprintStr.isEmpty() ? QStringList() : footprintStr.split(":");
-        const QString pkgGeneratedBy = footprintSplit.count()
-            ? generatedBy(footprintSplit.value(0), footprintSplit.mid(1))
-            : QString();
-        if ((!kiSymbol.extends.isEmpty()) && (!kiSymbol.gates.isEmpty())) {
-          symLog.critical(
-              QString("Symbol '%1' extends another symbol and contains gates.")
-                  .arg(kiSymbol.name));
-          continue;
-        } else if (kiSymbol.extends.isEmpty() && kiSymbol.gates.isEmpty()) {
-          symLog.critical(QString("Symbol '%1' does not contain any gates.")
-                              .arg(kiSymbol.name));
-          continue;
-        }
-        Symbol sym{
-            kiSymbol.name,
-            cmpGeneratedBy,
-            devGeneratedBy,
-            pkgGeneratedBy,
-            true,  // Might be set to false below.
-            isAlreadyImported<librepcb::Component>(cmpGeneratedBy),
-            isAlreadyImported<librepcb::Device>(devGeneratedBy),
-            kiSymbol.extends,
-            {},
-            Qt::Checked,
-            Qt::Checked,
-            Qt::Checked,
-        };
-        foreach (const KiCadSymbolGate& gate,
-                 mergeSymbolGates(kiSymbol.gates, kiSymbol.name)) {
-          const QString genBy =
-              generatedBy(lib.file.getCompleteBasename(),
-                          {kiSymbol.name, QString::number(gate.index)});
-          const bool alreadyImported =
-              isAlreadyImported<librepcb::Symbol>(genBy);
-          if (!alreadyImported) {
-            sym.symAlreadyImported = false;
-          }
-          sym.gates.append(Gate{
-              gate.index,
-              genBy,
-              alreadyImported,
-          });
-        }
-        lib.symbols.append(sym);
-        ++symbolCount;
-      }
-    } catch (const Exception& e) {
+    const ParsedFile<KiCadSymbolLibrary> parsed =
+        waitForResult(symbolLibFutures.at(i));
+    parsed.replayMessages(symLog);
+    if (!parsed.data) {
       symLog.critical(QString("Failed to parse symbol library '%1':")
                           .arg(lib.file.getFilename()) %
-                      " " % e.getMsg());
+                      " " % parsed.error);
     }
-    emit progressPercent(5 + (45 * (++i) / result->symbolLibs.count()));
+    const QList<KiCadSymbol> kiSymbols =
+        parsed.data ? parsed.data->symbols : QList<KiCadSymbol>();
+    for (const KiCadSymbol& kiSymbol : kiSymbols) {
+      const QString cmpGeneratedBy = generatedBy(
+          lib.file.getCompleteBasename(),
+          {kiSymbol.extends.isEmpty() ? kiSymbol.name : kiSymbol.extends});
+      const QString devGeneratedBy =
+          generatedBy(lib.file.getCompleteBasename(), {kiSymbol.name});
+      const std::optional<KiCadProperty> footprintProp =
+          KiCadTypeConverter::findProperty(kiSymbol.properties, "footprint");
+      const QString footprintStr =
+          footprintProp ? footprintProp->value.trimmed() : QString();
+      const QStringList footprintSplit =
+          footprintStr.isEmpty() ? QStringList() : footprintStr.split(":");
+      const QString pkgGeneratedBy = footprintSplit.count()
+          ? generatedBy(footprintSplit.value(0), footprintSplit.mid(1))
+          : QString();
+      if ((!kiSymbol.extends.isEmpty()) && (!kiSymbol.gates.isEmpty())) {
+        symLog.critical(
+            QString("Symbol '%1' extends another symbol and contains gates.")
+                .arg(kiSymbol.name));
+        continue;
+      } else if (kiSymbol.extends.isEmpty() && kiSymbol.gates.isEmpty()) {
+        symLog.critical(QString("Symbol '%1' does not contain any gates.")
+                            .arg(kiSymbol.name));
+        continue;
+      }
+      Symbol sym{
+          kiSymbol.name,
+          cmpGeneratedBy,
+          devGeneratedBy,
+          pkgGeneratedBy,
+          true,  // Might be set to false below.
+          isAlreadyImported<librepcb::Component>(cmpGeneratedBy),
+          isAlreadyImported<librepcb::Device>(devGeneratedBy),
+          kiSymbol.extends,
+          {},
+          Qt::Checked,
+          Qt::Checked,
+          Qt::Checked,
+      };
+      foreach (const KiCadSymbolGate& gate,
+               mergeSymbolGates(kiSymbol.gates, kiSymbol.name)) {
+        const QString genBy =
+            generatedBy(lib.file.getCompleteBasename(),
+                        {kiSymbol.name, QString::number(gate.index)});
+        const bool alreadyImported = isAlreadyImported<librepcb::Symbol>(genBy);
+        if (!alreadyImported) {
+          sym.symAlreadyImported = false;
+        }
+        sym.gates.append(Gate{
+            gate.index,
+            genBy,
+            alreadyImported,
+        });
+      }
+      lib.symbols.append(sym);
+      ++symbolCount;
+    }
+    emit progressPercent(5 + (45 * (i + 1) / result->symbolLibs.count()));
   }
 
   // Load footprints.
-  i = 0;
   int footprintCount = 0;
-  for (FootprintLibrary& lib : result->footprintLibs) {
+  for (int i = 0; i < result->footprintLibs.count(); ++i) {
+    FootprintLibrary& lib = result->footprintLibs[i];
     lib.footprints.clear();  // Might be a leftover from previous run.
-    for (const FilePath& fptFp : lib.files) {
+    for (int j = 0; j < lib.files.count(); ++j) {
       if (mAbort) break;
 
+      const FilePath& fptFp = lib.files.at(j);
       MessageLogger fptLog(
           log.get(),
           lib.dir.getCompleteBasename() + ":" + fptFp.getCompleteBasename());
-      try {
-        std::unique_ptr<SExpression> root = SExpression::parse(
-            FileUtils::readFile(fptFp), fptFp, SExpression::Mode::Permissive);
-        KiCadFootprint kiFpt = KiCadFootprint::parse(*root, fptLog);
-        const QString pkgGeneratedBy = generatedBy(
-            lib.dir.getCompleteBasename(), {fptFp.getCompleteBasename()});
-        lib.footprints.append(Footprint{
-            fptFp,
-            kiFpt.name,
-            pkgGeneratedBy,
-            isAlreadyImported<librepcb::Package>(pkgGeneratedBy),
-            Qt::Checked,
-        });
-        ++footprintCount;
-      } catch (const Exception& e) {
+      const ParsedFile<KiCadFootprint> parsed =
+          waitForResult(footprintFutures.at(i).at(j));
+      parsed.replayMessages(fptLog);
+      if (!parsed.data) {
         fptLog.critical(
             QString("Failed to parse footprint '%1':")
                 .arg(lib.dir.getFilename() + ":" + fptFp.getFilename()) %
-            " " % e.getMsg());
+            " " % parsed.error);
+        continue;
       }
+      const QString pkgGeneratedBy = generatedBy(
+          lib.dir.getCompleteBasename(), {fptFp.getCompleteBasename()});
+      lib.footprints.append(Footprint{
+          fptFp,
+          parsed.data->name,
+          pkgGeneratedBy,
+          isAlreadyImported<librepcb::Package>(pkgGeneratedBy),
+          Qt::Checked,
+      });
+      ++footprintCount;
     }
-    emit progressPercent(50 + (45 * (++i) / result->footprintLibs.count()));
+    emit progressPercent(50 + (45 * (i + 1) / result->footprintLibs.count()));
   }
 
   qDebug() << "Parsed all KiCad libraries in" << timer.elapsed() << "ms.";
@@ -718,10 +867,37 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
     }
   }
 
-  // Import packages.
-  QSet<QString> missing3dShapeLibs;
+  // Parse all required files in parallel. The conversion is done
+  // sequentially in this thread because the converter depends on previously
+  // converted elements and on database lookups, but the converted elements
+  // are written to disk in parallel again. All results are processed in
+  // order to keep the log output deterministic.
+  WorkerTasks tasks;
+  QVector<QVector<QFuture<ParsedFile<KiCadFootprint>>>> footprintFutures;
   for (const FootprintLibrary& lib : result->footprintLibs) {
+    QVector<QFuture<ParsedFile<KiCadFootprint>>> futures;
     for (const Footprint& fpt : lib.footprints) {
+      if ((fpt.checked != Qt::Unchecked) && (!fpt.alreadyImported)) {
+        futures.append(startParseFile<KiCadFootprint>(tasks, fpt.file));
+      } else {
+        futures.append(QFuture<ParsedFile<KiCadFootprint>>());
+      }
+    }
+    footprintFutures.append(futures);
+  }
+  QVector<QFuture<ParsedFile<KiCadSymbolLibrary>>> symbolLibFutures;
+  for (const SymbolLibrary& lib : result->symbolLibs) {
+    symbolLibFutures.append(
+        startParseFile<KiCadSymbolLibrary>(tasks, lib.file));
+  }
+  QList<PendingSave> pendingSaves;
+
+  // Import packages.
+  QSet<QString> missing3dShapeLibs;
+  for (int iLib = 0; iLib < result->footprintLibs.count(); ++iLib) {
+    const FootprintLibrary& lib = result->footprintLibs.at(iLib);
+    for (int iFpt = 0; iFpt < lib.footprints.count(); ++iFpt) {
+      const Footprint& fpt = lib.footprints.at(iFpt);
       if (mAbort) {
         break;
       }
@@ -734,10 +910,13 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
       emit progressStatus(lib.dir.getCompleteBasename() % ":" %
                           fpt.file.getCompleteBasename());
       try {
-        std::unique_ptr<SExpression> root =
-            SExpression::parse(FileUtils::readFile(fpt.file), fpt.file,
-                               SExpression::Mode::Permissive);
-        KiCadFootprint kiFpt = KiCadFootprint::parse(*root, fptLog);
+        const ParsedFile<KiCadFootprint> parsed =
+            waitForResult(footprintFutures.at(iLib).at(iFpt));
+        parsed.replayMessages(fptLog);
+        if (!parsed.data) {
+          throw RuntimeError(__FILE__, __LINE__, parsed.error);
+        }
+        const KiCadFootprint& kiFpt = *parsed.data;
 
         // Find 3D models.
         QMap<QString, FilePath> models;
@@ -772,13 +951,11 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
         auto package =
             converter.createPackage(lib.dir, kiFpt, fpt.generatedBy, models,
                                     fptLog);  // can throw
-        TransactionalDirectory dir(TransactionalFileSystem::openRW(
-            mDestinationLibraryFp
-                .getPathTo(librepcb::Package::getShortElementName())
-                .getPathTo(package->getUuid().toStr())));
-        package->saveTo(dir);
-        dir.getFileSystem()->save();
-        ++importedCount;
+        pendingSaves.append(startSave(
+            tasks, std::move(package), mDestinationLibraryFp,
+            {QString(lib.dir.getCompleteBasename() % ":" %
+                     fpt.file.getCompleteBasename())},
+            tr("Skipped footprint due to error: %1")));
       } catch (const Exception& e) {
         fptLog.critical(
             tr("Skipped footprint due to error: %1").arg(e.getMsg()));
@@ -789,13 +966,20 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
   }
 
   // Import symbols, components & devices.
-  for (const SymbolLibrary& lib : result->symbolLibs) {
+  for (int iLib = 0; iLib < result->symbolLibs.count(); ++iLib) {
+    const SymbolLibrary& lib = result->symbolLibs.at(iLib);
     MessageLogger libLog(log.get(), lib.file.getCompleteBasename());
+    if (mAbort) {
+      break;
+    }
     try {
-      std::unique_ptr<SExpression> root =
-          SExpression::parse(FileUtils::readFile(lib.file), lib.file,
-                             SExpression::Mode::Permissive);
-      KiCadSymbolLibrary kiLib = KiCadSymbolLibrary::parse(*root, libLog);
+      const ParsedFile<KiCadSymbolLibrary> parsed =
+          waitForResult(symbolLibFutures.at(iLib));
+      parsed.replayMessages(libLog);
+      if (!parsed.data) {
+        throw RuntimeError(__FILE__, __LINE__, parsed.error);
+      }
+      const KiCadSymbolLibrary& kiLib = *parsed.data;
       if (lib.symbols.count() != kiLib.symbols.count()) {
         throw LogicError(__FILE__, __LINE__);
       }
@@ -827,13 +1011,11 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
             auto symbol = converter.createSymbol(lib.file, kiSym, kiGate,
                                                  gate.symGeneratedBy,
                                                  gateLog);  // can throw
-            TransactionalDirectory dir(TransactionalFileSystem::openRW(
-                mDestinationLibraryFp
-                    .getPathTo(librepcb::Symbol::getShortElementName())
-                    .getPathTo(symbol->getUuid().toStr())));
-            symbol->saveTo(dir);
-            dir.getFileSystem()->save();
-            ++importedCount;
+            pendingSaves.append(startSave(
+                tasks, std::move(symbol), mDestinationLibraryFp,
+                {lib.file.getCompleteBasename(), kiSym.name,
+                 QString::number(kiGate.index)},
+                tr("Skipped symbol due to error: %1")));
           } catch (const Exception& e) {
             gateLog.critical(
                 tr("Skipped symbol due to error: %1").arg(e.getMsg()));
@@ -859,13 +1041,10 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
             auto component = converter.createComponent(
                 lib.file, kiSym, kiGates, sym.cmpGeneratedBy, symGeneratedBy,
                 symLog);  // can throw
-            TransactionalDirectory dir(TransactionalFileSystem::openRW(
-                mDestinationLibraryFp
-                    .getPathTo(librepcb::Component::getShortElementName())
-                    .getPathTo(component->getUuid().toStr())));
-            component->saveTo(dir);
-            dir.getFileSystem()->save();
-            ++importedCount;
+            pendingSaves.append(startSave(
+                tasks, std::move(component), mDestinationLibraryFp,
+                {lib.file.getCompleteBasename(), kiSym.name},
+                tr("Skipped component due to error: %1")));
           } catch (const Exception& e) {
             symLog.critical(
                 tr("Skipped component due to error: %1").arg(e.getMsg()));
@@ -902,13 +1081,10 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
                 lib.file, kiSym, kiGates, sym.devGeneratedBy,
                 sym.cmpGeneratedBy, sym.pkgGeneratedBy,
                 symLog);  // can throw
-            TransactionalDirectory dir(TransactionalFileSystem::openRW(
-                mDestinationLibraryFp
-                    .getPathTo(librepcb::Device::getShortElementName())
-                    .getPathTo(device->getUuid().toStr())));
-            device->saveTo(dir);
-            dir.getFileSystem()->save();
-            ++importedCount;
+            pendingSaves.append(startSave(
+                tasks, std::move(device), mDestinationLibraryFp,
+                {lib.file.getCompleteBasename(), kiSym.name},
+                tr("Skipped device due to error: %1")));
           } catch (const Exception& e) {
             symLog.critical(
                 tr("Skipped device due to error: %1").arg(e.getMsg()));
@@ -924,6 +1100,14 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
     }
   }
 
+  // Wait until all converted elements are written to disk.
+  for (PendingSave& save : pendingSaves) {
+    if (finishSave(save, *log)) {
+      ++importedCount;
+    }
+  }
+  pendingSaves.clear();
+
   // Warn about missing 3D shape libraries.
   foreach (const QString& libName, Toolbox::sortedQSet(missing3dShapeLibs)) {
     log->info(QString("3D model library not found: '%1'").arg(libName));
@@ -0,0 +1,121 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "benchmarkdatagenerator.h"
+
+#include <librepcb/core/fileio/transactionaldirectory.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/geometry/path.h>
+#include <librepcb/core/library/cmp/component.h>
+#include <librepcb/core/library/library.h>
+#include <librepcb/core/library/sym/symbol.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/syntheticprojectgenerator.h>
+#include <librepcb/core/types/layer.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BenchmarkDataGenerator::BenchmarkDataGenerator(quint32 seed) noexcept
+  : mRandom(seed) {
+}
+
+BenchmarkDataGenerator::~BenchmarkDataGenerator() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+Uuid BenchmarkDataGenerator::createUuid() noexcept {
+  return SyntheticProjectGenerator::createUuid(mRandom);
+}
+
+std::unique_ptr<Project> BenchmarkDataGenerator::createProject(
+    const FilePath& dir, int netCount, int innerLayerCount) {
+  SyntheticProjectGenerator::Options options;
+  options.componentCount = netCount;
+  options.netCount = std::max(netCount, 1);
+  options.innerLayerCount = innerLayerCount;
+  SyntheticProjectGenerator generator(options, mRandom.generate());
+  return generator.generate(
+      dir.getPathTo(getProjectFileName()));  // can throw
+}
+
+void BenchmarkDataGenerator::createLibrary(const FilePath& dir,
+                                           int elementCount) {
+  const Version version = Version::fromString("0.1");
+  std::shared_ptr<TransactionalFileSystem> fs =
+      TransactionalFileSystem::openRW(dir);  // can throw
+  TransactionalDirectory root(fs);
+  Library lib(createUuid(), version, "LibrePCB", ElementName("Benchmark"), "",
+              "");
+  lib.saveTo(root);  // can throw
+
+  for (int i = 0; i < elementCount; ++i) {
+    const ElementName name(QString("Element %1").arg(i + 1));
+    const QString keywords = QString("benchmark,element,%1").arg(i + 1);
+
+    Symbol sym(createUuid(), version, "LibrePCB", name, "", keywords);
+    const Length w = randomLength(Length(2540000), Length(10160000));
+    const Length h = randomLength(Length(2540000), Length(10160000));
+    sym.getPolygons().append(std::make_shared<Polygon>(
+        createUuid(), Layer::symbolOutlines(), UnsignedLength(200000), true,
+        false, Path::centeredRect(PositiveLength(w), PositiveLength(h))));
+    TransactionalDirectory symDir(
+        root, lib.getElementsDirectoryName<Symbol>() % "/" %
+            sym.getUuid().toStr());
+    sym.saveTo(symDir);  // can throw
+
+    Component cmp(createUuid(), version, "LibrePCB", name, "", keywords);
+    TransactionalDirectory cmpDir(
+        root, lib.getElementsDirectoryName<Component>() % "/" %
+            cmp.getUuid().toStr());
+    cmp.saveTo(cmpDir);  // can throw
+  }
+  fs->save();  // can throw
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+Length BenchmarkDataGenerator::randomLength(const Length& min,
+                                            const Length& max) noexcept {
+  return Length(min.toNm() + mRandom.bounded(max.toNm() - min.toNm()));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
@@ -0,0 +1,117 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARKS_BENCHMARKDATAGENERATOR_H
+#define BENCHMARKS_BENCHMARKDATAGENERATOR_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/core/fileio/filepath.h>
+#include <librepcb/core/types/length.h>
+#include <librepcb/core/types/point.h>
+#include <librepcb/core/types/uuid.h>
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class Project;
+
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Class BenchmarkDataGenerator
+ ******************************************************************************/
+
+/**
+ * @brief Generates synthetic, deterministic input data for benchmarks
+ *
+ * All generated data only depends on the seed passed to the constructor and
+ * the requested size, so benchmark results are comparable between different
+ * commits. The only exception are a few UUIDs created internally by
+ * ::librepcb::Project::create(), which don't influence the performance.
+ */
+class BenchmarkDataGenerator final {
+public:
+  // Constructors / Destructor
+  BenchmarkDataGenerator(const BenchmarkDataGenerator& other) = delete;
+  explicit BenchmarkDataGenerator(quint32 seed = 42) noexcept;
+  ~BenchmarkDataGenerator() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Create a deterministic (version 4) UUID
+   *
+   * @return A valid UUID derived from the random generator state.
+   */
+  Uuid createUuid() noexcept;
+
+  /**
+   * @brief Create a project with ::librepcb::SyntheticProjectGenerator
+   *
+   * The project contains as many two-pin components as nets, placed on a
+   * single board with traces, vias and two planes.
+   *
+   * @param dir             Empty directory to create the project in.
+   * @param netCount        Number of nets and components.
+   * @param innerLayerCount Number of inner copper layers of the board.
+   *
+   * @return The created (and already saved) project.
+   */
+  std::unique_ptr<Project> createProject(const FilePath& dir, int netCount,
+                                         int innerLayerCount = 0);
+
+  /**
+   * @brief Create a workspace library with synthetic elements
+   *
+   * @param dir           Directory to create the library in (must end with
+   *                      ".lplib" to be detected by the library scanner).
+   * @param elementCount  Number of symbols and components to create (each).
+   */
+  void createLibrary(const FilePath& dir, int elementCount);
+
+  // Static Methods
+  static QString getProjectFileName() noexcept { return "benchmark.lpp"; }
+
+  // Operator Overloadings
+  BenchmarkDataGenerator& operator=(const BenchmarkDataGenerator& rhs) =
+      delete;
+
+private:  // Methods
+  Length randomLength(const Length& min, const Length& max) noexcept;
+
+private:  // Data
+  QRandomGenerator mRandom;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <benchmark/benchmark.h>
+#include <librepcb/core/export/gerbergenerator.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmarks
+ ******************************************************************************/
+
+// Copper layer of a large board, with many lines and pads but only a few
+// distinct apertures.
+static void BM_GerberGeneratorCopperLayer(benchmark::State& state) {
+  const std::optional<QString> net("GND");
+  for (auto _ : state) {
+    GerberGenerator gen(QDateTime(QDate(2000, 2, 1), QTime(1, 2, 3, 4)),
+                        "Project Name", Uuid::createRandom(), "rev-1.0");
+    gen.setFileFunctionCopper(1, GerberGenerator::CopperSide::Top,
+                              GerberGenerator::Polarity::Positive);
+    for (int i = 0; i < state.range(0); ++i) {
+      const Point p(Length(i * 1000), Length(-i * 500));
+      gen.drawLine(p, p + Point(100000, 0), UnsignedLength(100000 + (i % 50)),
+                   GerberAttribute::ApertureFunction::Conductor, net,
+                   QString());
+      gen.flashRect(p, PositiveLength(500000 + (i % 200)),
+                    PositiveLength(300000), UnsignedLength(0), Angle::deg0(),
+                    GerberAttribute::ApertureFunction::SmdPadCopperDefined,
+                    net, "U1", QString::number(i), "GND");
+    }
+    gen.generate();
+    benchmark::DoNotOptimize(gen.toByteArray().size());
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_GerberGeneratorCopperLayer)
+    ->ArgNames({"objects"})
+    ->Arg(10000)
+    ->Arg(200000)
+    ->Unit(benchmark::kMillisecond);
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
@@ -0,0 +1,70 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../../benchmarkdatagenerator.h"
+
+#include <benchmark/benchmark.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/boardplanefragmentsbuilder.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/utils/scopeguard.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmarks
+ ******************************************************************************/
+
+static void BM_BoardPlaneFragmentsBuilder(benchmark::State& state) {
+  const FilePath dir = FilePath::getRandomTempPath();
+  auto sg = scopeGuard([&dir]() { QDir(dir.toStr()).removeRecursively(); });
+  BenchmarkDataGenerator generator;
+  std::unique_ptr<Project> project =
+      generator.createProject(dir, state.range(0), state.range(1));
+  Board& board = *project->getBoards().first();
+
+  for (auto _ : state) {
+    BoardPlaneFragmentsBuilder builder;
+    benchmark::DoNotOptimize(builder.runAndApply(board));  // can throw
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_BoardPlaneFragmentsBuilder)
+    ->ArgNames({"nets", "inner_layers"})
+    ->Args({100, 0})
+    ->Args({1000, 0})
+    ->Args({1000, 4})
+    ->Args({5000, 0})
+    ->Unit(benchmark::kMillisecond);
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
@@ -0,0 +1,104 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <benchmark/benchmark.h>
+#include <librepcb/core/rulecheck/approvalkey.h>
+#include <librepcb/core/types/uuid.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Helpers
+ ******************************************************************************/
+
+static QVector<std::shared_ptr<SExpression>> createApprovals(int count) {
+  QVector<std::shared_ptr<SExpression>> nodes;
+  for (int i = 0; i < count; ++i) {
+    std::shared_ptr<SExpression> node = SExpression::createList("approved");
+    node->appendChild(SExpression::createToken("foo"));
+    node->ensureLineBreak();
+    SExpression& child = node->appendList("device");
+    child.appendChild(SExpression::createToken(Uuid::createRandom().toStr()));
+    node->ensureLineBreak();
+    nodes.append(node);
+  }
+  return nodes;
+}
+
+// Simulate the approval handling after several DRC runs on a large board.
+template <typename Key>
+static void runApprovalSetOperations(benchmark::State& state) {
+  const QVector<std::shared_ptr<SExpression>> nodes =
+      createApprovals(state.range(0));
+  for (auto _ : state) {
+    QSet<Key> approved;
+    for (int i = 0; i < nodes.count(); i += 2) {
+      approved.insert(Key(*nodes.at(i)));
+    }
+    QSet<Key> supported;
+    for (int n = 0; n < 10; ++n) {
+      QSet<Key> current;
+      for (const auto& node : nodes) {
+        current.insert(Key(*node));
+      }
+      supported |= current;
+      approved = approved - (supported - current);
+    }
+    benchmark::DoNotOptimize(approved.count());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+/*******************************************************************************
+ *  Benchmarks
+ ******************************************************************************/
+
+static void BM_ApprovalSetOperationsSExpression(benchmark::State& state) {
+  runApprovalSetOperations<SExpression>(state);
+}
+BENCHMARK(BM_ApprovalSetOperationsSExpression)
+    ->ArgNames({"approvals"})
+    ->Arg(2000)
+    ->Arg(20000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_ApprovalSetOperationsKey(benchmark::State& state) {
+  runApprovalSetOperations<ApprovalKey>(state);
+}
+BENCHMARK(BM_ApprovalSetOperationsKey)
+    ->ArgNames({"approvals"})
+    ->Arg(2000)
+    ->Arg(20000)
+    ->Unit(benchmark::kMillisecond);
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
@@ -0,0 +1,93 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../benchmarkdatagenerator.h"
+
+#include <benchmark/benchmark.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/serialization/sexpression.h>
+#include <librepcb/core/utils/scopeguard.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmarks
+ ******************************************************************************/
+
+/**
+ * @brief Generate a board file of the given size and return its content
+ */
+static QByteArray generateBoardFile(int netCount) {
+  const FilePath dir = FilePath::getRandomTempPath();
+  auto sg = scopeGuard([&dir]() { QDir(dir.toStr()).removeRecursively(); });
+  BenchmarkDataGenerator generator;
+  generator.createProject(dir, netCount);
+  return FileUtils::readFile(
+      dir.getPathTo("boards/default/board.lp"));  // can throw
+}
+
+static void BM_SExpressionParse(benchmark::State& state) {
+  const QByteArray content = generateBoardFile(state.range(0));
+  const FilePath fp("/benchmark/board.lp");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SExpression::parse(content, fp));  // can throw
+  }
+  state.SetBytesProcessed(state.iterations() * content.size());
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SExpressionParse)
+    ->ArgName("nets")
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_SExpressionSerialize(benchmark::State& state) {
+  const QByteArray content = generateBoardFile(state.range(0));
+  const std::unique_ptr<SExpression> root =
+      SExpression::parse(content, FilePath("/benchmark/board.lp"));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(root->toByteArray());
+  }
+  state.SetBytesProcessed(state.iterations() * content.size());
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SExpressionSerialize)
+    ->ArgName("nets")
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
@@ -0,0 +1,150 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <benchmark/benchmark.h>
+#include <librepcb/core/types/uuid.h>
+
+#include <QtCore>
+
+#include <algorithm>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Helpers
+ ******************************************************************************/
+
+static QVector<Uuid> createUuids(int count) {
+  QVector<Uuid> uuids;
+  uuids.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    uuids.append(Uuid::createRandom());
+  }
+  return uuids;
+}
+
+/*******************************************************************************
+ *  Benchmarks
+ ******************************************************************************/
+
+// Parsing happens for every UUID contained in the loaded files.
+static void BM_UuidParse(benchmark::State& state) {
+  QStringList strings;
+  for (const Uuid& uuid : createUuids(state.range(0))) {
+    strings.append(uuid.toStr());
+  }
+  for (auto _ : state) {
+    for (const QString& str : strings) {
+      benchmark::DoNotOptimize(Uuid::fromString(str));  // can throw
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * strings.count());
+}
+BENCHMARK(BM_UuidParse)->ArgNames({"uuids"})->Arg(10000);
+
+static void BM_UuidToString(benchmark::State& state) {
+  const QVector<Uuid> uuids = createUuids(state.range(0));
+  for (auto _ : state) {
+    for (const Uuid& uuid : uuids) {
+      benchmark::DoNotOptimize(uuid.toStr());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * uuids.count());
+}
+BENCHMARK(BM_UuidToString)->ArgNames({"uuids"})->Arg(10000);
+
+static void BM_UuidHash(benchmark::State& state) {
+  const QVector<Uuid> uuids = createUuids(state.range(0));
+  for (auto _ : state) {
+    size_t hash = 0;
+    for (const Uuid& uuid : uuids) {
+      hash ^= qHash(uuid);
+    }
+    benchmark::DoNotOptimize(hash);
+  }
+  state.SetItemsProcessed(state.iterations() * uuids.count());
+}
+BENCHMARK(BM_UuidHash)->ArgNames({"uuids"})->Arg(10000);
+
+// Typical lookups of project items by UUID, e.g. net signals in the circuit.
+static void BM_UuidHashLookup(benchmark::State& state) {
+  const QVector<Uuid> uuids = createUuids(state.range(0));
+  QHash<Uuid, int> hash;
+  for (int i = 0; i < uuids.count(); ++i) {
+    hash.insert(uuids.at(i), i);
+  }
+  for (auto _ : state) {
+    int sum = 0;
+    for (const Uuid& uuid : uuids) {
+      sum += hash.value(uuid);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * uuids.count());
+}
+BENCHMARK(BM_UuidHashLookup)->ArgNames({"uuids"})->Arg(1000)->Arg(100000);
+
+// Set operations as used for determining added/removed items.
+static void BM_UuidSetOperations(benchmark::State& state) {
+  const QVector<Uuid> uuids = createUuids(state.range(0));
+  const QSet<Uuid> set1(uuids.begin(), uuids.begin() + uuids.count() / 2);
+  const QSet<Uuid> set2(uuids.begin() + uuids.count() / 4, uuids.end());
+  for (auto _ : state) {
+    const QSet<Uuid> united = set1 + set2;
+    const QSet<Uuid> intersected = set1 & set2;
+    const QSet<Uuid> subtracted = set1 - set2;
+    benchmark::DoNotOptimize(united.count() + intersected.count() +
+                             subtracted.count());
+  }
+  state.SetItemsProcessed(state.iterations() * uuids.count());
+}
+BENCHMARK(BM_UuidSetOperations)
+    ->ArgNames({"uuids"})
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+
+// Sorting by UUID, e.g. for deterministic serialization.
+static void BM_UuidSort(benchmark::State& state) {
+  const QVector<Uuid> uuids = createUuids(state.range(0));
+  for (auto _ : state) {
+    QVector<Uuid> sorted = uuids;
+    std::sort(sorted.begin(), sorted.end());
+    benchmark::DoNotOptimize(sorted.data());
+  }
+  state.SetItemsProcessed(state.iterations() * uuids.count());
+}
+BENCHMARK(BM_UuidSort)
+    ->ArgNames({"uuids"})
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
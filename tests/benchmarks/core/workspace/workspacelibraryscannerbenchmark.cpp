@@ -0,0 +1,80 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../benchmarkdatagenerator.h"
+
+#include <benchmark/benchmark.h>
+#include <librepcb/core/utils/scopeguard.h>
+#include <librepcb/core/workspace/workspacelibrarydb.h>
+#include <librepcb/core/workspace/workspacelibraryscanner.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Benchmarks
+ ******************************************************************************/
+
+static void BM_WorkspaceLibraryScanner(benchmark::State& state) {
+  const FilePath dir = FilePath::getRandomTempPath();
+  auto sg = scopeGuard([&dir]() { QDir(dir.toStr()).removeRecursively(); });
+  BenchmarkDataGenerator generator;
+  generator.createLibrary(dir.getPathTo("local/Benchmark.lplib"),
+                          state.range(0));
+  const FilePath dbFp =
+      WorkspaceLibraryDb(dir).getFilePath();  // Creates the database.
+
+  WorkspaceLibraryScanner scanner(dir, dbFp);
+  QEventLoop loop;
+  QString error;
+  QObject::connect(&scanner, &WorkspaceLibraryScanner::scanFailed, &loop,
+                   [&error](const QString& msg) { error = msg; });
+  QObject::connect(&scanner, &WorkspaceLibraryScanner::scanFinished, &loop,
+                   &QEventLoop::quit, Qt::QueuedConnection);
+  for (auto _ : state) {
+    scanner.startScan();
+    loop.exec();
+    if (!error.isEmpty()) {
+      state.SkipWithError(error.toStdString().c_str());
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_WorkspaceLibraryScanner)
+    ->ArgName("elements")
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
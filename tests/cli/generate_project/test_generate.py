@@ -0,0 +1,94 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import params
+from helpers import nofmt
+
+"""
+Test command "generate-project"
+"""
+
+
+def test_generate_without_traces(cli):
+    fp = cli.abspath("generated/generated.lpp")
+    code, stdout, stderr = cli.run(
+        "generate-project",
+        "--components=10",
+        "--nets=5",
+        "--schematics=2",
+        "--traces=0",
+        fp,
+    )
+    assert stderr == ""
+    assert stdout == nofmt(f"""\
+Generate project '{fp}'...
+ - 10 components, 5 nets, 2 schematics, 20 net labels
+ - 0 traces, 0 vias, 2 planes
+SUCCESS
+""")
+    assert code == 0
+
+    # The generated project must be valid.
+    code, stdout, stderr = cli.run("open-project", "--erc", fp)
+    assert stderr == ""
+    assert stdout.startswith(f"Open project '{fp}'...\n")
+    assert code in [0, 1]
+
+
+def test_generate_all_routed_without_vias(cli):
+    # Each net with N pads gets N-1 connections consisting of two traces.
+    fp = cli.abspath("generated/generated.lpp")
+    code, stdout, stderr = cli.run(
+        "generate-project",
+        "--components=10",
+        "--nets=5",
+        "--inner-layers=2",
+        "--planes=0",
+        "--traces=100",
+        "--vias=0",
+        "--seed=1",
+        fp,
+    )
+    assert stderr == ""
+    assert stdout == nofmt(f"""\
+Generate project '{fp}'...
+ - 10 components, 5 nets, 1 schematics, 20 net labels
+ - 30 traces, 0 vias, 0 planes
+SUCCESS
+""")
+    assert code == 0
+
+
+def test_generate_into_existing_project(cli):
+    project = params.EMPTY_PROJECT_LPP
+    cli.add_project(project.dir)
+    fp = cli.abspath(project.path)
+    code, stdout, stderr = cli.run("generate-project", fp)
+    assert "already contains a LibrePCB project" in stderr
+    assert stdout == nofmt(f"""\
+Generate project '{fp}'...
+Finished with errors!
+""")
+    assert code == 1
+
+
+def test_invalid_suffix(cli):
+    fp = cli.abspath("generated/generated.lppz")
+    code, stdout, stderr = cli.run("generate-project", fp)
+    assert stderr == "ERROR: The project file must have the suffix '.lpp'.\n"
+    assert stdout == nofmt(f"""\
+Generate project '{fp}'...
+Finished with errors!
+""")
+    assert code == 1
+
+
+def test_invalid_option_value(cli):
+    fp = cli.abspath("generated/generated.lpp")
+    code, stdout, stderr = cli.run("generate-project", "--vias=200", fp)
+    assert stderr == "ERROR: Invalid value for 'vias': 200\n"
+    assert stdout == nofmt(f"""\
+Generate project '{fp}'...
+Finished with errors!
+""")
+    assert code == 1
@@ -0,0 +1,44 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+"""
+Test command "generate-project" (basic parser tests)
+"""
+
+ERROR_TEXT = """\
+{error}
+Usage: {executable} [options] generate-project [command_options] project
+Help: {executable} generate-project --help
+"""
+
+
+def test_no_arguments(cli):
+    code, stdout, stderr = cli.run("generate-project")
+    assert stderr == ERROR_TEXT.format(
+        executable=cli.executable,
+        error="Missing arguments: project",
+    )
+    assert stdout == ""
+    assert code == 1
+
+
+def test_invalid_argument(cli):
+    code, stdout, stderr = cli.run("generate-project", "--invalid-argument")
+    assert stderr == ERROR_TEXT.format(
+        executable=cli.executable,
+        error="Unknown option 'invalid-argument'.",
+    )
+    assert stdout == ""
+    assert code == 1
+
+
+def test_invalid_number(cli):
+    code, stdout, stderr = cli.run("generate-project", "--nets=foo", "out.lpp")
+    assert stderr == (
+        "Invalid value for '--nets': 'foo'\n"
+        "Help: {executable} generate-project --help\n".format(
+            executable=cli.executable
+        )
+    )
+    assert stdout == ""
+    assert code == 1
@@ -64,3 +64,16 @@ Process {library.dev} devices...
 Finished with errors!
 """)
     assert code == 1
+
+
+def test_parallel_output_is_deterministic(cli):
+    library = params.POPULATED_LIBRARY
+    cli.add_library(library.dir)
+    for subdir in ["sym", "pkg", "cmp"]:
+        shutil.rmtree(cli.abspath(os.path.join(library.dir, subdir)))
+    expected = cli.run("open-library", "--all", "--check", library.dir)
+    for i in range(3):
+        result = cli.run(
+            "open-library", "--all", "--check", "--parallel=4", library.dir
+        )
+        assert result == expected
@@ -10,25 +10,32 @@ Usage: {executable} [options] open-library [command_options] library
 LibrePCB Command Line Interface
 
 Options:
-  -h, --help     Print this message.
-  -V, --version  Displays version information.
-  -v, --verbose  Verbose output.
-  --all          Perform the selected action(s) on all elements contained in
-                 the opened library.
-  --check        Run the library element check, print all non-approved messages
-                 and report failure (exit code = 1) if there are non-approved
-                 messages.
-  --minify-step  Minify the STEP models of all packages. Only works in
-                 conjunction with '--all'. Pass '--save' to write the minified
-                 files to disk.
-  --save         Save library (and contained elements if '--all' is given)
-                 before closing them (useful to upgrade file format).
-  --strict       Fail if the opened files are not strictly canonical, i.e.
-                 there would be changes when saving the library elements.
+  -h, --help              Print this message.
+  -V, --version           Displays version information.
+  -v, --verbose           Verbose output.
+  --all                   Perform the selected action(s) on all elements
+                          contained in the opened library.
+  --check                 Run the library element check, print all non-approved
+                          messages and report failure (exit code = 1) if there
+                          are non-approved messages.
+  --minify-step           Minify the STEP models of all packages. Only works in
+                          conjunction with '--all'. Pass '--save' to write the
+                          minified files to disk.
+  -j, --parallel <count>  Maximum number of library elements to process in
+                          parallel. Use 0 to process as many elements in
+                          parallel as there are CPU cores. Default: 1
+  --save                  Save library (and contained elements if '--all' is
+                          given) before closing them (useful to upgrade file
+                          format).
+  --strict                Fail if the opened files are not strictly canonical,
+                          i.e. there would be changes when saving the library
+                          elements.
+  --trace <file>          Record a performance trace and write it to the given
+                          file (Chrome trace event format, e.g. for Perfetto).
 
 Arguments:
-  open-library   Open a library to execute library-related tasks.
-  library        Path to library directory (*.lplib).
+  open-library            Open a library to execute library-related tasks.
+  library                 Path to library directory (*.lplib).
 """
 
 ERROR_TEXT = """\
@@ -63,3 +70,13 @@ def test_invalid_argument(cli):
     )
     assert stdout == ""
     assert code == 1
+
+
+def test_invalid_parallel_jobs(cli):
+    code, stdout, stderr = cli.run("open-library", "--parallel=-1", "foo")
+    assert stderr == f"""\
+Invalid number of parallel jobs: '-1'
+Help: {cli.executable} open-library --help
+"""
+    assert stdout == ""
+    assert code == 1
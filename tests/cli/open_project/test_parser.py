@@ -36,6 +36,11 @@ Options:
   --outdir <path>                    Override the output base directory of
                                      jobs. If not set, the standard output
                                      directory from the project is used.
+  -j, --parallel <count>             Maximum number of output jobs to run in
+                                     parallel. Use 0 to run as many jobs in
+                                     parallel as there are CPU cores. Default: 1
+  --force                            Run output jobs even if their inputs did
+                                     not change since the last run.
   --export-schematics <file>         [DEPRECATED, REPLACED BY: --run-jobs]
                                      Export schematics to given file(s).
                                      Existing files will be overwritten.
@@ -104,6 +109,9 @@ Options:
                                      canonical, i.e. there would be changes when
                                      saving the project. Note that this option
                                      is not available for *.lppz files.
+  --trace <file>                     Record a performance trace and write it to
+                                     the given file (Chrome trace event format,
+                                     e.g. for Perfetto).
 
 Arguments:
   open-project                       Open a project to execute project-related
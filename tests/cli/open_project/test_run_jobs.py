@@ -100,6 +100,95 @@ SUCCESS
     assert len(os.listdir(dir)) == 12
 
 
+@pytest.mark.parametrize(
+    "project",
+    [
+        params.PROJECT_WITH_TWO_BOARDS_LPP_PARAM,
+    ],
+)
+def test_project_with_parallel_jobs(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    dir = cli.abspath(project.output_dir)
+    code, stdout, stderr = cli.run("open-project", "--run-jobs", project.path)
+    if "LibrePCB was compiled without OpenCascade" in stderr:
+        pytest.skip("Feature not available.")
+    assert code == 0
+    sequential_lines = sorted(stdout.splitlines())
+    sequential_files = sorted(os.listdir(dir))
+
+    # The order of jobs is not deterministic anymore, but the output must be
+    # the same.
+    code, stdout, stderr = cli.run(
+        "open-project", "--run-jobs", "--force", "-j", "4", project.path
+    )
+    assert stderr == ""
+    assert sorted(stdout.splitlines()) == sequential_lines
+    assert code == 0
+    assert sorted(os.listdir(dir)) == sequential_files
+
+
+@pytest.mark.parametrize(
+    "project",
+    [
+        params.PROJECT_WITH_TWO_BOARDS_LPP_PARAM,
+    ],
+)
+def test_unchanged_jobs_are_skipped(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    dir = cli.abspath(project.output_dir)
+    code, stdout, stderr = cli.run("open-project", "--run-jobs", project.path)
+    if "LibrePCB was compiled without OpenCascade" in stderr:
+        pytest.skip("Feature not available.")
+    assert code == 0
+    files = sorted(os.listdir(dir))
+
+    # Second run without any changes skips all jobs except the copy job.
+    code, stdout, stderr = cli.run("open-project", "--run-jobs", project.path)
+    assert stderr == ""
+    lines = stdout.splitlines()
+    assert "Skip output job 'Gerber/Excellon' (up to date)." in lines
+    assert "Skip output job 'Project Archive' (up to date)." in lines
+    assert "Run output job 'Custom File'..." in lines
+    assert code == 0
+    assert sorted(os.listdir(dir)) == files
+
+    # Removed output files are generated again.
+    os.remove(os.path.join(dir, "Empty_Project_v1_Netlist.d356"))
+    code, stdout, stderr = cli.run("open-project", "--run-jobs", project.path)
+    assert stderr == ""
+    assert "Run output job 'Netlist'..." in stdout.splitlines()
+    assert code == 0
+    assert sorted(os.listdir(dir)) == files
+
+    # Forced run does not skip any job.
+    code, stdout, stderr = cli.run(
+        "open-project", "--run-jobs", "--force", project.path
+    )
+    assert stderr == ""
+    assert "Skip output job" not in stdout
+    assert code == 0
+    assert sorted(os.listdir(dir)) == files
+
+
+@pytest.mark.parametrize(
+    "project",
+    [
+        params.PROJECT_WITH_TWO_BOARDS_LPP_PARAM,
+    ],
+)
+def test_invalid_parallel_jobs_fails(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    code, stdout, stderr = cli.run(
+        "open-project", "--run-jobs", "--parallel=foo", project.path
+    )
+    assert stderr == nofmt(f"""\
+Invalid number of parallel jobs: 'foo'
+Help: {cli.executable} open-project --help
+""")
+    assert stdout == ""
+    assert code == 1
+
+
 @pytest.mark.parametrize(
     "project",
     [
@@ -0,0 +1,37 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import json
+import params
+import pytest
+from helpers import nofmt
+
+"""
+Test command "open-project --trace"
+"""
+
+
+@pytest.mark.parametrize(
+    "project",
+    [
+        params.EMPTY_PROJECT_LPP_PARAM,
+        params.PROJECT_WITH_TWO_BOARDS_LPPZ_PARAM,
+    ],
+)
+def test_trace(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    code, stdout, stderr = cli.run(
+        "open-project", "--trace=trace.json", project.path
+    )
+    assert stderr == ""
+    assert stdout == nofmt(f"""\
+Open project '{project.path}'...
+Trace written to 'trace.json'.
+SUCCESS
+""")
+    assert code == 0
+    with open(cli.abspath("trace.json"), "r") as f:
+        trace = json.load(f)
+    names = [event["name"] for event in trace["traceEvents"]]
+    assert "thread_name" in names
+    assert "ProjectLoader::open" in names
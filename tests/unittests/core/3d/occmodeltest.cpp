@@ -190,6 +190,48 @@ TEST_F(OccModelTest, testBuildAndSaveAssembly) {
   std::unique_ptr<OccModel> outModel = OccModel::loadStep(outContent);
 }
 
+TEST_F(OccModelTest, testAssemblyWithSharedModel) {
+  if (!OccModel::isAvailable()) {
+    GTEST_SKIP();
+  }
+
+  const FilePath modelFp(TEST_DATA_DIR
+                         "/unittests/librepcbcommon/OccModelTest/model.step");
+  const QByteArray content = FileUtils::readFile(modelFp);
+  const FilePath tmpDir = FilePath::getRandomTempPath();
+
+  auto build = [&](bool shared) {
+    std::unique_ptr<OccModel> assembly =
+        OccModel::createAssembly("Test Assembly");
+    std::unique_ptr<OccModel> sharedModel = OccModel::loadStep(content);
+    std::vector<std::unique_ptr<OccModel>> models;
+    for (int i = 0; i < 10; ++i) {
+      if (!shared) {
+        models.push_back(OccModel::loadStep(content));
+      }
+      assembly->addToAssembly(
+          shared ? *sharedModel : *models.back(),
+          std::make_tuple(Length(0), Length(0), Length(0)),
+          std::make_tuple(Angle::deg0(), Angle::deg0(), Angle::deg0()),
+          Transform(Point(Length(i * 1000000), Length(0)), Angle::deg0(),
+                    false),
+          QString("X%1").arg(i + 1));
+    }
+    const FilePath fp = tmpDir.getPathTo(shared ? "shared.step" : "copy.step");
+    assembly->saveAsStep("PCB Assembly", fp);
+    return FileUtils::readFile(fp);
+  };
+
+  // The shared model must be written only once, thus the file is smaller.
+  const QByteArray sharedContent = build(true);
+  const QByteArray copiedContent = build(false);
+  EXPECT_LT(sharedContent.size() * 2, copiedContent.size());
+
+  // Read back.
+  std::unique_ptr<OccModel> outModel = OccModel::loadStep(sharedContent);
+  QDir(tmpDir.toStr()).removeRecursively();
+}
+
 TEST_F(OccModelTest, testTesselate) {
   if (OccModel::isAvailable()) {
     const FilePath fp(TEST_DATA_DIR
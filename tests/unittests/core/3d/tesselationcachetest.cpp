@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/3d/tesselationcache.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/fileio/fileutils.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class TesselationCacheTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+  TesselationCacheTest() : mTmpDir(FilePath::getRandomTempPath()) {}
+  ~TesselationCacheTest() { QDir(mTmpDir.toStr()).removeRecursively(); }
+
+  static TesselationCache::Triangles createTriangles() noexcept {
+    TesselationCache::Triangles triangles;
+    triangles.insert(std::make_tuple(0.1, 0.2, 0.3),
+                     {QVector3D(1, 2, 3), QVector3D(4, 5, 6),
+                      QVector3D(-7.5, 8.25, -9.125)});
+    triangles.insert(std::make_tuple(1.0, 0.0, 0.5), {});
+    return triangles;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(TesselationCacheTest, testSerializeDeserialize) {
+  const TesselationCache::Triangles triangles = createTriangles();
+  const QByteArray data = TesselationCache::serialize(triangles);
+  const std::optional<TesselationCache::Triangles> result =
+      TesselationCache::deserialize(data);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(triangles, *result);
+}
+
+TEST_F(TesselationCacheTest, testDeserializeInvalid) {
+  const QByteArray data = TesselationCache::serialize(createTriangles());
+  EXPECT_FALSE(TesselationCache::deserialize(QByteArray()).has_value());
+  EXPECT_FALSE(TesselationCache::deserialize("foo").has_value());
+  EXPECT_FALSE(TesselationCache::deserialize(data.chopped(1)).has_value());
+  EXPECT_FALSE(TesselationCache::deserialize(data + "x").has_value());
+}
+
+TEST_F(TesselationCacheTest, testReadWrite) {
+  const TesselationCache cache(mTmpDir);
+  const QByteArray step1 = "foo";
+  const QByteArray step2 = "bar";
+  const TesselationCache::Triangles triangles = createTriangles();
+
+  EXPECT_FALSE(cache.read(step1).has_value());
+  cache.write(step1, triangles);
+  EXPECT_EQ(triangles, cache.read(step1));
+  EXPECT_FALSE(cache.read(step2).has_value());
+
+  // A second cache instance must see the same content.
+  EXPECT_EQ(triangles, TesselationCache(mTmpDir).read(step1));
+}
+
+TEST_F(TesselationCacheTest, testReadCorruptFile) {
+  const TesselationCache cache(mTmpDir);
+  const QByteArray step = "foo";
+  cache.write(step, createTriangles());
+  const QList<FilePath> files = FileUtils::getFilesInDirectory(mTmpDir);
+  ASSERT_EQ(1, files.count());
+  FileUtils::writeFile(files.first(), "corrupt");
+  EXPECT_FALSE(cache.read(step).has_value());
+}
+
+TEST_F(TesselationCacheTest, testTesselateInvalid) {
+  const TesselationCache cache(mTmpDir);
+  EXPECT_THROW(cache.tesselate(QByteArray()), Exception);
+  EXPECT_FALSE(mTmpDir.isExistingDir());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
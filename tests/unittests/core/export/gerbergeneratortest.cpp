@@ -234,6 +234,66 @@ TEST_F(GerberGeneratorTest, testDoesNotContainZeroSizeApertures) {
   ASSERT_GE(checkedCircles, 3);  // Sanity check if test works.
 }
 
+// Check if coordinates are formatted correctly, including negative numbers.
+TEST_F(GerberGeneratorTest, testCoordinateFormatting) {
+  GerberGenerator gen(QDateTime(QDate(2000, 2, 1), QTime(1, 2, 3, 4)),
+                      "Project Name", Uuid::createRandom(), "rev-1.0");
+  Path path({Vertex(Point(0, 0)), Vertex(Point(-1234567, 0), Angle::deg90()),
+             Vertex(Point(0, 987654321012))});
+  gen.flashCircle(Point(-1, 2), PositiveLength(100000), std::nullopt,
+                  std::nullopt, QString(), QString(), QString());
+  gen.drawPathOutline(path, UnsignedLength(200000), std::nullopt, std::nullopt,
+                      QString());
+  gen.generate();
+  const QString s = gen.toStr();
+  EXPECT_TRUE(s.contains("\nD10*\nX-1Y2D03*\n")) << qPrintable(s);
+  EXPECT_TRUE(s.contains("\nD11*\nX0Y0D02*\nX-1234567Y0D01*\nG03*\n"))
+      << qPrintable(s);
+  EXPECT_TRUE(s.contains("\nX0Y987654321012I")) << qPrintable(s);
+}
+
+// Check if the MD5 checksum is calculated over the whole output without
+// line breaks.
+TEST_F(GerberGeneratorTest, testMd5Checksum) {
+  QString s = generateEverything();
+  QRegularExpression re("G04 #@! TF\\.MD5,([0-9a-f]{32})\\*\n");
+  QRegularExpressionMatch match = re.match(s);
+  ASSERT_TRUE(match.hasMatch());
+  const QByteArray data =
+      s.left(match.capturedStart()).remove(QChar('\n')).toUtf8();
+  const QByteArray md5 =
+      QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex();
+  EXPECT_EQ(md5.toStdString(), match.captured(1).toStdString());
+}
+
+// Check that identical apertures are not added multiple times.
+TEST_F(GerberGeneratorTest, testApertureReuse) {
+  GerberGenerator gen(QDateTime(QDate(2000, 2, 1), QTime(1, 2, 3, 4)),
+                      "Project Name", Uuid::createRandom(), "rev-1.0");
+  gen.setFileFunctionCopper(1, GerberGenerator::CopperSide::Top,
+                            GerberGenerator::Polarity::Positive);
+
+  const std::optional<QString> net("GND");
+  for (int i = 0; i < 1000; ++i) {
+    const Point p(Length(i * 1000), Length(-i * 500));
+    gen.drawLine(p, p + Point(100000, 0), UnsignedLength(100000 + (i % 50)),
+                 GerberAttribute::ApertureFunction::Conductor, net, QString());
+    gen.flashRect(p, PositiveLength(500000 + (i % 200)),
+                  PositiveLength(300000), UnsignedLength(0), Angle::deg0(),
+                  GerberAttribute::ApertureFunction::SmdPadCopperDefined, net,
+                  "U1", QString::number(i), "GND");
+  }
+  gen.generate();
+
+  int apertures = 0;
+  foreach (const QByteArray& line, gen.toByteArray().split('\n')) {
+    if (line.startsWith("%ADD")) {
+      ++apertures;
+    }
+  }
+  EXPECT_EQ(50 + 200, apertures);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,117 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/application.h>
+#include <librepcb/core/font/strokefont.h>
+#include <librepcb/core/types/alignment.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class StrokeFontTest : public ::testing::Test {
+protected:
+  struct Result {
+    QVector<Path> paths;
+    Point bottomLeft;
+    Point topRight;
+  };
+
+  static Result stroke(const QString& text, const PositiveLength& height,
+                       const Length& letterSpacing, const Length& lineSpacing,
+                       const Alignment& align) {
+    Result r;
+    r.paths = Application::getDefaultStrokeFont().stroke(
+        text, height, letterSpacing, lineSpacing, align, r.bottomLeft,
+        r.topRight);
+    return r;
+  }
+
+  static Result strokeDefault() {
+    return stroke("AB\nCD", PositiveLength(1000000), Length(100000),
+                  Length(1500000), Alignment());
+  }
+
+  static void expectEqual(const Result& a, const Result& b) {
+    EXPECT_EQ(a.paths, b.paths);
+    EXPECT_EQ(a.bottomLeft, b.bottomLeft);
+    EXPECT_EQ(a.topRight, b.topRight);
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(StrokeFontTest, testRepeatedStrokeReturnsSameResult) {
+  const Result first = strokeDefault();
+  EXPECT_FALSE(first.paths.isEmpty());
+  for (int i = 0; i < 3; ++i) {
+    expectEqual(first, strokeDefault());
+  }
+}
+
+TEST_F(StrokeFontTest, testDifferentParametersDoNotCollide) {
+  const Result base = strokeDefault();
+  const Alignment align(HAlign::right(), VAlign::top());
+
+  // Each parameter of the cache key must lead to a different result.
+  const QVector<Result> others = {
+      stroke("AB\nCE", PositiveLength(1000000), Length(100000),
+             Length(1500000), Alignment()),
+      stroke("AB\nCD", PositiveLength(2000000), Length(100000),
+             Length(1500000), Alignment()),
+      stroke("AB\nCD", PositiveLength(1000000), Length(300000),
+             Length(1500000), Alignment()),
+      stroke("AB\nCD", PositiveLength(1000000), Length(100000),
+             Length(2500000), Alignment()),
+      stroke("AB\nCD", PositiveLength(1000000), Length(100000),
+             Length(1500000), align),
+  };
+  for (int i = 0; i < others.count(); ++i) {
+    SCOPED_TRACE(i);
+    EXPECT_FALSE(others.at(i).paths.isEmpty());
+    EXPECT_NE(base.paths, others.at(i).paths);
+  }
+
+  // Querying the same parameters again must still return their own results.
+  expectEqual(base, strokeDefault());
+  expectEqual(others.at(4),
+              stroke("AB\nCD", PositiveLength(1000000), Length(100000),
+                     Length(1500000), align));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
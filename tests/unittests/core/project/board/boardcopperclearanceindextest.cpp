@@ -0,0 +1,164 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/drc/boardcopperclearanceindex.h>
+#include <librepcb/core/project/board/drc/boarddesignrulecheck.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/rulecheck/approvalkey.h>
+#include <librepcb/core/serialization/sexpression.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardCopperClearanceIndexTest : public ::testing::Test {
+protected:
+  static std::unique_ptr<Project> openProject() {
+    FilePath projectFp(TEST_DATA_DIR "/projects/DRC/project.lpp");
+    std::shared_ptr<TransactionalFileSystem> projectFs =
+        TransactionalFileSystem::openRO(projectFp.getParentDir());
+    ProjectLoader loader;
+    return loader.open(std::unique_ptr<TransactionalDirectory>(
+                           new TransactionalDirectory(projectFs)),
+                       projectFp.getFilename());  // can throw
+  }
+
+  static QSet<SExpression> getApprovals(const RuleCheckMessageList& messages,
+                                        const QString& type = QString()) {
+    QSet<SExpression> approvals;
+    for (const auto& msg : messages) {
+      const QString msgType = msg->getApproval().getChild("@0").getValue();
+      if (type.isEmpty() || (msgType == type)) {
+        approvals.insert(msg->getApproval());
+      }
+    }
+    return approvals;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardCopperClearanceIndexTest, testCheckAllMatchesApprovals) {
+  // The DRC test project approves exactly the expected DRC messages (see
+  // BoardDesignRuleCheckTest), so they are used as the reference here.
+  std::unique_ptr<Project> project = openProject();
+  foreach (Board* board, project->getBoards()) {
+    QSet<SExpression> expected;
+    for (const ApprovalKey& approval : board->getDrcMessageApprovals()) {
+      const SExpression& node = approval.getNode();
+      if (node.getChild("@0").getValue() == "copper_clearance_violation") {
+        expected.insert(node);
+      }
+    }
+
+    const BoardDesignRuleCheckData data(*board, board->getDrcSettings(), false);
+    QSet<SExpression> actual;
+    if (BoardCopperClearanceIndex::isCheckEnabled(data)) {
+      const BoardCopperClearanceIndex index(
+          data, BoardDesignRuleCheck::maxArcTolerance());
+      actual = getApprovals(index.checkAll());
+    }
+    EXPECT_EQ(expected, actual) << qPrintable(*board->getName());
+  }
+}
+
+TEST_F(BoardCopperClearanceIndexTest, testCheckSegmentIsSubsetOfCheckAll) {
+  std::unique_ptr<Project> project = openProject();
+  foreach (Board* board, project->getBoards()) {
+    const BoardDesignRuleCheckData data(*board, board->getDrcSettings(), true);
+    const BoardCopperClearanceIndex index(
+        data, BoardDesignRuleCheck::maxArcTolerance());
+    const QSet<SExpression> all = getApprovals(index.checkAll());
+    for (const BoardDesignRuleCheckData::Segment& segment : data.segments) {
+      const QSet<SExpression> approvals =
+          getApprovals(index.checkSegment(segment));
+      EXPECT_TRUE(all.contains(approvals)) << qPrintable(*board->getName());
+    }
+  }
+}
+
+TEST_F(BoardCopperClearanceIndexTest, testCheckSegmentDetectsMovedTrace) {
+  std::unique_ptr<Project> project = openProject();
+  foreach (Board* board, project->getBoards()) {
+    const BoardDesignRuleCheckData data(*board, board->getDrcSettings(), true);
+    const BoardCopperClearanceIndex index(
+        data, BoardDesignRuleCheck::maxArcTolerance());
+    if (!BoardCopperClearanceIndex::isCheckEnabled(data)) {
+      continue;
+    }
+
+    // Place a new trace of a new segment without net exactly over the first
+    // trace of any segment with a net -> must be reported.
+    for (const BoardDesignRuleCheckData::Segment& segment : data.segments) {
+      if (segment.net && (!segment.traces.isEmpty())) {
+        BoardDesignRuleCheckData::Segment newSegment{
+            Uuid::createRandom(),
+            std::nullopt,
+            QString(),
+            std::nullopt,
+            {},
+            {},
+            {},
+            {},
+        };
+        BoardDesignRuleCheckData::Trace trace = segment.traces.first();
+        trace.uuid = Uuid::createRandom();
+        newSegment.traces.append(trace);
+        EXPECT_FALSE(index.checkSegment(newSegment).isEmpty())
+            << qPrintable(*board->getName());
+
+        // When using the existing segment instead, its indexed objects are
+        // ignored so only the violations of the original trace are reported.
+        newSegment.uuid = segment.uuid;
+        newSegment.net = segment.net;
+        newSegment.netClass = segment.netClass;
+        newSegment.traces = {segment.traces.first()};
+        const QSet<SExpression> approvals =
+            getApprovals(index.checkSegment(newSegment));
+        EXPECT_TRUE(getApprovals(index.checkAll()).contains(approvals))
+            << qPrintable(*board->getName());
+        break;
+      }
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -110,10 +110,10 @@ TEST(BoardDesignRuleCheckTest, testMessages) {
 
     // Build expected approvals.
     std::unique_ptr<SExpression> expected = SExpression::createList("node");
-    foreach (const SExpression& node,
+    foreach (const ApprovalKey& approval,
              Toolbox::sortedQSet(board->getDrcMessageApprovals())) {
       expected->ensureLineBreak();
-      expected->appendChild(node);
+      expected->appendChild(approval.getNode());
     }
     expected->ensureLineBreak();
 
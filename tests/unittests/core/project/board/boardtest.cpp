@@ -0,0 +1,202 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionaldirectory.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/boardstroketextdata.h>
+#include <librepcb/core/project/board/items/bi_netline.h>
+#include <librepcb/core/project/board/items/bi_netpoint.h>
+#include <librepcb/core/project/board/items/bi_netsegment.h>
+#include <librepcb/core/project/board/items/bi_stroketext.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/types/layer.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardTest : public ::testing::Test {
+protected:
+  std::unique_ptr<Project> mProject;
+  Board* mBoard;
+  QList<BI_NetPoint*> mNetPoints;
+  QList<BI_NetLine*> mNetLines;
+
+  BoardTest() : mBoard(nullptr) {
+    mProject = Project::create(
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        "project.lpp");
+    mBoard = new Board(
+        *mProject,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        "board", Uuid::createRandom(), ElementName("Board"));
+    mProject->addBoard(*mBoard);
+
+    // Add a trace consisting of three net points and two net lines.
+    BI_NetSegment* segment =
+        new BI_NetSegment(*mBoard, Uuid::createRandom(), nullptr);
+    mBoard->addNetSegment(*segment);
+    for (int i = 0; i < 3; ++i) {
+      mNetPoints.append(new BI_NetPoint(*segment, Uuid::createRandom(),
+                                        Point(i * 1000000, 0)));
+    }
+    for (int i = 0; i < 2; ++i) {
+      mNetLines.append(new BI_NetLine(*segment, Uuid::createRandom(),
+                                      *mNetPoints.at(i), *mNetPoints.at(i + 1),
+                                      Layer::topCopper(),
+                                      PositiveLength(100000)));
+    }
+    segment->addElements({}, {}, mNetPoints, mNetLines);
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardTest, testNetLineUpdatesWithoutBatch) {
+  int updates = 0;
+  BI_NetLine::OnEditedSlot slot(
+      [&updates](const BI_NetLine& obj, BI_NetLine::Event event) {
+        Q_UNUSED(obj);
+        if (event == BI_NetLine::Event::PositionsChanged) ++updates;
+      });
+  mNetLines.first()->onEdited.attach(slot);
+
+  // Each moved anchor notifies the net line immediately.
+  mNetPoints.at(0)->setPosition(Point(0, 1000000));
+  EXPECT_EQ(1, updates);
+  mNetPoints.at(1)->setPosition(Point(1000000, 1000000));
+  EXPECT_EQ(2, updates);
+}
+
+TEST_F(BoardTest, testNotificationsWithBatch) {
+  QHash<const BI_NetLine*, int> updates;
+  BI_NetLine::OnEditedSlot slot(
+      [&updates](const BI_NetLine& obj, BI_NetLine::Event event) {
+        if (event == BI_NetLine::Event::PositionsChanged) ++updates[&obj];
+      });
+  for (BI_NetLine* netLine : mNetLines) {
+    netLine->onEdited.attach(slot);
+  }
+  QHash<const BI_NetPoint*, int> moves;
+  BI_NetPoint::OnEditedSlot netPointSlot(
+      [&moves](const BI_NetPoint& obj, BI_NetPoint::Event event) {
+        if (event == BI_NetPoint::Event::PositionChanged) ++moves[&obj];
+      });
+  for (BI_NetPoint* netPoint : mNetPoints) {
+    netPoint->onEdited.attach(netPointSlot);
+  }
+  int finishedCount = 0;
+  std::pair<Point, Point> finishedRegion;
+  QObject::connect(mBoard, &Board::batchUpdateFinished,
+                   [&](const std::pair<Point, Point>& region,
+                       const QSet<NetSignal*>& netSignals) {
+                     Q_UNUSED(netSignals);
+                     ++finishedCount;
+                     finishedRegion = region;
+                   });
+
+  // Nested batch updates, each item must be notified only once at the very
+  // end, even though all net points have been moved (twice).
+  mBoard->beginBatchUpdate();
+  mBoard->beginBatchUpdate();
+  EXPECT_TRUE(mBoard->isBatchUpdateActive());
+  for (BI_NetPoint* netPoint : mNetPoints) {
+    netPoint->setPosition(netPoint->getPosition() + Point(0, 1000000));
+  }
+  mBoard->endBatchUpdate();
+  EXPECT_TRUE(mBoard->isBatchUpdateActive());
+  for (BI_NetPoint* netPoint : mNetPoints) {
+    netPoint->setPosition(netPoint->getPosition() + Point(0, 1000000));
+  }
+  EXPECT_TRUE(updates.isEmpty());
+  EXPECT_TRUE(moves.isEmpty());
+  EXPECT_EQ(0, finishedCount);
+  mBoard->endBatchUpdate();
+  EXPECT_FALSE(mBoard->isBatchUpdateActive());
+  EXPECT_EQ(1, updates.value(mNetLines.at(0)));
+  EXPECT_EQ(1, updates.value(mNetLines.at(1)));
+  for (BI_NetPoint* netPoint : mNetPoints) {
+    EXPECT_EQ(1, moves.value(netPoint));
+  }
+  EXPECT_EQ(1, finishedCount);
+
+  // The region must contain the old and new net line outlines.
+  EXPECT_NEAR(-50000, finishedRegion.first.getX().toNm(), 100);
+  EXPECT_NEAR(-50000, finishedRegion.first.getY().toNm(), 100);
+  EXPECT_NEAR(2050000, finishedRegion.second.getX().toNm(), 100);
+  EXPECT_NEAR(2050000, finishedRegion.second.getY().toNm(), 100);
+
+  // An empty batch update must not emit any change.
+  mBoard->beginBatchUpdate();
+  mBoard->endBatchUpdate();
+  EXPECT_EQ(1, finishedCount);
+
+  // Setting the same position again must neither.
+  mBoard->beginBatchUpdate();
+  mNetPoints.first()->setPosition(mNetPoints.first()->getPosition());
+  mBoard->endBatchUpdate();
+  EXPECT_EQ(1, finishedCount);
+  EXPECT_EQ(1, moves.value(mNetPoints.first()));
+}
+
+TEST_F(BoardTest, testStrokeTextSubstitution) {
+  auto createText = [this](const QString& text) {
+    BI_StrokeText* item = new BI_StrokeText(
+        *mBoard,
+        BoardStrokeTextData(Uuid::createRandom(), Layer::boardDocumentation(),
+                            text, Point(0, 0), Angle::deg0(),
+                            PositiveLength(1000000), UnsignedLength(100000),
+                            StrokeTextSpacing(), StrokeTextSpacing(),
+                            Alignment(), false, false, false));
+    mBoard->addStrokeText(*item);
+    return item;
+  };
+
+  // Texts without "{{" must be rendered unchanged, even if they look similar
+  // to attributes.
+  const QString plain = "{BOARD}} $BOARD {BOARD} }}BOARD{";
+  BI_StrokeText* plainText = createText(plain);
+  EXPECT_EQ(plain, plainText->getSubstitutedText());
+  EXPECT_FALSE(plainText->getPaths().isEmpty());
+
+  // Texts with "{{" must still be substituted.
+  BI_StrokeText* varText = createText("{{BOARD}}");
+  EXPECT_EQ("Board", varText->getSubstitutedText());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
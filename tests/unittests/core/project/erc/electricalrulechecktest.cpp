@@ -0,0 +1,246 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/project/circuit/circuit.h>
+#include <librepcb/core/project/circuit/netclass.h>
+#include <librepcb/core/project/circuit/netsignal.h>
+#include <librepcb/core/project/erc/electricalrulecheck.h>
+#include <librepcb/core/project/erc/electricalrulecheckmessages.h>
+#include <librepcb/core/project/erc/electricalrulechecktracker.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/schematic/schematic.h>
+#include <librepcb/core/project/syntheticprojectgenerator.h>
+#include <librepcb/core/serialization/sexpression.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ElectricalRuleCheckTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+  std::unique_ptr<Project> mProject;
+
+  ElectricalRuleCheckTest() : mTmpDir(FilePath::getRandomTempPath()) {
+    // Two components with two pins each, distributed over more nets than
+    // pins, so there are always some open nets.
+    SyntheticProjectGenerator::Options options;
+    options.componentCount = 2;
+    options.netCount = 6;
+    options.schematicCount = 1;
+    options.planeCount = 0;
+    options.tracePercent = 0;
+    mProject = SyntheticProjectGenerator(options, 42).generate(
+        mTmpDir.getPathTo("project.lpp"));
+  }
+
+  ~ElectricalRuleCheckTest() {
+    mProject.reset();
+    QDir(mTmpDir.toStr()).removeRecursively();
+  }
+
+  NetSignal& addUnusedNet(const QString& name) {
+    Circuit& circuit = mProject->getCircuit();
+    NetSignal* net = new NetSignal(circuit, Uuid::createRandom(),
+                                   *circuit.getNetClasses().first(),
+                                   CircuitIdentifier(name), false);
+    circuit.addNetSignal(*net);
+    return *net;
+  }
+
+  static RuleCheckMessageList getMessages(const RuleCheckMessageList& messages,
+                                          const QString& type) {
+    RuleCheckMessageList result;
+    for (const auto& msg : messages) {
+      if (msg->getApproval().getChild("@0").getValue() == type) {
+        result.append(msg);
+      }
+    }
+    return result;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ElectricalRuleCheckTest, testSnapshot) {
+  const ElectricalRuleCheckData data(*mProject);
+  const Uuid schematicUuid = mProject->getSchematics().first()->getUuid();
+
+  ASSERT_EQ(2, data.components.count());
+  for (const ElectricalRuleCheckData::Component& cmp : data.components) {
+    ASSERT_TRUE(cmp.symbol.has_value());
+    EXPECT_EQ(schematicUuid, cmp.symbol->schematic);
+    ASSERT_EQ(2, cmp.componentSignals.count());
+    for (const ElectricalRuleCheckData::ComponentSignal& sig :
+         cmp.componentSignals) {
+      EXPECT_TRUE(sig.net.has_value());
+      ASSERT_TRUE(sig.pin.has_value());
+      EXPECT_EQ(schematicUuid, sig.pin->schematic);
+      EXPECT_NE(cmp.symbol->position, sig.pin->position);
+    }
+  }
+
+  ASSERT_EQ(6, data.netSignals.count());
+  int componentSignals = 0;
+  for (const ElectricalRuleCheckData::NetSignal& net : data.netSignals) {
+    componentSignals += net.realComponentSignals;
+  }
+  EXPECT_EQ(4, componentSignals);
+
+  ASSERT_EQ(1, data.schematics.count());
+  EXPECT_EQ(2, data.schematics.first().symbols.count());
+  EXPECT_EQ(4, data.schematics.first().netSegments.count());
+  for (const ElectricalRuleCheckData::NetSegment& seg :
+       data.schematics.first().netSegments) {
+    EXPECT_EQ(schematicUuid, seg.schematic);
+    EXPECT_TRUE(seg.hasNetLabels);
+    EXPECT_EQ(1, seg.netLines.count());
+  }
+}
+
+TEST_F(ElectricalRuleCheckTest, testOpenNetLocations) {
+  const ElectricalRuleCheckData data(*mProject);
+  ElectricalRuleCheck erc;
+  const RuleCheckMessageList messages =
+      getMessages(erc.runChecks(data), "open_net");
+
+  QHash<Uuid, ElectricalRuleCheckData::NetSignal> openNets;
+  for (const ElectricalRuleCheckData::NetSignal& net : data.netSignals) {
+    if (net.realComponentSignals < 2) {
+      openNets.insert(net.uuid, net);
+    }
+  }
+  ASSERT_GT(openNets.count(), 0);
+  ASSERT_EQ(openNets.count(), messages.count());
+
+  // Locations are only built for the nets causing a message, from their
+  // wires if there are any.
+  for (const auto& msg : messages) {
+    const auto ercMsg = std::dynamic_pointer_cast<const ErcMsgBase>(msg);
+    ASSERT_TRUE(ercMsg);
+    const Uuid uuid = deserialize<Uuid>(msg->getApproval().getChild("net/@0"));
+    ASSERT_TRUE(openNets.contains(uuid));
+    if (openNets[uuid].realComponentSignals > 0) {
+      EXPECT_EQ(mProject->getSchematics().first()->getUuid(),
+                ercMsg->getSchematic());
+      EXPECT_EQ(1, msg->getLocations().count());
+    } else {
+      EXPECT_EQ(std::nullopt, ercMsg->getSchematic());
+      EXPECT_EQ(0, msg->getLocations().count());
+    }
+  }
+}
+
+TEST_F(ElectricalRuleCheckTest, testTracker) {
+  ElectricalRuleCheckTracker tracker(*mProject);
+  EXPECT_TRUE(tracker.getChanges().isEmpty());
+
+  const NetSignal& net = addUnusedNet("NEW");
+  EXPECT_EQ(QSet<Uuid>{net.getUuid()}, tracker.getChanges().netSignals);
+  EXPECT_TRUE(tracker.getChanges().components.isEmpty());
+  EXPECT_TRUE(tracker.getChanges().schematics.isEmpty());
+
+  const ElectricalRuleCheckData::Changes changes = tracker.takeChanges();
+  EXPECT_EQ(QSet<Uuid>{net.getUuid()}, changes.netSignals);
+  EXPECT_TRUE(tracker.getChanges().isEmpty());
+}
+
+TEST_F(ElectricalRuleCheckTest, testIncrementalSnapshot) {
+  ElectricalRuleCheckTracker tracker(*mProject);
+  const ElectricalRuleCheckData base(*mProject);
+  EXPECT_EQ(std::nullopt, base.baseId);
+
+  const NetSignal& net = addUnusedNet("NEW");
+  const ElectricalRuleCheckData data(*mProject, base, tracker.takeChanges());
+  EXPECT_NE(base.id, data.id);
+  EXPECT_EQ(base.id, data.baseId);
+  EXPECT_EQ(QSet<Uuid>{net.getUuid()}, data.changes.netSignals);
+  ASSERT_EQ(base.netSignals.count() + 1, data.netSignals.count());
+  int newNets = 0;
+  for (const ElectricalRuleCheckData::NetSignal& item : data.netSignals) {
+    if (item.uuid == net.getUuid()) {
+      EXPECT_EQ("NEW", item.name);
+      EXPECT_EQ(0, item.realComponentSignals);
+      ++newNets;
+    }
+  }
+  EXPECT_EQ(1, newNets);
+  EXPECT_EQ(base.components.count(), data.components.count());
+  EXPECT_EQ(base.schematics.count(), data.schematics.count());
+}
+
+TEST_F(ElectricalRuleCheckTest, testIncrementalChecks) {
+  ElectricalRuleCheckTracker tracker(*mProject);
+  const ElectricalRuleCheckData base(*mProject);
+  ElectricalRuleCheck erc;
+  const RuleCheckMessageList messages1 = erc.runChecks(base);
+
+  addUnusedNet("NEW");
+  const ElectricalRuleCheckData data(*mProject, base, tracker.takeChanges());
+  const RuleCheckMessageList messages2 = erc.runChecks(data);
+  EXPECT_EQ(messages1.count() + 1, messages2.count());
+
+  // The result must be the same as if all items were checked.
+  const RuleCheckMessageList messages3 =
+      ElectricalRuleCheck().runChecks(ElectricalRuleCheckData(*mProject));
+  EXPECT_EQ(messages3.count(), messages2.count());
+
+  // The messages of the unmodified nets are re-used.
+  for (const auto& msg : getMessages(messages1, "open_net")) {
+    EXPECT_TRUE(messages2.contains(msg));
+  }
+}
+
+TEST_F(ElectricalRuleCheckTest, testIncrementalChecksWithOtherBase) {
+  ElectricalRuleCheck erc;
+  const RuleCheckMessageList messages1 =
+      erc.runChecks(ElectricalRuleCheckData(*mProject));
+
+  // If the changes refer to another snapshot than the one of the last run,
+  // all items are checked again.
+  const ElectricalRuleCheckData base(*mProject);
+  const ElectricalRuleCheckData data(*mProject, base,
+                                     ElectricalRuleCheckData::Changes());
+  const RuleCheckMessageList messages2 = erc.runChecks(data);
+  EXPECT_EQ(messages1.count(), messages2.count());
+  for (const auto& msg : messages1) {
+    EXPECT_FALSE(messages2.contains(msg));
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
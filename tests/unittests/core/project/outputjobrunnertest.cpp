@@ -24,6 +24,7 @@
 #include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/fileio/transactionaldirectory.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/job/archiveoutputjob.h>
 #include <librepcb/core/job/bomoutputjob.h>
 #include <librepcb/core/job/copyoutputjob.h>
 #include <librepcb/core/job/gerberexcellonoutputjob.h>
@@ -121,6 +122,107 @@ TEST_F(OutputJobRunnerTest, testGerberExcellonRebuildsPlanes) {
   EXPECT_TRUE(content.contains("\nG37*\n"));
 }
 
+// Planes must also be rebuilt if jobs are run concurrently, and dependencies
+// between jobs must be respected.
+TEST_F(OutputJobRunnerTest, testConcurrentJobs) {
+  std::unique_ptr<Project> project = createProject();
+  QPointer<Board> board = createBoard(*project).release();
+  board->addPolygon(*createBoardOutline(*board).release());
+  QPointer<BI_Plane> plane = createPlane(*board).release();
+  board->addPlane(*plane);
+  project->addBoard(*board);
+
+  QVector<std::shared_ptr<OutputJob>> jobs;
+  std::shared_ptr<GerberExcellonOutputJob> gerberJob =
+      GerberExcellonOutputJob::protelStyle();
+  jobs.append(gerberJob);
+  QMap<Uuid, QString> archiveInputs = {{gerberJob->getUuid(), "gerber"}};
+  for (int i = 0; i < 8; ++i) {
+    std::shared_ptr<BomOutputJob> job = std::make_shared<BomOutputJob>();
+    job->setOutputPath(QString("bom%1.csv").arg(i));
+    jobs.append(job);
+    archiveInputs.insert(job->getUuid(), "bom");
+  }
+  std::shared_ptr<ArchiveOutputJob> archiveJob =
+      std::make_shared<ArchiveOutputJob>();
+  archiveJob->setInputJobs(archiveInputs);
+  archiveJob->setOutputPath("archive.zip");
+  jobs.append(archiveJob);
+
+  OutputJobRunner runner(*project);
+  runner.setOutputDirectory(mOutDir);
+  runner.setMaxConcurrentJobs(4);
+  QList<Uuid> startedJobs;
+  QObject::connect(&runner, &OutputJobRunner::jobStarted,
+                   [&](std::shared_ptr<const OutputJob> job) {
+                     startedJobs.append(job->getUuid());
+                   });
+  runner.run(jobs);
+
+  EXPECT_GT(plane->getFragments().count(), 0);
+  EXPECT_EQ(jobs.count(), startedJobs.count());
+  EXPECT_EQ(archiveJob->getUuid(), startedJobs.value(jobs.count() - 1));
+  EXPECT_TRUE(mOutDir.getPathTo("gerber/Unnamed_v1.g1").isExistingFile());
+  for (int i = 0; i < 8; ++i) {
+    const FilePath fp = mOutDir.getPathTo(QString("bom%1.csv").arg(i));
+    EXPECT_TRUE(fp.isExistingFile());
+  }
+  EXPECT_TRUE(mOutDir.getPathTo("archive.zip").isExistingFile());
+}
+
+// Errors must be reported also if jobs are run concurrently.
+TEST_F(OutputJobRunnerTest, testConcurrentJobsError) {
+  std::unique_ptr<Project> project = createProject();
+
+  QVector<std::shared_ptr<OutputJob>> jobs;
+  for (int i = 0; i < 4; ++i) {
+    std::shared_ptr<BomOutputJob> job = std::make_shared<BomOutputJob>();
+    job->setOutputPath((i == 2) ? QString("../bom.csv")
+                                : QString("bom%1.csv").arg(i));
+    jobs.append(job);
+  }
+
+  OutputJobRunner runner(*project);
+  runner.setOutputDirectory(mOutDir);
+  runner.setMaxConcurrentJobs(4);
+  EXPECT_THROW(runner.run(jobs), Exception);
+  EXPECT_FALSE(mOutDir.getPathTo("../bom.csv").isExistingFile());
+}
+
+// Jobs shall only be skipped if neither the inputs nor the outputs changed.
+TEST_F(OutputJobRunnerTest, testSkipUnchangedJobs) {
+  std::unique_ptr<Project> project = createProject();
+  std::shared_ptr<BomOutputJob> job = std::make_shared<BomOutputJob>();
+  job->setOutputPath("bom.csv");
+  const FilePath fp = mOutDir.getPathTo("bom.csv");
+
+  auto run = [&](bool skip) {
+    OutputJobRunner runner(*project);
+    runner.setOutputDirectory(mOutDir);
+    runner.setSkipUnchangedJobs(skip);
+    int skipped = 0;
+    QObject::connect(&runner, &OutputJobRunner::jobSkipped,
+                     [&](std::shared_ptr<const OutputJob>) { ++skipped; });
+    runner.run({job});
+    EXPECT_TRUE(fp.isExistingFile());
+    return skipped > 0;
+  };
+
+  EXPECT_FALSE(run(true));  // First run.
+  EXPECT_TRUE(run(true));  // Nothing changed.
+  EXPECT_FALSE(run(false));  // Skipping disabled.
+  EXPECT_TRUE(run(true));  // Nothing changed.
+  FileUtils::removeFile(fp);
+  EXPECT_FALSE(run(true));  // Output file removed.
+  EXPECT_TRUE(run(true));  // Nothing changed.
+  job->setCustomAttributes({"FOO"});
+  EXPECT_FALSE(run(true));  // Job modified.
+  EXPECT_TRUE(run(true));  // Nothing changed.
+  project->getDirectory().write("foo.txt", "foo");
+  EXPECT_FALSE(run(true));  // Project files modified.
+  EXPECT_TRUE(run(true));  // Nothing changed.
+}
+
 // Very important: For portability reasons, no absolute file paths are allowed!
 TEST_F(OutputJobRunnerTest, testAbsoluteOutputFilePath) {
   std::unique_ptr<Project> project = createProject();
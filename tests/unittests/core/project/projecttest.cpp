@@ -22,11 +22,17 @@
  ******************************************************************************/
 #include <gtest/gtest.h>
 #include <librepcb/core/application.h>
+#include <librepcb/core/exceptions.h>
 #include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionaldirectory.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/job/graphicsoutputjob.h>
+#include <librepcb/core/library/sym/symbol.h>
+#include <librepcb/core/project/board/board.h>
 #include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectlibrary.h>
 #include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/project/schematic/schematic.h>
 
 #include <QtCore>
 
@@ -241,6 +247,136 @@ TEST_F(ProjectTest, testSave) {
   }
 }
 
+TEST_F(ProjectTest, testOpenManyFiles) {
+  // Create a project with many files to be loaded concurrently.
+  {
+    std::unique_ptr<Project> project =
+        Project::create(createDir(), mProjectFile.getFilename());
+    for (int i = 0; i < 20; ++i) {
+      project->getLibrary().addSymbol(*new Symbol(
+          Uuid::createRandom(), Version::fromString("0.1"), "",
+          ElementName(QString("Symbol %1").arg(i)), "", ""));
+      project->addSchematic(*new Schematic(
+          *project,
+          std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+          QString("schematic%1").arg(i), Uuid::createRandom(),
+          ElementName(QString("Schematic %1").arg(i))));
+      project->addBoard(*new Board(
+          *project,
+          std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+          QString("board%1").arg(i), Uuid::createRandom(),
+          ElementName(QString("Board %1").arg(i))));
+    }
+    project->save();
+    project->getDirectory().getFileSystem()->save();
+  }
+
+  // Open the project and check that everything was loaded in correct order.
+  ProjectLoader loader;
+  std::unique_ptr<Project> project =
+      loader.open(createDir(), mProjectFile.getFilename());
+  EXPECT_EQ(20, project->getLibrary().getSymbols().count());
+  ASSERT_EQ(20, project->getSchematics().count());
+  ASSERT_EQ(20, project->getBoards().count());
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(QString("Schematic %1").arg(i),
+              *project->getSchematics().at(i)->getName());
+    EXPECT_EQ(QString("Board %1").arg(i),
+              *project->getBoards().at(i)->getName());
+  }
+  foreach (const Symbol* symbol, project->getLibrary().getSymbols()) {
+    EXPECT_EQ(QThread::currentThread(), symbol->thread());
+  }
+  EXPECT_FALSE(loader.getTimings().isEmpty());
+}
+
+TEST_F(ProjectTest, testOpenInvalidBoard) {
+  {
+    std::unique_ptr<Project> project =
+        Project::create(createDir(), mProjectFile.getFilename());
+    project->addBoard(*new Board(
+        *project,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        "board", Uuid::createRandom(), ElementName("Board")));
+    project->save();
+    project->getDirectory().getFileSystem()->save();
+  }
+
+  // Errors while parsing in worker threads must be reported.
+  FileUtils::writeFile(mProjectDir.getPathTo("boards/board/board.lp"),
+                       "(librepcb_board");
+  ProjectLoader loader;
+  EXPECT_THROW(loader.open(createDir(), mProjectFile.getFilename()),
+               Exception);
+}
+
+TEST_F(ProjectTest, testLazyLoading) {
+  {
+    std::unique_ptr<Project> project =
+        Project::create(createDir(), mProjectFile.getFilename());
+    project->addSchematic(*new Schematic(
+        *project,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        "schematic", Uuid::createRandom(), ElementName("Schematic")));
+    project->addBoard(*new Board(
+        *project,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        "board", Uuid::createRandom(), ElementName("Board")));
+    project->save();
+    project->getDirectory().getFileSystem()->save();
+  }
+
+  // Schematics and boards are loaded on first access.
+  ProjectLoader loader;
+  loader.setLazyLoading(true);
+  std::unique_ptr<Project> project =
+      loader.open(createDir(), mProjectFile.getFilename());
+  EXPECT_EQ(1, project->getSchematics().count());
+  EXPECT_EQ("Board", *project->getBoardByIndex(0)->getName());
+  EXPECT_EQ(project->getBoards().first(), project->getPrimaryBoard().data());
+  EXPECT_TRUE(project->getLazyLoadingErrors().isEmpty());
+
+  // Saving must not lose anything.
+  project->save();
+  project->getDirectory().getFileSystem()->save();
+  project.reset();
+  project = loader.open(createDir(), mProjectFile.getFilename());
+  project->save();
+  project->getDirectory().getFileSystem()->save();
+  project.reset();
+  loader.setLazyLoading(false);
+  project = loader.open(createDir(), mProjectFile.getFilename());
+  EXPECT_EQ(1, project->getSchematics().count());
+  EXPECT_EQ(1, project->getBoards().count());
+}
+
+TEST_F(ProjectTest, testLazyLoadingInvalidBoard) {
+  {
+    std::unique_ptr<Project> project =
+        Project::create(createDir(), mProjectFile.getFilename());
+    project->addBoard(*new Board(
+        *project,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        "board", Uuid::createRandom(), ElementName("Board")));
+    project->save();
+    project->getDirectory().getFileSystem()->save();
+  }
+  FileUtils::writeFile(mProjectDir.getPathTo("boards/board/board.lp"),
+                       "(librepcb_board");
+
+  // Opening succeeds, but the error is reported on first access.
+  ProjectLoader loader;
+  loader.setLazyLoading(true);
+  std::unique_ptr<Project> project =
+      loader.open(createDir(), mProjectFile.getFilename());
+  EXPECT_EQ(0, project->getSchematics().count());
+  EXPECT_TRUE(project->getLazyLoadingErrors().isEmpty());
+  EXPECT_THROW(project->loadPendingBoards(), Exception);
+  EXPECT_EQ(1, project->getLazyLoadingErrors().count());
+  EXPECT_EQ(0, project->getBoards().count());
+  EXPECT_THROW(project->save(), Exception);
+}
+
 TEST_F(ProjectTest, testIfDateTimeIsUpdatedOnSave) {
   // create new project
   std::unique_ptr<Project> project =
@@ -0,0 +1,186 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionaldirectory.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/items/bi_netsegment.h>
+#include <librepcb/core/project/circuit/circuit.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/project/schematic/items/si_netsegment.h>
+#include <librepcb/core/project/schematic/schematic.h>
+#include <librepcb/core/project/syntheticprojectgenerator.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SyntheticProjectGeneratorTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+
+  SyntheticProjectGeneratorTest() : mTmpDir(FilePath::getRandomTempPath()) {}
+  ~SyntheticProjectGeneratorTest() {
+    QDir(mTmpDir.toStr()).removeRecursively();
+  }
+
+  FilePath getProjectFile(const QString& dirName) const noexcept {
+    return mTmpDir.getPathTo(dirName).getPathTo("project.lpp");
+  }
+
+  static SyntheticProjectGenerator::Options createOptions() noexcept {
+    SyntheticProjectGenerator::Options options;
+    options.componentCount = 20;
+    options.netCount = 8;
+    options.innerLayerCount = 2;
+    options.schematicCount = 3;
+    options.planeCount = 3;
+    options.tracePercent = 100;
+    options.viaPercent = 50;
+    return options;
+  }
+
+  static QByteArray readFile(const FilePath& projectFile,
+                             const QString& path) {
+    return FileUtils::readFile(projectFile.getParentDir().getPathTo(path));
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SyntheticProjectGeneratorTest, testGenerateAndReload) {
+  const FilePath fp = getProjectFile("project");
+  SyntheticProjectGenerator generator(createOptions(), 42);
+  generator.generate(fp);
+  const SyntheticProjectGenerator::Statistics& stats =
+      generator.getStatistics();
+  EXPECT_EQ(20, stats.components);
+  EXPECT_EQ(8, stats.nets);
+  EXPECT_EQ(3, stats.schematics);
+  EXPECT_EQ(40, stats.netLabels);
+  EXPECT_EQ(3, stats.planes);
+  EXPECT_GT(stats.traces, 0);
+  EXPECT_GT(stats.vias, 0);
+
+  // Reload the project to make sure the generated files are valid.
+  ProjectLoader loader;
+  std::unique_ptr<Project> project = loader.open(
+      std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+          TransactionalFileSystem::openRO(fp.getParentDir()))),
+      fp.getFilename());
+  EXPECT_EQ(20, project->getCircuit().getComponentInstances().count());
+  EXPECT_EQ(8, project->getCircuit().getNetSignals().count());
+  ASSERT_EQ(3, project->getSchematics().count());
+  int netLabels = 0;
+  for (const Schematic* schematic : project->getSchematics()) {
+    for (const SI_NetSegment* segment : schematic->getNetSegments()) {
+      netLabels += segment->getNetLabels().count();
+    }
+  }
+  EXPECT_EQ(stats.netLabels, netLabels);
+  ASSERT_EQ(1, project->getBoards().count());
+  const Board& board = *project->getBoards().first();
+  EXPECT_EQ(2, board.getInnerLayerCount());
+  EXPECT_EQ(20, board.getDeviceInstances().count());
+  EXPECT_EQ(3, board.getPlanes().count());
+  int traces = 0;
+  int vias = 0;
+  for (const BI_NetSegment* segment : board.getNetSegments()) {
+    traces += segment->getNetLines().count();
+    vias += segment->getVias().count();
+  }
+  EXPECT_EQ(stats.traces, traces);
+  EXPECT_EQ(stats.vias, vias);
+}
+
+TEST_F(SyntheticProjectGeneratorTest, testWithoutTraces) {
+  SyntheticProjectGenerator::Options options = createOptions();
+  options.tracePercent = 0;
+  SyntheticProjectGenerator generator(options, 42);
+  std::unique_ptr<Project> project = generator.generate(getProjectFile("p"));
+  EXPECT_EQ(0, generator.getStatistics().traces);
+  EXPECT_EQ(0, generator.getStatistics().vias);
+  EXPECT_EQ(0, project->getBoards().first()->getNetSegments().count());
+}
+
+TEST_F(SyntheticProjectGeneratorTest, testSameSeedIsDeterministic) {
+  const FilePath fp1 = getProjectFile("project1");
+  const FilePath fp2 = getProjectFile("project2");
+  SyntheticProjectGenerator(createOptions(), 42).generate(fp1);
+  SyntheticProjectGenerator(createOptions(), 42).generate(fp2);
+  for (const QString& path : {"boards/default/board.lp",
+                              "schematics/sheet_1/schematic.lp",
+                              "schematics/sheet_3/schematic.lp"}) {
+    EXPECT_EQ(readFile(fp1, path).toStdString(),
+              readFile(fp2, path).toStdString())
+        << qPrintable(path);
+  }
+}
+
+TEST_F(SyntheticProjectGeneratorTest, testDifferentSeedsDiffer) {
+  const FilePath fp1 = getProjectFile("project1");
+  const FilePath fp2 = getProjectFile("project2");
+  SyntheticProjectGenerator(createOptions(), 1).generate(fp1);
+  SyntheticProjectGenerator(createOptions(), 2).generate(fp2);
+  const QString path = "boards/default/board.lp";
+  EXPECT_NE(readFile(fp1, path), readFile(fp2, path));
+}
+
+TEST_F(SyntheticProjectGeneratorTest, testInvalidOptions) {
+  auto generate = [this](SyntheticProjectGenerator::Options options) {
+    SyntheticProjectGenerator(options).generate(getProjectFile("project"));
+  };
+  SyntheticProjectGenerator::Options options = createOptions();
+  options.netCount = 0;
+  EXPECT_THROW(generate(options), RuntimeError);
+  options = createOptions();
+  options.schematicCount = 0;
+  EXPECT_THROW(generate(options), RuntimeError);
+  options = createOptions();
+  options.innerLayerCount = -1;
+  EXPECT_THROW(generate(options), RuntimeError);
+  options = createOptions();
+  options.viaPercent = 101;
+  EXPECT_THROW(generate(options), RuntimeError);
+  EXPECT_FALSE(mTmpDir.isExistingDir());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,110 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/rulecheck/approvalkey.h>
+#include <librepcb/core/types/uuid.h>
+#include <librepcb/core/utils/toolbox.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ApprovalKeyTest : public ::testing::Test {
+protected:
+  static std::unique_ptr<SExpression> createApproval(
+      const QString& type, const QString& uuid) {
+    std::unique_ptr<SExpression> node = SExpression::createList("approved");
+    node->appendChild(SExpression::createToken(type));
+    node->ensureLineBreak();
+    SExpression& child = node->appendList("device");
+    child.appendChild(SExpression::createToken(uuid));
+    node->ensureLineBreak();
+    return node;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ApprovalKeyTest, testEqual) {
+  const QString uuid = Uuid::createRandom().toStr();
+  const ApprovalKey key1(*createApproval("foo", uuid));
+  const ApprovalKey key2(*createApproval("foo", uuid));
+  EXPECT_TRUE(key1 == key2);
+  EXPECT_FALSE(key1 != key2);
+  EXPECT_EQ(qHash(key1), qHash(key2));
+  EXPECT_EQ(key1.getNode(), key2.getNode());
+}
+
+TEST_F(ApprovalKeyTest, testNotEqual) {
+  const QString uuid = Uuid::createRandom().toStr();
+  const ApprovalKey key(*createApproval("foo", uuid));
+  EXPECT_NE(key, ApprovalKey(*createApproval("bar", uuid)));
+  EXPECT_NE(key, ApprovalKey(*createApproval("foo", "x")));
+
+  // Node types and structure must be taken into account.
+  std::unique_ptr<SExpression> node = createApproval("foo", uuid);
+  node->getChild(0) = *SExpression::createString("foo");
+  EXPECT_NE(key, ApprovalKey(*node));
+  node = createApproval("foo", uuid);
+  node->ensureLineBreak();
+  node->appendChild(SExpression::createToken("x"));
+  EXPECT_NE(key, ApprovalKey(*node));
+}
+
+TEST_F(ApprovalKeyTest, testCopy) {
+  const ApprovalKey key(*createApproval("foo", "bar"));
+  ApprovalKey copy(*createApproval("bar", "foo"));
+  copy = key;
+  EXPECT_EQ(key, copy);
+  EXPECT_EQ(key.getNode(), copy.getNode());
+}
+
+TEST_F(ApprovalKeyTest, testSort) {
+  QSet<ApprovalKey> set = {
+      ApprovalKey(*createApproval("b", "1")),
+      ApprovalKey(*createApproval("a", "2")),
+      ApprovalKey(*createApproval("a", "1")),
+  };
+  const QList<ApprovalKey> sorted = Toolbox::sortedQSet(set);
+  ASSERT_EQ(3, sorted.count());
+  EXPECT_EQ(*createApproval("a", "1"), sorted.at(0).getNode());
+  EXPECT_EQ(*createApproval("a", "2"), sorted.at(1).getNode());
+  EXPECT_EQ(*createApproval("b", "1"), sorted.at(2).getNode());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -145,6 +145,26 @@ TEST_P(UuidTest, testOperatorComparisons) {
   }
 }
 
+TEST_P(UuidTest, testHash) {
+  const UuidTestData& data = GetParam();
+
+  if (data.valid) {
+    const Uuid uuid1 = Uuid::fromString(data.uuid);
+    const Uuid uuid2 = Uuid::fromString(data.uuid);
+    const Uuid uuid3 =
+        Uuid::fromString("d2c30518-5cd1-4ce9-a569-44f783a3f66a");  // valid UUID
+    EXPECT_EQ(qHash(uuid1), qHash(uuid2));
+    EXPECT_EQ(qHash(uuid1, 42), qHash(uuid2, 42));
+    EXPECT_NE(qHash(uuid1), qHash(uuid3));
+    EXPECT_EQ(qHash(uuid1), qHash(std::make_optional(uuid2)));
+  }
+}
+
+TEST(UuidTest, testSize) {
+  // Make sure UUIDs are stored compactly as they are used everywhere.
+  EXPECT_EQ(16U, sizeof(Uuid));
+}
+
 TEST(UuidTest, testCreateRandom) {
   for (int i = 0; i < 1000; i++) {
     Uuid uuid = Uuid::createRandom();
@@ -0,0 +1,154 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/utils/taskscheduler.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class TaskSchedulerTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(TaskSchedulerTest, testResult) {
+  TaskScheduler scheduler(2);
+  QFuture<int> future = scheduler.run(TaskScheduler::Group::Default,
+                                      TaskScheduler::Priority::Normal,
+                                      []() { return 42; });
+  scheduler.waitForFinished(future);
+  ASSERT_EQ(1, future.resultCount());
+  EXPECT_EQ(42, future.result());
+}
+
+TEST_F(TaskSchedulerTest, testException) {
+  TaskScheduler scheduler(2);
+  QFuture<void> future =
+      scheduler.run(TaskScheduler::Group::Default,
+                    TaskScheduler::Priority::Normal, []() {
+                      throw RuntimeError(__FILE__, __LINE__, "foo");
+                    });
+  EXPECT_THROW(scheduler.waitForFinished(future), RuntimeError);
+}
+
+TEST_F(TaskSchedulerTest, testCancelledTokenSkipsTask) {
+  TaskScheduler scheduler(2);
+  CancellationToken token;
+  token.cancel();
+  std::atomic<bool> executed(false);
+  QFuture<void> future = scheduler.run(
+      TaskScheduler::Group::Default, TaskScheduler::Priority::Normal,
+      [&executed]() { executed = true; }, token);
+  scheduler.waitForFinished(future);
+  EXPECT_TRUE(future.isCanceled());
+  EXPECT_FALSE(executed.load());
+}
+
+TEST_F(TaskSchedulerTest, testPriorityOrder) {
+  TaskScheduler scheduler(1);
+  QSemaphore blocker;
+  QMutex mutex;
+  QList<TaskScheduler::Priority> order;
+  auto record = [&mutex, &order](TaskScheduler::Priority priority) {
+    QMutexLocker lock(&mutex);
+    order.append(priority);
+  };
+
+  // Occupy the only thread until all tasks are queued.
+  QFuture<void> blocking =
+      scheduler.run(TaskScheduler::Group::Default,
+                    TaskScheduler::Priority::Normal,
+                    [&blocker]() { blocker.acquire(); });
+  for (auto priority :
+       {TaskScheduler::Priority::Background, TaskScheduler::Priority::Normal,
+        TaskScheduler::Priority::Interactive}) {
+    scheduler.run(TaskScheduler::Group::Default, priority,
+                  [&record, priority]() { record(priority); });
+  }
+  blocker.release();
+  EXPECT_TRUE(scheduler.waitForDone(10000));
+
+  const QList<TaskScheduler::Priority> expected = {
+      TaskScheduler::Priority::Interactive,
+      TaskScheduler::Priority::Normal,
+      TaskScheduler::Priority::Background,
+  };
+  EXPECT_EQ(expected, order);
+}
+
+TEST_F(TaskSchedulerTest, testConcurrencyLimit) {
+  TaskScheduler scheduler(4);
+  scheduler.setConcurrencyLimit(TaskScheduler::Group::Drc, 1);
+  EXPECT_EQ(1, scheduler.getConcurrencyLimit(TaskScheduler::Group::Drc));
+  std::atomic<int> running(0);
+  std::atomic<int> maxRunning(0);
+  for (int i = 0; i < 4; ++i) {
+    scheduler.run(TaskScheduler::Group::Drc, TaskScheduler::Priority::Normal,
+                  [&running, &maxRunning]() {
+                    const int count = ++running;
+                    int max = maxRunning.load();
+                    while ((count > max) &&
+                           (!maxRunning.compare_exchange_weak(max, count))) {
+                    }
+                    QThread::msleep(20);
+                    --running;
+                  });
+  }
+  EXPECT_TRUE(scheduler.waitForDone(10000));
+  EXPECT_EQ(1, maxRunning.load());
+  EXPECT_EQ(0, scheduler.getQueuedTasksCount(TaskScheduler::Group::Drc));
+  EXPECT_EQ(0, scheduler.getRunningTasksCount(TaskScheduler::Group::Drc));
+}
+
+TEST_F(TaskSchedulerTest, testNestedWaitDoesNotDeadlock) {
+  TaskScheduler scheduler(1);
+  QFuture<int> outer = scheduler.run(
+      TaskScheduler::Group::Default, TaskScheduler::Priority::Normal,
+      [&scheduler]() {
+        QFuture<int> inner = scheduler.run(TaskScheduler::Group::Default,
+                                           TaskScheduler::Priority::Normal,
+                                           []() { return 21; });
+        scheduler.waitForFinished(inner);
+        return inner.result() * 2;
+      });
+  scheduler.waitForFinished(outer);
+  EXPECT_EQ(42, outer.result());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,168 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/utils/tracer.h>
+
+#include <QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class TracerTest : public ::testing::Test {
+protected:
+  ~TracerTest() { Tracer::instance().stop(); }
+
+  static int countEvents(const QVector<Tracer::Event>& events,
+                         const char* name) noexcept {
+    return std::count_if(events.begin(), events.end(),
+                         [name](const Tracer::Event& e) {
+                           return qstrcmp(e.name, name) == 0;
+                         });
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(TracerTest, testDisabledByDefault) {
+  Tracer& tracer = Tracer::instance();
+  EXPECT_FALSE(tracer.isEnabled());
+  const int countBefore = tracer.getEvents().count();
+  { TraceZone zone("zone"); }
+  tracer.addCounter("counter", 42);
+  EXPECT_EQ(countBefore, tracer.getEvents().count());
+}
+
+TEST_F(TracerTest, testZone) {
+  Tracer& tracer = Tracer::instance();
+  tracer.start();
+  EXPECT_TRUE(tracer.isEnabled());
+  { TraceZone zone("zone"); }
+  tracer.stop();
+  { TraceZone zone("zone"); }
+
+  const QVector<Tracer::Event> events = tracer.getEvents();
+  ASSERT_EQ(1, events.count());
+  EXPECT_STREQ("zone", events.first().name);
+  EXPECT_EQ('X', events.first().phase);
+  EXPECT_GE(events.first().durationNs, 0);
+}
+
+TEST_F(TracerTest, testCounter) {
+  Tracer& tracer = Tracer::instance();
+  tracer.start();
+  tracer.addCounter("counter", 42);
+
+  const QVector<Tracer::Event> events = tracer.getEvents();
+  ASSERT_EQ(1, events.count());
+  EXPECT_STREQ("counter", events.first().name);
+  EXPECT_EQ('C', events.first().phase);
+  EXPECT_EQ(42, events.first().value);
+}
+
+TEST_F(TracerTest, testStartClearsEvents) {
+  Tracer& tracer = Tracer::instance();
+  tracer.start();
+  tracer.addCounter("counter", 1);
+  tracer.start();
+  EXPECT_EQ(0, tracer.getEvents().count());
+}
+
+TEST_F(TracerTest, testMaxEvents) {
+  Tracer& tracer = Tracer::instance();
+  tracer.start(2);
+  for (int i = 0; i < 5; ++i) {
+    tracer.addCounter("counter", i);
+  }
+  EXPECT_EQ(2, tracer.getEvents().count());
+  EXPECT_EQ(3, tracer.getDroppedEventsCount());
+}
+
+TEST_F(TracerTest, testMultipleThreads) {
+  Tracer& tracer = Tracer::instance();
+  tracer.start();
+  QThreadPool pool;
+  pool.setMaxThreadCount(4);
+  QList<QFuture<void>> futures;
+  for (int i = 0; i < 4; ++i) {
+    futures.append(QtConcurrent::run(&pool, []() {
+      for (int k = 0; k < 100; ++k) {
+        TraceZone zone("zone");
+      }
+    }));
+  }
+  for (QFuture<void>& future : futures) {
+    future.waitForFinished();
+  }
+
+  const QVector<Tracer::Event> events = tracer.getEvents();
+  EXPECT_EQ(400, countEvents(events, "zone"));
+  const QMap<int, QString> threads = tracer.getThreadNames();
+  for (const Tracer::Event& e : events) {
+    EXPECT_TRUE(threads.contains(e.threadId));
+  }
+}
+
+TEST_F(TracerTest, testChromeTraceJson) {
+  Tracer& tracer = Tracer::instance();
+  tracer.start();
+  { TraceZone zone("my \"zone\""); }
+  tracer.addCounter("counter", 42);
+
+  QJsonParseError error;
+  const QJsonDocument doc =
+      QJsonDocument::fromJson(tracer.toChromeTraceJson(), &error);
+  ASSERT_EQ(QJsonParseError::NoError, error.error)
+      << qPrintable(error.errorString());
+  const QJsonArray events = doc.object().value("traceEvents").toArray();
+  QHash<QString, QJsonObject> eventsByName;
+  for (const QJsonValue& value : events) {
+    eventsByName.insert(value.toObject().value("name").toString(),
+                        value.toObject());
+  }
+  ASSERT_TRUE(eventsByName.contains("thread_name"));
+  ASSERT_TRUE(eventsByName.contains("my \"zone\""));
+  ASSERT_TRUE(eventsByName.contains("counter"));
+  EXPECT_EQ("X", eventsByName["my \"zone\""].value("ph").toString());
+  EXPECT_TRUE(eventsByName["my \"zone\""].contains("dur"));
+  EXPECT_EQ("C", eventsByName["counter"].value("ph").toString());
+  EXPECT_EQ(
+      42,
+      eventsByName["counter"].value("args").toObject().value("value").toInt());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
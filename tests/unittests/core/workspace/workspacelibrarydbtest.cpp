@@ -284,6 +284,87 @@ TEST_F(WorkspaceLibraryDbTest, testGetAllWithUuidAndLibrary) {
             str(mWsDb->getAll<Symbol>(uuid(1), toAbs("lib2"))));
 }
 
+/*******************************************************************************
+ *  Tests for getAllInfos()
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testGetAllInfosEmptyDb) {
+  EXPECT_EQ(0, mWsDb->getAllInfos<ComponentCategory>({}).count());
+  EXPECT_EQ(0, mWsDb->getAllInfos<Symbol>({}, toAbs("lib")).count());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetAllInfosCategories) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("0.1"), false,
+                                QByteArray(), QString());
+  int id = mWriter->addCategory<ComponentCategory>(
+      lib, toAbs("lib/cat1"), uuid(1), version("0.1"), false, std::nullopt);
+  mWriter->addTranslation<ComponentCategory>(id, "", ElementName("n1"), "d1",
+                                             "k1");
+  mWriter->addTranslation<ComponentCategory>(id, "de_DE", ElementName("n2"),
+                                             std::nullopt, std::nullopt);
+  mWriter->addCategory<ComponentCategory>(lib, toAbs("lib/cat2"), uuid(2),
+                                          version("0.2"), true, uuid(1));
+  mWriter->addCategory<ComponentCategory>(0, toAbs("cat3"), uuid(3),
+                                          version("0.3"), false, std::nullopt);
+
+  auto infos = mWsDb->getAllInfos<ComponentCategory>({"de_DE"}, toAbs("lib"));
+  std::sort(infos.begin(), infos.end(), [](const auto& a, const auto& b) {
+    return a.filePath < b.filePath;
+  });
+  ASSERT_EQ(2, infos.count());
+  EXPECT_EQ(str(toAbs("lib/cat1")), str(infos[0].filePath));
+  EXPECT_EQ(str(uuid(1)), str(infos[0].uuid));
+  EXPECT_EQ(str(version("0.1")), str(infos[0].version));
+  EXPECT_FALSE(infos[0].deprecated);
+  EXPECT_EQ("n2", infos[0].name.toStdString());
+  EXPECT_EQ("d1", infos[0].description.toStdString());
+  EXPECT_EQ("k1", infos[0].keywords.toStdString());
+  EXPECT_FALSE(infos[0].parent.has_value());
+  EXPECT_EQ(str(toAbs("lib/cat2")), str(infos[1].filePath));
+  EXPECT_EQ(str(version("0.2")), str(infos[1].version));
+  EXPECT_TRUE(infos[1].deprecated);
+  EXPECT_EQ("", infos[1].name.toStdString());
+  EXPECT_EQ(uuid(1), infos[1].parent);
+
+  // Without library filter.
+  EXPECT_EQ(3, mWsDb->getAllInfos<ComponentCategory>({}).count());
+  EXPECT_EQ(0, mWsDb->getAllInfos<PackageCategory>({}).count());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetAllInfosElements) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("0.1"), false,
+                                QByteArray(), QString());
+  int id = mWriter->addElement<Symbol>(lib, toAbs("lib/sym1"), uuid(1),
+                                       version("0.1"), false, QString());
+  mWriter->addTranslation<Symbol>(id, "", ElementName("n1"), "d1", "k1");
+  mWriter->addToCategory<Symbol>(id, uuid(10));
+  mWriter->addToCategory<Symbol>(id, uuid(11));
+  id = mWriter->addElement<Symbol>(lib, toAbs("lib/sym2"), uuid(2),
+                                   version("0.2"), false, QString());
+  id = mWriter->addElement<Symbol>(0, toAbs("sym3"), uuid(3), version("0.3"),
+                                   false, QString());
+  mWriter->addTranslation<Symbol>(id, "", ElementName("n3"), "d3", "k3");
+  mWriter->addToCategory<Symbol>(id, uuid(10));
+
+  auto infos = mWsDb->getAllInfos<Symbol>({}, toAbs("lib"));
+  std::sort(infos.begin(), infos.end(), [](const auto& a, const auto& b) {
+    return a.filePath < b.filePath;
+  });
+  ASSERT_EQ(2, infos.count());
+  EXPECT_EQ(str(uuid(1)), str(infos[0].uuid));
+  EXPECT_EQ("n1", infos[0].name.toStdString());
+  EXPECT_EQ("d1", infos[0].description.toStdString());
+  EXPECT_EQ("k1", infos[0].keywords.toStdString());
+  EXPECT_EQ(str(QSet<Uuid>{uuid(10), uuid(11)}), str(infos[0].categories));
+  EXPECT_EQ(str(uuid(2)), str(infos[1].uuid));
+  EXPECT_EQ("", infos[1].name.toStdString());
+  EXPECT_EQ(str(QSet<Uuid>{}), str(infos[1].categories));
+
+  // Without library filter.
+  EXPECT_EQ(3, mWsDb->getAllInfos<Symbol>({}).count());
+  EXPECT_EQ(0, mWsDb->getAllInfos<Device>({}).count());
+}
+
 /*******************************************************************************
  *  Tests for getLatest()
  ******************************************************************************/
@@ -0,0 +1,244 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionaldirectory.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/library/cmp/component.h>
+#include <librepcb/core/sqlitedatabase.h>
+#include <librepcb/core/utils/taskscheduler.h>
+#include <librepcb/core/workspace/workspacelibrarydb.h>
+#include <librepcb/core/workspace/workspacelibrarydbwriter.h>
+#include <librepcb/editor/library/libraryelementcache.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class LibraryElementCacheTest : public ::testing::Test {
+protected:
+  FilePath mWsDir;
+  std::unique_ptr<WorkspaceLibraryDb> mWsDb;
+  std::unique_ptr<SQLiteDatabase> mDb;
+  std::unique_ptr<WorkspaceLibraryDbWriter> mWriter;
+  std::shared_ptr<TransactionalFileSystem> mFs;
+
+  LibraryElementCacheTest() : mWsDir(FilePath::getRandomTempPath()) {
+    FileUtils::makePath(mWsDir);
+    mWsDb.reset(new WorkspaceLibraryDb(mWsDir));
+    mDb.reset(new SQLiteDatabase(mWsDb->getFilePath()));
+    mWriter.reset(new WorkspaceLibraryDbWriter(mWsDir, *mDb));
+    mFs.reset(new TransactionalFileSystem(mWsDir, true));
+  }
+
+  ~LibraryElementCacheTest() {
+    mFs.reset();
+    mWriter.reset();
+    mDb.reset();
+    mWsDb.reset();
+    QDir(mWsDir.toStr()).removeRecursively();
+  }
+
+  Uuid addComponent(const QString& name) {
+    const Uuid uuid = Uuid::createRandom();
+    const Version version = Version::fromString("0.1");
+    mWriter->addElement<Component>(0, mWsDir.getPathTo(uuid.toStr()), uuid,
+                                   version, false, QString());
+    TransactionalDirectory dir(mFs, uuid.toStr());
+    Component cmp(uuid, version, "", ElementName(name), "", "");
+    cmp.saveTo(dir);
+    mFs->save();
+    return uuid;
+  }
+
+  static bool waitFor(const std::function<bool()>& condition) {
+    QElapsedTimer timer;
+    timer.start();
+    while ((!condition()) && (timer.elapsed() < 10000)) {
+      qApp->processEvents(QEventLoop::AllEvents, 10);
+    }
+    return condition();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(LibraryElementCacheTest, testGetCachedElement) {
+  const Uuid uuid = addComponent("foo");
+  LibraryElementCache cache(*mWsDb);
+  std::shared_ptr<const Component> cmp = cache.getComponent(uuid, true);
+  ASSERT_TRUE(cmp != nullptr);
+  EXPECT_EQ(uuid, cmp->getUuid());
+  EXPECT_EQ(cmp, cache.getComponent(uuid, true));
+  EXPECT_EQ(1, cache.getCount());
+}
+
+TEST_F(LibraryElementCacheTest, testGetNonExistentElement) {
+  LibraryElementCache cache(*mWsDb);
+  const Uuid uuid = Uuid::createRandom();
+  EXPECT_EQ(nullptr, cache.getComponent(uuid, false));
+  EXPECT_THROW(cache.getComponent(uuid, true), Exception);
+  EXPECT_EQ(0, cache.getCount());
+}
+
+TEST_F(LibraryElementCacheTest, testReset) {
+  const Uuid uuid = addComponent("foo");
+  LibraryElementCache cache(*mWsDb);
+  std::shared_ptr<const Component> cmp = cache.getComponent(uuid, true);
+  cache.reset();
+  EXPECT_EQ(0, cache.getCount());
+  EXPECT_NE(cmp, cache.getComponent(uuid, true));
+}
+
+TEST_F(LibraryElementCacheTest, testLeastRecentlyUsedEviction) {
+  const Uuid uuid1 = addComponent("foo");
+  const Uuid uuid2 = addComponent("bar");
+  const Uuid uuid3 = addComponent("baz");
+  LibraryElementCache cache(*mWsDb);
+  std::shared_ptr<const Component> cmp1 = cache.getComponent(uuid1, true);
+  std::shared_ptr<const Component> cmp2 = cache.getComponent(uuid2, true);
+  cache.setMaxCost(cache.getTotalCost());
+  EXPECT_EQ(cmp1, cache.getComponent(uuid1, true));  // Mark as recently used.
+  std::shared_ptr<const Component> cmp3 = cache.getComponent(uuid3, true);
+  EXPECT_LE(cache.getTotalCost(), cache.getMaxCost());
+  EXPECT_EQ(cmp3, cache.getComponent(uuid3, true));
+  EXPECT_NE(cmp2, cache.getComponent(uuid2, true));  // Has been evicted.
+}
+
+TEST_F(LibraryElementCacheTest, testRequest) {
+  const Uuid uuid = addComponent("foo");
+  LibraryElementCache cache(*mWsDb);
+  QObject context;
+  std::optional<std::shared_ptr<const Component>> result;
+  QString error = "no callback";
+  cache.request<Component>(
+      uuid, &context,
+      [&](std::shared_ptr<const Component> cmp, QString errorMsg) {
+        result = cmp;
+        error = errorMsg;
+      });
+  EXPECT_FALSE(result.has_value());  // Must not be invoked synchronously.
+  ASSERT_TRUE(waitFor([&]() { return result.has_value(); }));
+  ASSERT_TRUE(*result != nullptr);
+  EXPECT_EQ(uuid, (*result)->getUuid());
+  EXPECT_EQ("", error.toStdString());
+  EXPECT_EQ(*result, cache.getComponent(uuid, true));
+}
+
+TEST_F(LibraryElementCacheTest, testRequestNonExistentElement) {
+  LibraryElementCache cache(*mWsDb);
+  QObject context;
+  std::optional<std::shared_ptr<const Component>> result;
+  QString error;
+  cache.request<Component>(
+      Uuid::createRandom(), &context,
+      [&](std::shared_ptr<const Component> cmp, QString errorMsg) {
+        result = cmp;
+        error = errorMsg;
+      });
+  ASSERT_TRUE(waitFor([&]() { return result.has_value(); }));
+  EXPECT_EQ(nullptr, *result);
+  EXPECT_FALSE(error.isEmpty());
+}
+
+TEST_F(LibraryElementCacheTest, testRequestWithDestroyedContext) {
+  const Uuid uuid = addComponent("foo");
+  LibraryElementCache cache(*mWsDb);
+  bool called = false;
+  {
+    QObject context;
+    cache.request<Component>(
+        uuid, &context,
+        [&](std::shared_ptr<const Component>, QString) { called = true; });
+  }
+  EXPECT_TRUE(waitFor([&]() { return cache.getCount() == 1; }));
+  qApp->processEvents();
+  EXPECT_FALSE(called);
+}
+
+TEST_F(LibraryElementCacheTest, testPrefetch) {
+  const Uuid uuid1 = addComponent("foo");
+  const Uuid uuid2 = addComponent("bar");
+  LibraryElementCache cache(*mWsDb);
+  cache.prefetch<Component>({uuid1, uuid2, Uuid::createRandom()});
+  EXPECT_TRUE(waitFor([&]() { return cache.getCount() == 2; }));
+  std::shared_ptr<const Component> cmp1 = cache.getComponent(uuid1, true);
+  ASSERT_TRUE(cmp1 != nullptr);
+  EXPECT_EQ(uuid1, cmp1->getUuid());
+}
+
+TEST_F(LibraryElementCacheTest, testGetWhilePrefetching) {
+  const Uuid uuid = addComponent("foo");
+  LibraryElementCache cache(*mWsDb);
+  cache.prefetch<Component>({uuid});
+  std::shared_ptr<const Component> cmp = cache.getComponent(uuid, true);
+  ASSERT_TRUE(cmp != nullptr);
+  EXPECT_EQ(uuid, cmp->getUuid());
+  EXPECT_EQ(1, cache.getCount());
+  qApp->processEvents();
+  EXPECT_EQ(cmp, cache.getComponent(uuid, true));
+}
+
+TEST_F(LibraryElementCacheTest, testRequestWhilePrefetching) {
+  const Uuid uuid = addComponent("foo");
+  LibraryElementCache cache(*mWsDb);
+  cache.prefetch<Component>({uuid});
+  QObject context;
+  int calls = 0;
+  std::shared_ptr<const Component> result;
+  cache.request<Component>(
+      uuid, &context, [&](std::shared_ptr<const Component> cmp, QString) {
+        ++calls;
+        result = cmp;
+      });
+  ASSERT_TRUE(waitFor([&]() { return calls > 0; }));
+  ASSERT_TRUE(result != nullptr);
+  EXPECT_EQ(uuid, result->getUuid());
+
+  // The callback must be invoked only once, even though the load has been
+  // scheduled twice.
+  EXPECT_TRUE(TaskScheduler::instance().waitForDone(5000));
+  qApp->processEvents();
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(1, cache.getCount());
+  EXPECT_EQ(result, cache.getComponent(uuid, true));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace editor
+}  // namespace librepcb
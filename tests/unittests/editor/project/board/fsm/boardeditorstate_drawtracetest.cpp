@@ -0,0 +1,227 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/syntheticprojectgenerator.h>
+#include <librepcb/core/workspace/workspace.h>
+#include <librepcb/editor/graphics/graphicslayerlist.h>
+#include <librepcb/editor/graphics/graphicsscene.h>
+#include <librepcb/editor/project/board/boardgraphicsscene.h>
+#include <librepcb/editor/project/board/fsm/boardeditorfsm.h>
+#include <librepcb/editor/project/board/fsm/boardeditorfsmadapter.h>
+#include <librepcb/editor/project/board/fsm/boardeditorstate_drawtrace.h>
+#include <librepcb/editor/undostack.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardEditorState_DrawTraceTest : public ::testing::Test,
+                                       public BoardEditorFsmAdapter {
+protected:
+  FilePath mTmpDir;
+  std::unique_ptr<Workspace> mWorkspace;
+  std::unique_ptr<Project> mProject;
+  std::unique_ptr<UndoStack> mUndoStack;
+  std::unique_ptr<GraphicsLayerList> mLayers;
+  std::unique_ptr<BoardGraphicsScene> mScene;
+
+  BoardEditorState_DrawTraceTest() : mTmpDir(FilePath::getRandomTempPath()) {
+    const FilePath wsDir = mTmpDir.getPathTo("workspace");
+    Workspace::createNewWorkspace(wsDir);
+    mWorkspace.reset(new Workspace(wsDir, "data"));
+
+    // A board with a single device and no traces, so there's enough space
+    // to draw traces without touching any other item.
+    SyntheticProjectGenerator::Options options;
+    options.componentCount = 1;
+    options.netCount = 1;
+    options.planeCount = 0;
+    options.tracePercent = 0;
+    mProject = SyntheticProjectGenerator(options).generate(
+        mTmpDir.getPathTo("project/project.lpp"));
+
+    mUndoStack.reset(new UndoStack());
+    mLayers = GraphicsLayerList::boardLayers(&mWorkspace->getSettings());
+    mScene.reset(new BoardGraphicsScene(
+        getBoard(), *mLayers, std::make_shared<QSet<const NetSignal*>>()));
+  }
+
+  ~BoardEditorState_DrawTraceTest() {
+    mScene.reset();
+    mUndoStack.reset();
+    mLayers.reset();
+    mProject.reset();
+    mWorkspace.reset();
+    QDir(mTmpDir.toStr()).removeRecursively();
+  }
+
+  Board& getBoard() noexcept { return *mProject->getBoards().first(); }
+
+  BoardEditorFsm::Context getContext() noexcept {
+    return BoardEditorFsm::Context{
+        *mWorkspace, *mProject, getBoard(), *mUndoStack, *mLayers, *this,
+    };
+  }
+
+  static void click(BoardEditorState& state, const Point& pos) noexcept {
+    GraphicsSceneMouseEvent e;
+    e.scenePos = pos;
+    e.downPos = pos;
+    state.processGraphicsSceneMouseMoved(e);
+    e.buttons = Qt::LeftButton;
+    state.processGraphicsSceneLeftMouseButtonPressed(e);
+  }
+
+  // BoardEditorFsmAdapter
+  BoardGraphicsScene* fsmGetGraphicsScene() noexcept override {
+    return mScene.get();
+  }
+  bool fsmGetIgnoreLocks() const noexcept override { return false; }
+  void fsmSetViewCursor(
+      const std::optional<Qt::CursorShape>& shape) noexcept override {
+    Q_UNUSED(shape);
+  }
+  void fsmSetViewGrayOut(bool grayOut) noexcept override { Q_UNUSED(grayOut); }
+  void fsmSetViewInfoBoxText(const QString& text) noexcept override {
+    Q_UNUSED(text);
+  }
+  void fsmSetViewRuler(
+      const std::optional<std::pair<Point, Point>>& pos) noexcept override {
+    Q_UNUSED(pos);
+  }
+  void fsmSetViewDrcMarkers(const QVector<Path>& locations) noexcept override {
+    Q_UNUSED(locations);
+  }
+  void fsmSetSceneCursor(const Point& pos, bool cross,
+                         bool circle) noexcept override {
+    Q_UNUSED(pos);
+    Q_UNUSED(cross);
+    Q_UNUSED(circle);
+  }
+  QPainterPath fsmCalcPosWithTolerance(
+      const Point& pos, qreal multiplier) const noexcept override {
+    const qreal tolerance = Length(100000).toPx() * multiplier;
+    QPainterPath path;
+    path.addEllipse(pos.toPxQPointF(), tolerance, tolerance);
+    return path;
+  }
+  Point fsmMapGlobalPosToScenePos(const QPoint& pos) const noexcept override {
+    Q_UNUSED(pos);
+    return Point();
+  }
+  void fsmSetHighlightedNetSignals(
+      const QSet<const NetSignal*>& sigs) noexcept override {
+    Q_UNUSED(sigs);
+  }
+  void fsmAbortBlockingToolsInOtherEditors() noexcept override {}
+  void fsmSetStatusBarMessage(const QString& message,
+                              int timeoutMs = -1) noexcept override {
+    Q_UNUSED(message);
+    Q_UNUSED(timeoutMs);
+  }
+  void fsmSetFeatures(Features features) noexcept override {
+    Q_UNUSED(features);
+  }
+  void fsmToolLeave() noexcept override {}
+  void fsmToolEnter(BoardEditorState_Select& state) noexcept override {
+    Q_UNUSED(state);
+  }
+  void fsmToolEnter(BoardEditorState_DrawTrace& state) noexcept override {
+    Q_UNUSED(state);
+  }
+  void fsmToolEnter(BoardEditorState_AddVia& state) noexcept override {
+    Q_UNUSED(state);
+  }
+  void fsmToolEnter(BoardEditorState_AddPad& state) noexcept override {
+    Q_UNUSED(state);
+  }
+  void fsmToolEnter(BoardEditorState_DrawPolygon& state) noexcept override {
+    Q_UNUSED(state);
+  }
+  void fsmToolEnter(BoardEditorState_AddStrokeText& state) noexcept override {
+    Q_UNUSED(state);
+  }
+  void fsmToolEnter(BoardEditorState_DrawPlane& state) noexcept override {
+    Q_UNUSED(state);
+  }
+  void fsmToolEnter(BoardEditorState_DrawZone& state) noexcept override {
+    Q_UNUSED(state);
+  }
+  void fsmToolEnter(BoardEditorState_AddHole& state) noexcept override {
+    Q_UNUSED(state);
+  }
+  void fsmToolEnter(BoardEditorState_AddDevice& state) noexcept override {
+    Q_UNUSED(state);
+  }
+  void fsmToolEnter(BoardEditorState_Measure& state) noexcept override {
+    Q_UNUSED(state);
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardEditorState_DrawTraceTest, testClearanceIndexKeptWhileDrawing) {
+  BoardEditorState_DrawTrace state(getContext());
+  ASSERT_TRUE(state.entry());
+  EXPECT_EQ(0, state.getClearanceIndexBuildCount());
+
+  // Starting a trace builds the clearance index.
+  click(state, Point(25400000, 25400000));
+  EXPECT_EQ(1, state.getClearanceIndexBuildCount());
+
+  // Adding the next points commits the drawn traces, but the index is kept.
+  click(state, Point(30480000, 25400000));
+  EXPECT_TRUE(mUndoStack->canUndo());
+  EXPECT_EQ(1, state.getClearanceIndexBuildCount());
+  click(state, Point(30480000, 30480000));
+  EXPECT_EQ(1, state.getClearanceIndexBuildCount());
+
+  // After finishing the trace, the next trace might belong to another net so
+  // the committed traces have to be added to the index.
+  EXPECT_TRUE(state.processAbortCommand());
+  click(state, Point(35560000, 35560000));
+  EXPECT_EQ(2, state.getClearanceIndexBuildCount());
+
+  EXPECT_TRUE(state.exit());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace editor
+}  // namespace librepcb
@@ -144,6 +144,52 @@ TEST_F(KiCadLibraryImportTest, testImport) {
   EXPECT_EQ(22, dstFiles.count());
 }
 
+TEST_F(KiCadLibraryImportTest, testImportIsDeterministic) {
+  // Files are parsed and written in parallel, but the result and the log
+  // output must not depend on the thread scheduling.
+  const FilePath src(TEST_DATA_DIR "/unittests/kicadimport");
+  auto run = [&](const FilePath& dst) {
+    KiCadLibraryImport import(*mWsDb, dst);
+    std::shared_ptr<MessageLogger> log = std::make_shared<MessageLogger>();
+    EXPECT_TRUE(import.startScan(src, FilePath(), log));
+    import.getResult();
+    EXPECT_TRUE(import.startParse(log));
+    import.getResult();
+    EXPECT_TRUE(import.startImport(log));
+    std::shared_ptr<KiCadLibraryImport::Result> result = import.getResult();
+    EXPECT_EQ(KiCadLibraryImport::State::Imported, import.getState());
+    QStringList symbols;
+    for (const KiCadLibraryImport::SymbolLibrary& lib : result->symbolLibs) {
+      for (const KiCadLibraryImport::Symbol& sym : lib.symbols) {
+        symbols.append(lib.file.getCompleteBasename() % ":" % sym.name);
+      }
+    }
+    QStringList footprints;
+    for (const KiCadLibraryImport::FootprintLibrary& lib :
+         result->footprintLibs) {
+      for (const KiCadLibraryImport::Footprint& fpt : lib.footprints) {
+        footprints.append(lib.dir.getCompleteBasename() % ":" % fpt.name);
+      }
+    }
+    const int fileCount =
+        FileUtils::getFilesInDirectory(dst, QStringList(), true, false)
+            .count();
+    QDir(dst.toStr()).removeRecursively();
+    return std::make_tuple(symbols, footprints, log->getMessagesPlain(),
+                           fileCount);
+  };
+
+  const auto result1 = run(FilePath::getRandomTempPath());
+  const auto result2 = run(FilePath::getRandomTempPath());
+  EXPECT_EQ(3, std::get<0>(result1).count());
+  EXPECT_EQ(3, std::get<1>(result1).count());
+  EXPECT_EQ(22, std::get<3>(result1));
+  EXPECT_EQ(std::get<0>(result1), std::get<0>(result2));
+  EXPECT_EQ(std::get<1>(result1), std::get<1>(result2));
+  EXPECT_EQ(std::get<2>(result1), std::get<2>(result2));
+  EXPECT_EQ(std::get<3>(result1), std::get<3>(result2));
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/